@@ -330,6 +330,8 @@ set(hasxft ${has${xft}})
 set(hascling ${has${cling}})
 set(haslzmacompression ${has${lzma}})
 set(hascocoa ${has${cocoa}})
+set(haslz4 ${has${lz4}})
+set(haszstd ${has${zstd}})
 set(usec++11 ${has${cxx11}})
 set(uselibc++11 ${has${libcxx11}})
 set(hasllvm undef)
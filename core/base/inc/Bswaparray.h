@@ -0,0 +1,49 @@
+/* @(#)root/base:$Id$ */
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+#ifndef ROOT_Bswaparray
+#define ROOT_Bswaparray
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Bswaparray                                                           //
+//                                                                      //
+// Byte swapping routines for arrays of 2, 4 and 8 bytes elements,      //
+// used by TBufferFile to convert arrays of basic types from and to     //
+// the big endian format of the ROOT files.                             //
+//                                                                      //
+// Use of routines is similar to that of memcpy, except that n is the   //
+// number of array elements (not the number of bytes). The source and   //
+// the destination need not be aligned and must not overlap.            //
+//                                                                      //
+// On x86 the routines use SSSE3 or AVX2 shuffles when the processor    //
+// supports them. The kernel is selected at the first call; it can be   //
+// changed with R__SetBswapKernel (e.g. to compare the performances).   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+enum EBswapKernel {
+   kBswapScalar = 0,   // one element at a time
+   kBswapSSSE3  = 1,   // 16 bytes at a time
+   kBswapAVX2   = 2    // 32 bytes at a time
+};
+
+void        R__bswapcpy16(void *to, const void *from, Int_t n);
+void        R__bswapcpy32(void *to, const void *from, Int_t n);
+void        R__bswapcpy64(void *to, const void *from, Int_t n);
+
+Int_t       R__GetBswapKernel();
+const char *R__GetBswapKernelName(Int_t kernel);
+Int_t       R__SetBswapKernel(Int_t kernel);
+
+#endif
@@ -112,6 +112,7 @@ class TClassStreamer;   // Streamer functor for a class
 class TMemberStreamer;  // Streamer functor for a data member
 typedef void (*ClassStreamerFunc_t)(TBuffer&, void*);  // Streamer function for a class
 typedef void (*MemberStreamerFunc_t)(TBuffer&, void*, Int_t); // Streamer function for a data member
+typedef void (*ClassSpecializedStreamerFunc_t)(TBuffer&, void*, const Long_t*); // Streamer of the data members of a class, at the given offsets
 
 // This class is used to implement proxy around collection classes.
 class TVirtualCollectionProxy;
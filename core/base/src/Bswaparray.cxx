@@ -0,0 +1,348 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Bswaparray                                                           //
+//                                                                      //
+// Byte swapping of arrays (see Bswaparray.h).                          //
+//                                                                      //
+// The vector kernels are compiled with the target attribute of gcc and //
+// clang, so that the library itself does not require SSSE3 or AVX2;    //
+// the best kernel supported by the processor running the code is       //
+// chosen at the first call.                                            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Bswaparray.h"
+#include "Bytes.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__INTEL_COMPILER) && \
+    ((defined(__clang__) && (__clang_major__ > 3 || \
+                             (__clang_major__ == 3 && __clang_minor__ >= 8))) || \
+     (!defined(__clang__) && defined(__GNUC__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define R__BSWAP_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+   typedef void (*BswapFunc_t)(void *to, const void *from, Int_t n);
+
+   //______________________________________________________________________________
+   inline UShort_t Swap16(UShort_t x)
+   {
+#if defined(R__USEASMSWAP)
+      return Rbswap_16(x);
+#else
+      return (UShort_t)((x << 8) | (x >> 8));
+#endif
+   }
+
+   //______________________________________________________________________________
+   inline UInt_t Swap32(UInt_t x)
+   {
+#if defined(R__USEASMSWAP)
+      return Rbswap_32(x);
+#else
+      return ((x & 0x000000ffU) << 24) | ((x & 0x0000ff00U) <<  8) |
+             ((x & 0x00ff0000U) >>  8) | ((x & 0xff000000U) >> 24);
+#endif
+   }
+
+   //______________________________________________________________________________
+   inline ULong64_t Swap64(ULong64_t x)
+   {
+#if defined(R__USEASMSWAP)
+      return Rbswap_64(x);
+#else
+      return ((ULong64_t)Swap32((UInt_t)x) << 32) | Swap32((UInt_t)(x >> 32));
+#endif
+   }
+
+   // The elements are moved with memcpy, which the compilers turn into
+   // plain loads and stores, since the buffers need not be aligned.
+
+   //______________________________________________________________________________
+   void BswapCopy16Scalar(void *to, const void *from, Int_t n)
+   {
+      char *dst = (char*)to;
+      const char *src = (const char*)from;
+      for (Int_t i = 0; i < n; ++i, dst += 2, src += 2) {
+         UShort_t x;
+         memcpy(&x, src, 2);
+         x = Swap16(x);
+         memcpy(dst, &x, 2);
+      }
+   }
+
+   //______________________________________________________________________________
+   void BswapCopy32Scalar(void *to, const void *from, Int_t n)
+   {
+      char *dst = (char*)to;
+      const char *src = (const char*)from;
+      for (Int_t i = 0; i < n; ++i, dst += 4, src += 4) {
+         UInt_t x;
+         memcpy(&x, src, 4);
+         x = Swap32(x);
+         memcpy(dst, &x, 4);
+      }
+   }
+
+   //______________________________________________________________________________
+   void BswapCopy64Scalar(void *to, const void *from, Int_t n)
+   {
+      char *dst = (char*)to;
+      const char *src = (const char*)from;
+      for (Int_t i = 0; i < n; ++i, dst += 8, src += 8) {
+         ULong64_t x;
+         memcpy(&x, src, 8);
+         x = Swap64(x);
+         memcpy(dst, &x, 8);
+      }
+   }
+
+#ifdef R__BSWAP_X86_KERNELS
+
+   // pshufb masks: byte i of the result is byte mask[i] of the source.
+   // The AVX2 shuffle works on each 128 bits lane separately, so its
+   // masks are the SSSE3 ones repeated twice.
+
+   //______________________________________________________________________________
+   __attribute__((target("ssse3")))
+   void BswapCopySSSE3(void *to, const void *from, Int_t n, Int_t size, __m128i mask)
+   {
+      // Swap 16 bytes at a time, the remaining elements one by one.
+
+      char *dst = (char*)to;
+      const char *src = (const char*)from;
+      Int_t nbytes = n * size;
+      Int_t i = 0;
+      for (; i + 16 <= nbytes; i += 16) {
+         __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+         _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, mask));
+      }
+      if (i == nbytes) return;
+      if (size == 2)      BswapCopy16Scalar(dst + i, src + i, (nbytes - i) / 2);
+      else if (size == 4) BswapCopy32Scalar(dst + i, src + i, (nbytes - i) / 4);
+      else                BswapCopy64Scalar(dst + i, src + i, (nbytes - i) / 8);
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("ssse3")))
+   void BswapCopy16SSSE3(void *to, const void *from, Int_t n)
+   {
+      BswapCopySSSE3(to, from, n, 2, _mm_set_epi8(14,15,12,13,10,11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("ssse3")))
+   void BswapCopy32SSSE3(void *to, const void *from, Int_t n)
+   {
+      BswapCopySSSE3(to, from, n, 4, _mm_set_epi8(12,13,14,15, 8, 9,10,11, 4, 5, 6, 7, 0, 1, 2, 3));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("ssse3")))
+   void BswapCopy64SSSE3(void *to, const void *from, Int_t n)
+   {
+      BswapCopySSSE3(to, from, n, 8, _mm_set_epi8( 8, 9,10,11,12,13,14,15, 0, 1, 2, 3, 4, 5, 6, 7));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("avx2")))
+   void BswapCopyAVX2(void *to, const void *from, Int_t n, Int_t size, __m256i mask)
+   {
+      // Swap 64 then 32 bytes at a time, the remaining elements with SSSE3.
+
+      char *dst = (char*)to;
+      const char *src = (const char*)from;
+      Int_t nbytes = n * size;
+      Int_t i = 0;
+      for (; i + 64 <= nbytes; i += 64) {
+         __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + i));
+         __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+         _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v0, mask));
+         _mm256_storeu_si256((__m256i*)(dst + i + 32), _mm256_shuffle_epi8(v1, mask));
+      }
+      if (i + 32 <= nbytes) {
+         __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+         _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v, mask));
+         i += 32;
+      }
+      if (i == nbytes) return;
+      BswapCopySSSE3(dst + i, src + i, (nbytes - i) / size, size, _mm256_castsi256_si128(mask));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("avx2")))
+   void BswapCopy16AVX2(void *to, const void *from, Int_t n)
+   {
+      BswapCopyAVX2(to, from, n, 2,
+                    _mm256_set_epi8(14,15,12,13,10,11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                    14,15,12,13,10,11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("avx2")))
+   void BswapCopy32AVX2(void *to, const void *from, Int_t n)
+   {
+      BswapCopyAVX2(to, from, n, 4,
+                    _mm256_set_epi8(12,13,14,15, 8, 9,10,11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                    12,13,14,15, 8, 9,10,11, 4, 5, 6, 7, 0, 1, 2, 3));
+   }
+
+   //______________________________________________________________________________
+   __attribute__((target("avx2")))
+   void BswapCopy64AVX2(void *to, const void *from, Int_t n)
+   {
+      BswapCopyAVX2(to, from, n, 8,
+                    _mm256_set_epi8( 8, 9,10,11,12,13,14,15, 0, 1, 2, 3, 4, 5, 6, 7,
+                                     8, 9,10,11,12,13,14,15, 0, 1, 2, 3, 4, 5, 6, 7));
+   }
+
+#endif
+
+   void BswapCopy16First(void *to, const void *from, Int_t n);
+   void BswapCopy32First(void *to, const void *from, Int_t n);
+   void BswapCopy64First(void *to, const void *from, Int_t n);
+
+   // The pointers are statically initialized to functions selecting the
+   // kernel on their first call, so that the routines can be used during
+   // the initialization of the libraries.
+   Int_t       gBswapKernel = -1;
+   BswapFunc_t gBswapCopy16 = BswapCopy16First;
+   BswapFunc_t gBswapCopy32 = BswapCopy32First;
+   BswapFunc_t gBswapCopy64 = BswapCopy64First;
+
+   //______________________________________________________________________________
+   Int_t GetBestBswapKernel()
+   {
+      // Return the fastest kernel supported by the processor.
+
+#ifdef R__BSWAP_X86_KERNELS
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))  return kBswapAVX2;
+      if (__builtin_cpu_supports("ssse3")) return kBswapSSSE3;
+#endif
+      return kBswapScalar;
+   }
+
+   //______________________________________________________________________________
+   void UseBswapKernel(Int_t kernel)
+   {
+      // Switch the function pointers to the given kernel. Concurrent
+      // selections are harmless: all the threads store the same values.
+
+      switch (kernel) {
+#ifdef R__BSWAP_X86_KERNELS
+         case kBswapAVX2:
+            gBswapCopy16 = BswapCopy16AVX2;
+            gBswapCopy32 = BswapCopy32AVX2;
+            gBswapCopy64 = BswapCopy64AVX2;
+            break;
+         case kBswapSSSE3:
+            gBswapCopy16 = BswapCopy16SSSE3;
+            gBswapCopy32 = BswapCopy32SSSE3;
+            gBswapCopy64 = BswapCopy64SSSE3;
+            break;
+#endif
+         default:
+            kernel = kBswapScalar;
+            gBswapCopy16 = BswapCopy16Scalar;
+            gBswapCopy32 = BswapCopy32Scalar;
+            gBswapCopy64 = BswapCopy64Scalar;
+            break;
+      }
+      gBswapKernel = kernel;
+   }
+
+   //______________________________________________________________________________
+   void BswapCopy16First(void *to, const void *from, Int_t n)
+   {
+      UseBswapKernel(GetBestBswapKernel());
+      gBswapCopy16(to, from, n);
+   }
+
+   //______________________________________________________________________________
+   void BswapCopy32First(void *to, const void *from, Int_t n)
+   {
+      UseBswapKernel(GetBestBswapKernel());
+      gBswapCopy32(to, from, n);
+   }
+
+   //______________________________________________________________________________
+   void BswapCopy64First(void *to, const void *from, Int_t n)
+   {
+      UseBswapKernel(GetBestBswapKernel());
+      gBswapCopy64(to, from, n);
+   }
+}
+
+//______________________________________________________________________________
+void R__bswapcpy16(void *to, const void *from, Int_t n)
+{
+   // Copy n elements of 2 bytes from from to to, swapping their bytes.
+
+   if (n > 0) gBswapCopy16(to, from, n);
+}
+
+//______________________________________________________________________________
+void R__bswapcpy32(void *to, const void *from, Int_t n)
+{
+   // Copy n elements of 4 bytes from from to to, swapping their bytes.
+
+   if (n > 0) gBswapCopy32(to, from, n);
+}
+
+//______________________________________________________________________________
+void R__bswapcpy64(void *to, const void *from, Int_t n)
+{
+   // Copy n elements of 8 bytes from from to to, swapping their bytes.
+
+   if (n > 0) gBswapCopy64(to, from, n);
+}
+
+//______________________________________________________________________________
+Int_t R__GetBswapKernel()
+{
+   // Return the kernel used by the R__bswapcpy routines (see EBswapKernel).
+
+   if (gBswapKernel < 0) UseBswapKernel(GetBestBswapKernel());
+   return gBswapKernel;
+}
+
+//______________________________________________________________________________
+const char *R__GetBswapKernelName(Int_t kernel)
+{
+   // Return the name of a kernel.
+
+   switch (kernel) {
+      case kBswapAVX2:  return "AVX2";
+      case kBswapSSSE3: return "SSSE3";
+      default:          return "scalar";
+   }
+}
+
+//______________________________________________________________________________
+Int_t R__SetBswapKernel(Int_t kernel)
+{
+   // Select the kernel used by the R__bswapcpy routines. If the processor
+   // does not support it, the best supported kernel is used instead.
+   // Returns the kernel selected.
+
+   Int_t best = GetBestBswapKernel();
+   if (kernel < 0 || kernel > best) kernel = best;
+   UseBswapKernel(kernel);
+   return gBswapKernel;
+}
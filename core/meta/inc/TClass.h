@@ -128,6 +128,8 @@ private:
    ROOT::DesFunc_t     fDestructor;     //pointer to a function call an object's destructor.
    ROOT::DirAutoAdd_t  fDirAutoAdd;     //pointer which implements the Directory Auto Add feature for this class.']'
    ClassStreamerFunc_t fStreamerFunc;   //Wrapper around this class custom Streamer member function.
+   ClassSpecializedStreamerFunc_t fSpecializedStreamerFunc; //!Streamer of the data members generated for the class layout
+   const char        **fSpecializedMembers; //!Null terminated list of the data members streamed by fSpecializedStreamerFunc
    Int_t               fSizeof;         //Sizeof the class.
 
            Int_t      fCanSplit;        //!Indicates whether this class can be split or not.
@@ -305,6 +307,8 @@ public:
    ShowMembersFunc_t  GetShowMembersWrapper() const { return fShowMembers; }
    TClassStreamer    *GetStreamer() const;
    ClassStreamerFunc_t GetStreamerFunc() const;
+   ClassSpecializedStreamerFunc_t GetSpecializedStreamerFunc() const { return fSpecializedStreamerFunc; }
+   const char       **GetSpecializedMembers() const { return fSpecializedMembers; }
    TObjArray         *GetStreamerInfos() const { return fStreamerInfo; }
    TVirtualStreamerInfo     *GetStreamerInfo(Int_t version=0) const;
    TVirtualStreamerInfo     *GetStreamerInfoAbstractEmulated(Int_t version=0) const;
@@ -360,6 +364,7 @@ public:
    void               AdoptMemberStreamer(const char *name, TMemberStreamer *strm);
    void               SetMemberStreamer(const char *name, MemberStreamerFunc_t strm);
    void               SetStreamerFunc(ClassStreamerFunc_t strm);
+   void               SetSpecializedStreamerFunc(ClassSpecializedStreamerFunc_t strm, const char **members);
 
    // Function to retrieve the TClass object and dictionary function
    static void           AddClass(TClass *cl);
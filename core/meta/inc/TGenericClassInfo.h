@@ -59,6 +59,8 @@ namespace ROOT {
       DirAutoAdd_t                fDirAutoAdd;
       TClassStreamer             *fStreamer;
       ClassStreamerFunc_t         fStreamerFunc;
+      ClassSpecializedStreamerFunc_t fSpecializedStreamerFunc;
+      const char                **fSpecializedMembers;
       TVirtualCollectionProxy    *fCollectionProxy;
       Int_t                       fSizeof;
       Int_t                       fPragmaBits;
@@ -137,6 +139,7 @@ namespace ROOT {
       void                              SetReadRules( const std::vector<ROOT::TSchemaHelper>& rules );
       Short_t                           SetStreamer(ClassStreamerFunc_t);
       void                              SetStreamerFunc(ClassStreamerFunc_t);
+      void                              SetSpecializedStreamerFunc(ClassSpecializedStreamerFunc_t, const char **members);
       Short_t                           SetVersion(Short_t version);
 
       //   protected:
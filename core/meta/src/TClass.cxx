@@ -779,7 +779,7 @@ TClass::TClass() :
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -805,7 +805,7 @@ TClass::TClass(const char *name, Bool_t silent) :
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -854,7 +854,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -883,7 +883,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -1162,6 +1162,8 @@ TClass::TClass(const TClass& cl) :
   fDestructor(cl.fDestructor),
   fDirAutoAdd(cl.fDirAutoAdd),
   fStreamerFunc(cl.fStreamerFunc),
+  fSpecializedStreamerFunc(cl.fSpecializedStreamerFunc),
+  fSpecializedMembers(cl.fSpecializedMembers),
   fSizeof(cl.fSizeof),
   fCanSplit(cl.fCanSplit),
   fProperty(cl.fProperty),
@@ -2012,6 +2014,8 @@ TObject *TClass::Clone(const char *new_name) const
    copy->SetDestructor(fDestructor);
    copy->SetDirectoryAutoAdd(fDirAutoAdd);
    copy->fStreamerFunc = fStreamerFunc;
+   copy->fSpecializedStreamerFunc = fSpecializedStreamerFunc;
+   copy->fSpecializedMembers = fSpecializedMembers;
    if (fStreamer) {
       copy->AdoptStreamer(fStreamer->Generate());
    }
@@ -5372,6 +5376,19 @@ void TClass::SetStreamerFunc(ClassStreamerFunc_t strm)
    }
 }
 
+//______________________________________________________________________________
+void TClass::SetSpecializedStreamerFunc(ClassSpecializedStreamerFunc_t strm, const char **members)
+{
+   // Set the streamer of the data members generated by rootcling for the layout
+   // of this class (LinkDef option 'specialized') and the null terminated list
+   // of the names of these data members. It is used by TStreamerInfo instead of
+   // its actions when the StreamerInfo describes the layout of the class (see
+   // TStreamerInfo::Compile).
+
+   fSpecializedStreamerFunc = strm;
+   fSpecializedMembers = strm ? members : 0;
+}
+
 //______________________________________________________________________________
 void TClass::SetMerge(ROOT::MergeFunc_t newMerge)
 {
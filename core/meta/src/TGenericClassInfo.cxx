@@ -49,7 +49,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(showmembers),
         fVersion(1),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof),
+        fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fCollectionProxy(0), fSizeof(sizof),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
    {
       // Constructor.
@@ -69,7 +69,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(showmembers),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-   fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof), fPragmaBits(pragmabits),
+   fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fCollectionProxy(0), fSizeof(sizof), fPragmaBits(pragmabits),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
    {
       // Constructor with version number.
@@ -89,7 +89,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(0),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof), fPragmaBits(pragmabits),
+        fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fCollectionProxy(0), fSizeof(sizof), fPragmaBits(pragmabits),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
 
    {
@@ -111,7 +111,7 @@ namespace ROOT {
         fIsA(0), fShowMembers(0),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(0), fPragmaBits(pragmabits),
+        fStreamerFunc(0), fSpecializedStreamerFunc(0), fSpecializedMembers(0), fCollectionProxy(0), fSizeof(0), fPragmaBits(pragmabits),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
 
    {
@@ -139,6 +139,8 @@ namespace ROOT {
     fDeleteArray(gci.fDeleteArray),
     fDestructor(gci.fDestructor),
     fStreamer(gci.fStreamer),
+    fSpecializedStreamerFunc(gci.fSpecializedStreamerFunc),
+    fSpecializedMembers(gci.fSpecializedMembers),
     fCollectionProxy(gci.fCollectionProxy),
     fSizeof(gci.fSizeof)
    { }
@@ -164,6 +166,8 @@ namespace ROOT {
        fDeleteArray=gci.fDeleteArray;
        fDestructor=gci.fDestructor;
        fStreamer=gci.fStreamer;
+       fSpecializedStreamerFunc=gci.fSpecializedStreamerFunc;
+       fSpecializedMembers=gci.fSpecializedMembers;
        fCollectionProxy=gci.fCollectionProxy;
        fSizeof=gci.fSizeof;
      } return *this;
@@ -228,6 +232,7 @@ namespace ROOT {
          fClass->SetDestructor(fDestructor);
          fClass->SetDirectoryAutoAdd(fDirAutoAdd);
          fClass->SetStreamerFunc(fStreamerFunc);
+         fClass->SetSpecializedStreamerFunc(fSpecializedStreamerFunc, fSpecializedMembers);
          fClass->SetMerge(fMerge);
          fClass->SetResetAfterMerge(fResetAfterMerge);
          fClass->AdoptStreamer(fStreamer); fStreamer = 0;
@@ -465,6 +470,17 @@ namespace ROOT {
       if (fClass) fClass->SetStreamerFunc(streamer);
    }
 
+   void TGenericClassInfo::SetSpecializedStreamerFunc(ClassSpecializedStreamerFunc_t streamer, const char **members)
+   {
+      // Set the streamer of the data members generated for the class layout
+      // (LinkDef option 'specialized') and the null terminated list of the
+      // names of these data members, in the order they are streamed.
+
+      fSpecializedStreamerFunc = streamer;
+      fSpecializedMembers = members;
+      if (fClass) fClass->SetSpecializedStreamerFunc(streamer, members);
+   }
+
    const char *TGenericClassInfo::GetDeclFileName() const
    {
       // Get the name of the declaring header file.
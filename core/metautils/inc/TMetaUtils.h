@@ -121,6 +121,7 @@ namespace ROOT {
          bool fRequestNoInputOperator;
          bool fRequestOnlyTClass;
          int  fRequestedVersionNumber;
+         bool fRequestSpecializedStreamer;
 
       public:
          enum ERootFlag {
@@ -152,6 +153,8 @@ namespace ROOT {
          bool RequestNoStreamer() const { return fRequestNoStreamer; }
          bool RequestOnlyTClass() const { return fRequestOnlyTClass; }
          int  RequestedVersionNumber() const { return fRequestedVersionNumber; }
+         bool RequestSpecializedStreamer() const { return fRequestSpecializedStreamer; }
+         void SetRequestSpecializedStreamer(bool val) { fRequestSpecializedStreamer = val; }
          int  RootFlag() const {
             // Return the request (streamerInfo, has_version, etc.) combined in a single
             // int.  See RScanner::AnnotatedRecordDecl::ERootFlag.
@@ -263,6 +266,7 @@ namespace ROOT {
       void WriteEverything(CallWriteStreamer_t WriteStreamerFunc, std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt);
       void WriteClassInit(std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt, bool& needCollectionProxy);
 
+      bool WriteSpecializedStreamer(std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt);
       bool HasCustomStreamerMemberFunction(const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl* clxx, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt);
       void WriteBodyShowMembers(std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt, bool outside);
       const int kInfo     =      0;
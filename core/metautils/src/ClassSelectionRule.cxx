@@ -157,6 +157,11 @@ void ClassSelectionRule::SetRequestedVersionNumber(int version)
    fRequestedVersionNumber = version;
 }
 
+void ClassSelectionRule::SetRequestSpecializedStreamer(bool value)
+{
+   fRequestSpecializedStreamer = value;
+}
+
 bool ClassSelectionRule::RequestOnlyTClass() const
 {
    return fRequestOnlyTClass;
@@ -176,3 +181,8 @@ int ClassSelectionRule::RequestedVersionNumber() const
 { 
    return fRequestedVersionNumber;
 }
+
+bool ClassSelectionRule::RequestSpecializedStreamer() const
+{
+   return fRequestSpecializedStreamer;
+}
@@ -43,12 +43,13 @@ private:
    bool fRequestProtected;       // Explicit request to be able to access protected member from the interpreter.
    bool fRequestPrivate;         // Explicit request to be able to access private member from the interpreter.
    int  fRequestedVersionNumber; // Explicit request for a specific version number (default to no request with -1).
+   bool fRequestSpecializedStreamer; // for linkdef.h: true if we had options=specialized, generate a streamer of the data members
 
 public:
    ClassSelectionRule(long index, cling::Interpreter &interp):
-   BaseSelectionRule(index, interp), fIsInheritable(false), fRequestStreamerInfo(false), fRequestNoStreamer(false), fRequestNoInputOperator(false), fRequestOnlyTClass(false), fRequestProtected(false), fRequestPrivate(false), fRequestedVersionNumber(-1) {}
+   BaseSelectionRule(index, interp), fIsInheritable(false), fRequestStreamerInfo(false), fRequestNoStreamer(false), fRequestNoInputOperator(false), fRequestOnlyTClass(false), fRequestProtected(false), fRequestPrivate(false), fRequestedVersionNumber(-1), fRequestSpecializedStreamer(false) {}
    ClassSelectionRule(long index, bool inherit, ESelect sel, std::string attributeName, std::string attributeValue, cling::Interpreter &interp):
-   BaseSelectionRule(index, sel, attributeName, attributeValue, interp), fIsInheritable(inherit), fRequestStreamerInfo(false), fRequestNoStreamer(false), fRequestNoInputOperator(false), fRequestOnlyTClass(false), fRequestProtected(false), fRequestPrivate(false), fRequestedVersionNumber(-1) {}
+   BaseSelectionRule(index, sel, attributeName, attributeValue, interp), fIsInheritable(inherit), fRequestStreamerInfo(false), fRequestNoStreamer(false), fRequestNoInputOperator(false), fRequestOnlyTClass(false), fRequestProtected(false), fRequestPrivate(false), fRequestedVersionNumber(-1), fRequestSpecializedStreamer(false) {}
 
    void Print(std::ostream &out) const;
 
@@ -72,6 +73,7 @@ public:
    void SetRequestProtected(bool val);
    void SetRequestPrivate(bool val);
    void SetRequestedVersionNumber(int version);
+   void SetRequestSpecializedStreamer(bool val);
 
    bool RequestOnlyTClass() const;      // True if the user want the TClass intiliazer but *not* the interpreter meta data
    bool RequestNoStreamer() const;      // Request no Streamer function in the dictionary
@@ -80,6 +82,7 @@ public:
    bool RequestProtected() const;
    bool RequestPrivate() const;
    int  RequestedVersionNumber() const;
+   bool RequestSpecializedStreamer() const; // Request the streamer of the data members specialized for the class layout
 };
 
 #endif
@@ -988,6 +988,131 @@ bool ROOT::TMetaUtils::hasOpaqueTypedef(const ROOT::TMetaUtils::AnnotatedRecordD
    }
 }
 
+//______________________________________________________________________________
+static const char *R__SpecializedBasicTypeName(const clang::Type *type, const clang::ASTContext &ctx)
+{
+   // Return the name of the ROOT typedef of the fundamental type or 0 if the
+   // type cannot be streamed by a specialized streamer. The enums are
+   // streamed as Int_t, as TStreamerInfo does: they are supported only if
+   // they are stored in 32 bits, so that they can be accessed as an Int_t.
+
+   if (type->isEnumeralType()) {
+      if (ctx.getTypeSize(type) != 32) return 0;
+      return "Int_t";
+   }
+   const clang::BuiltinType *builtin = llvm::dyn_cast<clang::BuiltinType>(type->getCanonicalTypeInternal().getTypePtr());
+   if (!builtin) return 0;
+   switch (builtin->getKind()) {
+      case clang::BuiltinType::Bool:      return "Bool_t";
+      case clang::BuiltinType::Char_S:
+      case clang::BuiltinType::SChar:     return "Char_t";
+      case clang::BuiltinType::Char_U:
+      case clang::BuiltinType::UChar:     return "UChar_t";
+      case clang::BuiltinType::Short:     return "Short_t";
+      case clang::BuiltinType::UShort:    return "UShort_t";
+      case clang::BuiltinType::Int:       return "Int_t";
+      case clang::BuiltinType::UInt:      return "UInt_t";
+      case clang::BuiltinType::Long:      return "Long_t";
+      case clang::BuiltinType::ULong:     return "ULong_t";
+      case clang::BuiltinType::LongLong:  return "Long64_t";
+      case clang::BuiltinType::ULongLong: return "ULong64_t";
+      case clang::BuiltinType::Float:     return "Float_t";
+      case clang::BuiltinType::Double:    return "Double_t";
+      default: return 0;
+   }
+}
+
+//______________________________________________________________________________
+bool ROOT::TMetaUtils::WriteSpecializedStreamer(std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt)
+{
+   // Write the function streaming the data members of the class selected with
+   // the LinkDef option 'specialized', in the order of its StreamerInfo, and
+   // the list of their names. The data members are accessed through the offsets
+   // of the StreamerInfo elements, which are checked at run time to describe
+   // the layout of the class: the base classes are streamed by TStreamerInfo.
+   // Return false, and write nothing, if the class has a data member which is
+   // not a fundamental type, an enum stored in 32 bits, an array of those or
+   // a TString.
+
+   if (!cl.RequestSpecializedStreamer()) return false;
+
+   std::string classname = TClassEdit::GetLong64_Name(cl.GetNormalizedName());
+   if (!cl.RequestStreamerInfo() || cl.RequestNoStreamer() || TClassEdit::IsStdClass(classname.c_str())
+       || HasCustomStreamerMemberFunction(cl, decl, interp, normCtxt)) {
+      ROOT::TMetaUtils::Warning(0, "The option 'specialized' of %s is ignored: it requires a StreamerInfo based streamer ('+').\n", classname.c_str());
+      return false;
+   }
+
+   std::string mappedname;
+   ROOT::TMetaUtils::GetCppName(mappedname,classname.c_str());
+
+   std::ostringstream members;
+   std::ostringstream reading;
+   std::ostringstream writing;
+   int index = 0;
+   for(clang::RecordDecl::field_iterator field_iter = decl->field_begin(), end = decl->field_end();
+       field_iter != end;
+       ++field_iter)
+   {
+      // Transient data members are not in the StreamerInfo
+      const char *comment = ROOT::TMetaUtils::GetComment( **field_iter ).data();
+      if (comment[0] == '!') continue;
+
+      clang::QualType type = field_iter->getType();
+      std::string type_name = type.getAsString(decl->getASTContext().getPrintingPolicy());
+      std::string name = field_iter->getName().str();
+      const clang::Type *underlying_type = ROOT::TMetaUtils::GetUnderlyingType(type);
+
+      const char *basic = 0;
+      if (!type->isPointerType() && !strstr(type_name.c_str(),"Float16_t") && !strstr(type_name.c_str(),"Double32_t")) {
+         basic = R__SpecializedBasicTypeName(underlying_type, decl->getASTContext());
+      }
+      std::ostringstream address;
+      address << "(R__p+R__offsets[" << index << "])";
+
+      if (basic && type->isConstantArrayType()) {
+         const clang::ConstantArrayType *arrayType = llvm::dyn_cast<clang::ConstantArrayType>(type.getTypePtr());
+         llvm::APInt len = arrayType->getSize();
+         while(const clang::ConstantArrayType *subArrayType = llvm::dyn_cast<clang::ConstantArrayType>(arrayType->getArrayElementTypeNoTypeQual()) ) {
+            len *= subArrayType->getSize();
+            arrayType = subArrayType;
+         }
+         reading << "         R__b.ReadFastArray((" << basic << "*)" << address.str() << "," << len.getLimitedValue() << ");" << "\n";
+         writing << "         R__b.WriteFastArray((" << basic << "*)" << address.str() << "," << len.getLimitedValue() << ");" << "\n";
+      } else if (basic && !type->isArrayType()) {
+         reading << "         R__b >> *(" << basic << "*)" << address.str() << ";" << "\n";
+         writing << "         R__b << *(" << basic << "*)" << address.str() << ";" << "\n";
+      } else if (!type->isPointerType() && !type->isArrayType() && underlying_type->getAsCXXRecordDecl()
+                 && ROOT::TMetaUtils::R__GetQualifiedName(*underlying_type->getAsCXXRecordDecl()) == "TString") {
+         reading << "         ((TString*)" << address.str() << ")->Streamer(R__b);" << "\n";
+         writing << "         ((TString*)" << address.str() << ")->Streamer(R__b);" << "\n";
+      } else {
+         ROOT::TMetaUtils::Info(0, "No specialized streamer for %s: the type %s of %s is not supported, the StreamerInfo actions are used.\n",
+                                classname.c_str(), type_name.c_str(), name.c_str());
+         return false;
+      }
+      members << "\"" << name << "\", ";
+      ++index;
+   }
+
+   finalString << "\n" << "   // Streamer of the data members of " << classname << " specialized for its layout" << "\n"
+               << "   static const char *" << mappedname << "_specializedMembers[] = { " << members.str() << "0 };" << "\n";
+   if (index) {
+      finalString << "   static void specializedStreamer_" << mappedname << "(TBuffer &R__b, void *obj, const Long_t *R__offsets)" << "\n"
+                  << "   {" << "\n"
+                  << "      char *R__p = (char*)obj;" << "\n"
+                  << "      if (R__b.IsReading()) {" << "\n" << reading.str()
+                  << "      } else {" << "\n" << writing.str()
+                  << "      }" << "\n";
+   } else {
+      // No data member: only the base classes, streamed by TStreamerInfo
+      finalString << "   static void specializedStreamer_" << mappedname << "(TBuffer &, void *, const Long_t *)" << "\n"
+                  << "   {" << "\n";
+   }
+   finalString << "   }" << "\n";
+   return true;
+}
+
 void ROOT::TMetaUtils::WriteClassInit(std::ostream& finalString, const ROOT::TMetaUtils::AnnotatedRecordDecl &cl, const clang::CXXRecordDecl *decl, const cling::Interpreter &interp, const ROOT::TMetaUtils::TNormalizedCtxt &normCtxt, bool& needCollectionProxy)
 {
 
@@ -1116,6 +1241,8 @@ void ROOT::TMetaUtils::WriteClassInit(std::ostream& finalString, const ROOT::TMe
       }
    }
 
+   bool specialized = WriteSpecializedStreamer(finalString, cl, decl, interp, normCtxt);
+
    finalString << "\n" << "   // Function generating the singleton type initializer" << "\n";
 
    finalString << "   static TGenericClassInfo *GenerateInitInstanceLocal(const " << csymbol.c_str() << "*)" << "\n" << "   {" << "\n";
@@ -1208,6 +1335,9 @@ void ROOT::TMetaUtils::WriteClassInit(std::ostream& finalString, const ROOT::TMe
       // We have a custom member function streamer or an older (not StreamerInfo based) automatic streamer.
       finalString << "      instance.SetStreamerFunc(&streamer_" << mappedname.c_str() << ");" << "\n";
    }
+   if (specialized) {
+      finalString << "      instance.SetSpecializedStreamerFunc(&specializedStreamer_" << mappedname.c_str() << ", " << mappedname.c_str() << "_specializedMembers);" << "\n";
+   }
    if (HasNewMerge(decl, interp) || HasOldMerge(decl, interp)) {
       finalString << "      instance.SetMerge(&merge_" << mappedname.c_str() << ");" << "\n";
    }
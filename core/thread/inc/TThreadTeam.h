@@ -0,0 +1,55 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TThreadTeam
+#define ROOT_TThreadTeam
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TThreadTeam                                                          //
+//                                                                      //
+// Runs the parts 0,1,...,n-1 of a job concurrently and returns when    //
+// all of them are done. The part 0 is run by the calling thread, the   //
+// other ones by a team of threads created at the first job and kept    //
+// waiting for the next ones, so that a job run at each iteration of    //
+// an algorithm does not create threads.                                //
+//                                                                      //
+// There is one team per process and it runs one job at a time: a job  //
+// submitted while the team is busy (by another thread, or by a part   //
+// of the running job) is run in sequence by the calling thread. The    //
+// parts whose thread cannot be created are run by the calling thread   //
+// as well, after the other ones.                                       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+
+class TThreadTeam {
+
+public:
+   // Interface of the jobs run by TThreadTeam::Run
+   class TJob {
+   public:
+      virtual ~TJob() { }
+      virtual void Run(UInt_t ipart) = 0;  // run the part ipart of the job
+   };
+
+   static void   Run(TJob &job, UInt_t nparts);
+   static UInt_t GetNCores();
+
+private:
+   TThreadTeam();                       // not implemented
+};
+
+#endif
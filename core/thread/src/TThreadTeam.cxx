@@ -0,0 +1,188 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TThreadTeam                                                          //
+//                                                                      //
+// Runs the parts of a job in a team of threads kept for the next jobs. //
+// See the header file for the description of the interface.           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TThreadTeam.h"
+#include "TThread.h"
+#include "TMutex.h"
+#include "TCondition.h"
+#include "TSystem.h"
+#include "TVirtualMutex.h"
+
+#include <vector>
+
+
+namespace {
+
+   class TTeam {
+
+   private:
+      struct TWorkerArgs {
+         TTeam    *fTeam;
+         UInt_t    fPart;        // part of the jobs run by the thread
+         ULong64_t fGeneration;  // last job seen by the thread
+      };
+
+      TMutex                fBusy;        // held while a job is running
+      TMutex                fMutex;       // protects the data members below
+      TCondition            fStart;       // signals a new job to the threads
+      TCondition            fDone;        // signals the end of the job to the calling thread
+      std::vector<TThread*> fThreads;     // threads of the parts 1,2,...
+      TThreadTeam::TJob    *fJob;         // current job
+      UInt_t                fNParts;      // number of parts of the current job
+      UInt_t                fNRunning;    // threads still running their part of the job
+      ULong64_t             fGeneration;  // number of jobs started
+      UInt_t                fNCores;      // number of cores of the machine
+
+      static void *Worker(void *arg);
+
+   public:
+      TTeam();
+
+      UInt_t GetNCores() const { return fNCores; }
+      UInt_t Start(TThreadTeam::TJob &job, UInt_t nparts);
+      void   Wait();
+   };
+
+   TTeam *gTeam = 0;
+
+   //______________________________________________________________________________
+   TTeam &GetTeam()
+   {
+      // Return the team of the process, creating it on first use. It is never
+      // deleted: its threads wait for the next job until the end of the process.
+
+      TThread::Initialize();
+      R__LOCKGUARD(gGlobalMutex);
+      if (!gTeam) gTeam = new TTeam;
+      return *gTeam;
+   }
+
+   //______________________________________________________________________________
+   TTeam::TTeam() : fBusy(kFALSE), fMutex(kFALSE), fStart(&fMutex), fDone(&fMutex),
+                    fJob(0), fNParts(0), fNRunning(0), fGeneration(0), fNCores(1)
+   {
+      // Create a team without any thread, they are started by the jobs.
+
+      SysInfo_t info;
+      if (gSystem->GetSysInfo(&info) == 0 && info.fCpus > 0)
+         fNCores = info.fCpus;
+   }
+
+   //______________________________________________________________________________
+   UInt_t TTeam::Start(TThreadTeam::TJob &job, UInt_t nparts)
+   {
+      // Start the parts 1,...,nparts-1 of job in the threads of the team.
+      // Returns the number of parts started plus one (the part 0, left to
+      // the calling thread), or 0 if the team is busy with another job.
+
+      if (fBusy.TryLock() != 0) return 0;
+
+      R__LOCKGUARD(&fMutex);
+      // The team only grows, the threads beyond nparts-1 get no part. The
+      // threads are created under fMutex: they take the current generation
+      // and wait for the job started below.
+      while (fThreads.size() < nparts - 1) {
+         TWorkerArgs *args = new TWorkerArgs;
+         args->fTeam       = this;
+         args->fPart       = fThreads.size() + 1;
+         args->fGeneration = fGeneration;
+         TThread *thread = new TThread(&TTeam::Worker, args);
+         if (thread->Run() != 0) {
+            delete thread;
+            delete args;
+            break;
+         }
+         fThreads.push_back(thread);
+      }
+      fJob    = &job;
+      fNParts = nparts;
+      UInt_t nstarted = nparts - 1 < fThreads.size() ? nparts - 1 : fThreads.size();
+      fNRunning = nstarted;
+      fGeneration++;
+      fStart.Broadcast();
+      return nstarted + 1;
+   }
+
+   //______________________________________________________________________________
+   void TTeam::Wait()
+   {
+      // Wait for the end of the parts started by Start and release the team.
+
+      {
+         R__LOCKGUARD(&fMutex);
+         while (fNRunning > 0)
+            fDone.Wait();
+         fJob = 0;
+      }
+      fBusy.UnLock();
+   }
+
+   //______________________________________________________________________________
+   void *TTeam::Worker(void *arg)
+   {
+      // Loop of the threads of the team: run the part of each new job.
+
+      TWorkerArgs *args = (TWorkerArgs*) arg;
+      TTeam &team = *args->fTeam;
+      team.fMutex.Lock();
+      while (kTRUE) {
+         while (team.fGeneration == args->fGeneration)
+            team.fStart.Wait();
+         args->fGeneration = team.fGeneration;
+         if (args->fPart >= team.fNParts) continue;
+         TThreadTeam::TJob *job = team.fJob;
+         team.fMutex.UnLock();
+         job->Run(args->fPart);
+         team.fMutex.Lock();
+         if (--team.fNRunning == 0) team.fDone.Signal();
+      }
+      return 0;
+   }
+
+}
+
+//______________________________________________________________________________
+void TThreadTeam::Run(TJob &job, UInt_t nparts)
+{
+   // Run the parts 0,...,nparts-1 of job and return when all of them are
+   // done. The part 0 is run by the calling thread.
+
+   if (nparts == 0) return;
+   if (nparts == 1) {
+      job.Run(0);
+      return;
+   }
+
+   TTeam &team = GetTeam();
+   UInt_t nstarted = team.Start(job, nparts);
+   job.Run(0);
+   if (nstarted > 0) team.Wait();
+   else nstarted = 1;
+   for (UInt_t i = nstarted; i < nparts; i++)
+      job.Run(i);
+}
+
+//______________________________________________________________________________
+UInt_t TThreadTeam::GetNCores()
+{
+   // Return the number of cores of the machine, the default number of parts
+   // of the jobs.
+
+   return GetTeam().GetNCores();
+}
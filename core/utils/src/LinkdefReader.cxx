@@ -49,7 +49,7 @@ std::map<std::string, LinkdefReader::EPragmaNames> LinkdefReader::fgMapPragmaNam
 std::map<std::string, LinkdefReader::ECppNames> LinkdefReader::fgMapCppNames;
 
 struct LinkdefReader::Options {
-   Options() : fNoStreamer(0), fNoInputOper(0), fUseByteCount(0), fVersionNumber(-1) {}
+   Options() : fNoStreamer(0), fNoInputOper(0), fUseByteCount(0), fVersionNumber(-1), fSpecializedStreamer(0) {}
 
    int fNoStreamer;
    int fNoInputOper;
@@ -58,6 +58,7 @@ struct LinkdefReader::Options {
       int fRequestStreamerInfo;
    };
    int fVersionNumber;
+   int fSpecializedStreamer;
 };
 
 /*
@@ -399,6 +400,7 @@ bool LinkdefReader::AddRule(std::string ruletype, std::string identifier, bool l
                   if (options->fNoInputOper) csr.SetRequestNoInputOperator(true);
                   if (options->fRequestStreamerInfo) csr.SetRequestStreamerInfo(true);
                   if (options->fVersionNumber >= 0) csr.SetRequestedVersionNumber(options->fVersionNumber);
+                  if (options->fSpecializedStreamer) csr.SetRequestSpecializedStreamer(true);
                }
                if ( csr.RequestStreamerInfo() && csr.RequestNoStreamer() ) {
                   std::cerr << "Warning: " << identifier << " option + mutual exclusive with -, + prevails\n";
@@ -664,6 +666,9 @@ public:
        *   nomap: (ignored by roocling; prevents entry in ROOT's rootmap file)
        *   stub: (ignored by rootcling was a directly for CINT code generation)
        *   version(x): sets the version number of the class to x
+       *   specialized: generate the streamer of the data members specialized for the
+       *                class layout, used instead of the StreamerInfo actions when the
+       *                layout on file is the one of the class (requires '+')
        */
 
       // We assume that the first toke in option or options
@@ -687,6 +692,7 @@ public:
          else if (tok.getIdentifierInfo()->getName() == "nostreamer") options.fNoStreamer = 1;
          else if (tok.getIdentifierInfo()->getName() == "noinputoper") options.fNoInputOper = 1;
          else if (tok.getIdentifierInfo()->getName() == "evolution") options.fRequestStreamerInfo = 1;
+         else if (tok.getIdentifierInfo()->getName() == "specialized") options.fSpecializedStreamer = 1;
          else if (tok.getIdentifierInfo()->getName() == "stub") {
             // This was solely for CINT dictionary, ignore for now.
             // options.fUseStubs = 1;
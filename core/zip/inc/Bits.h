@@ -15,6 +15,8 @@
 #include "zlib.h"
 #include "RConfigure.h"
 #include "ZipLZMA.h"
+#include "ZipLZ4.h"
+#include "ZipZSTD.h"
 
 #include <stdio.h>
 
@@ -152,9 +154,16 @@ ulg R__bits_sent;   /* bit length of the compressed data */
    R__ZipMode = 2 : LZMA compression algorithm is used
    R__ZipMode = 0 or 3 : a very old compression algorithm is used
    (the very old algorithm is supported for backward compatibility)
+   R__ZipMode = 4 : LZ4 compression algorithm is used
+   R__ZipMode = 5 : ZSTD (Zstandard) compression algorithm is used
    The LZMA algorithm requires the external XZ package be installed when linking
    is done. LZMA typically has significantly higher compression factors, but takes
    more CPU time and memory resources while compressing.
+   LZ4 and ZSTD require the external lz4 and zstd packages and are only
+   available when ROOT was configured with them (R__HAS_LZ4 and R__HAS_ZSTD),
+   otherwise ZLIB is used instead. LZ4 has lower compression factors than ZLIB
+   but decompresses several times faster; ZSTD compresses about as well as ZLIB
+   while being significantly faster both when compressing and decompressing.
 */
 int R__ZipMode = 1;
 
@@ -421,6 +430,8 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
      /*                      1 = zlib */
      /*                      2 = lzma */
      /*                      3 = old */
+     /*                      4 = lz4 */
+     /*                      5 = zstd */
 {
   int err;
   int method   = Z_DEFLATED;
@@ -440,6 +451,22 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
     return;
   }
 
+#ifdef R__HAS_LZ4
+  // The LZ4 compression algorithm
+  if (compressionAlgorithm == 4) {
+    R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
+    return;
+  }
+#endif
+
+#ifdef R__HAS_ZSTD
+  // The ZSTD compression algorithm
+  if (compressionAlgorithm == 5) {
+    R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+    return;
+  }
+#endif
+
   // The very old algorithm for backward compatibility
   // 0 for selecting with R__ZipMode in a backward compatible way
   // 3 for selecting in other cases
@@ -492,7 +519,7 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
     return;
 
   // 1 is for ZLIB (which is the default), ZLIB is also used for any illegal
-  // algorithm setting
+  // algorithm setting and for LZ4 and ZSTD when ROOT is built without them
   } else {
 
     z_stream stream;
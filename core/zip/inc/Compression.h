@@ -25,6 +25,13 @@ namespace ROOT {
    // in greater compression factors, but takes more CPU time
    // and memory when compressing.  LZMA memory usage is particularly
    // high for compression levels 8 and 9.
+   // The LZ4 algorithm gives lower compression factors than
+   // ZLIB but decompresses several times faster, which makes it
+   // a good choice for data read many times by CPU bound analysis.
+   // The ZSTD algorithm (Zstandard) compresses about as well as
+   // ZLIB while being significantly faster, both when compressing
+   // and decompressing. LZ4 and ZSTD require ROOT to be built with
+   // the corresponding external packages, otherwise ZLIB is used.
    //
    // The current algorithms support level 1 to 9. The higher
    // the level the greater the compression and more CPU time
@@ -34,6 +41,8 @@ namespace ROOT {
                                 kZLIB,
                                 kLZMA,
                                 kOldCompressionAlgo,
+                                kLZ4,
+                                kZSTD,
                                 // if adding new algorithm types,
                                 // keep this enum value last
                                 kUndefinedCompressionAlgorithm
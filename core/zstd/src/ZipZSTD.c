@@ -0,0 +1,94 @@
+// @(#)root/zstd:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ZipZSTD.h"
+#include "RConfigure.h"
+#include <stdio.h>
+
+#ifdef R__HAS_ZSTD
+#include "zstd.h"
+#endif
+
+static const int kHeaderSize = 9;
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+#ifdef R__HAS_ZSTD
+   size_t out_size;               /* compressed size */
+   unsigned in_size;
+
+   *irep = 0;
+
+   if (*tgtsize <= kHeaderSize) {
+      return;
+   }
+
+   if (*srcsize > 0xffffff || *srcsize < 0) {
+      return;
+   }
+
+   /* ROOT levels 1 to 9 map directly onto the ZSTD levels of the same
+      value; the ZSTD levels above 9 are not used since their compression
+      speed is comparable to LZMA. */
+   if (cxlevel > 9) cxlevel = 9;
+   out_size = ZSTD_compress(&tgt[kHeaderSize], (size_t)(*tgtsize - kHeaderSize),
+                            src, (size_t)(*srcsize), cxlevel);
+   if (ZSTD_isError(out_size) || out_size > 0xffffff) {
+      /* No need to print an error message. We simply abandon the compression
+         the buffer cannot be compressed or compressed buffer would be larger than original buffer
+      */
+      return;
+   }
+
+   tgt[0] = 'Z';  /* Signature of Zstandard */
+   tgt[1] = 'S';
+   tgt[2] = 1;
+
+   in_size   = (unsigned) (*srcsize);
+
+   tgt[3] = (char)(out_size & 0xff);
+   tgt[4] = (char)((out_size >> 8) & 0xff);
+   tgt[5] = (char)((out_size >> 16) & 0xff);
+
+   tgt[6] = (char)(in_size & 0xff);         /* decompressed size */
+   tgt[7] = (char)((in_size >> 8) & 0xff);
+   tgt[8] = (char)((in_size >> 16) & 0xff);
+
+   *irep = (int)out_size + kHeaderSize;
+#else
+   (void)cxlevel; (void)srcsize; (void)src; (void)tgtsize; (void)tgt;
+   *irep = 0;
+#endif
+}
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+#ifdef R__HAS_ZSTD
+   size_t returnStatus;
+
+   *irep = 0;
+
+   returnStatus = ZSTD_decompress(tgt, (size_t)(*tgtsize),
+                                  &src[kHeaderSize], (size_t)(*srcsize - kHeaderSize));
+   if (ZSTD_isError(returnStatus)) {
+      fprintf(stderr,
+              "R__unzipZSTD: error %s in ZSTD_decompress\n",
+              ZSTD_getErrorName(returnStatus));
+      return;
+   }
+
+   *irep = (int)returnStatus;
+#else
+   (void)srcsize; (void)src; (void)tgtsize; (void)tgt;
+   fprintf(stderr,
+           "R__unzipZSTD: ROOT was built without ZSTD support, cannot decompress buffer\n");
+   *irep = 0;
+#endif
+}
@@ -124,6 +124,11 @@ private:
       return fFunc->EvalPar(x,p); 
    }
 
+   /// evaluate function at n points (see TF1::EvalParBatch)
+   void DoEvalParBatch (unsigned int n, const double * x, const double * p, double * result) const { 
+      fFunc->EvalParBatch(n, x, fDim, result, p); 
+   }
+
    /// evaluate the partial derivative with respect to the parameter
    double DoParameterDerivative(const double * x, const double * p, unsigned int ipar) const; 
 
@@ -127,6 +127,11 @@ private:
       return fFunc->EvalPar(fX,p); 
    }
 
+   /// evaluate function at n points (see TF1::EvalParBatch)
+   void DoEvalParBatch (unsigned int n, const double * x, const double * p, double * result) const { 
+      fFunc->EvalParBatch(n, x, 1, result, p); 
+   }
+
    /// evaluate function using the cached parameter values of this class (not of TF1)
    /// re-implement for better efficiency
    double DoEval (double x) const { 
@@ -233,6 +233,7 @@ public:
    virtual Double_t    Eval(Double_t x, Double_t y=0, Double_t z=0, Double_t t=0) const;
    virtual Double_t    EvalParOld(const Double_t *x, const Double_t *params=0);
    virtual Double_t    EvalPar(const Double_t *x, const Double_t *params=0){return ((*this).*fOptimal)(x,params);};
+   virtual void        EvalParBatch(Int_t n, const Double_t *x, Int_t stride, Double_t *result, const Double_t *params=0);
    virtual const TObject *GetLinearPart(Int_t i);
    virtual Int_t       GetNdim() const {return fNdim;}
    virtual Int_t       GetNpar() const {return fNpar;}
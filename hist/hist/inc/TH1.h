@@ -75,6 +75,7 @@ class TList;
 class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
+class THistConcurrentFill;
 
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
@@ -123,6 +124,7 @@ protected:
     Double_t     *fIntegral;        //!Integral of bins used by GetRandom
     TVirtualHistPainter *fPainter;  //!pointer to histogram painter
     EBinErrorOpt  fBinStatErrOpt;   //option for bin statistical errors 
+    THistConcurrentFill *fConcurrentFill; //!state of the concurrent filling (see SetConcurrentFill)
     static Int_t  fgBufferSize;     //!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   //!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  //!flag to use under/overflows in statistics
@@ -145,7 +147,9 @@ protected:
    TH1(const char *name,const char *title,Int_t nbinsx,const Float_t *xbins);
    TH1(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins);
    virtual void     Copy(TObject &hnew) const;
+   virtual void     AddConcurrentStats(Double_t entries, const Double_t *stats);
    virtual Int_t    BufferFill(Double_t x, Double_t w);
+   Int_t            FillConcurrent(Int_t bin, Bool_t inRange, Double_t w, Double_t x, Double_t y=0, Double_t z=0);
    virtual Bool_t   FindNewAxisLimits(const TAxis* axis, const Double_t point, Double_t& newMin, Double_t &newMax);
    virtual void     SavePrimitiveHelp(std::ostream &out, const char *hname, Option_t *option = "");
    static Bool_t    RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis);
@@ -161,6 +165,7 @@ protected:
    static bool CheckEqualAxes(const TAxis* a1, const TAxis* a2);
    static bool CheckConsistentSubAxes(const TAxis *a1, Int_t firstBin1, Int_t lastBin1, const TAxis *a2, Int_t firstBin2=0, Int_t lastBin2=0);
    static bool CheckConsistency(const TH1* h1, const TH1* h2);
+   void        ReduceConcurrentFill();
 
 public:
    // TH1 status bits
@@ -320,6 +325,7 @@ public:
    virtual Double_t Interpolate(Double_t x, Double_t y);
    virtual Double_t Interpolate(Double_t x, Double_t y, Double_t z);
            Bool_t   IsBinOverflow(Int_t bin) const;
+           Bool_t   IsConcurrentFill() const { return fConcurrentFill != 0; }
            Bool_t   IsBinUnderflow(Int_t bin) const;
    virtual Double_t KolmogorovTest(const TH1 *h2, Option_t *option="") const;
    virtual void     LabelsDeflate(Option_t *axis="X");
@@ -362,6 +368,7 @@ public:
    virtual void     SetBinErrorOption(EBinErrorOpt type) { fBinStatErrOpt = type; }
    virtual void     SetBuffer(Int_t buffersize, Option_t *option="");
    virtual UInt_t   SetCanExtend(UInt_t extendBitMask);
+           Bool_t   SetConcurrentFill(Bool_t concurrent=kTRUE);
    virtual void     SetContent(const Double_t *content);
    virtual void     SetContour(Int_t nlevels, const Double_t *levels=0);
    virtual void     SetContourLevel(Int_t level, Double_t value);
@@ -53,6 +53,7 @@ protected:
    TH3(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
                                          ,Int_t nbinsy,const Double_t *ybins
                                          ,Int_t nbinsz,const Double_t *zbins);
+   virtual void     AddConcurrentStats(Double_t entries, const Double_t *stats);
    virtual Int_t    BufferFill(Double_t x, Double_t y, Double_t z, Double_t w);
 
    void DoFillProfileProjection(TProfile2D * p2, const TAxis & a1, const TAxis & a2, const TAxis & a3, Int_t bin1, Int_t bin2, Int_t bin3, Int_t inBin, Bool_t useWeights) const;
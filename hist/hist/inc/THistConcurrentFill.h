@@ -0,0 +1,85 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THistConcurrentFill
+#define ROOT_THistConcurrentFill
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THistConcurrentFill                                                  //
+//                                                                      //
+// State of a histogram filled by several threads at the same time      //
+// (see TH1::SetConcurrentFill).                                        //
+//                                                                      //
+// The bin contents and the sums of squares of weights are updated      //
+// with atomic compare-and-swap loops. The statistics (entries, sumw,   //
+// sumw2, sumwx, ...) are accumulated by each thread in its own slot,   //
+// without atomic operations; TH1::ReduceConcurrentFill adds to the     //
+// histogram what the slots accumulated since the previous reduction,   //
+// once the filling threads are done.                                   //
+// The threads are numbered at their first concurrent fill, the numbers //
+// of the threads that exited being given again to new threads (on the  //
+// platforms with POSIX threads). The threads beyond the first          //
+// kMaxSlots-1 running at the same time share the last slot, which is   //
+// then updated with atomic operations.                                 //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+class TArray;
+class TH1;
+class TVirtualMutex;
+
+class THistConcurrentFill {
+
+public:
+   // s[0] = entries, then the statistics in the order of TH1::GetStats
+   enum { kNStats = 12, kMaxSlots = 256 };
+
+private:
+   enum EStorage { kUnknown, kChar, kShort, kInt, kFloat, kDouble };
+
+   struct TSlot {
+      Double_t fStats[kNStats];    // accumulated by the thread(s) of this slot
+      Double_t fReduced[kNStats];  // part of fStats already added to the histogram
+      char     fPad[64];           // keeps the slots of different threads on different cache lines
+   };
+
+   TArray         *fArray;             // bin contents of the histogram
+   EStorage        fStorage;           // type of the bin contents
+   Int_t           fDimension;         // dimension of the histogram
+   TSlot          *fSlots[kMaxSlots];  // per-thread statistics, allocated at the first fill of each thread
+   TVirtualMutex  *fMutex;             // serializes the reductions
+   Bool_t          fMissingSumw2;      // a weighted fill without Sumw2 has been reported
+
+   THistConcurrentFill(const THistConcurrentFill&);            // Not implemented
+   THistConcurrentFill &operator=(const THistConcurrentFill&); // Not implemented
+
+   void           AddBinContent(Int_t bin, Double_t w);
+   TSlot         *GetSlot(Int_t ordinal);
+   static Int_t   ThreadOrdinal();
+
+public:
+   THistConcurrentFill(TH1 *h);
+   ~THistConcurrentFill();
+
+   void            Fill(Int_t bin, Double_t w, Double_t *sumw2, Bool_t stats,
+                        Double_t x, Double_t y = 0, Double_t z = 0);
+   Bool_t          FirstMissingSumw2();
+   TVirtualMutex *&GetMutex() { return fMutex; }
+   Bool_t          IsValid() const { return fStorage != kUnknown; }
+   Bool_t          Reduce(Double_t *delta);
+};
+
+#endif
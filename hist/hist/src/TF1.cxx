@@ -13,6 +13,8 @@
 #include "TROOT.h"
 #include "TMath.h"
 #include "TF1.h"
+#include "TF2.h"
+#include "TF3.h"
 #include "TH1.h"
 #include "TGraph.h"
 #include "TVirtualPad.h"
@@ -1333,6 +1335,31 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+//______________________________________________________________________________
+void TF1::EvalParBatch(Int_t n, const Double_t *x, Int_t stride, Double_t *result, const Double_t *params)
+{
+   // Evaluate the function at n points and store the values in result.
+   // The coordinates of the point i are x[i*stride], x[i*stride+1], ...
+   // If argument params is omitted or equal 0, the internal values
+   // of parameters (array fParams) will be used instead.
+   //
+   // The functions defined by a formula are evaluated by blocks of points
+   // (see TFormula::EvalParBatch); the other ones, and the classes deriving
+   // from TF1 which re-implement EvalPar (e.g. TF12), point by point.
+
+   fgCurrent = this;
+
+   if (fType == 0 && (IsA() == TF1::Class() || IsA() == TF2::Class() || IsA() == TF3::Class())) {
+      TFormula::EvalParBatch(n, x, stride, result, params);
+      return;
+   }
+   const Double_t *p = params ? params : fParams;
+   for (Int_t i = 0; i < n; ++i) {
+      if (fMethodCall) InitArgs(x + i*stride, p);
+      result[i] = EvalPar(x + i*stride, p);
+   }
+}
+
 //______________________________________________________________________________
 void TF1::ExecuteEvent(Int_t event, Int_t px, Int_t py)
 {
@@ -10,6 +10,7 @@
  *************************************************************************/
 
 #include <math.h>
+#include <vector>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -2962,6 +2963,215 @@ Double_t TFormula::EvalParOld(const Double_t *x, const Double_t *uparams)
 
 }
 
+//______________________________________________________________________________
+void TFormula::EvalParBatch(Int_t n, const Double_t *x, Int_t stride, Double_t *result, const Double_t *uparams)
+{
+//*-*-*-*-*-*-*-*-*-*-*Evaluate this formula at n points*-*-*-*-*-*-*-*-*-*-*-*
+//*-*                  =================================
+//*-*
+//*-*   The coordinates of the point i are x[i*stride], x[i*stride+1], ...
+//*-*   and its value is stored in result[i].
+//*-*   The parameters used will be the ones in the array params if params is given
+//*-*    otherwise parameters will be taken from the stored data members fParams
+//*-*
+//*-*   Each operator of the formula is applied to a block of points at a time
+//*-*   instead of interpreting the whole formula for each point, so that the
+//*-*   inner loops (in particular those of the predefined functions gaus, expo,
+//*-*   landau and polN) can be vectorized by the compiler. The formulas using
+//*-*   strings, the operators ?:, && and ||, external functions or rndm are
+//*-*   evaluated point by point with EvalPar.
+//*-*
+//*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+
+   const Int_t kBatchSize = 64;
+   Double_t *params = uparams ? const_cast<Double_t*>(uparams) : fParams;
+
+   // Check that all the operators can be evaluated by blocks and find the
+   // size of the stack. The right side of && and || must not be evaluated
+   // when the left side decides the result (e.g. in x!=0 && 5%x>1, where
+   // the modulo by zero would trap), so these formulas are evaluated point
+   // by point, as the blocks would evaluate both sides.
+   Int_t depth = 0, maxdepth = 0;
+   Bool_t batch = (fNoper > 0);
+   for (Int_t i = 0; batch && i < fNoper; ++i) {
+      switch (fOper[i] >> kTFOperShift) {
+         case kParameter: case kConstant: case kVariable: case kpi:
+         case kxexpo: case kyexpo: case kzexpo: case kxyexpo:
+         case kxgaus: case kygaus: case kzgaus:
+         case kxlandau: case kylandau: case kzlandau:
+         case kxpol: case kypol: case kzpol:
+            if (++depth > maxdepth) maxdepth = depth;
+            break;
+         case kAdd: case kSubstract: case kMultiply: case kDivide: case kModulo:
+         case katan2: case kfmod: case kpow: case kmin: case kmax:
+         case kAnd: case kOr: case kEqual: case kNotEqual:
+         case kLess: case kGreater: case kLessThan: case kGreaterThan:
+         case kBitAnd: case kBitOr: case kLeftShift: case kRightShift:
+            if (depth < 2) batch = kFALSE;
+            --depth;
+            break;
+         case kcos: case ksin: case ktan: case kacos: case kasin: case katan:
+         case kcosh: case ksinh: case ktanh: case kacosh: case kasinh: case katanh:
+         case ksq: case ksqrt: case klog: case kexp: case klog10:
+         case kabs: case ksign: case kint: case kSignInv: case kNot:
+            if (depth < 1) batch = kFALSE;
+            break;
+         default:
+            batch = kFALSE;
+      }
+   }
+   if (!batch || depth < 1) {
+      for (Int_t i = 0; i < n; ++i) result[i] = EvalPar(x + i*stride, params);
+      return;
+   }
+
+   std::vector<Double_t> work((maxdepth + 2)*kBatchSize);
+   Double_t *xv = &work[maxdepth*kBatchSize];  // coordinate used by gaus, expo, ...
+   Double_t *pw = xv + kBatchSize;             // powers of xv for polN
+
+   // a (resp. b) is the first (resp. second) operand of the block operations
+   #define R__BATCH_UNARY(expr)                                                 \
+      { Double_t *t = &work[(pos-1)*kBatchSize];                             \
+        for (Int_t k = 0; k < m; ++k) { const Double_t a = t[k]; t[k] = (expr); } \
+        continue; }
+   #define R__BATCH_BINARY(expr)                                                \
+      { pos--; Double_t *t = &work[(pos-1)*kBatchSize]; const Double_t *u = t + kBatchSize; \
+        for (Int_t k = 0; k < m; ++k) { const Double_t a = t[k], b = u[k]; t[k] = (expr); } \
+        continue; }
+
+   for (Int_t first = 0; first < n; first += kBatchSize) {
+      const Int_t m = TMath::Min(kBatchSize, n - first);
+      const Double_t *xb = x + first*stride;
+      Int_t pos = 0;
+      for (Int_t i = 0; i < fNoper; ++i) {
+         const Int_t oper = fOper[i];
+         const Int_t action = oper >> kTFOperShift;
+         const Int_t param = oper & kTFOperMask;
+         switch (action) {
+            case kParameter: {
+               Double_t *t = &work[(pos++)*kBatchSize];
+               for (Int_t k = 0; k < m; ++k) t[k] = params[param];
+               continue;
+            }
+            case kConstant: {
+               Double_t *t = &work[(pos++)*kBatchSize];
+               for (Int_t k = 0; k < m; ++k) t[k] = fConst[param];
+               continue;
+            }
+            case kpi: {
+               Double_t *t = &work[(pos++)*kBatchSize];
+               for (Int_t k = 0; k < m; ++k) t[k] = TMath::ACos(-1);
+               continue;
+            }
+            case kVariable: {
+               Double_t *t = &work[(pos++)*kBatchSize];
+               for (Int_t k = 0; k < m; ++k) t[k] = xb[k*stride + param];
+               continue;
+            }
+            case kAdd      : R__BATCH_BINARY(a + b);
+            case kSubstract: R__BATCH_BINARY(a - b);
+            case kMultiply : R__BATCH_BINARY(a * b);
+            case kDivide   : R__BATCH_BINARY(b == 0 ? 0 : a / b);
+            case kModulo   : R__BATCH_BINARY(Double_t(Long64_t(a) % Long64_t(b)));
+            case katan2    : R__BATCH_BINARY(TMath::ATan2(a, b));
+            case kfmod     : R__BATCH_BINARY(fmod(a, b));
+            case kpow      : R__BATCH_BINARY(TMath::Power(a, b));
+            case kmin      : R__BATCH_BINARY(TMath::Min(a, b));
+            case kmax      : R__BATCH_BINARY(TMath::Max(a, b));
+            case kAnd      : R__BATCH_BINARY((a != 0 && b != 0) ? 1 : 0);
+            case kOr       : R__BATCH_BINARY((a != 0 || b != 0) ? 1 : 0);
+            case kEqual    : R__BATCH_BINARY(a == b ? 1 : 0);
+            case kNotEqual : R__BATCH_BINARY(a != b ? 1 : 0);
+            case kLess     : R__BATCH_BINARY(a <  b ? 1 : 0);
+            case kGreater  : R__BATCH_BINARY(a >  b ? 1 : 0);
+            case kLessThan : R__BATCH_BINARY(a <= b ? 1 : 0);
+            case kGreaterThan: R__BATCH_BINARY(a >= b ? 1 : 0);
+            case kBitAnd    : R__BATCH_BINARY(((Int_t) a) & ((Int_t) b));
+            case kBitOr     : R__BATCH_BINARY(((Int_t) a) | ((Int_t) b));
+            case kLeftShift : R__BATCH_BINARY(((Int_t) a) << ((Int_t) b));
+            case kRightShift: R__BATCH_BINARY(((Int_t) a) >> ((Int_t) b));
+
+            case kcos  : R__BATCH_UNARY(TMath::Cos(a));
+            case ksin  : R__BATCH_UNARY(TMath::Sin(a));
+            case ktan  : R__BATCH_UNARY(TMath::Cos(a) == 0 ? 0 : TMath::Tan(a));
+            case kacos : R__BATCH_UNARY(TMath::Abs(a) > 1 ? 0 : TMath::ACos(a));
+            case kasin : R__BATCH_UNARY(TMath::Abs(a) > 1 ? 0 : TMath::ASin(a));
+            case katan : R__BATCH_UNARY(TMath::ATan(a));
+            case kcosh : R__BATCH_UNARY(TMath::CosH(a));
+            case ksinh : R__BATCH_UNARY(TMath::SinH(a));
+            case ktanh : R__BATCH_UNARY(TMath::CosH(a) == 0 ? 0 : TMath::TanH(a));
+            case kacosh: R__BATCH_UNARY(a < 1 ? 0 : TMath::ACosH(a));
+            case kasinh: R__BATCH_UNARY(TMath::ASinH(a));
+            case katanh: R__BATCH_UNARY(TMath::Abs(a) > 1 ? 0 : TMath::ATanH(a));
+            case ksq   : R__BATCH_UNARY(a * a);
+            case ksqrt : R__BATCH_UNARY(TMath::Sqrt(TMath::Abs(a)));
+            case klog  : R__BATCH_UNARY(a > 0 ? TMath::Log(a) : 0);
+            case kexp  : R__BATCH_UNARY(a < -700 ? 0 : (a > 700 ? TMath::Exp(700) : TMath::Exp(a)));
+            case klog10: R__BATCH_UNARY(a > 0 ? TMath::Log10(a) : 0);
+            case kabs  : R__BATCH_UNARY(TMath::Abs(a));
+            case ksign : R__BATCH_UNARY(a < 0 ? -1 : 1);
+            case kint  : R__BATCH_UNARY(Double_t(Int_t(a)));
+            case kSignInv: R__BATCH_UNARY(-1 * a);
+            case kNot  : R__BATCH_UNARY(a != 0 ? 0 : 1);
+
+            case kxyexpo: {
+               Double_t *t = &work[(pos++)*kBatchSize];
+               for (Int_t k = 0; k < m; ++k) {
+                  t[k] = TMath::Exp(params[param]+params[param+1]*xb[k*stride]+params[param+2]*xb[k*stride+1]);
+               }
+               continue;
+            }
+         }
+
+         // The predefined functions of one variable
+         Int_t var = 0;
+         if      (action >= kxpol)    var = action - kxpol;
+         else if (action >= kxlandau) var = action - kxlandau;
+         else if (action >= kxgaus)   var = action - kxgaus;
+         else                         var = action - kxexpo;
+         for (Int_t k = 0; k < m; ++k) xv[k] = xb[k*stride + var];
+         Double_t *t = &work[(pos++)*kBatchSize];
+         if (action >= kxpol) {
+            Int_t inter = param/100;
+            Int_t int1  = param-inter*100-1;
+            for (Int_t k = 0; k < m; ++k) { t[k] = 0; pw[k] = 1; }
+            for (Int_t j = 0; j < inter+1; ++j) {
+               const Double_t c = params[j+int1];
+               for (Int_t k = 0; k < m; ++k) {
+                  t[k] += pw[k]*c;
+                  pw[k] *= xv[k];
+               }
+            }
+         } else if (action >= kxlandau) {
+            const Bool_t norm = IsNormalized();
+            for (Int_t k = 0; k < m; ++k) {
+               t[k] = params[param]*TMath::Landau(xv[k],params[param+1],params[param+2],norm);
+            }
+         } else if (action >= kxgaus) {
+            const Double_t mean = params[param+1], sigma = params[param+2];
+            if (sigma == 0) {
+               for (Int_t k = 0; k < m; ++k) t[k] = params[param]*1.e30;
+            } else {
+               // Same operations as TMath::Gaus
+               for (Int_t k = 0; k < m; ++k) {
+                  const Double_t arg = (xv[k]-mean)/sigma;
+                  t[k] = TMath::Exp(-0.5*arg*arg);
+               }
+               if (IsNormalized()) {
+                  for (Int_t k = 0; k < m; ++k) t[k] = t[k]/(2.50662827463100024*sigma);
+               }
+               for (Int_t k = 0; k < m; ++k) t[k] = params[param]*t[k];
+            }
+         } else {
+            for (Int_t k = 0; k < m; ++k) t[k] = TMath::Exp(params[param]+params[param+1]*xv[k]);
+         }
+      }
+      for (Int_t k = 0; k < m; ++k) result[first+k] = work[k];
+   }
+   #undef R__BATCH_UNARY
+   #undef R__BATCH_BINARY
+}
+
 //------------------------------------------------------------------------------
 TString TFormula::GetExpFormula(Option_t *option) const
 {
@@ -21,6 +21,7 @@
 #include "THashList.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "THistConcurrentFill.h"
 #include "TF2.h"
 #include "TF3.h"
 #include "TPluginManager.h"
@@ -38,6 +39,7 @@
 #include "TVirtualHistPainter.h"
 #include "TVirtualFFT.h"
 #include "TSystem.h"
+#include "TVirtualMutex.h"
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -562,6 +564,7 @@ TH1::TH1(): TNamed(), TAttLine(), TAttFill(), TAttMarker()
    fBufferSize    = 0;
    fBuffer        = 0;
    fBinStatErrOpt = kNormal;
+   fConcurrentFill= 0;
    fXaxis.SetName("xaxis");
    fYaxis.SetName("yaxis");
    fZaxis.SetName("zaxis");
@@ -584,6 +587,8 @@ TH1::~TH1()
    fIntegral = 0;
    delete[] fBuffer;
    fBuffer = 0;
+   delete fConcurrentFill;
+   fConcurrentFill = 0;
    if (fFunctions) {
       fFunctions->SetBit(kInvalidObject);
       TObject* obj = 0;
@@ -697,6 +702,7 @@ TH1::TH1(const TH1 &h) : TNamed(), TAttLine(), TAttFill(), TAttMarker()
    // Copy constructor.
    // The list of functions is not copied. (Use Clone if needed)
 
+   fConcurrentFill = 0;
    ((TH1&)h).Copy(*this);
 }
 
@@ -735,6 +741,7 @@ void TH1::Build()
    fBufferSize    = 0;
    fBuffer        = 0;
    fBinStatErrOpt = kNormal;
+   fConcurrentFill= 0;
    fXaxis.SetName("xaxis");
    fYaxis.SetName("yaxis");
    fZaxis.SetName("zaxis");
@@ -1163,6 +1170,21 @@ void TH1::AddBinContent(Int_t, Double_t)
 }
 
 
+//______________________________________________________________________________
+void TH1::AddConcurrentStats(Double_t entries, const Double_t *stats)
+{
+   // Add to the statistics of this histogram the ones accumulated by the
+   // threads filling it concurrently (see ReduceConcurrentFill).
+   // stats is in the order of GetStats.
+
+   fEntries += entries;
+   fTsumw   += stats[0];
+   fTsumw2  += stats[1];
+   fTsumwx  += stats[2];
+   fTsumwx2 += stats[3];
+}
+
+
 //______________________________________________________________________________
 void TH1::AddDirectory(Bool_t add)
 {
@@ -2333,6 +2355,10 @@ void TH1::Copy(TObject &obj) const
    // Note that this function does not copy the list of associated functions.
    // Use TObject::Clone to make a full copy of an histogram.
 
+   // The concurrent filling mode is not copied.
+   if (fConcurrentFill) ((TH1*)this)->ReduceConcurrentFill();
+   ((TH1&)obj).SetConcurrentFill(kFALSE);
+
    if (((TH1&)obj).fDirectory) {
       // We are likely to change the hash value of this object
       // with TNamed::Copy, to keep things correct, we need to
@@ -2974,6 +3000,10 @@ Int_t TH1::Fill(Double_t x)
    //
    //    The function returns the corresponding bin number which has its content incremented by 1
 
+   if (fConcurrentFill) {
+      Int_t bin = fXaxis.FindFixBin(x);
+      return FillConcurrent(bin, bin > 0 && bin <= fXaxis.GetNbins(), 1, x);
+   }
    if (fBuffer) return BufferFill(x,1);
 
    Int_t bin;
@@ -3007,6 +3037,10 @@ Int_t TH1::Fill(Double_t x, Double_t w)
    //
    //    The function returns the corresponding bin number which has its content incremented by w
 
+   if (fConcurrentFill) {
+      Int_t bin = fXaxis.FindFixBin(x);
+      return FillConcurrent(bin, bin > 0 && bin <= fXaxis.GetNbins(), w, x);
+   }
    if (fBuffer) return BufferFill(x,w);
 
    Int_t bin;
@@ -3064,6 +3098,26 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 }
 
 
+//______________________________________________________________________________
+Int_t TH1::FillConcurrent(Int_t bin, Bool_t inRange, Double_t w, Double_t x, Double_t y, Double_t z)
+{
+   // Fill the global bin bin with the weight w in the concurrent mode
+   // (see SetConcurrentFill). inRange tells whether the coordinates x,y,z
+   // are inside the axis ranges, in which case they are used in the
+   // statistics. Returns bin or -1 like Fill.
+
+   if (w != 1 && !fSumw2.fN) {
+      // Sumw2 cannot be created while the threads are filling
+      if (fConcurrentFill->FirstMissingSumw2())
+         Error("Fill", "Sumw2 must be called before filling concurrently with weights, the weighted fills are ignored");
+      return -1;
+   }
+   Bool_t stats = inRange || fgStatOverflows;
+   fConcurrentFill->Fill(bin, w, fSumw2.fN ? fSumw2.fArray : 0, stats, x, y, z);
+   return stats ? bin : -1;
+}
+
+
 //______________________________________________________________________________
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3850,6 +3904,7 @@ Double_t TH1::GetEntries() const
       Int_t nentries = (Int_t) fBuffer[0];
       if (nentries > 0) return nentries;
    }
+   if (fConcurrentFill) ((TH1*)this)->ReduceConcurrentFill();
 
    return fEntries;
 }
@@ -5847,6 +5902,21 @@ void TH1::ExtendAxis(Double_t x, TAxis *axis)
 }
 
 
+//______________________________________________________________________________
+void TH1::ReduceConcurrentFill()
+{
+   // Add to the statistics of this histogram what the threads filling it
+   // concurrently accumulated since the previous call (see SetConcurrentFill).
+   // This must be called after the filling threads are done (joined): the
+   // per-thread statistics are read without synchronization with them.
+
+   if (!fConcurrentFill) return;
+   R__LOCKGUARD2(fConcurrentFill->GetMutex());
+   Double_t delta[THistConcurrentFill::kNStats];
+   if (fConcurrentFill->Reduce(delta)) AddConcurrentStats(delta[0], delta + 1);
+}
+
+
 //______________________________________________________________________________
 void TH1::RecursiveRemove(TObject *obj)
 {
@@ -5937,6 +6007,92 @@ UInt_t TH1::SetCanExtend(UInt_t extendBitMask)
 }
 
 
+//______________________________________________________________________________
+Bool_t TH1::SetConcurrentFill(Bool_t concurrent)
+{
+   // Switch on (or off) the concurrent filling mode, in which several threads
+   // can call Fill on this histogram at the same time, without a lock.
+   //
+   // In this mode the bin contents, and the sums of squares of weights if
+   // Sumw2 has been called, are incremented with atomic operations. The
+   // number of entries and the sums used for the statistics (sum of weights,
+   // of weight*x, of weight*x*x, ...) are accumulated by each thread in its
+   // own buffer. The buffers are added to the histogram statistics when
+   // they are read (GetEntries, GetStats, GetMean, GetRMS, ...), when the
+   // histogram is written, copied or reset, and when the mode is switched off.
+   // These functions must therefore be called after the filling threads
+   // are done (joined).
+   // This saves the memory of one histogram per thread, which matters for
+   // large TH2 and TH3.
+   //
+   // Only the functions Fill(x), Fill(x,w), TH2::Fill(x,y), TH2::Fill(x,y,w),
+   // TH3::Fill(x,y,z) and TH3::Fill(x,y,z,w) may be called concurrently.
+   // All the other functions (Draw, Fit, Add, Scale, Rebin, ...) must be
+   // called when no thread is filling.
+   //
+   // The restrictions are:
+   //  - Sumw2 must be called before the threads fill with weights different
+   //    from 1: it cannot be called implicitly as in Fill(x,w), the weighted
+   //    fills are then ignored and reported once.
+   //  - the axes must not be extendable (SetCanExtend) and an automatic
+   //    binning buffer is emptied and deleted.
+   //  - the profiles, TH1K and TH2Poly, whose Fill functions update more than
+   //    the bin contents, are not supported.
+   //  - TThread::Initialize must have been called (as for all multi-threaded
+   //    programs using ROOT) for the reductions to be protected by a mutex.
+   //
+   // Returns kFALSE if the mode cannot be switched on. The mode is not saved
+   // with the histogram and not copied by Clone.
+   //
+   // Example:
+   //    TThread::Initialize();
+   //    TH3F *h = new TH3F("h", "h", 200, 0, 1, 200, 0, 1, 200, 0, 1);
+   //    h->SetConcurrentFill();
+   //    // ... the threads call h->Fill(x,y,z) ...
+   //    h->SetConcurrentFill(kFALSE);
+
+   if (!concurrent) {
+      if (fConcurrentFill) {
+         ReduceConcurrentFill();
+         delete fConcurrentFill;
+         fConcurrentFill = 0;
+      }
+      return kTRUE;
+   }
+   if (fConcurrentFill) return kTRUE;
+
+   if (InheritsFrom("TProfile") || InheritsFrom("TProfile2D") || InheritsFrom("TProfile3D") ||
+       InheritsFrom("TH1K") || InheritsFrom("TH2Poly")) {
+      Error("SetConcurrentFill", "The concurrent filling is not supported for a %s", ClassName());
+      return kFALSE;
+   }
+   if (fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend()) {
+      Error("SetConcurrentFill", "The concurrent filling is not supported with extendable axes");
+      return kFALSE;
+   }
+   if (fBuffer) BufferEmpty(1);
+   if (fXaxis.GetXmin() >= fXaxis.GetXmax() ||
+       (fDimension > 1 && fYaxis.GetXmin() >= fYaxis.GetXmax()) ||
+       (fDimension > 2 && fZaxis.GetXmin() >= fZaxis.GetXmax())) {
+      Error("SetConcurrentFill", "The axis limits must be set before switching on the concurrent filling");
+      return kFALSE;
+   }
+   if (fBuffer) {
+      delete [] fBuffer;
+      fBuffer = 0;
+      fBufferSize = 0;
+   }
+   THistConcurrentFill *fill = new THistConcurrentFill(this);
+   if (!fill->IsValid()) {
+      Error("SetConcurrentFill", "The concurrent filling is not supported for the bin contents of a %s", ClassName());
+      delete fill;
+      return kFALSE;
+   }
+   fConcurrentFill = fill;
+   return kTRUE;
+}
+
+
 //______________________________________________________________________________
 void TH1::SetDefaultBufferSize(Int_t buffersize)
 {
@@ -6300,6 +6456,7 @@ void TH1::Streamer(TBuffer &b)
       b.CheckByteCount(R__s, R__c, TH1::IsA());
 
    } else {
+      if (fConcurrentFill) ReduceConcurrentFill();
       b.WriteClassBuffer(TH1::Class(),this);
    }
 }
@@ -6418,6 +6575,7 @@ void TH1::Reset(Option_t *option)
    opt.ToUpper();
    fSumw2.Reset();
    if (fIntegral) {delete [] fIntegral; fIntegral = 0;}
+   if (fConcurrentFill) ReduceConcurrentFill();
 
    if (opt.Contains("M")) {
       SetMinimum();
@@ -7006,6 +7164,7 @@ void TH1::GetStats(Double_t *stats) const
    //  the histogram.
 
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->ReduceConcurrentFill();
 
    // Loop on bins (possibly including underflows/overflows)
    Int_t bin, binx;
@@ -7058,6 +7217,7 @@ void TH1::PutStats(Double_t *stats)
 {
    // Replace current statistics with the values in array stats
 
+   if (fConcurrentFill) ReduceConcurrentFill();
    fTsumw   = stats[0];
    fTsumw2  = stats[1];
    fTsumwx  = stats[2];
@@ -7072,6 +7232,7 @@ void TH1::ResetStats()
    // and replace with values calculates from bin content
    // The number of entries is set to the total bin content or (in case of weighted histogram)
    // to number of effective entries
+   if (fConcurrentFill) ReduceConcurrentFill();
    Double_t stats[kNstat] = {0};
    fTsumw = 0;
    fEntries = 1; // to force re-calculation of the statistics in TH1::GetStats
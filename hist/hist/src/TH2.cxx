@@ -152,6 +152,19 @@ TH2::~TH2()
 }
 
 
+//______________________________________________________________________________
+void TH2::AddConcurrentStats(Double_t entries, const Double_t *stats)
+{
+   // Add the statistics accumulated by the threads filling concurrently
+   // (see TH1::SetConcurrentFill).
+
+   TH1::AddConcurrentStats(entries, stats);
+   fTsumwy  += stats[4];
+   fTsumwy2 += stats[5];
+   fTsumwxy += stats[6];
+}
+
+
 //______________________________________________________________________________
 Int_t TH2::BufferEmpty(Int_t action)
 {
@@ -297,6 +310,12 @@ Int_t TH2::Fill(Double_t x,Double_t y)
    // The function returns the corresponding global bin number which has its content
    // incremented by 1
 
+   if (fConcurrentFill) {
+      Int_t binx = fXaxis.FindFixBin(x);
+      Int_t biny = fYaxis.FindFixBin(y);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins();
+      return FillConcurrent(biny*(fXaxis.GetNbins()+2) + binx, inRange, 1, x, y);
+   }
    if (fBuffer) return BufferFill(x,y,1);
 
    Int_t binx, biny, bin;
@@ -341,6 +360,12 @@ Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
    // The function returns the corresponding global bin number which has its content
    // incremented by w
 
+   if (fConcurrentFill) {
+      Int_t binx = fXaxis.FindFixBin(x);
+      Int_t biny = fYaxis.FindFixBin(y);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins();
+      return FillConcurrent(biny*(fXaxis.GetNbins()+2) + binx, inRange, w, x, y);
+   }
    if (fBuffer) return BufferFill(x,y,w);
 
    Int_t binx, biny, bin;
@@ -1080,6 +1105,7 @@ void TH2::GetStats(Double_t *stats) const
    //  the histogram.
 
    if (fBuffer) ((TH2*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH2*)this)->ReduceConcurrentFill();
 
    if ((fTsumw == 0 && fEntries > 0) || fXaxis.TestBit(TAxis::kAxisRange) || fYaxis.TestBit(TAxis::kAxisRange)) {
       std::fill(stats, stats + 7, 0);
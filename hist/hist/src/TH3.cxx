@@ -134,6 +134,23 @@ TH3::~TH3()
 }
 
 
+//______________________________________________________________________________
+void TH3::AddConcurrentStats(Double_t entries, const Double_t *stats)
+{
+   // Add the statistics accumulated by the threads filling concurrently
+   // (see TH1::SetConcurrentFill).
+
+   TH1::AddConcurrentStats(entries, stats);
+   fTsumwy  += stats[4];
+   fTsumwy2 += stats[5];
+   fTsumwxy += stats[6];
+   fTsumwz  += stats[7];
+   fTsumwz2 += stats[8];
+   fTsumwxz += stats[9];
+   fTsumwyz += stats[10];
+}
+
+
 //______________________________________________________________________________
 void TH3::Copy(TObject &obj) const
 {
@@ -275,6 +292,15 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
    // The function returns the corresponding global bin number which has its content
    // incremented by 1
 
+   if (fConcurrentFill) {
+      Int_t binx = fXaxis.FindFixBin(x);
+      Int_t biny = fYaxis.FindFixBin(y);
+      Int_t binz = fZaxis.FindFixBin(z);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins() &&
+                       binz > 0 && binz <= fZaxis.GetNbins();
+      Int_t bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+      return FillConcurrent(bin, inRange, 1, x, y, z);
+   }
    if (fBuffer) return BufferFill(x,y,z,1);
 
    Int_t binx, biny, binz, bin;
@@ -323,6 +349,15 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
    // The function returns the corresponding global bin number which has its content
    // incremented by w
 
+   if (fConcurrentFill) {
+      Int_t binx = fXaxis.FindFixBin(x);
+      Int_t biny = fYaxis.FindFixBin(y);
+      Int_t binz = fZaxis.FindFixBin(z);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins() &&
+                       binz > 0 && binz <= fZaxis.GetNbins();
+      Int_t bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+      return FillConcurrent(bin, inRange, w, x, y, z);
+   }
    if (fBuffer) return BufferFill(x,y,z,w);
 
    Int_t binx, biny, binz, bin;
@@ -1114,6 +1149,7 @@ void TH3::GetStats(Double_t *stats) const
    // stats[10]= sumwyz
 
    if (fBuffer) ((TH3*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH3*)this)->ReduceConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Double_t w,err;
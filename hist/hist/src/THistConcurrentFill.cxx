@@ -0,0 +1,311 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Helper class used internally by TH1 for the concurrent filling
+// (see TH1::SetConcurrentFill and THistConcurrentFill.h).
+
+#include "THistConcurrentFill.h"
+#include "TH1.h"
+#include "TVirtualMutex.h"
+#include "ThreadLocalStorage.h"
+
+#include <string.h>
+#include <vector>
+
+// The compare-and-swap builtins of gcc (also provided by clang and icc).
+// With other compilers the fills are serialized by a mutex.
+#if defined(__GNUC__)
+#define R__HAS_SYNC_BUILTINS
+#endif
+
+// The ordinals of the exiting threads are recycled by a destructor of
+// thread specific data.
+#ifndef _WIN32
+#include <pthread.h>
+#define R__RECYCLE_ORDINALS
+#endif
+
+namespace {
+
+   Int_t gNThreadOrdinals = 0;
+
+#ifdef R__RECYCLE_ORDINALS
+   pthread_mutex_t     gOrdinalMutex   = PTHREAD_MUTEX_INITIALIZER;
+   pthread_once_t      gOrdinalKeyOnce = PTHREAD_ONCE_INIT;
+   pthread_key_t       gOrdinalKey;
+   std::vector<Int_t> *gFreeOrdinals   = 0;  // ordinals of the threads that exited
+
+   //______________________________________________________________________________
+   void ReleaseThreadOrdinal(void *value)
+   {
+      // Called when a thread that filled histograms concurrently exits:
+      // its ordinal, and so its slots, can be taken by a new thread.
+
+      pthread_mutex_lock(&gOrdinalMutex);
+      if (!gFreeOrdinals) gFreeOrdinals = new std::vector<Int_t>;
+      gFreeOrdinals->push_back(Int_t((Long_t)value - 1));
+      pthread_mutex_unlock(&gOrdinalMutex);
+   }
+
+   //______________________________________________________________________________
+   void CreateOrdinalKey()
+   {
+      pthread_key_create(&gOrdinalKey, &ReleaseThreadOrdinal);
+   }
+#endif
+
+   //______________________________________________________________________________
+   template <typename T>
+   inline Bool_t CompareAndSwap(T *p, T oldval, T newval)
+   {
+      // Store newval in *p if *p is still oldval. Returns kFALSE if *p was
+      // changed by another thread.
+
+#ifdef R__HAS_SYNC_BUILTINS
+      return __sync_bool_compare_and_swap(p, oldval, newval);
+#else
+      if (*p != oldval) return kFALSE;
+      *p = newval;
+      return kTRUE;
+#endif
+   }
+
+   //______________________________________________________________________________
+   template <typename T, typename TBits>
+   inline void AtomicAddReal(T *p, Double_t w)
+   {
+      // Add w to the floating point value *p. TBits is the integer type of
+      // the same size as T, on which the compare-and-swap is done.
+
+      union { T fValue; TBits fBits; } oldval, newval;
+      do {
+         oldval.fValue = *(volatile T*)p;
+         newval.fValue = oldval.fValue + T(w);
+      } while (!CompareAndSwap((TBits*)p, oldval.fBits, newval.fBits));
+   }
+
+   //______________________________________________________________________________
+   template <typename T>
+   inline void AtomicAddInt(T *p, Double_t w, Long64_t vmax)
+   {
+      // Add Int_t(w) to the integer *p, saturating at -vmax and vmax as
+      // TH1C, TH1S and TH1I::AddBinContent do.
+
+      Long64_t inc = Int_t(w);
+      T oldval, newval;
+      do {
+         oldval = *(volatile T*)p;
+         Long64_t val = oldval + inc;
+         if (val >  vmax) val =  vmax;
+         if (val < -vmax) val = -vmax;
+         newval = T(val);
+         if (newval == oldval) return;
+      } while (!CompareAndSwap(p, oldval, newval));
+   }
+}
+
+TTHREAD_TLS_DECLARE(Int_t, tordinal);
+
+//______________________________________________________________________________
+THistConcurrentFill::THistConcurrentFill(TH1 *h) :
+   fArray(0), fStorage(kUnknown), fDimension(h->GetDimension()), fMutex(0),
+   fMissingSumw2(kFALSE)
+{
+   // Prepare the concurrent filling of h. IsValid() returns kFALSE if the
+   // bin contents of h are not stored in one of the TArray types.
+
+   memset(fSlots, 0, sizeof(fSlots));
+   if (TArrayD *a = dynamic_cast<TArrayD*>(h)) {
+      fArray = a;
+      fStorage = kDouble;
+   } else if (TArrayF *a = dynamic_cast<TArrayF*>(h)) {
+      fArray = a;
+      fStorage = kFloat;
+   } else if (TArrayI *a = dynamic_cast<TArrayI*>(h)) {
+      fArray = a;
+      fStorage = kInt;
+   } else if (TArrayS *a = dynamic_cast<TArrayS*>(h)) {
+      fArray = a;
+      fStorage = kShort;
+   } else if (TArrayC *a = dynamic_cast<TArrayC*>(h)) {
+      fArray = a;
+      fStorage = kChar;
+   }
+}
+
+//______________________________________________________________________________
+THistConcurrentFill::~THistConcurrentFill()
+{
+   // Destructor. The statistics not yet reduced are lost.
+
+   for (Int_t i = 0; i < kMaxSlots; ++i) delete fSlots[i];
+   delete fMutex;
+}
+
+//______________________________________________________________________________
+void THistConcurrentFill::AddBinContent(Int_t bin, Double_t w)
+{
+   // Add w to the content of bin. The array is looked up at each call
+   // since the histogram may have been rebinned between two fills.
+
+   switch (fStorage) {
+      case kDouble:
+         AtomicAddReal<Double_t, Long64_t>(static_cast<TArrayD*>(fArray)->fArray + bin, w);
+         break;
+      case kFloat:
+         AtomicAddReal<Float_t, Int_t>(static_cast<TArrayF*>(fArray)->fArray + bin, w);
+         break;
+      case kInt:
+         AtomicAddInt(static_cast<TArrayI*>(fArray)->fArray + bin, w, 2147483647);
+         break;
+      case kShort:
+         AtomicAddInt(static_cast<TArrayS*>(fArray)->fArray + bin, w, 32767);
+         break;
+      case kChar:
+         AtomicAddInt(static_cast<TArrayC*>(fArray)->fArray + bin, w, 127);
+         break;
+      default:
+         break;
+   }
+}
+
+//______________________________________________________________________________
+void THistConcurrentFill::Fill(Int_t bin, Double_t w, Double_t *sumw2, Bool_t stats,
+                               Double_t x, Double_t y, Double_t z)
+{
+   // Add w to the content of bin and, if sumw2 is not null, w*w to
+   // sumw2[bin]. The entries and, if stats is true, the sums of w, w*w,
+   // w*x, w*x*x, ... are added to the slot of the calling thread.
+
+#ifndef R__HAS_SYNC_BUILTINS
+   R__LOCKGUARD2(fMutex);
+#endif
+   AddBinContent(bin, w);
+   if (sumw2) AtomicAddReal<Double_t, Long64_t>(sumw2 + bin, w*w);
+
+   Double_t s[kNStats];
+   Int_t n = 1;
+   s[0] = 1;
+   if (stats) {
+      s[1] = w;
+      s[2] = w*w;
+      s[3] = w*x;
+      s[4] = w*x*x;
+      n = 5;
+      if (fDimension > 1) {
+         s[5] = w*y;
+         s[6] = w*y*y;
+         s[7] = w*x*y;
+         n = 8;
+      }
+      if (fDimension > 2) {
+         s[8]  = w*z;
+         s[9]  = w*z*z;
+         s[10] = w*x*z;
+         s[11] = w*y*z;
+         n = 12;
+      }
+   }
+
+   Int_t ordinal = ThreadOrdinal();
+   TSlot *slot = GetSlot(ordinal);
+   if (ordinal < kMaxSlots - 1) {
+      for (Int_t i = 0; i < n; ++i) slot->fStats[i] += s[i];
+   } else {
+      for (Int_t i = 0; i < n; ++i) AtomicAddReal<Double_t, Long64_t>(slot->fStats + i, s[i]);
+   }
+}
+
+//______________________________________________________________________________
+Bool_t THistConcurrentFill::FirstMissingSumw2()
+{
+   // Return kTRUE at the first call only, so that the weighted fills made
+   // without Sumw2 are reported once.
+
+   R__LOCKGUARD2(fMutex);
+   if (fMissingSumw2) return kFALSE;
+   fMissingSumw2 = kTRUE;
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+THistConcurrentFill::TSlot *THistConcurrentFill::GetSlot(Int_t ordinal)
+{
+   // Return the slot of the thread with the given ordinal, creating it at
+   // the first call.
+
+   if (ordinal > kMaxSlots - 1) ordinal = kMaxSlots - 1;
+   TSlot *slot = *(TSlot* volatile*)(fSlots + ordinal);
+   if (slot) return slot;
+   slot = new TSlot;
+   memset(slot, 0, sizeof(TSlot));
+   // Only the last slot can be created by two threads at the same time.
+   if (!CompareAndSwap(fSlots + ordinal, (TSlot*)0, slot)) {
+      delete slot;
+      slot = fSlots[ordinal];
+   }
+   return slot;
+}
+
+//______________________________________________________________________________
+Bool_t THistConcurrentFill::Reduce(Double_t *delta)
+{
+   // Set delta to what the slots accumulated since the previous call, in
+   // the order of THistConcurrentFill::Fill. The slots are read without
+   // synchronization with the filling threads: this must be called after
+   // they are done (joined), with the lock returned by GetMutex held.
+   // Returns kFALSE if no thread filled the histogram.
+
+   for (Int_t i = 0; i < kNStats; ++i) delta[i] = 0;
+   Bool_t filled = kFALSE;
+   for (Int_t k = 0; k < kMaxSlots; ++k) {
+      TSlot *slot = *(TSlot* volatile*)(fSlots + k);
+      if (!slot) continue;
+      for (Int_t i = 0; i < kNStats; ++i) {
+         Double_t current = *(volatile Double_t*)(slot->fStats + i);
+         delta[i] += current - slot->fReduced[i];
+         slot->fReduced[i] = current;
+      }
+      filled = kTRUE;
+   }
+   return filled;
+}
+
+//______________________________________________________________________________
+Int_t THistConcurrentFill::ThreadOrdinal()
+{
+   // Number the threads in the order of their first concurrent fill,
+   // whatever the histogram. A new thread takes, if any, the ordinal of a
+   // thread that exited, so that the ordinals stay below the number of
+   // threads running at the same time and the threads do not end up
+   // sharing the last slot in long jobs.
+
+   TTHREAD_TLS_INIT(Int_t,tordinal,-1);
+   Int_t ordinal = TTHREAD_TLS_GET(Int_t,tordinal);
+   if (ordinal >= 0) return ordinal;
+#ifdef R__RECYCLE_ORDINALS
+   pthread_once(&gOrdinalKeyOnce, &CreateOrdinalKey);
+   pthread_mutex_lock(&gOrdinalMutex);
+   if (gFreeOrdinals && !gFreeOrdinals->empty()) {
+      ordinal = gFreeOrdinals->back();
+      gFreeOrdinals->pop_back();
+   } else {
+      ordinal = gNThreadOrdinals++;
+   }
+   pthread_mutex_unlock(&gOrdinalMutex);
+   pthread_setspecific(gOrdinalKey, (void*)(Long_t)(ordinal + 1));
+#elif defined(R__HAS_SYNC_BUILTINS)
+   ordinal = __sync_fetch_and_add(&gNThreadOrdinals, 1);
+#else
+   ordinal = gNThreadOrdinals++;
+#endif
+   TTHREAD_TLS_SET(Int_t,tordinal,ordinal);
+   return ordinal;
+}
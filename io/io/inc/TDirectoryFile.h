@@ -45,9 +45,21 @@ protected:
    Long64_t    fSeekKeys;        //Location of Keys record on file
    TFile      *fFile;            //pointer to current file in memory
    TList      *fKeys;            //Pointer to keys list in memory
+   Long64_t    fSeekKeysIndex;   //!Location of the keys index record on file
+   Int_t       fNbytesKeysIndex; //!Number of bytes of the keys index record
+   Int_t       fKeylenKeysIndex; //!Length of the key header of the keys index record
+   Int_t       fNkeysIndex;      //!Number of keys in the keys index
+   Int_t       fNbucketsIndex;   //!Number of hash buckets of the keys index
+   Bool_t      fKeysPending;     //!True if fKeys is still to be read, the keys are found through the index
+   TList      *fIndexedKeys;     //!Keys read through the index while fKeys is pending
+
+   static Int_t fgKeysIndexThreshold; //Minimum number of keys of a directory to write its keys index
 
    virtual void         CleanTargets();
    void Init(TClass *cl = 0);
+   TKey                *LookupKey(const char *name, Short_t cycle, Bool_t exact) const;
+   Int_t                ReadIndexedKeys(const char *name);
+   Bool_t               ReadKeysIndexLocation();
 
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
@@ -88,10 +100,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
    virtual TFile      *GetFile() const { return fFile; }
    virtual TKey       *GetKey(const char *name, Short_t cycle=9999) const;
-   virtual TList      *GetListOfKeys() const { return fKeys; }
+   virtual TList      *GetListOfKeys() const;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
    virtual Int_t       GetNbytesKeys() const { return fNbytesKeys; }
-   virtual Int_t       GetNkeys() const { return fKeys->GetSize(); }
+   virtual Int_t       GetNkeys() const { return fKeysPending ? fNkeysIndex : fKeys->GetSize(); }
    virtual Long64_t    GetSeekDir() const { return fSeekDir; }
    virtual Long64_t    GetSeekParent() const { return fSeekParent; }
    virtual Long64_t    GetSeekKeys() const { return fSeekKeys; }
@@ -112,6 +124,8 @@ public:
    virtual void        SaveSelf(Bool_t force = kFALSE);
    virtual Int_t       SaveObjectAs(const TObject *obj, const char *filename="", Option_t *option="") const;
    virtual void        SetBufferSize(Int_t bufsize);
+   static  void        SetKeysIndexThreshold(Int_t nkeys);
+   static  Int_t       GetKeysIndexThreshold();
    void                SetModified() {fModified = kTRUE;}
    void                SetSeekDir(Long64_t v) { fSeekDir = v; }
    virtual void        SetTRefAction(TObject *ref, TObject *parent);
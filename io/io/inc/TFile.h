@@ -93,8 +93,11 @@ protected:
 
    TList           *fInfoCache;      //!Cached list of the streamer infos in this file
    TList           *fOpenPhases;     //!Time info about open phases
+   char            *fMapAddress;     //!Address of the memory mapping of the file (option MMAP)
+   Long64_t         fMapSize;        //!Size of the memory mapping of the file
 
    static TList    *fgAsyncOpenRequests; //List of handles for pending open requests
+   static Int_t     fgAsyncVectorReads;  //Advise the kernel of the reads of ReadBuffers (-1: from rootrc)
 
    static TString   fgCacheFileDir;          //Directory where to locally stage files
    static Bool_t    fgCacheFileDisconnected; //Indicates, we trust in the files in the cache dir without stat on the cached file
@@ -108,10 +111,14 @@ protected:
    static Int_t     fgReadaheadSize;         //Readahead buffer size
    static Bool_t    fgReadInfo;              //if true (default) ReadStreamerInfo is called when opening a file
 
+   void          AdviseReadBuffers(Long64_t *pos, Int_t *len, Int_t nbuf);
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void  Init(Bool_t create);
    Bool_t        FlushWriteCache();
+   Bool_t        MapFile();
+   Bool_t        ReadBufferMapped(char *buf, Int_t len);
    Int_t         ReadBufferViaCache(char *buf, Int_t len);
+   void          UnmapFile();
    Int_t         WriteBufferViaCache(const char *buf, Int_t len);
 
    // Creating projects
@@ -185,6 +192,7 @@ public:
    Float_t             GetCompressionFactor();
    virtual Long64_t    GetEND() const { return fEND; }
    virtual Int_t       GetErrno() const;
+   const char         *GetMappedBuffer(Long64_t pos, Int_t len, Bool_t borrow = kFALSE) const;
    virtual void        ResetErrno() const;
    Int_t               GetFd() const { return fD; }
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
@@ -211,6 +219,7 @@ public:
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
+           Bool_t      IsMapped() const { return fMapAddress != 0; }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
    virtual void        ls(Option_t *option="") const;
@@ -266,6 +275,7 @@ public:
 
    static EAsyncOpenStatus GetAsyncOpenStatus(const char *name);
    static EAsyncOpenStatus GetAsyncOpenStatus(TFileOpenHandle *handle);
+   static Bool_t       GetAsyncVectorReads();
    static const TUrl  *GetEndpointUrl(const char *name);
 
    static Long64_t     GetFileBytesRead();
@@ -273,6 +283,8 @@ public:
    static Int_t        GetFileReadCalls();
    static Int_t        GetReadaheadSize();
 
+   static void         ReleaseMappedBuffer(const char *buffer);
+   static void         SetAsyncVectorReads(Bool_t async = kTRUE);
    static void         SetFileBytesRead(Long64_t bytes = 0);
    static void         SetFileBytesWritten(Long64_t bytes = 0);
    static void         SetFileReadCalls(Int_t readcalls = 0);
@@ -24,6 +24,8 @@
 // rfio, dcap, etc.                                                     //
 // The merging interface allows files containing histograms and trees   //
 // to be merged, like the standalone hadd program.                      //
+// With SetNProcesses(n), subsets of the input files are merged in      //
+// parallel into temporary files which are then merged in the output.   //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
@@ -37,6 +39,8 @@
 #include "TStopwatch.h"
 #endif
 
+#include <vector>
+
 class TList;
 class TFile;
 class TDirectory;
@@ -65,10 +69,14 @@ protected:
    TString        fObjectNames;     // List of object names to be either merged exclusively or skipped
    TList         *fMergeList;       // list of TObjString containing the name of the files need to be merged
    TList         *fExcessFiles;     //! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitiation on the max number of files opened.
+   Int_t          fNProcesses;      //! Number of processes merging subsets of the input files (default 1, see SetNProcesses)
 
    Bool_t         OpenExcessFiles();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
+   Bool_t         MergeSubset(const char *output, const std::vector<TString> &inputs,
+                               Int_t first, Int_t end, Int_t type, Int_t isubset);
+   Bool_t         MergeSubsets(Int_t type, TList &partials);
 
 public:
    enum EPartialMergeType {
@@ -94,6 +102,8 @@ public:
    TFile      *GetOutputFile() const { return fOutputFile; }
    Int_t       GetMaxOpenedFies() const { return fMaxOpenedFiles; }
    void        SetMaxOpenedFiles(Int_t newmax);
+   Int_t       GetNProcesses() const { return fNProcesses; }
+   void        SetNProcesses(Int_t nprocesses);
    const char *GetMsgPrefix() const { return fMsgPrefix; }
    void        SetMsgPrefix(const char *prefix);
    void        AddObjectNames(const char *name) {fObjectNames += name; fObjectNames += " ";}
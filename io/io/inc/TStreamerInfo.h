@@ -109,7 +109,12 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteObjectWise;     //! List of write action resulting from the compilation.
    TStreamerInfoActions::TActionSequence *fWriteMemberWise;     //! List of write action resulting from the compilation for use in member wise streaming.
 
+   ClassSpecializedStreamerFunc_t fSpecializedFunc; //! Streamer of the data members generated for the class layout, used instead of the actions.
+   Long_t           *fSpecializedOffsets;//! Offsets of the data members streamed by fSpecializedFunc
+   Int_t             fNspecializedBases; //! Number of base class elements streamed before fSpecializedFunc
+
    static  Int_t     fgCount;            //Number of TStreamerInfo instances
+   static  Bool_t    fgUseSpecialized;   //True if the specialized streamers of the classes are used
    static TStreamerElement *fgElement;   //Pointer to current TStreamerElement
    static Double_t   GetValueAux(Int_t type, void *ladd, int k, Int_t len);
    static void       PrintValueAux(char *ladd, Int_t atype, TStreamerElement * aElement, Int_t aleng, Int_t *count);
@@ -124,6 +129,7 @@ private:
    TStreamerInfo& operator=(const TStreamerInfo&); // TStreamerInfo are copiable.  Not Implemented.
    void AddReadAction(Int_t index, TStreamerElement* element);
    void AddWriteAction(Int_t index, TStreamerElement* element);
+   void CompileSpecialized();
 public:
 
    //status bits
@@ -193,6 +199,7 @@ public:
    void                ForceWriteInfo(TFile *file, Bool_t force=kFALSE);
    Int_t               GenerateHeaderFile(const char *dirname, const TList *subClasses = 0, const TList *extrainfos = 0);
    TClass             *GetActualClass(const void *obj) const;
+   ClassSpecializedStreamerFunc_t GetSpecializedStreamerFunc() const { return fgUseSpecialized ? fSpecializedFunc : 0; }
    TClass             *GetClass() const {return fClass;}
    UInt_t              GetCheckSum() const {return fCheckSum;}
    UInt_t              GetCheckSum(UInt_t code) const;
@@ -262,6 +269,7 @@ public:
    void                SetCheckSum(UInt_t checksum) {fCheckSum = checksum;}
    void                SetClass(TClass *cl) {fClass = cl;}
    void                SetClassVersion(Int_t vers) {fClassVersion=vers;}
+   void                StreamSpecialized(TBuffer &b, char *pointer);
    void                TagFile(TFile *fFile);
    Int_t               WriteBuffer(TBuffer &b, char *pointer, Int_t first);
    Int_t               WriteBufferClones(TBuffer &b, TClonesArray *clones, Int_t nc, Int_t first, Int_t eoffset);
@@ -275,6 +283,8 @@ public:
    virtual TClassStreamer *GenExplicitClassStreamer( const ::ROOT::TCollectionProxyInfo &info, TClass *cl );
 
    static TStreamerElement   *GetCurrentElement();
+   static Bool_t       CanUseSpecialized();
+   static void         UseSpecialized(Bool_t use=kTRUE);
 
 
 #ifdef R__BROKEN_FUNCTION_TEMPLATES
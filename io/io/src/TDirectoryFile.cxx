@@ -50,14 +50,68 @@
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+// The keys index of a directory is a separate record made of a header
+// (magic, number of keys, number of buckets), the table of the first entry of
+// each bucket (nbuckets+1 Int_t) and the entries sorted by bucket. An entry
+// holds the hash of the key name, the length and the location of the key
+// header in the keys record. The location of the index is given by a trailer
+// at the end of the keys record, after the key headers, which is ignored by
+// the versions of ROOT reading only the key headers.
+const UInt_t kKeysIndexMagic   = 0x4b494458; // "KIDX"
+const Int_t  kKeysIndexHeader  = 12;
+const Int_t  kKeysIndexEntry   = 16;
+const Int_t  kKeysIndexTrailer = 24;
+
+Int_t TDirectoryFile::fgKeysIndexThreshold = 1000;
+
 ClassImp(TDirectoryFile)
 
+namespace {
+
+   //______________________________________________________________________________
+   UInt_t KeyNameHash(const char *name)
+   {
+      // FNV-1a hash of a key name, independent of the platform since it is stored
+      // in the keys index.
+
+      UInt_t hash = 2166136261U;
+      for (const unsigned char *c = (const unsigned char *)name; *c; ++c) {
+         hash ^= *c;
+         hash *= 16777619U;
+      }
+      return hash;
+   }
+
+   //______________________________________________________________________________
+   TKey *SelectKey(TList *keys, const char *name, Short_t cycle, Bool_t exact)
+   {
+      // Return the key of keys named name with the highest cycle if cycle is 9999,
+      // otherwise the one with this cycle if exact is true, or with the highest
+      // cycle below or equal to cycle. keys may contain keys with other names.
+
+      if (!keys) return 0;
+      TKey *found = 0;
+      TKey *key;
+      TIter next(keys);
+      while ((key = (TKey *) next())) {
+         if (strcmp(name, key->GetName())) continue;
+         if (cycle != 9999) {
+            if (exact && key->GetCycle() != cycle) continue;
+            if (!exact && key->GetCycle() > cycle) continue;
+         }
+         if (!found || key->GetCycle() > found->GetCycle()) found = key;
+      }
+      return found;
+   }
+}
+
 
 //______________________________________________________________________________
 TDirectoryFile::TDirectoryFile() : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fSeekKeysIndex(0), fNbytesKeysIndex(0), fKeylenKeysIndex(0)
+   , fNkeysIndex(0), fNbucketsIndex(0), fKeysPending(kFALSE), fIndexedKeys(0)
 {
 //*-*-*-*-*-*-*-*-*-*-*-*Directory default constructor-*-*-*-*-*-*-*-*-*-*-*-*
 //*-*                    =============================
@@ -68,7 +122,8 @@ TDirectoryFile::TDirectoryFile(const char *name, const char *title, Option_t *cl
            : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fSeekKeysIndex(0), fNbytesKeysIndex(0), fKeylenKeysIndex(0)
+   , fNkeysIndex(0), fNbucketsIndex(0), fKeysPending(kFALSE), fIndexedKeys(0)
 {
 //*-*-*-*-*-*-*-*-*-*-*-* Create a new DirectoryFile *-*-*-*-*-*-*-*-*-*-*-*-*-*
 //*-*                     ==========================
@@ -166,7 +221,8 @@ void TDirectoryFile::Init(TClass *cl)
 TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(directory)
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fSeekKeysIndex(0), fNbytesKeysIndex(0), fKeylenKeysIndex(0)
+   , fNkeysIndex(0), fNbucketsIndex(0), fKeysPending(kFALSE), fIndexedKeys(0)
 {
    // Copy constructor.
    ((TDirectoryFile&)directory).Copy(*this);
@@ -181,6 +237,11 @@ TDirectoryFile::~TDirectoryFile()
       fKeys->Delete("slow");
       SafeDelete(fKeys);
    }
+   if (fIndexedKeys) {
+      fIndexedKeys->Delete("slow");
+      SafeDelete(fIndexedKeys);
+   }
+   fKeysPending = kFALSE;
 
    CleanTargets();
 
@@ -230,16 +291,19 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
 
    key->SetMotherDir(this);
 
+   // The keys still to be read (see GetListOfKeys) are read before the new one is added
+   TList *keys = GetListOfKeys();
+
    // This is a fast hash lookup in case the key does not already exist
-   TKey *oldkey = (TKey*)fKeys->FindObject(key->GetName());
+   TKey *oldkey = (TKey*)keys->FindObject(key->GetName());
    if (!oldkey) {
-      fKeys->Add(key);
+      keys->Add(key);
       return 1;
    }
 
    // If the key name already exists we have to make a scan for it
    // and insert the new key ahead of the current one
-   TObjLink *lnk = fKeys->FirstLink();
+   TObjLink *lnk = keys->FirstLink();
    while (lnk) {
       oldkey = (TKey*)lnk->GetObject();
       if (!strcmp(oldkey->GetName(), key->GetName()))
@@ -247,7 +311,7 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       lnk = lnk->Next();
    }
 
-   fKeys->AddBefore(lnk, key);
+   keys->AddBefore(lnk, key);
    return oldkey->GetCycle() + 1;
 }
 
@@ -262,13 +326,14 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = 0;
       TIter nextin(fList);
       TKey *key = 0, *keyo = 0;
-      TIter next(fKeys);
+      TList *keys = GetListOfKeys();
+      TIter next(keys);
 
       cd();
 
       //Add objects that are only in memory
       while ((obj = nextin())) {
-         if (fKeys->FindObject(obj->GetName())) continue;
+         if (keys->FindObject(obj->GetName())) continue;
          b->Add(obj, obj->GetName());
       }
 
@@ -552,6 +617,10 @@ void TDirectoryFile::Close(Option_t *)
    if (fKeys) {
       fKeys->Delete("slow");
    }
+   if (fIndexedKeys) {
+      fIndexedKeys->Delete("slow");
+   }
+   fKeysPending = kFALSE;
 
    CleanTargets();
 }
@@ -883,16 +952,10 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObj();
-            break;
-         }
-      }
+   TKey *key = LookupKey(namobj, cycle, kTRUE);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObj();
    }
 
    return idcur;
@@ -992,16 +1055,10 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //*-*---------------------Case of Key---------------------
 //                        ===========
    void *idcur = 0;
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObjectAny(expectedClass);
-            break;
-         }
-      }
+   TKey *key = LookupKey(namobj, cycle, kTRUE);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObjectAny(expectedClass);
    }
 
    return idcur;
@@ -1025,15 +1082,39 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 //*-*-*-*-*-*-*-*-*-*-*Return pointer to key with name,cycle*-*-*-*-*-*-*-*
 //*-*                  =====================================
 //  if cycle = 9999 returns highest cycle
+//  otherwise returns the highest cycle below or equal to cycle
 //
-   TKey *key;
-   TIter next(GetListOfKeys());
-   while ((key = (TKey *) next()))
-      if (!strcmp(name, key->GetName())) {
-         if (cycle == 9999)             return key;
-         if (cycle >= key->GetCycle())  return key;
+   return LookupKey(name, cycle, kFALSE);
+}
+
+//______________________________________________________________________________
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   // Return the list of the keys of this directory. When the directory has
+   // a keys index and the file is read only, the keys are only read at the
+   // first call.
+
+   if (fKeysPending) ((TDirectoryFile*)this)->ReadKeys(kFALSE);
+   return fKeys;
+}
+
+//______________________________________________________________________________
+TKey *TDirectoryFile::LookupKey(const char *name, Short_t cycle, Bool_t exact) const
+{
+   // Return the key with name and cycle (see SelectKey above). The keys with
+   // this name are found through the hash table of fKeys, or through the
+   // keys index on file if fKeys is not read yet.
+
+   if (fKeysPending) {
+      if (!SelectKey(fIndexedKeys ? ((THashList*)fIndexedKeys)->GetListForObject(name) : 0, name, 9999, kFALSE)) {
+         ((TDirectoryFile*)this)->ReadIndexedKeys(name);
       }
-   return 0;
+      if (fKeysPending) {
+         return SelectKey(fIndexedKeys ? ((THashList*)fIndexedKeys)->GetListForObject(name) : 0, name, cycle, exact);
+      }
+   }
+   if (!fKeys) return 0;
+   return SelectKey(((THashList*)fKeys)->GetListForObject(name), name, cycle, exact);
 }
 
 //______________________________________________________________________________
@@ -1281,6 +1362,16 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
    if ( fSeekKeys >  0) {
+      // When the file is read only and the directory has a keys index, the
+      // keys are read at the first call to GetListOfKeys: until then the
+      // objects are found through the index.
+      if (!forceRead && !fKeysPending && !fFile->IsWritable() && !fKeys->GetSize() &&
+          ReadKeysIndexLocation()) {
+         fKeysPending = kTRUE;
+         return fNkeysIndex;
+      }
+      fKeysPending = kFALSE;
+
       TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
@@ -1305,12 +1396,165 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
          }
          fKeys->Add(key);
       }
+
+      // Location of the keys index, needed to free it when the keys are written again
+      fSeekKeysIndex = 0;
+      // The trailer ends the data of the keys record, as written by WriteKeys
+      char *trailer = headerkey->GetBuffer() + headerkey->GetObjlen() - kKeysIndexTrailer;
+      if (trailer >= buffer) {
+         UInt_t magic;
+         frombuf(trailer, &fSeekKeysIndex);
+         frombuf(trailer, &fNbytesKeysIndex);
+         frombuf(trailer, &fKeylenKeysIndex);
+         frombuf(trailer, &fNkeysIndex);
+         frombuf(trailer, &magic);
+         if (magic != kKeysIndexMagic || fNkeysIndex != nkeys || fSeekKeysIndex < 64 ||
+             fSeekKeysIndex + fNbytesKeysIndex > fsize) {
+            fSeekKeysIndex = 0;
+         }
+      }
       delete headerkey;
    }
 
    return nkeys;
 }
 
+//______________________________________________________________________________
+Bool_t TDirectoryFile::ReadKeysIndexLocation()
+{
+   // Read the trailer of the keys record giving the location of the keys
+   // index and check the header of the index. Return kFALSE if the directory
+   // has no valid keys index.
+
+   fSeekKeysIndex = 0;
+   if (fNbytesKeys < kKeysIndexTrailer) return kFALSE;
+   char trailer[kKeysIndexTrailer];
+   if (fFile->ReadBuffer(trailer, fSeekKeys + fNbytesKeys - kKeysIndexTrailer, kKeysIndexTrailer)) {
+      return kFALSE;
+   }
+   char *buffer = trailer;
+   Long64_t seekindex;
+   Int_t nbytesindex, keylenindex, nkeys;
+   UInt_t magic;
+   frombuf(buffer, &seekindex);
+   frombuf(buffer, &nbytesindex);
+   frombuf(buffer, &keylenindex);
+   frombuf(buffer, &nkeys);
+   frombuf(buffer, &magic);
+   if (magic != kKeysIndexMagic || seekindex < 64 || keylenindex <= 0 ||
+       nbytesindex < keylenindex + kKeysIndexHeader || seekindex + nbytesindex > fFile->GetSize()) {
+      return kFALSE;
+   }
+
+   char header[kKeysIndexHeader];
+   if (fFile->ReadBuffer(header, seekindex + keylenindex, kKeysIndexHeader)) return kFALSE;
+   buffer = header;
+   Int_t nkeysindex, nbuckets;
+   frombuf(buffer, &magic);
+   frombuf(buffer, &nkeysindex);
+   frombuf(buffer, &nbuckets);
+   if (magic != kKeysIndexMagic || nkeysindex != nkeys || nbuckets <= 0 ||
+       kKeysIndexHeader + 4*(nbuckets+1) + kKeysIndexEntry*nkeys > nbytesindex - keylenindex) {
+      return kFALSE;
+   }
+
+   fSeekKeysIndex    = seekindex;
+   fNbytesKeysIndex  = nbytesindex;
+   fKeylenKeysIndex  = keylenindex;
+   fNkeysIndex       = nkeys;
+   fNbucketsIndex    = nbuckets;
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t TDirectoryFile::ReadIndexedKeys(const char *name)
+{
+   // Read from the keys index the keys named name and add them to
+   // fIndexedKeys. Only the bucket of name in the index and the headers
+   // of the matching keys are read. If the index is inconsistent with
+   // the file, the whole list of keys is read instead.
+   // Return the number of keys read.
+
+   UInt_t hash = KeyNameHash(name);
+   Long64_t data = fSeekKeysIndex + fKeylenKeysIndex;
+   Int_t bucket = hash % (UInt_t)fNbucketsIndex;
+
+   char range[8];
+   char *buffer = range;
+   Int_t first, last;
+   if (fFile->ReadBuffer(range, data + kKeysIndexHeader + 4*bucket, 8)) {
+      ReadKeys(kFALSE);
+      return 0;
+   }
+   frombuf(buffer, &first);
+   frombuf(buffer, &last);
+   if (first < 0 || last < first || last > fNkeysIndex) {
+      Error("ReadIndexedKeys","invalid keys index, reading all the keys");
+      ReadKeys(kFALSE);
+      return 0;
+   }
+   if (first == last) return 0;
+
+   Int_t nentries = last - first;
+   char *entries = new char[kKeysIndexEntry*nentries];
+   Long64_t seekentries = data + kKeysIndexHeader + 4*(fNbucketsIndex+1) + kKeysIndexEntry*(Long64_t)first;
+   if (fFile->ReadBuffer(entries, seekentries, kKeysIndexEntry*nentries)) {
+      delete [] entries;
+      ReadKeys(kFALSE);
+      return 0;
+   }
+
+   TDirectory::TContext ctxt(this);
+   if (!fIndexedKeys) fIndexedKeys = new THashList();
+   Long64_t fsize = fFile->GetSize();
+   Int_t nkeys = 0;
+   Bool_t valid = kTRUE;
+   buffer = entries;
+   for (Int_t i = 0; i < nentries && valid; i++) {
+      UInt_t entryhash;
+      Int_t len;
+      Long64_t seek;
+      frombuf(buffer, &entryhash);
+      frombuf(buffer, &len);
+      frombuf(buffer, &seek);
+      if (entryhash != hash) continue;
+      if (len <= 0 || seek < 64 || seek + len > fsize) {
+         valid = kFALSE;
+         break;
+      }
+      char *header = new char[len];
+      char *hbuffer = header;
+      if (fFile->ReadBuffer(header, seek, len)) {
+         delete [] header;
+         valid = kFALSE;
+         break;
+      }
+      TKey *key = new TKey(this);
+      key->ReadKeyBuffer(hbuffer);
+      delete [] header;
+      if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize ||
+          key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
+         delete key;
+         valid = kFALSE;
+         break;
+      }
+      if (strcmp(name, key->GetName())) {
+         delete key;
+         continue;
+      }
+      fIndexedKeys->Add(key);
+      nkeys++;
+   }
+   delete [] entries;
+
+   if (!valid) {
+      Error("ReadIndexedKeys","invalid keys index, reading all the keys");
+      ReadKeys(kFALSE);
+      return 0;
+   }
+   return nkeys;
+}
+
 
 //______________________________________________________________________________
 Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
@@ -1323,13 +1567,8 @@ Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
    // See TObject::Write().
 
    if (!fFile) { Error("Read","No file open"); return 0; }
-   TKey *key = 0;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(keyname,key->GetName()) == 0) {
-         return key->Read(obj);
-      }
-   }
+   TKey *key = LookupKey(keyname, 9999, kFALSE);
+   if (key) return key->Read(obj);
    Error("Read","Key not found"); 
    return 0;
 }
@@ -1355,7 +1594,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
-   TKey *key = (TKey*)fKeys->FindObject(fName);
+   TKey *key = (TKey*)GetListOfKeys()->FindObject(fName);
    TClass *cl = IsA();
    if (key) {
       cl = TClass::GetClass(key->GetClassName());
@@ -1518,6 +1757,9 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 
    TDirectory::TContext ctxt(this);
 
+   // The keys must be in memory to be updated
+   if (writable && fKeysPending) ReadKeys(kFALSE);
+
    fWritable = writable;
 
    // recursively set all sub-directories
@@ -1623,7 +1865,8 @@ void TDirectoryFile::Streamer(TBuffer &b)
       }
       R__LOCKGUARD2(gROOTMutex);
       gROOT->GetUUIDs()->AddUUID(fUUID,this);
-      if (fSeekKeys) ReadKeys();
+      // the header has just been read: the keys may be read on demand
+      if (fSeekKeys) ReadKeys(kFALSE);
    } else {
       if (fFile && !fFile->IsBinary()) {
          b.WriteVersion(TDirectoryFile::Class());
@@ -2002,10 +2245,14 @@ void TDirectoryFile::WriteKeys()
       return;
    }
 
-//*-* Delete the old keys structure if it exists
+//*-* Delete the old keys structure and its index if they exist
    if (fSeekKeys != 0) {
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
+   if (fSeekKeysIndex != 0) {
+      f->MakeFree(fSeekKeysIndex, fSeekKeysIndex + fNbytesKeysIndex -1);
+      fSeekKeysIndex = 0;
+   }
 //*-* Write new keys record
    TIter next(fKeys);
    TKey *key;
@@ -2015,20 +2262,118 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+   Bool_t index = fgKeysIndexThreshold > 0 && nkeys >= fgKeysIndexThreshold;
+   if (index) nbytes += kKeysIndexTrailer;
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
       return;
    }
+
+//*-* The keys index is a separate record, allocated before filling the keys
+//*-* record since its location is written in the trailer of the keys record
+   TKey *indexkey = 0;
+   Int_t nbuckets = nkeys;
+   if (index) {
+      Int_t nbytesindex = kKeysIndexHeader + 4*(nbuckets+1) + kKeysIndexEntry*nkeys;
+      indexkey = new TKey(fName,fTitle,IsA(),nbytesindex,this);
+      if (indexkey->GetSeekKey() == 0) {
+         delete indexkey;
+         indexkey = 0;
+      }
+   }
+
    char *buffer = headerkey->GetBuffer();
    next.Reset();
    tobuf(buffer, nkeys);
+   UInt_t   *hashes = indexkey ? new UInt_t[nkeys] : 0;
+   Int_t    *lens   = indexkey ? new Int_t[nkeys] : 0;
+   Long64_t *seeks  = indexkey ? new Long64_t[nkeys] : 0;
+   Long64_t  seek0  = headerkey->GetSeekKey() + headerkey->GetKeylen();
+   Int_t i = 0;
    while ((key = (TKey*)next())) {
+      if (indexkey) {
+         hashes[i] = KeyNameHash(key->GetName());
+         seeks[i]  = seek0 + (buffer - headerkey->GetBuffer());
+      }
+      char *start = buffer;
       key->FillBuffer(buffer);
-   }
+      if (indexkey) lens[i] = buffer - start;
+      i++;
+   }
+
+   if (index) {
+      buffer = headerkey->GetBuffer() + nbytes - kKeysIndexTrailer;
+      tobuf(buffer, indexkey ? indexkey->GetSeekKey() : (Long64_t)0);
+      tobuf(buffer, indexkey ? indexkey->GetNbytes() : 0);
+      tobuf(buffer, indexkey ? indexkey->GetKeylen() : 0);
+      tobuf(buffer, nkeys);
+      tobuf(buffer, indexkey ? kKeysIndexMagic : 0);
+   }
+
+   if (indexkey) {
+      // the entries are sorted by bucket, keeping the order of fKeys in each bucket
+      Int_t *first = new Int_t[nbuckets+1];
+      for (i = 0; i <= nbuckets; i++) first[i] = 0;
+      for (i = 0; i < nkeys; i++) first[hashes[i] % (UInt_t)nbuckets + 1]++;
+      for (i = 0; i < nbuckets; i++) first[i+1] += first[i];
+      Int_t *order = new Int_t[nkeys];
+      Int_t *fill  = new Int_t[nbuckets];
+      for (i = 0; i < nbuckets; i++) fill[i] = first[i];
+      for (i = 0; i < nkeys; i++) order[fill[hashes[i] % (UInt_t)nbuckets]++] = i;
+
+      buffer = indexkey->GetBuffer();
+      tobuf(buffer, kKeysIndexMagic);
+      tobuf(buffer, nkeys);
+      tobuf(buffer, nbuckets);
+      for (i = 0; i <= nbuckets; i++) tobuf(buffer, first[i]);
+      for (i = 0; i < nkeys; i++) {
+         Int_t k = order[i];
+         tobuf(buffer, hashes[k]);
+         tobuf(buffer, lens[k]);
+         tobuf(buffer, seeks[k]);
+      }
+      delete [] first;
+      delete [] order;
+      delete [] fill;
+
+      fSeekKeysIndex   = indexkey->GetSeekKey();
+      fNbytesKeysIndex = indexkey->GetNbytes();
+      fKeylenKeysIndex = indexkey->GetKeylen();
+      fNkeysIndex      = nkeys;
+      fNbucketsIndex   = nbuckets;
+      indexkey->WriteFile();
+      delete indexkey;
+   }
+   delete [] hashes;
+   delete [] lens;
+   delete [] seeks;
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
    headerkey->WriteFile();
    delete headerkey;
 }
+
+//______________________________________________________________________________
+void TDirectoryFile::SetKeysIndexThreshold(Int_t nkeys)
+{
+   // Set the minimum number of keys of a directory for which a keys index is
+   // written with the list of keys (1000 by default, 0 to write no index).
+   // When a file is opened in read mode, the keys of a directory with an index
+   // are only read at the first call to GetListOfKeys (e.g. by ls or by a loop
+   // on the keys): Get, GetObject, GetKey and FindKey only read the bucket of
+   // the index corresponding to the requested name and the matching key headers,
+   // so that opening the file and reading an object do not depend on the number
+   // of keys.
+
+   fgKeysIndexThreshold = nkeys;
+}
+
+//______________________________________________________________________________
+Int_t TDirectoryFile::GetKeysIndexThreshold()
+{
+   // Return the minimum number of keys of a directory to write its keys index.
+
+   return fgKeysIndexThreshold;
+}
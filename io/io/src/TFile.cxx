@@ -70,6 +70,7 @@
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -113,6 +114,7 @@
 #include "TStopwatch.h"
 #include "compiledata.h"
 #include <cmath>
+#include <map>
 #include <set>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
@@ -127,6 +129,7 @@ Int_t    TFile::fgReadaheadSize = 256000;
 Int_t    TFile::fgReadCalls = 0;
 Bool_t   TFile::fgReadInfo = kTRUE;
 TList   *TFile::fgAsyncOpenRequests = 0;
+Int_t    TFile::fgAsyncVectorReads = -1;
 TString  TFile::fgCacheFileDir;
 Bool_t   TFile::fgCacheFileForce = kFALSE;
 Bool_t   TFile::fgCacheFileDisconnected = kTRUE;
@@ -135,6 +138,21 @@ Bool_t   TFile::fgOnlyStaged = 0;
 
 const Int_t kBEGIN = 100;
 
+namespace {
+   // The memory mappings of the files opened with option MMAP, indexed by
+   // their address. A mapping stays alive after TFile::Close as long as
+   // some baskets (e.g. of a tree detached with SetDirectory(0)) still
+   // borrow their buffer from it, see TFile::GetMappedBuffer.
+   struct TFileMapping_t {
+      Long64_t fSize;       // Size of the mapping
+      Int_t    fNBorrowed;  // Number of buffers borrowed from the mapping
+      Bool_t   fClosed;     // True once the file has been closed
+   };
+   typedef std::map<const char*, TFileMapping_t> FileMappings_t;
+   FileMappings_t  gFileMappings;
+   TVirtualMutex  *gFileMappingsMutex = 0;
+}
+
 ClassImp(TFile)
 
 //*-*x17 macros/layout_file
@@ -162,6 +180,8 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
    fReadCalls       = 0;
    fInfoCache       = 0;
    fOpenPhases      = 0;
+   fMapAddress      = 0;
+   fMapSize         = 0;
    fNoAnchorInName  = kFALSE;
    fIsRootFile      = kTRUE;
    fIsArchive       = kFALSE;
@@ -190,7 +210,8 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 
 //_____________________________________________________________________________
 TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t compress)
-           : TDirectoryFile(), fUrl(fname1,kTRUE), fInfoCache(0), fOpenPhases(0)
+           : TDirectoryFile(), fUrl(fname1,kTRUE), fInfoCache(0), fOpenPhases(0),
+             fMapAddress(0), fMapSize(0)
 {
    // Opens or creates a local ROOT file whose name is fname1. It is
    // recommended to specify fname1 as "<file>.root". The suffix ".root"
@@ -210,6 +231,9 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    //           = UPDATE          open an existing file for writing.
    //                             if no file exists, it is created.
    //           = READ            open an existing file for reading (default).
+   //           = MMAP            open an existing file for reading and map
+   //                             it in memory: the keys and the baskets are
+   //                             read from the mapping (see TFile::MapFile).
    //           = NET             used by derived remote file access
    //                             classes, not a user callable option
    //           = WEB             used by derived remote http access
@@ -380,6 +404,11 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    Bool_t recreate = (fOption == "RECREATE") ? kTRUE : kFALSE;
    Bool_t update   = (fOption == "UPDATE") ? kTRUE : kFALSE;
    Bool_t read     = (fOption == "READ") ? kTRUE : kFALSE;
+   Bool_t mapped   = (fOption == "MMAP") ? kTRUE : kFALSE;
+   if (mapped) {
+      read    = kTRUE;
+      fOption = "READ";
+   }
    if (!create && !recreate && !update && !read) {
       read    = kTRUE;
       fOption = "READ";
@@ -475,6 +504,7 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      if (mapped) MapFile();
    }
 
    Init(create);
@@ -492,7 +522,7 @@ zombie:
 }
 
 //______________________________________________________________________________
-TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0)
+TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0), fMapAddress(0), fMapSize(0)
 {
    // TFile objects can not be copied.
 
@@ -821,10 +851,16 @@ void TFile::Init(Bool_t create)
 
    // Count number of TProcessIDs in this file
    {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
+      if (fKeysPending) {
+         // the keys are not read yet: look up the TProcessIDs, which are
+         // named ProcessID0, ProcessID1, ..., through the keys index
+         while (GetKey(Form("ProcessID%d",fNProcessIDs))) fNProcessIDs++;
+      } else {
+         TIter next(fKeys);
+         TKey *key;
+         while ((key = (TKey*)next())) {
+            if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
+         }
       }
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
@@ -861,6 +897,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -893,6 +930,10 @@ void TFile::Close(Option_t *option)
    // TDirectoryFile, TDirectoryFile::Close will induce the proper cd.
    TDirectoryFile::Close();
 
+   // The mapping is kept until the baskets still borrowing from it (those
+   // of the trees detached from the file) are deleted.
+   UnmapFile();
+
    if (IsWritable()) {
       TFree *f1 = (TFree*)fFree->First();
       if (f1) {
@@ -1155,6 +1196,28 @@ TFileCacheWrite *TFile::GetCacheWrite() const
    return fCacheWrite;
 }
 
+//______________________________________________________________________________
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len, Bool_t borrow) const
+{
+   // Return the address of the len bytes at the offset pos in the file
+   // when the file has been opened with option MMAP, or 0 if the file is
+   // not mapped or the bytes are not in the mapping.
+   // The memory is read-only and is valid until the file is closed.
+   // If borrow is true, the memory stays valid after the file is closed,
+   // until it is given back with ReleaseMappedBuffer.
+
+   if (!fMapAddress || fWritable || pos < 0 || len < 0) return 0;
+   Long64_t offset = pos + fArchiveOffset;
+   if (offset + len > fMapSize) return 0;
+   if (borrow) {
+      R__LOCKGUARD2(gFileMappingsMutex);
+      FileMappings_t::iterator it = gFileMappings.find(fMapAddress);
+      if (it == gFileMappings.end()) return 0;
+      it->second.fNBorrowed++;
+   }
+   return fMapAddress + offset;
+}
+
 //______________________________________________________________________________
 Int_t TFile::GetRecordHeader(char *buf, Long64_t first, Int_t maxbytes, Int_t &nbytes, Int_t &objlen, Int_t &keylen)
 {
@@ -1447,6 +1510,48 @@ void TFile::Map()
    Printf("%d/%06d  At:%lld  N=%-8d  %-14s",date,time,idcur,1,"END");
 }
 
+//______________________________________________________________________________
+Bool_t TFile::MapFile()
+{
+   // Map the file in memory, read-only (option MMAP of the constructor).
+   // The keys are then copied from the mapping without any system call
+   // and TBasket::ReadBasketBuffers uses the baskets in place: the
+   // uncompressed baskets are not copied at all and the compressed ones
+   // are unzipped directly from the mapping. The pages are shared with
+   // all the processes reading the same file.
+   // Returns kFALSE if the file cannot be mapped, in which case it is
+   // read with the usual system calls.
+
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size = 0;
+   if (SysStat(fD, &id, &size, &flags, &modtime) || size <= 0 ||
+       (Long64_t)(size_t)size != size) {
+      Warning("MapFile", "cannot get the size of %s, the file is not mapped", GetName());
+      return kFALSE;
+   }
+   void *addr = mmap(0, (size_t)size, PROT_READ, MAP_SHARED, fD, 0);
+   if (addr == MAP_FAILED) {
+      Warning("MapFile", "cannot map %s (%s), the file is read without mapping",
+              GetName(), gSystem->GetError());
+      return kFALSE;
+   }
+   fMapAddress = (char*)addr;
+   fMapSize    = size;
+   {
+      R__LOCKGUARD2(gFileMappingsMutex);
+      TFileMapping_t &mapping = gFileMappings[fMapAddress];
+      mapping.fSize      = size;
+      mapping.fNBorrowed = 0;
+      mapping.fClosed    = kFALSE;
+   }
+   return kTRUE;
+#else
+   Warning("MapFile", "memory mapped files are not supported on this platform, %s is not mapped", GetName());
+   return kFALSE;
+#endif
+}
+
 //______________________________________________________________________________
 void TFile::Paint(Option_t *option)
 {
@@ -1487,6 +1592,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMapAddress && !fWritable && fOffset + len <= fMapSize)
+         return ReadBufferMapped(buf, len);
+
       Seek(pos);
       ssize_t siz;
 
@@ -1532,6 +1640,13 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (fMapAddress && !fWritable) {
+         if (fOffset + len <= fMapSize)
+            return ReadBufferMapped(buf, len);
+         // The reads from the mapping do not move the file cursor.
+         Seek(GetRelOffset());
+      }
+
       ssize_t siz;
       Double_t start = 0;
 
@@ -1564,6 +1679,32 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
    return kTRUE;
 }
 
+//______________________________________________________________________________
+Bool_t TFile::ReadBufferMapped(char *buf, Int_t len)
+{
+   // Copy len bytes at the current offset from the memory mapping of the
+   // file (see MapFile). The caller checks that they are in the mapping.
+   // Returns kTRUE in case of failure.
+
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+
+   memcpy(buf, fMapAddress + fOffset, len);
+   fOffset += len;
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+   return kFALSE;
+}
+
 //______________________________________________________________________________
 Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
@@ -1583,6 +1724,27 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   // Memory mapped files: copy the blocks from the mapping
+   if (fMapAddress && !fWritable) {
+      Int_t j;
+      for (j = 0; j < nbuf; j++) {
+         if (!GetMappedBuffer(pos[j], len[j])) break;
+      }
+      if (j == nbuf) {
+         Long64_t k = 0;
+         for (j = 0; j < nbuf; j++) {
+            SetOffset(pos[j]);
+            ReadBufferMapped(&buf[k], len[j]);
+            k += len[j];
+         }
+         return kFALSE;
+      }
+   }
+
+   // Local files: tell the kernel about all the reads at once (see AdviseReadBuffers)
+   if (nbuf > 1 && IsA() == TFile::Class() && GetAsyncVectorReads())
+      AdviseReadBuffers(pos, len, nbuf);
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1633,6 +1795,47 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+#if defined(R__LINUX) && !defined(R__WINGCC)
+//______________________________________________________________________________
+void TFile::AdviseReadBuffers(Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   // Tell the kernel that the nbuf blocks described in arrays pos and len
+   // are going to be read, so that it starts reading all of them at once
+   // in the page cache (posix_fadvise POSIX_FADV_WILLNEED) while
+   // ReadBuffers reads them one after the other. This keeps the device
+   // queue full, which matters for SSDs and network file systems, without
+   // any thread. The blocks are merged as in ReadBuffers according to the
+   // readahead size; nothing is done if they make a single read.
+
+   Long64_t begin = pos[0];
+   Long64_t end   = pos[0] + len[0];
+   Int_t nadvised = 0;
+   for (Int_t i = 1; i <= nbuf; ++i) {
+      if (i < nbuf && pos[i] >= pos[i-1] && pos[i] + len[i] - begin < fgReadaheadSize) {
+         end = TMath::Max(end, pos[i] + len[i]);
+         continue;
+      }
+      if (i == nbuf && nadvised == 0) return;
+#if defined(R__SEEK64)
+      posix_fadvise64(fD, begin + fArchiveOffset, end - begin, POSIX_FADV_WILLNEED);
+#else
+      posix_fadvise(fD, begin + fArchiveOffset, end - begin, POSIX_FADV_WILLNEED);
+#endif
+      ++nadvised;
+      if (i < nbuf) {
+         begin = pos[i];
+         end   = pos[i] + len[i];
+      }
+   }
+}
+#else
+//______________________________________________________________________________
+void TFile::AdviseReadBuffers(Long64_t *, Int_t *, Int_t)
+{
+   // Not supported on this platform, the blocks are read without advice.
+}
+#endif
+
 //______________________________________________________________________________
 Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
 {
@@ -2143,6 +2346,46 @@ void TFile::SumBuffer(Int_t bufsize)
    fSum2Buffer += bufsize*bufsize;
 }
 
+//_______________________________________________________________________
+void TFile::ReleaseMappedBuffer(const char *buffer)
+{
+   // Give back a buffer borrowed with GetMappedBuffer(pos, len, kTRUE).
+   // The mapping of a closed file is removed with its last buffer.
+
+   R__LOCKGUARD2(gFileMappingsMutex);
+   FileMappings_t::iterator it = gFileMappings.upper_bound(buffer);
+   if (it == gFileMappings.begin()) return;
+   --it;
+   if (buffer >= it->first + it->second.fSize) return;
+   if (--it->second.fNBorrowed > 0 || !it->second.fClosed) return;
+#ifndef WIN32
+   munmap((void*)it->first, (size_t)it->second.fSize);
+#endif
+   gFileMappings.erase(it);
+}
+
+//_______________________________________________________________________
+void TFile::UnmapFile()
+{
+   // Remove the memory mapping of the file, if any. The removal is
+   // deferred while buffers borrowed from it are still in use.
+
+#ifndef WIN32
+   if (fMapAddress) {
+      R__LOCKGUARD2(gFileMappingsMutex);
+      FileMappings_t::iterator it = gFileMappings.find(fMapAddress);
+      if (it != gFileMappings.end() && it->second.fNBorrowed > 0) {
+         it->second.fClosed = kTRUE;
+      } else {
+         munmap(fMapAddress, (size_t)fMapSize);
+         if (it != gFileMappings.end()) gFileMappings.erase(it);
+      }
+   }
+#endif
+   fMapAddress = 0;
+   fMapSize    = 0;
+}
+
 //_______________________________________________________________________
 void TFile::UseCache(Int_t /*maxCacheSize*/, Int_t /*pageSize*/)
 {
@@ -4223,6 +4466,31 @@ Int_t TFile::GetReadaheadSize()
 //______________________________________________________________________________
 void TFile::SetReadaheadSize(Int_t bytes) { fgReadaheadSize = bytes; }
 
+//______________________________________________________________________________
+Bool_t TFile::GetAsyncVectorReads()
+{
+   // Static function returning true if ReadBuffers tells the kernel about
+   // all the reads of the local files at once (see AdviseReadBuffers). The
+   // default is given by the rootrc variable TFile.AsyncVectorReads
+   // (default 1), read at the first call.
+
+   R__LOCKGUARD2(gROOTMutex);
+   if (fgAsyncVectorReads < 0) {
+      fgAsyncVectorReads = gEnv->GetValue("TFile.AsyncVectorReads", 1) ? 1 : 0;
+   }
+   return fgAsyncVectorReads > 0;
+}
+
+//______________________________________________________________________________
+void TFile::SetAsyncVectorReads(Bool_t async)
+{
+   // Static function setting whether ReadBuffers tells the kernel about all
+   // the reads of the local files at once (see AdviseReadBuffers).
+
+   R__LOCKGUARD2(gROOTMutex);
+   fgAsyncVectorReads = async ? 1 : 0;
+}
+
 //______________________________________________________________________________
 void TFile::SetFileBytesRead(Long64_t bytes) { fgBytesRead = bytes; }
 
@@ -4481,7 +4749,8 @@ TFile::EFileType TFile::GetType(const char *name, Option_t *option, TString *pre
             // If option "READ" test existence and access
             TString opt = option;
             Bool_t read = (opt.IsNull() ||
-                          !opt.CompareTo("READ", TString::kIgnoreCase)) ? kTRUE : kFALSE;
+                          !opt.CompareTo("READ", TString::kIgnoreCase) ||
+                          !opt.CompareTo("MMAP", TString::kIgnoreCase)) ? kTRUE : kFALSE;
             if (read) {
                char *fn;
                if ((fn = gSystem->ExpandPathName(TUrl(lfname).GetFile()))) {
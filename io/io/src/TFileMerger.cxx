@@ -22,6 +22,14 @@
 // The merging interface allows files containing histograms and trees   //
 // to be merged, like the standalone hadd program.                      //
 //                                                                      //
+// With SetNProcesses(n), the input files are split in n subsets of     //
+// consecutive files, each merged by its own process into a temporary   //
+// file; these are then merged, in order, in the output file. The       //
+// subsets are merged by forked copies of the process, because merging  //
+// (TH1::Merge, TTree::CloneTree, the TClass lookups, the lists of      //
+// gROOT, ...) is not thread safe. The output does not depend on the    //
+// order in which the processes finish.                                 //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TFileMerger.h"
@@ -40,6 +48,9 @@
 #include "TClassRef.h"
 #include "TROOT.h"
 #include "TMemFile.h"
+#include "TMath.h"
+
+#include <vector>
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -48,6 +59,12 @@
 // For getrlimit
 #include <sys/time.h>
 #include <sys/resource.h>
+// For fork and waitpid
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <stdio.h>
 #endif
 
 ClassImp(TFileMerger)
@@ -57,6 +74,7 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+
 //______________________________________________________________________________
 static Int_t R__GetSystemMaxOpenedFiles()
 {
@@ -87,7 +105,7 @@ static Int_t R__GetSystemMaxOpenedFiles()
 TFileMerger::TFileMerger(Bool_t isLocal, Bool_t histoOneGo)
             : fOutputFile(0), fFastMethod(kTRUE), fNoTrees(kFALSE), fExplicitCompLevel(kFALSE), fCompressionChange(kFALSE),
               fPrintLevel(0), fMsgPrefix("TFileMerger"), fMaxOpenedFiles( R__GetSystemMaxOpenedFiles() ),
-              fLocal(isLocal), fHistoOneGo(histoOneGo), fObjectNames()
+              fLocal(isLocal), fHistoOneGo(histoOneGo), fObjectNames(), fNProcesses(1)
 {
    // Create file merger object.
 
@@ -749,6 +767,160 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
    return status;
 }
 
+//______________________________________________________________________________
+Bool_t TFileMerger::MergeSubset(const char *output, const std::vector<TString> &inputs,
+                                Int_t first, Int_t end, Int_t type, Int_t isubset)
+{
+   // Merge the input files [first,end) into the temporary file output with
+   // a new TFileMerger. Called in the processes forked by MergeSubsets, or
+   // in the calling process for the first subset.
+
+   TFileMerger merger(kFALSE, fHistoOneGo);
+   merger.SetMsgPrefix(TString::Format("%s[%d]", fMsgPrefix.Data(), isubset));
+   merger.SetPrintLevel(fPrintLevel);
+   merger.SetFastMethod(fFastMethod);
+   merger.SetNotrees(fNoTrees);
+   merger.SetMaxOpenedFiles(fMaxOpenedFiles / fNProcesses);
+   merger.fObjectNames = fObjectNames;
+   // The temporary files have the compression of the output file, so that
+   // their trees can be fast cloned in it.
+   if (!merger.OutputFile(output, "RECREATE", fOutputFile->GetCompressionSettings())) {
+      return kFALSE;
+   }
+   Bool_t status = kTRUE;
+   for (Int_t i = first; status && i < end; ++i) {
+      status = merger.AddFile(inputs[i], kFALSE);
+   }
+   if (status) {
+      status = merger.PartialMerge(type & ~kIncremental);
+   }
+   return status;
+}
+
+#ifndef WIN32
+//______________________________________________________________________________
+Bool_t TFileMerger::MergeSubsets(Int_t type, TList &partials)
+{
+   // Split the input files in fNProcesses subsets of consecutive files and
+   // merge each subset, in its own process, into a temporary file. The
+   // subsets are merged by forked copies of the calling process, which
+   // merges the first subset itself: the merging of the objects is not
+   // thread safe, and the processes share nothing but the files. The input
+   // files are then replaced in fFileList by the temporary files, in the
+   // order of the subsets, so that the output is the same whatever the
+   // order in which the processes finish. A subset whose process cannot be
+   // forked is merged by the calling process.
+   // The names of the temporary files are added to partials; the caller
+   // removes them once they are merged.
+   // Nothing is done if there are less than two files per subset or if an
+   // input file cannot be reopened by name (TMemFile).
+   // Returns kFALSE in case of error.
+
+   std::vector<TString> inputs;
+   TIter next(fFileList);
+   TFile *file;
+   while ((file = (TFile*)next())) {
+      if (file->InheritsFrom(TMemFile::Class())) return kTRUE;
+      inputs.push_back(file->GetName());
+   }
+   Int_t nopened = inputs.size();
+   TIter nextexcess(fExcessFiles);
+   TObjString *url;
+   while ((url = (TObjString*)nextexcess())) {
+      inputs.push_back(url->GetName());
+   }
+   Int_t nsubsets = TMath::Min(fNProcesses, (Int_t)inputs.size() / 2);
+   if (nsubsets < 2) return kTRUE;
+
+   if (fPrintLevel > 0) {
+      Printf("%s Merging %d files in %d subsets with %d processes",
+             fMsgPrefix.Data(), (Int_t)inputs.size(), nsubsets, nsubsets);
+   }
+
+   // The input files are opened again by the subset mergers.
+   next.Reset();
+   while ((file = (TFile*)next())) {
+      if (file->TestBit(kCanDelete)) file->Close();
+   }
+   fFileList->Clear();
+
+   std::vector<TString> outputs(nsubsets);
+   std::vector<Int_t> first(nsubsets + 1);
+   for (Int_t i = 0; i < nsubsets; ++i) {
+      TUUID uuid;
+      outputs[i].Form("%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
+      partials.Add(new TObjString(outputs[i]));
+      first[i] = (Int_t)((Long64_t)inputs.size() * i / nsubsets);
+   }
+   first[nsubsets] = inputs.size();
+
+   // Flush the output buffers, which would otherwise be written by each process
+   std::cout.flush();
+   fflush(stdout);
+
+   std::vector<pid_t> pids(nsubsets, 0);
+   for (Int_t i = 1; i < nsubsets; ++i) {
+      pid_t child = fork();
+      if (child == 0) {
+         Bool_t ok = MergeSubset(outputs[i], inputs, first[i], first[i+1], type, i);
+         std::cout.flush();
+         fflush(stdout);
+         _exit(ok ? 0 : 1);
+      }
+      if (child < 0) {
+         SysError("MergeSubsets", "cannot fork the merge of the files %d to %d, merging them in this process",
+                  first[i], first[i+1] - 1);
+         continue;
+      }
+      pids[i] = child;
+   }
+
+   Bool_t status = kTRUE;
+   for (Int_t i = 0; i < nsubsets; ++i) {
+      Bool_t ok = kFALSE;
+      if (pids[i] > 0) {
+         int wstatus = 0;
+         while (waitpid(pids[i], &wstatus, 0) < 0 && errno == EINTR) {}
+         ok = WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0;
+      } else {
+         ok = MergeSubset(outputs[i], inputs, first[i], first[i+1], type, i);
+      }
+      if (!ok) {
+         Error("MergeSubsets", "error during the merge of the files %d to %d",
+               first[i], first[i+1] - 1);
+         status = kFALSE;
+      }
+   }
+
+   // Remove the local copies of the input files.
+   if (fLocal) {
+      for (Int_t i = 0; i < nopened; ++i) gSystem->Unlink(inputs[i]);
+   }
+   fExcessFiles->Clear();
+   if (!status) return kFALSE;
+
+   for (Int_t i = 0; i < nsubsets; ++i) {
+      TFile *newfile = TFile::Open(outputs[i], "READ");
+      if (!newfile || newfile->IsZombie()) {
+         Error("MergeSubsets", "cannot open the temporary file %s", outputs[i].Data());
+         delete newfile;
+         return kFALSE;
+      }
+      newfile->SetBit(kCanDelete);
+      fFileList->Add(newfile);
+   }
+   return kTRUE;
+}
+#else
+//______________________________________________________________________________
+Bool_t TFileMerger::MergeSubsets(Int_t, TList &)
+{
+   // No fork on Windows: the input files are merged by this process.
+
+   return kTRUE;
+}
+#endif
+
 //______________________________________________________________________________
 Bool_t TFileMerger::PartialMerge(Int_t in_type)
 {
@@ -813,6 +985,15 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
    
    Bool_t result = kTRUE;
    Int_t type = in_type;
+
+   // Merge subsets of the input files in parallel, the temporary files
+   // holding their results replace the input files.
+   TList partials;
+   partials.SetOwner(kTRUE);
+   if (fNProcesses > 1) {
+      result = MergeSubsets(in_type, partials);
+   }
+
    while (result && fFileList->GetEntries()>0) {
       result = MergeRecursive(fOutputFile, fFileList, type);
       
@@ -840,6 +1021,11 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
          OpenExcessFiles();         
       }
    }
+   TIter nextpartial(&partials);
+   TObject *partial;
+   while ((partial = nextpartial())) {
+      gSystem->Unlink(partial->GetName());
+   }
    if (!result) {
       Error("Merge", "error during merge of your ROOT files");
    } else {
@@ -937,6 +1123,19 @@ void TFileMerger::SetMaxOpenedFiles(Int_t newmax)
    }
 }
 
+//______________________________________________________________________________
+void TFileMerger::SetNProcesses(Int_t nprocesses)
+{
+   // Set the number of processes used by Merge and PartialMerge. If it is
+   // larger than one, subsets of the input files are merged in parallel by
+   // forked copies of the process into temporary files, which are then
+   // merged in the output file (see MergeSubsets). The temporary files are
+   // written in the directory returned by gSystem->TempDirectory().
+   // Not supported on Windows, where the files are merged by one process.
+
+   fNProcesses = nprocesses < 1 ? 1 : nprocesses;
+}
+
 //______________________________________________________________________________
 void TFileMerger::SetMsgPrefix(const char *prefix)
 {
@@ -74,6 +74,7 @@
 
 TStreamerElement *TStreamerInfo::fgElement = 0;
 Int_t   TStreamerInfo::fgCount = 0;
+Bool_t  TStreamerInfo::fgUseSpecialized = kTRUE;
 
 const Int_t kMaxLen = 1024;
 
@@ -142,6 +143,10 @@ TStreamerInfo::TStreamerInfo()
    fReadMemberWise = 0;
    fWriteObjectWise = 0;
    fWriteMemberWise = 0;
+
+   fSpecializedFunc = 0;
+   fSpecializedOffsets = 0;
+   fNspecializedBases = 0;
 }
 
 //______________________________________________________________________________
@@ -175,6 +180,10 @@ TStreamerInfo::TStreamerInfo(TClass *cl)
    fReadMemberWise = 0;
    fWriteObjectWise = 0;
    fWriteMemberWise = 0;
+
+   fSpecializedFunc = 0;
+   fSpecializedOffsets = 0;
+   fNspecializedBases = 0;
 }
 
 //______________________________________________________________________________
@@ -190,6 +199,7 @@ TStreamerInfo::~TStreamerInfo()
    delete [] fMethod;  fMethod =0;
    delete [] fComp;    fComp   =0;
    delete [] fVirtualInfoLoc; fVirtualInfoLoc =0;
+   delete [] fSpecializedOffsets; fSpecializedOffsets =0;
 
    delete fReadObjectWise;
    delete fReadMemberWise;
@@ -2073,6 +2083,9 @@ void TStreamerInfo::Clear(Option_t *option)
       delete [] fElem;     fElem    = 0;
       delete [] fMethod;   fMethod  = 0;
       delete [] fComp;     fComp    = 0;
+      delete [] fSpecializedOffsets; fSpecializedOffsets = 0;
+      fSpecializedFunc = 0;
+      fNspecializedBases = 0;
       fNdata = 0;
       fSize = 0;
       ResetBit(kIsCompiled);
@@ -2260,6 +2273,16 @@ TObject *TStreamerInfo::Clone(const char *newname) const
    return newinfo;
 }
 
+//______________________________________________________________________________
+Bool_t TStreamerInfo::CanUseSpecialized()
+{
+   // static function returning true if the streamers generated by rootcling
+   // for the layout of the classes (LinkDef option 'specialized') are used
+   // instead of the StreamerInfo actions.
+
+   return fgUseSpecialized;
+}
+
 //______________________________________________________________________________
 Bool_t TStreamerInfo::CompareContent(TClass *cl, TVirtualStreamerInfo *info, Bool_t warn, Bool_t complete)
 {
@@ -4335,6 +4358,30 @@ void TStreamerInfo::Streamer(TBuffer &R__b)
    }
 }
 
+//______________________________________________________________________________
+void TStreamerInfo::StreamSpecialized(TBuffer &b, char *pointer)
+{
+   // Stream the object at pointer with the streamer generated by rootcling for
+   // the layout of the class: the base classes are streamed by their elements,
+   // as the actions do (TObject::Streamer and TNamed::Streamer for the TObject
+   // and TNamed bases), then the data members of the class by the generated function.
+   // Must only be called when GetSpecializedStreamerFunc() is not null.
+
+   for (Int_t i = 0; i < fNspecializedBases; ++i) {
+      TStreamerBase *element = (TStreamerBase*)fElements->UncheckedAt(i);
+      switch (element->GetType()) {
+         case kTObject: ((TObject*)(pointer+element->GetOffset()))->TObject::Streamer(b); break;
+         case kTNamed:  ((TNamed*)(pointer+element->GetOffset()))->TNamed::Streamer(b); break;
+         case kBase:
+            if (b.IsReading()) element->ReadBuffer(b,pointer);
+            else element->WriteBuffer(b,pointer);
+            break;
+         default: break; // TObject base ignored (TClass::IgnoreTObjectStreamer)
+      }
+   }
+   fSpecializedFunc(b,pointer,fSpecializedOffsets);
+}
+
 //______________________________________________________________________________
 void TStreamerInfo::TagFile(TFile *file)
 {
@@ -4584,6 +4631,17 @@ void TStreamerInfo::PrintValueAux(char *ladd, Int_t atype, TStreamerElement *aEl
    }
 }
 
+//______________________________________________________________________________
+void TStreamerInfo::UseSpecialized(Bool_t use)
+{
+   // static function: use (default) or not the streamers generated by rootcling
+   // for the layout of the classes selected with the LinkDef option 'specialized'
+   // When not used, the objects of these classes are streamed by the StreamerInfo
+   // actions, which produce the same buffers.
+
+   fgUseSpecialized = use;
+}
+
 //______________________________________________________________________________
 void TStreamerInfo::Update(const TClass *oldcl, TClass *newcl)
 {
@@ -23,6 +23,8 @@
 #include "TClassEdit.h"
 #include "TVirtualCollectionIterators.h"
 #include "TProcessID.h"
+#include "TClass.h"
+#include "TSchemaRuleSet.h"
 
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
@@ -2287,6 +2289,10 @@ void TStreamerInfo::Compile()
    fMethod = 0;
    delete[] fComp;
    fComp = 0;
+   delete[] fSpecializedOffsets;
+   fSpecializedOffsets = 0;
+   fSpecializedFunc = 0;
+   fNspecializedBases = 0;
 
    if (fReadObjectWise) {
       fReadObjectWise->fActions.clear();
@@ -2467,11 +2473,65 @@ void TStreamerInfo::Compile()
 
    fOptimized = isOptimized;
 
+   CompileSpecialized();
+
    if (gDebug > 0) {
       ls();
    }
 }
 
+//______________________________________________________________________________
+void TStreamerInfo::CompileSpecialized()
+{
+   // Enable the streamer generated by rootcling for the layout of the class
+   // (LinkDef option 'specialized') if this StreamerInfo describes exactly that
+   // layout: same version and checksum as the class, no schema evolution rules,
+   // the base classes followed by the data members known to the generated
+   // function, in the same order and without type conversion. Otherwise the
+   // actions of the StreamerInfo are used.
+
+   if (!fClass || !fClass->GetSpecializedStreamerFunc() || fClass->TestBit(TClass::kIsEmulation)) return;
+   if (fClassVersion != fClass->GetClassVersion() || fCheckSum != fClass->GetCheckSum()) return;
+   const ROOT::TSchemaRuleSet *rules = fClass->GetSchemaRules();
+   if (rules && rules->GetRules() && rules->GetRules()->GetEntriesFast()) return;
+
+   Int_t ndata = fElements->GetEntriesFast();
+   Int_t nbases = 0;
+   while (nbases < ndata && ((TStreamerElement*)fElements->UncheckedAt(nbases))->IsBase()) {
+      // the bases are streamed by StreamSpecialized as by the actions
+      TStreamerElement *base = (TStreamerElement*)fElements->UncheckedAt(nbases);
+      Int_t type = base->GetType();
+      if (base->IsA() != TStreamerBase::Class()) return;
+      if (type != kBase && type != kTObject && type != kTNamed && type >= 0) return;
+      ++nbases;
+   }
+   const char **members = fClass->GetSpecializedMembers();
+   Int_t nmembers = 0;
+   while (members[nmembers]) ++nmembers;
+   if (ndata - nbases != nmembers) return;
+
+   Long_t *offsets = new Long_t[nmembers+1];
+   for (Int_t i = 0; i < nmembers; ++i) {
+      TStreamerElement *element = (TStreamerElement*)fElements->UncheckedAt(nbases+i);
+      Int_t type = element->GetType();
+      Bool_t supported = (type > 0 && type < kOffsetL) || (type > kOffsetL && type < kOffsetP) || type == kTString;
+      Int_t basic = type % kOffsetL;
+      if (type != kTString && (basic == kCharStar || basic == kBits || basic == kFloat16 || basic == kDouble32)) {
+         supported = kFALSE;
+      }
+      if (!supported || element->GetNewType() != type || element->GetOffset() == kMissing
+          || strcmp(element->GetName(), members[i]) != 0) {
+         delete [] offsets;
+         return;
+      }
+      offsets[i] = element->GetOffset();
+   }
+   offsets[nmembers] = 0;
+   fSpecializedOffsets = offsets;
+   fNspecializedBases = nbases;
+   fSpecializedFunc = fClass->GetSpecializedStreamerFunc();
+}
+
 template <typename From> 
 static void AddReadConvertAction(TStreamerInfoActions::TActionSequence *sequence, Int_t newtype, TConfiguration *conf)
 {
@@ -32,6 +32,13 @@
   the Trees with
        hadd -T targetfile source1 source2 ...
 
+  The merge can be done by several processes with
+       hadd -j 8 targetfile source1 source2 ...
+  (or -j8) the source files are then split in 8 subsets of consecutive
+  files, merged in parallel in temporary files which are finally merged
+  in the target file (see TFileMerger::SetNProcesses). With -j 0, one
+  process per core is used.
+
   Wildcarding and indirect files are also supported
     hadd result.root  myfil*.root
    will merge all files in myfil*.root
@@ -77,7 +84,7 @@ int main( int argc, char **argv )
 {
 
    if ( argc < 3 || "-h" == std::string(argv[1]) || "--help" == std::string(argv[1]) ) {
-      std::cout << "Usage: " << argv[0] << " [-f[0-9]] [-k] [-T] [-O] [-n maxopenedfiles] [-v verbosity] targetfile source1 [source2 source3 ...]" << std::endl;
+      std::cout << "Usage: " << argv[0] << " [-f[0-9]] [-k] [-T] [-O] [-n maxopenedfiles] [-j nprocesses] [-v verbosity] targetfile source1 [source2 source3 ...]" << std::endl;
       std::cout << "This program will add histograms from a list of root files and write them" << std::endl;
       std::cout << "to a target root file. The target file is newly created and must not " << std::endl;
       std::cout << "exist, or if -f (\"force\") is given, must not be one of the source files." << std::endl;
@@ -87,6 +94,8 @@ int main( int argc, char **argv )
       std::cout << "If the option -O is used, when merging TTree, the basket size is re-optimized" <<std::endl;
       std::cout << "If the option -v is used, explicitly set the verbosity level; 0 request no output, 99 is the default" <<std::endl;
       std::cout << "If the option -n is used, hadd will open at most 'maxopenedfiles' at once, use 0 to request to use the system maximum." << std::endl;
+      std::cout << "If the option -j is used, subsets of the source files are merged in parallel by 'nprocesses' processes (0: one per core)" << std::endl;
+      std::cout << " and the results are then merged in the target file." << std::endl;
       std::cout << "When -the -f option is specified, one can also specify the compression" <<std::endl;
       std::cout << "level of the target file. By default the compression level is 1, but" <<std::endl;
       std::cout << "if \"-f0\" is specified, the target file will not be compressed." <<std::endl;
@@ -101,6 +110,7 @@ int main( int argc, char **argv )
    Bool_t reoptimize = kFALSE;
    Bool_t noTrees = kFALSE;
    Int_t maxopenedfiles = 0;
+   Int_t nprocesses = 1;
    Int_t verbosity = 99;
 
    int outputPlace = 0;
@@ -133,6 +143,30 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strncmp(argv[a],"-j",2) == 0 ) {
+         // The number of processes follows, either in the same argument (-j8) or in the next one (-j 8).
+         const char *count = argv[a]+2;
+         if (*count == '\0') {
+            if (a+1 < argc) {
+               count = argv[a+1];
+               ++a;
+               ++ffirst;
+            } else {
+               count = 0;
+            }
+         }
+         char *end = 0;
+         Long_t request = count ? strtol(count, &end, 10) : -1;
+         if (count && end != count && *end == '\0' && request >= 0 && request < kMaxInt) {
+            nprocesses = (Int_t)request;
+            if (nprocesses == 0) {
+               SysInfo_t info;
+               nprocesses = (gSystem->GetSysInfo(&info) == 0 && info.fCpus > 0) ? info.fCpus : 1;
+            }
+         } else {
+            std::cerr << "Error: could not parse the number of processes passed with -j" << (count ? std::string(": ") + count : std::string()) << ". The files will be merged by one process.\n";
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 >= argc) {
             std::cerr << "Error: no verbosity level was provided after -v.\n";
@@ -187,6 +221,9 @@ int main( int argc, char **argv )
    if (maxopenedfiles > 0) {
       merger.SetMaxOpenedFiles(maxopenedfiles);
    }
+   if (nprocesses > 1) {
+      merger.SetNProcesses(nprocesses);
+   }
    if (!merger.OutputFile(targetname,force,newcomp) ) {
       std::cerr << "hadd error opening target file (does " << argv[ffirst-1] << " exist?)." << std::endl;
       std::cerr << "Pass \"-f\" argument to force re-creation of output file." << std::endl;
@@ -117,7 +117,8 @@ include/Fit/%.h: $(MATHCOREDIRI)/Fit/%.h
 include/%.h:    $(MATHCOREDIRI)/%.h
 		cp $< $@
 
-$(MATHCORELIB): $(MATHCOREO) $(MATHCOREDO) $(ORDER_) $(MAINLIBS)
+$(MATHCORELIB): $(MATHCOREO) $(MATHCOREDO) $(ORDER_) $(MAINLIBS) \
+                $(MATHCORELIBDEP)
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)"  \
 		   "$(SOFLAGS)" libMathCore.$(SOEXT) $@     \
 		   "$(MATHCOREO) $(MATHCOREDO)" \
@@ -31,13 +31,6 @@
 #include "Fit/FitUtil.h"
 #endif
 
-//#define ROOT_FIT_PARALLEL
-
-#ifdef ROOT_FIT_PARALLEL
-#ifndef ROOT_Fit_FitUtilParallel
-#include "Fit/FitUtilParallel.h"
-#endif
-#endif
 
 /** 
 @defgroup FitMethodFunc Fit Method Classes 
@@ -82,7 +75,9 @@ public:
       fData(data), 
       fFunc(func), 
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func.NPar() ) )
+      fGrad ( std::vector<double> ( func.NPar() ) ),
+      fExecutionPolicy(kSerial), 
+      fNThreads(0)
    { }
 
    /** 
@@ -111,6 +106,7 @@ public:
    virtual BaseFunction * Clone() const { 
       // clone the function
       Chi2FCN * fcn =  new Chi2FCN(fData,fFunc); 
+      fcn->SetExecutionPolicy(fExecutionPolicy, fNThreads); 
       return fcn; 
    }
  
@@ -132,7 +128,7 @@ public:
    // need to be virtual to be instantiated
    virtual void Gradient(const double *x, double *g) const { 
       // evaluate the chi2 gradient
-      FitUtil::EvaluateChi2Gradient(fFunc, fData, x, g, fNEffPoints);
+      FitUtil::EvaluateChi2Gradient(fFunc, fData, x, g, fNEffPoints, fExecutionPolicy, fNThreads);
    }
 
    /// get type of fit method function
@@ -144,6 +140,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// set the execution policy (and the number of threads) used to evaluate the function and its gradient
+   void SetExecutionPolicy(ExecutionPolicy policy, unsigned int nThreads = 0) { 
+      fExecutionPolicy = policy; 
+      fNThreads = nThreads; 
+   }
+
 
 
 protected: 
@@ -159,14 +161,10 @@ private:
     */
    virtual double DoEval (const double * x) const { 
       this->UpdateNCalls();
-#ifdef ROOT_FIT_PARALLEL
-      return FitUtilParallel::EvaluateChi2(fFunc, fData, x, fNEffPoints); 
-#else 
       if (!fData.HaveCoordErrors() ) 
-         return FitUtil::EvaluateChi2(fFunc, fData, x, fNEffPoints); 
+         return FitUtil::EvaluateChi2(fFunc, fData, x, fNEffPoints, fExecutionPolicy, fNThreads); 
       else 
          return FitUtil::EvaluateChi2Effective(fFunc, fData, x, fNEffPoints); 
-#endif
    } 
 
    // for derivatives 
@@ -182,6 +180,9 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
 
+   ExecutionPolicy fExecutionPolicy;  // serial or multithreaded evaluation over the data points
+   unsigned int fNThreads;            // number of threads of the multithreaded evaluation (0 = one per core)
+
 
 }; 
 
@@ -26,6 +26,10 @@
 #include "Math/IParamFunctionfwd.h"
 #endif
 
+#ifndef ROOT_Fit_FitUtilParallel
+#include "Fit/FitUtilParallel.h"
+#endif
+
 
 #include <vector>
 
@@ -182,6 +186,12 @@ public:
    ///Apply Weight correction for error matrix computation
    bool UseWeightCorrection() const { return fWeightCorr; }
 
+   /// policy used to evaluate the objective function (chi2 or likelihood) on the data points
+   ExecutionPolicy GetExecutionPolicy() const { return fExecutionPolicy; }
+
+   /// number of threads used with the kMultithread policy (0 means one thread per core)
+   unsigned int NThreads() const { return fNThreads; }
+
 
    /// return vector of parameter indeces for which the Minos Error will be computed
    const std::vector<unsigned int> & MinosParams() const { return fMinosParams; }
@@ -211,6 +221,17 @@ public:
    ///Update configuration after a fit using the FitResult
    void SetUpdateAfterFit(bool on = true) { fUpdateAfterFit = on; } 
 
+   /**
+      set the policy used to evaluate the objective function and its gradient on the data points.
+      With kMultithread the data are divided in chunks evaluated by nThreads threads 
+      (one per core if nThreads is zero) and the result does not depend on the number of threads.
+      The model function must support concurrent evaluations (see ROOT::Fit::ExecutionPolicy)
+   */
+   void SetExecutionPolicy(ExecutionPolicy policy, unsigned int nThreads = 0) { 
+      fExecutionPolicy = policy; 
+      fNThreads = nThreads; 
+   }
+
 
    /**
       static function to control default minimizer type and algorithm
@@ -230,6 +251,8 @@ private:
    bool fMinosErrors;      // do full error analysis using Minos
    bool fUpdateAfterFit;   // update the configuration after a fit using the result
    bool fWeightCorr;       // apply correction to errors for weights fits 
+   ExecutionPolicy fExecutionPolicy;  // serial or multithreaded evaluation of the objective function
+   unsigned int fNThreads;            // number of threads for the multithreaded evaluation (0 = one per core)
 
    std::vector<ROOT::Fit::ParameterSettings> fSettings;  // vector with the parameter settings
    std::vector<unsigned int> fMinosParams;               // vector with the parameter indeces for running Minos
@@ -21,6 +21,10 @@
 #include "Fit/DataVectorfwd.h"
 #endif
 
+#ifndef ROOT_Fit_FitUtilParallel
+#include "Fit/FitUtilParallel.h"
+#endif
+
 
 namespace ROOT { 
 
@@ -33,6 +37,10 @@ namespace ROOT {
    namespace defining utility free functions using in Fit for evaluating the various fit method 
    functions (chi2, likelihood, etc..)  given the data and the model function 
 
+   The chi2, the likelihoods and their gradients can be evaluated by several threads 
+   with the execution policy kMultithread (see ROOT::Fit::ExecutionPolicy); 
+   nThreads = 0 means one thread per core. 
+
    @ingroup FitMain
 */ 
 namespace FitUtil {
@@ -46,7 +54,8 @@ namespace FitUtil {
        evaluate the Chi2 given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the Chi2 evaluation
    */ 
-   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);  
+   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints, 
+                       ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    /** 
        evaluate the effective Chi2 given a model function and the data at the point x. 
@@ -59,38 +68,37 @@ namespace FitUtil {
        evaluate the Chi2 gradient given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the Chi2 evaluation
    */ 
-   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);  
+   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints, 
+                             ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    /** 
        evaluate the LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);  
+   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, 
+                       ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    /** 
        evaluate the LogL gradient given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints);  
+   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints, 
+                             ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    /** 
        evaluate the Poisson LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
        By default is extended, pass extedend to false if want to be not extended (MultiNomial)
    */ 
-   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);  
+   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, 
+                              ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    /** 
        evaluate the Poisson LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);  
-
-//    /** 
-//        Parallel evaluate the Chi2 given a model function and the data at the point x. 
-//        return also nPoints as the effective number of used points in the Chi2 evaluation
-//    */ 
-//    double ParallelEvalChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);  
+   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, 
+                                    ExecutionPolicy executionPolicy = kSerial, unsigned int nThreads = 0);  
 
    // methods required by dedicate minimizer like Fumili 
  
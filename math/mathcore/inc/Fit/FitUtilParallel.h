@@ -8,65 +8,79 @@
  *                                                                    *
  **********************************************************************/
 
-// Header file for class FitUtil
-
-
-#ifdef _WIN32  // no support for parallel fits on Win32 
-#ifdef ROOT_FIT_PARALLEL
-#undef ROOT_FIT_PARALLEL
-#endif
-#endif
-
-#ifdef ROOT_FIT_PARALLEL
+// Header file for the parallel evaluation of the fit method functions
 
 #ifndef ROOT_Fit_FitUtilParallel
 #define ROOT_Fit_FitUtilParallel
 
-#ifndef ROOT_Math_IParamFunctionfwd
-#include "Math/IParamFunctionfwd.h"
-#endif
-
-#ifndef ROOT_Fit_DataVectorfwd
-#include "Fit/DataVectorfwd.h"
-#endif
 
+namespace ROOT {
 
-namespace ROOT { 
+   namespace Fit {
 
-   namespace Fit { 
+   /**
+      policy used to evaluate the fit method functions (chi2, likelihoods and their gradients)
+      on the data points:
+      - kSerial : all the points are evaluated in sequence by the calling thread (default)
+      - kMultithread : the points are divided in chunks of fixed size (FitUtilParallel::kChunkSize) which
+        are evaluated by a pool of threads. The sums of the chunks are added in the order of the chunks,
+        so that the result does not depend on the number of threads.
+        The model function must then support concurrent calls of operator()(x,p) (and of ParameterGradient
+        for the gradients). This is not the case of interpreted functions.
 
+      @ingroup FitMain
+   */
+   enum ExecutionPolicy {
+      kSerial,
+      kMultithread
+   };
 
-   typedef  ROOT::Math::IParamMultiFunction IModelFunction;
-   
 
-/** 
-   namespace defining free functions for Fitting parallel mode 
-
-   Status: functions are not not completed and are still preliminary
+/**
+   namespace defining the free functions used for the parallel evaluation of the
+   fit method functions (see ROOT::Fit::FitUtil)
 
    @ingroup FitMain
-*/ 
+*/
 namespace FitUtilParallel {
 
+   /// number of data points of the chunks evaluated in parallel
+   const unsigned int kChunkSize = 1024;
+
+   /**
+      interface of the computations made by ROOT::Fit::FitUtilParallel::Evaluate:
+      a set of sums over the data points, computed by chunks of points
+   */
+   class ChunkTask {
+
+   public:
+
+      virtual ~ChunkTask() {}
 
+      /// number of sums computed by the task
+      virtual unsigned int NSums() const = 0;
 
-   /** 
-       evaluate the Chi2 given a model function and the data at the point x. 
-       return also nPoints as the effective number of used points in the Chi2 evaluation
-       Use a parallel evaluation spawning multiple threads 
-   */ 
-   double EvaluateChi2(IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);  
+      /// add to sums the contributions of the points [begin, end).
+      /// Must support concurrent calls on different chunks
+      virtual void Evaluate(unsigned int begin, unsigned int end, double * sums) const = 0;
 
+   };
 
-   double EvaluateLogL(IModelFunction & func, const UnBinData & data, const double * p, unsigned int &nPoints);  
+   /**
+       compute the sums of task on the n data points according to the execution policy.
+       With kMultithread the sums of each chunk are computed by nThreads threads
+       (the number of cores if nThreads is zero) and added pairwise in the chunk order
+   */
+   void Evaluate(const ChunkTask & task, unsigned int n, double * sums, ExecutionPolicy policy = kSerial, unsigned int nThreads = 0);
 
+   /// default number of threads (number of available cores)
+   unsigned int DefaultNThreads();
 
-} // end namespace FitUtil 
+} // end namespace FitUtilParallel
 
    } // end namespace Fit
 
 } // end namespace ROOT
 
 
-#endif /* ROOT_Fit_FitUtil */
-#endif /* ROOT_FIT_PARALLEL */
+#endif /* ROOT_Fit_FitUtilParallel */
@@ -29,12 +29,6 @@
 #include "Fit/FitUtil.h"
 #endif
 
-#ifdef ROOT_FIT_PARALLEL
-#ifndef ROOT_Fit_FitUtilParallel
-#include "Fit/FitUtilParallel.h"
-#endif
-#endif
-
 namespace ROOT { 
 
    namespace Fit { 
@@ -72,7 +66,9 @@ public:
       fData(data), 
       fFunc(func), 
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func.NPar() ) )
+      fGrad ( std::vector<double> ( func.NPar() ) ),
+      fExecutionPolicy(kSerial), 
+      fNThreads(0)
    {}
   
 
@@ -97,7 +93,11 @@ private:
 public: 
 
    /// clone the function (need to return Base for Windows)
-   virtual BaseFunction * Clone() const { return  new LogLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); }
+   virtual BaseFunction * Clone() const { 
+      LogLikelihoodFCN * fcn = new LogLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); 
+      fcn->SetExecutionPolicy(fExecutionPolicy, fNThreads); 
+      return fcn; 
+   }
 
 
    //using BaseObjFunction::operator();
@@ -115,7 +115,7 @@ public:
    // need to be virtual to be instantited
    virtual void Gradient(const double *x, double *g) const { 
       // evaluate the chi2 gradient
-      FitUtil::EvaluateLogLGradient(fFunc, fData, x, g, fNEffPoints);
+      FitUtil::EvaluateLogLGradient(fFunc, fData, x, g, fNEffPoints, fExecutionPolicy, fNThreads);
    }
 
    /// get type of fit method function
@@ -127,6 +127,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// set the execution policy (and the number of threads) used to evaluate the function and its gradient
+   void SetExecutionPolicy(ExecutionPolicy policy, unsigned int nThreads = 0) { 
+      fExecutionPolicy = policy; 
+      fNThreads = nThreads; 
+   }
+
    // Use sum of the weight squared in evaluating the likelihood 
    // (this is needed for calculating the errors)
    void UseSumOfWeightSquare(bool on = true) { 
@@ -148,11 +154,7 @@ private:
    virtual double DoEval (const double * x) const { 
       this->UpdateNCalls();
 
-#ifdef ROOT_FIT_PARALLEL
-      return FitUtilParallel::EvaluateLogL(fFunc, fData, x, fNEffPoints); 
-#else 
-      return FitUtil::EvaluateLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints); 
-#endif
+      return FitUtil::EvaluateLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy, fNThreads); 
    } 
 
    // for derivatives 
@@ -173,6 +175,9 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
 
+   ExecutionPolicy fExecutionPolicy;  // serial or multithreaded evaluation over the data points
+   unsigned int fNThreads;            // number of threads of the multithreaded evaluation (0 = one per core)
+
 
 }; 
 
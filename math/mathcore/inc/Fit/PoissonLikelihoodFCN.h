@@ -29,13 +29,6 @@
 #include "Fit/FitUtil.h"
 #endif
 
-//#define PARALLEL
-// #ifdef PARALLEL
-// #ifndef ROOT_Fit_FitUtilParallel
-// #include "Fit/FitUtilParallel.h"
-// #endif
-// #endif
-
 namespace ROOT {
 
    namespace Fit {
@@ -71,7 +64,9 @@ public:
       fData(data),
       fFunc(func),
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func.NPar() ) )
+      fGrad ( std::vector<double> ( func.NPar() ) ),
+      fExecutionPolicy(kSerial),
+      fNThreads(0)
    { }
 
 
@@ -96,7 +91,11 @@ private:
 public:
 
    /// clone the function (need to return Base for Windows)
-   virtual BaseFunction * Clone() const { return new  PoissonLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); }
+   virtual BaseFunction * Clone() const {
+      PoissonLikelihoodFCN * fcn = new  PoissonLikelihoodFCN(fData,fFunc,fWeight,fIsExtended);
+      fcn->SetExecutionPolicy(fExecutionPolicy, fNThreads);
+      return fcn;
+   }
 
    // effective points used in the fit
    virtual unsigned int NFitPoints() const { return fNEffPoints; }
@@ -110,7 +109,7 @@ public:
    /// evaluate gradient
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluatePoissonLogLGradient(fFunc, fData, x, g );
+      FitUtil::EvaluatePoissonLogLGradient(fFunc, fData, x, g, fExecutionPolicy, fNThreads );
    }
 
    /// get type of fit method function
@@ -122,6 +121,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// set the execution policy (and the number of threads) used to evaluate the function and its gradient
+   void SetExecutionPolicy(ExecutionPolicy policy, unsigned int nThreads = 0) {
+      fExecutionPolicy = policy;
+      fNThreads = nThreads;
+   }
+
    bool IsWeighted() const { return (fWeight != 0); }
 
    // Use the weights in evaluating the likelihood 
@@ -149,7 +154,7 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::EvaluatePoissonLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints);
+      return FitUtil::EvaluatePoissonLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy, fNThreads);
    }
 
    // for derivatives
@@ -172,6 +177,9 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
 
+   ExecutionPolicy fExecutionPolicy;  // serial or multithreaded evaluation over the data points
+   unsigned int fNThreads;            // number of threads of the multithreaded evaluation (0 = one per core)
+
 };
 
       // define useful typedef's
@@ -125,6 +125,16 @@ public:
       return DoEvalPar(x, p); 
    }
 
+   /**
+      Evaluate the function at n points for the given parameters p and store the values in result.
+      The coordinates of the point i are x[i*NDim()], ..., x[i*NDim()+NDim()-1].
+      The default implementation calls DoEvalPar for each point; derived classes can re-implement
+      DoEvalParBatch to evaluate all the points in one call (e.g. with vectorized loops)
+   */
+   void EvalParBatch(unsigned int n, const double * x, const double * p, double * result) const { 
+      DoEvalParBatch(n, x, p, result); 
+   }
+
    using BaseFunc::operator();
 
 
@@ -136,6 +146,15 @@ private:
    */
    virtual double DoEvalPar(const double * x, const double * p) const = 0; 
 
+   /**
+      Implementation of the evaluation at n points (see EvalParBatch)
+   */
+   virtual void DoEvalParBatch(unsigned int n, const double * x, const double * p, double * result) const { 
+      const unsigned int ndim = NDim(); 
+      for (unsigned int i = 0; i < n; ++i) 
+         result[i] = DoEvalPar(x + i*ndim, p); 
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
    */
@@ -186,6 +205,15 @@ public:
       return DoEvalPar(*x, p); 
    }
 
+   /**
+      Evaluate the function at the n points x[0], ..., x[n-1] for the given parameters p 
+      and store the values in result.
+      The default implementation calls DoEvalPar for each point
+   */
+   void EvalParBatch(unsigned int n, const double * x, const double * p, double * result) const { 
+      DoEvalParBatch(n, x, p, result); 
+   }
+
 private:
 
    /**
@@ -194,6 +222,14 @@ private:
    */
    virtual double DoEvalPar(double x, const double * p) const = 0; 
 
+   /**
+      Implementation of the evaluation at n points (see EvalParBatch)
+   */
+   virtual void DoEvalParBatch(unsigned int n, const double * x, const double * p, double * result) const { 
+      for (unsigned int i = 0; i < n; ++i) 
+         result[i] = DoEvalPar(x[i], p); 
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionOneDim interface DoEval(x) using the cached parameter values
    */
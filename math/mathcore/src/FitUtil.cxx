@@ -275,6 +275,82 @@ namespace ROOT {
          };
 
 
+         // evaluation of the model function by blocks of points with 
+         // IParamMultiFunction::EvalParBatch, which avoids a virtual call per point 
+         // and allows the function to vectorize its loops (e.g. the TF1 gaus, expo and polN)
+         // The coordinates of each block are copied in a contiguous buffer
+         // The blocks do not extend beyond the point end (excluded)
+         class BatchEvaluator { 
+
+         public: 
+
+            enum { kSize = 256 };  // number of points in a block 
+
+            BatchEvaluator(const IModelFunction & func, const double * p, unsigned int end) : 
+               fFunc(func), 
+               fParams(p), 
+               fDim(func.NDim() ), 
+               fLast(end), 
+               fFirst(0), 
+               fEnd(0), 
+               fX(kSize * func.NDim() ), 
+               fValues(kSize)
+            {}
+
+            // value of the function at the point i of binned data 
+            // using the bin centers if useBinCenter is true
+            double operator() (const BinData & data, unsigned int i, bool useBinCenter) { 
+               if (i < fFirst || i >= fEnd) { 
+                  Next(i); 
+                  for (unsigned int k = fFirst; k < fEnd; ++k) { 
+                     double * xk = &fX[(k-fFirst)*fDim];
+                     const double * x1 = data.Coords(k); 
+                     if (useBinCenter) { 
+                        const double * x2 = data.BinUpEdge(k); 
+                        for (unsigned int j = 0; j < fDim; ++j) xk[j] = 0.5*(x2[j]+ x1[j]);
+                     }
+                     else 
+                        std::copy(x1, x1 + fDim, xk); 
+                  }
+                  Evaluate(); 
+               }
+               return fValues[i-fFirst]; 
+            }
+
+            // value of the function at the point i of unbinned data 
+            double operator() (const UnBinData & data, unsigned int i) { 
+               if (i < fFirst || i >= fEnd) { 
+                  Next(i); 
+                  for (unsigned int k = fFirst; k < fEnd; ++k) { 
+                     const double * x = data.Coords(k); 
+                     std::copy(x, x + fDim, &fX[(k-fFirst)*fDim]); 
+                  }
+                  Evaluate(); 
+               }
+               return fValues[i-fFirst]; 
+            }
+
+         private: 
+
+            void Next(unsigned int i) { 
+               fFirst = i; 
+               fEnd = std::min(i + kSize, fLast); 
+            }
+            void Evaluate() { 
+               fFunc.EvalParBatch(fEnd-fFirst, &fX.front(), fParams, &fValues.front() ); 
+            }
+
+            const IModelFunction & fFunc; 
+            const double * fParams; 
+            unsigned int fDim; 
+            unsigned int fLast;           // end of the range of points
+            unsigned int fFirst;          // first point of the current block
+            unsigned int fEnd;            // end of the current block
+            std::vector<double> fX;       // coordinates of the points of the block 
+            std::vector<double> fValues;  // function values of the points of the block 
+         };
+
+
          // function to avoid infinities or nan
          double CorrectValue(double rval) { 
             // avoid infinities or nan in  rval
@@ -331,119 +407,143 @@ namespace ROOT {
 // for chi2 functions
 //___________________________________________________________________________________________________________________________
 
-double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {  
-   // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints 
-   // the actual number of used points
-   // normal chi2 using only error on values (from fitting histogram)
-   // optionally the integral of function in the bin is used 
-   
-   unsigned int n = data.Size();
+namespace FitUtil { 
+
+   // sum of the chi2 residuals of a range of points (see FitUtil::EvaluateChi2)
+   class Chi2Task : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      Chi2Task(const IModelFunction & func, const BinData & data, const double * p) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p)
+      { 
+         // get fit option and check case if using integral of bins
+         const DataOptions & fitOpt = data.Opt();
+         fUseBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+         fUseBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         fUseExpErrors = (fitOpt.fExpErrors);
+         fMaxResValue = std::numeric_limits<double>::max() / data.Size();
+         fWrefVolume = 1.0; 
+         if (fUseBinVolume) 
+            fWrefVolume /= data.RefVolume();
+      }
 
-   double chi2 = 0;
-   nPoints = 0; // count the effective non-zero points
-   
-   // do not cache parameter values (it is not thread safe)
-   //func.SetParameters(p); 
+      unsigned int NSums() const { return 1; } 
 
-   
-   // get fit option and check case if using integral of bins
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-   bool useExpErrors = (fitOpt.fExpErrors);
+      void Evaluate(unsigned int begin, unsigned int end, double * sums) const { 
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl; 
-   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
-   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
-   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
-#endif
+         const BinData & data = fData;
+         const double * p = fParams;
+         double chi2 = 0;
 
+         IntegralEvaluator<> igEval( fFunc, p, fUseBinIntegral); 
+         BatchEvaluator batchEval( fFunc, p, end); 
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+         for (unsigned int i = begin; i < end; ++ i) { 
 
-   double maxResValue = std::numeric_limits<double>::max() /n;
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
+            double y, invError; 
+            // in case of no error in y invError=1 is returned
+            const double * x1 = data.GetPoint(i,y, invError);
 
-   for (unsigned int i = 0; i < n; ++ i) { 
+            double fval = 0;
 
+            double binVolume = 1.0; 
+            if (fUseBinVolume) { 
+               unsigned int ndim = data.NDim(); 
+               const double * x2 = data.BinUpEdge(i);  
+               for (unsigned int j = 0; j < ndim; ++j) {
+                  binVolume *= std::abs( x2[j]-x1[j] );
+               }
+               // normalize the bin volume using a reference value
+               binVolume *= fWrefVolume;
+            }
 
-      double y, invError; 
-      // in case of no error in y invError=1 is returned
-      const double * x1 = data.GetPoint(i,y, invError);
+            if (!fUseBinIntegral) {
+               // evaluated at the bin center when using the bin volume
+               fval = batchEval( data, i, fUseBinVolume );
+            }
+            else {
+               // calculate integral normalized by bin volume
+               fval = igEval( x1, data.BinUpEdge(i)) ; 
+            }
+            // normalize result if requested according to bin volume
+            if (fUseBinVolume) fval *= binVolume;
+
+            // expected errors
+            if (fUseExpErrors) {
+               // we need first to check if a weight factor needs to be applied
+               // weight = sumw2/sumw = error**2/content
+               double invWeight = y * invError * invError;
+               if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0; 
+               // compute expected error  as f(x) / weight
+               double invError2 = (fval > 0) ? invWeight / fval : 0.0; 
+               invError = std::sqrt(invError2); 
+            }         
+
+#ifdef DEBUG      
+            std::cout << x1[0] << "  " << y << "  " << 1./invError << " params : "; 
+            for (unsigned int ipar = 0; ipar < fFunc.NPar(); ++ipar) 
+               std::cout << p[ipar] << "\t";
+            std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << fWrefVolume << std::endl; 
+#endif
 
-      double fval = 0;
+            if (invError > 0) { 
 
-      double binVolume = 1.0; 
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         const double * x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+               double tmp = ( y -fval )* invError;  	  
+               double resval = tmp * tmp;
+
+               // avoid inifinity or nan in chi2 values due to wrong function values 
+               if ( resval < fMaxResValue )  
+                  chi2 += resval; 
+               else {  
+                  chi2 += fMaxResValue;
+               }
+            }
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
+         sums[0] += chi2; 
       }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+   private: 
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-      }
-      else {
-         // calculate integral normalized by bin volume
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ; 
-      }
-      // normalize result if requested according to bin volume
-      if (useBinVolume) fval *= binVolume;
-
-      // expected errors
-      if (useExpErrors) {
-         // we need first to check if a weight factor needs to be applied
-         // weight = sumw2/sumw = error**2/content
-         double invWeight = y * invError * invError;
-         if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0; 
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0; 
-         invError = std::sqrt(invError2); 
-      }         
+      const IModelFunction & fFunc; 
+      const BinData & fData; 
+      const double * fParams; 
+      bool fUseBinIntegral; 
+      bool fUseBinVolume; 
+      bool fUseExpErrors; 
+      double fMaxResValue; 
+      double fWrefVolume; 
+   };
 
-//#define DEBUG
-#ifdef DEBUG      
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl; 
-#endif
-//#undef DEBUG
+}
 
+double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints, 
+                             ExecutionPolicy executionPolicy, unsigned int nThreads) {  
+   // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints 
+   // the actual number of used points
+   // normal chi2 using only error on values (from fitting histogram)
+   // optionally the integral of function in the bin is used 
+   
+   unsigned int n = data.Size();
 
-      if (invError > 0) { 
-         nPoints++;
+   // do not cache parameter values (it is not thread safe)
+   //func.SetParameters(p); 
 
-         double tmp = ( y -fval )* invError;  	  
-         double resval = tmp * tmp;
-         
+#ifdef DEBUG
+   const DataOptions & fitOpt = data.Opt();
+   std::cout << "\n\nFit data size = " << n << std::endl;
+   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl; 
+   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
+   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
+   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
+#endif
 
-         // avoid inifinity or nan in chi2 values due to wrong function values 
-         if ( resval < maxResValue )  
-            chi2 += resval; 
-         else {  
-            //nRejected++; 
-            chi2 += maxResValue;
-         }
-      }
+   double chi2 = 0;
+   Chi2Task task(func, data, p); 
+   FitUtilParallel::Evaluate(task, n, &chi2, executionPolicy, nThreads); 
 
-      
-   }
    nPoints=n;
 
 #ifdef DEBUG
@@ -683,128 +783,162 @@ double FitUtil::EvaluateChi2Residual(const IModelFunction & func, const BinData
 
 }
 
-void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints) { 
-   // evaluate the gradient of the chi2 function
-   // this function is used when the model function knows how to calculate the derivative and we can  
-   // avoid that the minimizer re-computes them 
-   //
-   // case of chi2 effective (errors on coordinate) is not supported
+namespace FitUtil { 
+
+   // sum of the gradients of the chi2 residuals of a range of points (see FitUtil::EvaluateChi2Gradient)
+   // the last sum is the number of rejected points 
+   class Chi2GradientTask : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      Chi2GradientTask(const IGradModelFunction & func, const BinData & data, const double * p) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p)
+      { 
+         const DataOptions & fitOpt = data.Opt();
+         fUseBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+         fUseBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         fWrefVolume = 1.0; 
+         if (fUseBinVolume) 
+            fWrefVolume /= data.RefVolume();
+      }
 
-   if ( data.HaveCoordErrors() ) {
-      MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
-   }
+      unsigned int NSums() const { return fFunc.NPar() + 1; } 
 
-   unsigned int nRejected = 0; 
+      void Evaluate(unsigned int begin, unsigned int end, double * sums) const { 
 
-   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
-   assert (fg != 0); // must be called by a gradient function
+         const IGradModelFunction & func = fFunc; 
+         const BinData & data = fData;
+         const double * p = fParams;
 
-   const IGradModelFunction & func = *fg; 
-   unsigned int n = data.Size();
+         std::vector<double> xc; 
+         if (fUseBinVolume) xc.resize(data.NDim() );
 
+         IntegralEvaluator<> igEval( func, p, fUseBinIntegral); 
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   std::cout << "evaluate chi2 using function gradient " << &func << "  " << p << std::endl; 
-#endif
+         unsigned int npar = func.NPar(); 
+         std::vector<double> gradFunc( npar ); 
+         double * g = sums; 
+         unsigned int nRejected = 0; 
 
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         for (unsigned int i = begin; i < end; ++ i) { 
 
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
+            double y, invError = 0; 
+            const double * x1 = data.GetPoint(i,y, invError);
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+            double fval = 0; 
+            const double * x2 = 0; 
 
-   //int nRejected = 0; 
-   // set values of parameters 
+            double binVolume = 1; 
+            if (fUseBinVolume) { 
+               unsigned int ndim = data.NDim(); 
+               x2 = data.BinUpEdge(i);  
+               for (unsigned int j = 0; j < ndim; ++j) {
+                  binVolume *= std::abs( x2[j]-x1[j] );
+                  xc[j] = 0.5*(x2[j]+ x1[j]);
+               }
+               // normalize the bin volume using a reference value
+               binVolume *= fWrefVolume;
+            }
 
-   unsigned int npar = func.NPar(); 
-   //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
-   std::vector<double> gradFunc( npar ); 
-   // set all vector values to zero
-   std::vector<double> g( npar); 
+            const double * x = (fUseBinVolume) ? &xc.front() : x1;
 
-   for (unsigned int i = 0; i < n; ++ i) { 
+            if (!fUseBinIntegral ) {
+               fval = func ( x, p ); 
+               func.ParameterGradient(  x , p, &gradFunc[0] ); 
+            }
+            else { 
+               x2 = data.BinUpEdge(i); 
+               // calculate normalized integral and gradient (divided by bin volume)
+               fval = igEval( x1, x2 ) ; 
+               CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
+            }
+            if (fUseBinVolume) fval *= binVolume;
 
+#ifdef DEBUG      
+            std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
+            for (unsigned int ipar = 0; ipar < npar; ++ipar) 
+               std::cout << p[ipar] << "\t";
+            std::cout << "\tfval = " << fval << std::endl; 
+#endif
+            if ( !CheckValue(fval) ) { 
+               nRejected++; 
+               continue;
+            } 
 
-      double y, invError = 0; 
-      const double * x1 = data.GetPoint(i,y, invError);
+            // loop on the parameters
+            unsigned int ipar = 0; 
+            for ( ; ipar < npar ; ++ipar) { 
 
-      double fval = 0; 
-      const double * x2 = 0; 
+               // correct gradient for bin volumes
+               if (fUseBinVolume) gradFunc[ipar] *= binVolume;
 
-      double binVolume = 1; 
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
+               // avoid singularity in the function (infinity and nan ) in the chi2 sum 
+               // eventually add possibility of excluding some points (like singularity) 
+               double dfval = gradFunc[ipar];
+               if ( !CheckValue(dfval) ) { 
+                     break; // exit loop on parameters
+               } 
+ 
+               // calculate derivative point contribution
+               double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];  	  
+               g[ipar] += tmp;
+            }
+
+            if ( ipar < npar ) { 
+                // case loop was broken for an overflow in the gradient calculation  
+               nRejected++; 
+               continue;
+            } 
+         } 
+         sums[npar] += nRejected; 
       }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+   private: 
 
-      if (!useBinIntegral ) {
-         fval = func ( x, p ); 
-         func.ParameterGradient(  x , p, &gradFunc[0] ); 
-      }
-      else { 
-         x2 = data.BinUpEdge(i); 
-         // calculate normalized integral and gradient (divided by bin volume)
-         // need to set function and parameters here in case loop is parallelized 
-         fval = igEval( x1, x2 ) ; 
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
-      }
-      if (useBinVolume) fval *= binVolume;
+      const IGradModelFunction & fFunc; 
+      const BinData & fData; 
+      const double * fParams; 
+      bool fUseBinIntegral; 
+      bool fUseBinVolume; 
+      double fWrefVolume; 
+   };
 
-#ifdef DEBUG      
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
-      for (unsigned int ipar = 0; ipar < npar; ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl; 
-#endif
-      if ( !CheckValue(fval) ) { 
-         nRejected++; 
-         continue;
-      } 
+}
+
+void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints, 
+                                   ExecutionPolicy executionPolicy, unsigned int nThreads) { 
+   // evaluate the gradient of the chi2 function
+   // this function is used when the model function knows how to calculate the derivative and we can  
+   // avoid that the minimizer re-computes them 
+   //
+   // case of chi2 effective (errors on coordinate) is not supported
 
-      // loop on the parameters
-      unsigned int ipar = 0; 
-      for ( ; ipar < npar ; ++ipar) { 
+   if ( data.HaveCoordErrors() ) {
+      MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
+   }
 
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[ipar] *= binVolume;
+   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
+   assert (fg != 0); // must be called by a gradient function
 
-         // avoid singularity in the function (infinity and nan ) in the chi2 sum 
-         // eventually add possibility of excluding some points (like singularity) 
-         double dfval = gradFunc[ipar];
-         if ( !CheckValue(dfval) ) { 
-               break; // exit loop on parameters
-         } 
- 
-         // calculate derivative point contribution
-         double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];  	  
-         g[ipar] += tmp;
-      
-      }
+   const IGradModelFunction & func = *fg; 
+   unsigned int n = data.Size();
 
-      if ( ipar < npar ) { 
-          // case loop was broken for an overflow in the gradient calculation  
-         nRejected++; 
-         continue;
-      } 
 
+#ifdef DEBUG
+   std::cout << "\n\nFit data size = " << n << std::endl;
+   std::cout << "evaluate chi2 using function gradient " << &func << "  " << p << std::endl; 
+#endif
 
-   } 
+   unsigned int npar = func.NPar(); 
+   //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
+   // gradient followed by the number of rejected points
+   std::vector<double> g( npar + 1); 
+
+   Chi2GradientTask task(func, data, p); 
+   FitUtilParallel::Evaluate(task, n, &g[0], executionPolicy, nThreads); 
+   unsigned int nRejected = (unsigned int) g[npar]; 
 
    // correct the number of points
    nPoints = n; 
@@ -815,7 +949,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    } 
 
    // copy result 
-   std::copy(g.begin(), g.end(), grad);
+   std::copy(g.begin(), g.begin() + npar, grad);
 
 }
 
@@ -875,8 +1009,87 @@ double FitUtil::EvaluatePdf(const IModelFunction & func, const UnBinData & data,
    return logPdf;
 }
 
+namespace FitUtil { 
+
+   // sum of the log of the pdf of a range of points (see FitUtil::EvaluateLogL) 
+   // followed by the sums of the weights and of the weights squared 
+   class LogLTask : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      LogLTask(const IModelFunction & func, const UnBinData & data, const double * p, int iWeight, bool extended, double norm) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p), 
+         fWeight(iWeight), 
+         fExtended(extended), 
+         fNorm(norm)
+      {}
+
+      unsigned int NSums() const { return 3; } 
+
+      void Evaluate(unsigned int begin, unsigned int end, double * sums) const { 
+
+         const UnBinData & data = fData;
+         const double * p = fParams;
+         double logl = 0;
+         double sumW = 0;
+         double sumW2 = 0;
+
+         BatchEvaluator batchEval( fFunc, p, end); 
+
+         for (unsigned int i = begin; i < end; ++ i) { 
+#ifdef DEBUG      
+            const double * x = data.Coords(i);
+#endif
+            double fval = batchEval( data, i ); 
+            if (fNorm != 1.0) fval = fval / fNorm;
+
+#ifdef DEBUG      
+            std::cout << "x [ " << data.NDim() << " ] = "; 
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               std::cout << x[j] << "\t"; 
+            std::cout << "\tpar = [ " << fFunc.NPar() << " ] =  "; 
+            for (unsigned int ipar = 0; ipar < fFunc.NPar(); ++ipar) 
+               std::cout << p[ipar] << "\t";
+            std::cout << "\tfval = " << fval << std::endl; 
+#endif
+            // function EvalLog protects against negative or too small values of fval
+            double logval =  ROOT::Math::Util::EvalLog( fval);       
+            if (fWeight > 0) { 
+               double weight = data.Weight(i); 
+               logval *= weight; 
+               if (fWeight ==2) { 
+                  logval *= weight; // use square of weights in likelihood
+                  if (fExtended) { 
+                     // needed sum of weights and sum of weight square if likelkihood is extended
+                     sumW += weight; 
+                     sumW2 += weight*weight; 
+                  }
+               }
+            }
+            logl += logval;
+         }
+         sums[0] += logl; 
+         sums[1] += sumW; 
+         sums[2] += sumW2; 
+      }
+
+   private: 
+
+      const IModelFunction & fFunc; 
+      const UnBinData & fData; 
+      const double * fParams; 
+      int fWeight; 
+      bool fExtended; 
+      double fNorm; 
+   };
+
+}
+
 double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * p,
-                                   int iWeight,  bool extended, unsigned int &nPoints) {  
+                             int iWeight,  bool extended, unsigned int &nPoints, 
+                             ExecutionPolicy executionPolicy, unsigned int nThreads) {  
    // evaluate the LogLikelihood 
 
    unsigned int n = data.Size();
@@ -886,7 +1099,6 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
    std::cout << "func pointer is " << typeid(func).name() << std::endl;
 #endif
 
-   double logl = 0;
    //unsigned int nRejected = 0; 
 
    // this is needed if function must be normalized 
@@ -901,40 +1113,14 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
       norm = igEval.Integral(&xmin[0],&xmax[0]);
    }
 
-   // needed to compue effective global weight in case of extended likelihood 
-   double sumW = 0;
-   double sumW2 = 0;
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x = data.Coords(i);
-      double fval = func ( x, p ); 
-      if (normalizeFunc) fval = fval / norm;
-
-#ifdef DEBUG      
-      std::cout << "x [ " << data.NDim() << " ] = "; 
-      for (unsigned int j = 0; j < data.NDim(); ++j)
-         std::cout << x[j] << "\t"; 
-      std::cout << "\tpar = [ " << func.NPar() << " ] =  "; 
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl; 
-#endif
-      // function EvalLog protects against negative or too small values of fval
-      double logval =  ROOT::Math::Util::EvalLog( fval);       
-      if (iWeight > 0) { 
-         double weight = data.Weight(i); 
-         logval *= weight; 
-         if (iWeight ==2) { 
-            logval *= weight; // use square of weights in likelihood
-            if (extended) { 
-               // needed sum of weights and sum of weight square if likelkihood is extended
-               sumW += weight; 
-               sumW2 += weight*weight; 
-            }
-         }
-      }
-      logl += logval;
-   }
+   // the sum of the logs followed by the sum of weights and sum of weight square 
+   // needed to compute the effective global weight in case of extended likelihood 
+   double sums[3] = { 0, 0, 0 }; 
+   LogLTask task(func, data, p, iWeight, extended, norm); 
+   FitUtilParallel::Evaluate(task, n, sums, executionPolicy, nThreads); 
+   double logl = sums[0];
+   double sumW = sums[1];
+   double sumW2 = sums[2];
 
    if (extended) { 
       // add Poisson extended term
@@ -991,7 +1177,62 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
    return -logl;
 }
 
-void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int & ) { 
+namespace FitUtil { 
+
+   // sum of the gradients of the log of the pdf of a range of points (see FitUtil::EvaluateLogLGradient)
+   class LogLGradientTask : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      LogLGradientTask(const IGradModelFunction & func, const UnBinData & data, const double * p) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p)
+      {}
+
+      unsigned int NSums() const { return fFunc.NPar(); } 
+
+      void Evaluate(unsigned int begin, unsigned int end, double * g) const { 
+
+         const IGradModelFunction & func = fFunc; 
+         const UnBinData & data = fData;
+         const double * p = fParams;
+         unsigned int n = data.Size();
+
+         unsigned int npar = func.NPar(); 
+         std::vector<double> gradFunc( npar ); 
+
+         for (unsigned int i = begin; i < end; ++ i) { 
+            const double * x = data.Coords(i);
+            double fval = func ( x , p); 
+            func.ParameterGradient( x, p, &gradFunc[0] );
+            for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
+               if (fval > 0)  
+                  g[kpar] -= 1./fval * gradFunc[ kpar ]; 
+               else if (gradFunc [ kpar] != 0) { 
+                  const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                  const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                  double gg = kdmax1 * gradFunc[ kpar ];  
+                  if ( gg > 0) gg = std::min( gg, kdmax2);
+                  else gg = std::max(gg, - kdmax2);
+                  g[kpar] -= gg;
+               }
+               // if func derivative is zero term is also zero so do not add in g[kpar]
+            }
+         }
+      }
+
+   private: 
+
+      const IGradModelFunction & fFunc; 
+      const UnBinData & fData; 
+      const double * fParams; 
+   };
+
+}
+
+void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int &, 
+                                   ExecutionPolicy executionPolicy, unsigned int nThreads) { 
    // evaluate the gradient of the log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
@@ -1002,30 +1243,13 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
    //int nRejected = 0; 
 
    unsigned int npar = func.NPar(); 
-   std::vector<double> gradFunc( npar ); 
    std::vector<double> g( npar); 
 
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x = data.Coords(i);
-      double fval = func ( x , p); 
-      func.ParameterGradient( x, p, &gradFunc[0] );
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
-         if (fval > 0)  
-            g[kpar] -= 1./fval * gradFunc[ kpar ]; 
-         else if (gradFunc [ kpar] != 0) { 
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];  
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
-         }
-         // if func derivative is zero term is also zero so do not add in g[kpar]
-      }
-            
-    // copy result 
-   std::copy(g.begin(), g.end(), grad);
-   }
+   LogLGradientTask task(func, data, p); 
+   FitUtilParallel::Evaluate(task, n, &g[0], executionPolicy, nThreads); 
+
+   // copy result 
+   if (n > 0) std::copy(g.begin(), g.end(), grad);
 }
 //_________________________________________________________________________________________________
 // for binned log likelihood functions      
@@ -1136,8 +1360,141 @@ double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData
    return logPdf;
 }
 
+namespace FitUtil { 
+
+   // sum of the Poisson log likelihood terms of a range of points (see FitUtil::EvaluatePoissonLogL) 
+   // followed by the number of points with non-zero content 
+   class PoissonLogLTask : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      PoissonLogLTask(const IModelFunction & func, const BinData & data, const double * p, int iWeight, bool extended) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p), 
+         fExtended(extended)
+      { 
+         // get fit option and check case of using integral of bins
+         const DataOptions & fitOpt = data.Opt();
+         fUseIntegral = fitOpt.fIntegral; 
+         fUseBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+         fUseBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         fUseW2 = (iWeight == 2);
+         fWrefVolume = 1.0; 
+         if (fUseBinVolume) 
+            fWrefVolume /= data.RefVolume();
+      }
+
+      unsigned int NSums() const { return 2; } 
+
+      void Evaluate(unsigned int begin, unsigned int end, double * sums) const { 
+
+         const BinData & data = fData;
+         const double * p = fParams;
+         double nloglike = 0;  // negative loglikelihood 
+         unsigned int nPoints = 0; 
+
+         IntegralEvaluator<> igEval( fFunc, p, fUseIntegral); 
+         BatchEvaluator batchEval( fFunc, p, end); 
+
+         for (unsigned int i = begin; i < end; ++ i) { 
+            const double * x1 = data.Coords(i);
+            double y = data.Value(i);
+
+            double fval = 0;   
+            double binVolume = 1.0; 
+
+            if (fUseBinVolume) { 
+               unsigned int ndim = data.NDim(); 
+               const double * x2 = data.BinUpEdge(i);  
+               for (unsigned int j = 0; j < ndim; ++j) {
+                  binVolume *= std::abs( x2[j]-x1[j] );
+               }
+               // normalize the bin volume using a reefrence value
+               binVolume *= fWrefVolume;
+            }
+
+            if (!fUseBinIntegral) {
+               // evaluated at the bin center when using the bin volume
+               fval = batchEval( data, i, fUseBinVolume );
+            }
+            else {
+               // calculate integral (normalized by bin volume) 
+               fval = igEval( x1, data.BinUpEdge(i)) ; 
+            }
+            if (fUseBinVolume) fval *= binVolume;
+
+#ifdef DEBUG
+            int NSAMPLE = 100;
+            if (i%NSAMPLE == 0) { 
+               std::cout << "evt " << i << " x1 = [ "; 
+               for (unsigned int j=0; j < fFunc.NDim(); ++j) std::cout << x1[j] << " , ";
+               std::cout << "]  ";
+               if (fUseIntegral) { 
+                  std::cout << "x2 = [ "; 
+                  for (unsigned int j=0; j < fFunc.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
+                  std::cout << "] ";
+               }
+               std::cout << "  y = " << y << " fval = " << fval << std::endl;
+            }
+#endif
+
+            // EvalLog protects against 0 values of fval but don't want to add in the -log sum 
+            // negative values of fval 
+            fval = std::max(fval, 0.0);
+
+            double tmp = 0; 
+            if (fUseW2) { 
+               // apply weight correction . Effective weight is error^2/ y
+               // and expected events in bins is fval/weight
+               // can apply correction only when y is not zero otherwise weight is undefined
+               // (in case of weighted likelihood I don't care about the constant term due to 
+               // the saturated model)
+               if (y != 0) { 
+                  double error = data.Error(i);
+                  double weight = (error*error)/y;  // this is the bin effective weight
+                  if (fExtended) { 
+                     tmp = fval * weight;
+                  }
+                  tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
+               }
+            }
+            else {
+               // standard case no weights or iWeight=1 
+               // this is needed for Poisson likelihood (which are extened and not for multinomial) 
+               // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
+               // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
+               if (fExtended) tmp = fval -y ;
+               if (y >  0) { 
+                  tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));  
+                  nPoints++;
+               }
+            }
+
+            nloglike +=  tmp;  
+         }
+         sums[0] += nloglike; 
+         sums[1] += nPoints; 
+      }
+
+   private: 
+
+      const IModelFunction & fFunc; 
+      const BinData & fData; 
+      const double * fParams; 
+      bool fExtended; 
+      bool fUseIntegral; 
+      bool fUseBinIntegral; 
+      bool fUseBinVolume; 
+      bool fUseW2; 
+      double fWrefVolume; 
+   };
+
+}
+
 double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, 
-                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints ) {  
+                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints, 
+                                    ExecutionPolicy executionPolicy, unsigned int nThreads) {  
    // evaluate the Poisson Log Likelihood
    // for binned likelihood fits
    // this is Sum ( f(x_i)  -  y_i * log( f (x_i) ) )
@@ -1162,123 +1519,13 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    std::cout << "]  - data size = " << n << std::endl;
 #endif
    
-   double nloglike = 0;  // negative loglikelihood 
-   nPoints = 0;  // npoints
-
-
-   // get fit option and check case of using integral of bins
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-   bool useW2 = (iWeight == 2);
-
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
-
-   IntegralEvaluator<> igEval( func, p, fitOpt.fIntegral); 
-
-   // double nuTot = 0; // total number of expected events (needed for non-extended fits) 
-   // double wTot = 0; // sum of all weights  
-   // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
-
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      
-      double fval = 0;   
-      double binVolume = 1.0; 
-
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         const double * x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reefrence value
-         binVolume *= wrefVolume;
-      }
-
-      const double * x = (useBinVolume) ? &xc.front() : x1;
-
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-      }
-      else {
-         // calculate integral (normalized by bin volume) 
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ; 
-      }
-      if (useBinVolume) fval *= binVolume;
-
-
+   // negative loglikelihood followed by the number of points
+   double sums[2] = { 0, 0 }; 
+   PoissonLogLTask task(func, data, p, iWeight, extended); 
+   FitUtilParallel::Evaluate(task, n, sums, executionPolicy, nThreads); 
+   double nloglike = sums[0]; 
+   nPoints = (unsigned int) sums[1]; 
 
-#ifdef DEBUG
-      int NSAMPLE = 100;
-      if (i%NSAMPLE == 0) { 
-         std::cout << "evt " << i << " x1 = [ "; 
-         for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
-         std::cout << "]  ";
-         if (fitOpt.fIntegral) { 
-            std::cout << "x2 = [ "; 
-            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
-            std::cout << "] ";
-         }
-         std::cout << "  y = " << y << " fval = " << fval << std::endl;
-      }
-#endif
-
-
-      // EvalLog protects against 0 values of fval but don't want to add in the -log sum 
-      // negative values of fval 
-      fval = std::max(fval, 0.0);
-
-
-      double tmp = 0; 
-      if (useW2) { 
-         // apply weight correction . Effective weight is error^2/ y
-         // and expected events in bins is fval/weight
-         // can apply correction only when y is not zero otherwise weight is undefined
-         // (in case of weighted likelihood I don't care about the constant term due to 
-         // the saturated model)
-         if (y != 0) { 
-            double error = data.Error(i);
-            double weight = (error*error)/y;  // this is the bin effective weight
-            if (extended) { 
-               tmp = fval * weight;
-               // wTot  += weight; 
-               // w2Tot += weight*weight; 
-            }
-            tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
-         }
-         
-         //  need to compute total weight and weight-square
-         // if (extended ) { 
-         //    nuTot += fval;
-         // }
-
-      }
-      else {
-         // standard case no weights or iWeight=1 
-         // this is needed for Poisson likelihood (which are extened and not for multinomial) 
-         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
-         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
-         if (extended) tmp = fval -y ;
-         if (y >  0) { 
-            tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));  
-            nPoints++;
-         }
-      }
-
-
-      nloglike +=  tmp;  
-   }
-   
    // if (notExtended) { 
    //    // not extended : remove from the Likelihood the global Poisson term
    //    if (!useW2)  
@@ -1303,90 +1550,129 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    return nloglike;  
 }
 
-void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad ) { 
-   // evaluate the gradient of the Poisson log likelihood function
+namespace FitUtil { 
+
+   // sum of the gradients of the Poisson log likelihood terms of a range of points 
+   // (see FitUtil::EvaluatePoissonLogLGradient)
+   class PoissonLogLGradientTask : public FitUtilParallel::ChunkTask { 
+
+   public: 
+
+      PoissonLogLGradientTask(const IGradModelFunction & func, const BinData & data, const double * p) : 
+         fFunc(func), 
+         fData(data), 
+         fParams(p)
+      { 
+         const DataOptions & fitOpt = data.Opt();
+         fUseBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+         fUseBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         fWrefVolume = 1.0;
+         if (fUseBinVolume) 
+            fWrefVolume /= data.RefVolume();
+      }
 
-   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
-   assert (fg != 0); // must be called by a grad function
-   const IGradModelFunction & func = *fg; 
+      unsigned int NSums() const { return fFunc.NPar(); } 
 
-   unsigned int n = data.Size();
+      void Evaluate(unsigned int begin, unsigned int end, double * g) const { 
 
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+         const IGradModelFunction & func = fFunc; 
+         const BinData & data = fData;
+         const double * p = fParams;
+         unsigned int n = data.Size();
 
-   double wrefVolume = 1.0;
-   std::vector<double> xc;  
-   if (useBinVolume) {
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
+         std::vector<double> xc;  
+         if (fUseBinVolume) xc.resize(data.NDim() );
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+         IntegralEvaluator<> igEval( func, p, fUseBinIntegral); 
 
-   unsigned int npar = func.NPar(); 
-   std::vector<double> gradFunc( npar ); 
-   std::vector<double> g( npar); 
+         unsigned int npar = func.NPar(); 
+         std::vector<double> gradFunc( npar ); 
 
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      double fval = 0; 
-      const double * x2 = 0; 
-
-      double binVolume = 1.0; 
-      if (useBinVolume) { 
-         x2 = data.BinUpEdge(i);  
-         unsigned int ndim = data.NDim(); 
-         for (unsigned int j = 0; j < ndim; ++j) { 
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
+         for (unsigned int i = begin; i < end; ++ i) { 
+            const double * x1 = data.Coords(i);
+            double y = data.Value(i);
+            double fval = 0; 
+            const double * x2 = 0; 
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+            double binVolume = 1.0; 
+            if (fUseBinVolume) { 
+               x2 = data.BinUpEdge(i);  
+               unsigned int ndim = data.NDim(); 
+               for (unsigned int j = 0; j < ndim; ++j) { 
+                  binVolume *= std::abs( x2[j]-x1[j] );
+                  xc[j] = 0.5*(x2[j]+ x1[j]);
+               }
+               // normalize the bin volume using a reference value
+               binVolume *= fWrefVolume;
+            }
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] ); 
-      }
-      else {
-         // calculate integral (normalized by bin volume) 
-         // need to set function and parameters here in case loop is parallelized
-         x2 = data.BinUpEdge(i);
-         fval = igEval( x1, x2) ; 
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
-      }
-      if (useBinVolume) fval *= binVolume;
+            const double * x = (fUseBinVolume) ? &xc.front() : x1;
+
+            if (!fUseBinIntegral) {
+               fval = func ( x, p );
+               func.ParameterGradient(  x , p, &gradFunc[0] ); 
+            }
+            else {
+               // calculate integral (normalized by bin volume) 
+               x2 = data.BinUpEdge(i);
+               fval = igEval( x1, x2) ; 
+               CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
+            }
+            if (fUseBinVolume) fval *= binVolume;
       
-      // correct the gradient
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
-
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[kpar] *= binVolume; 
-
-         // df/dp * (1.  - y/f )
-         if (fval > 0)  
-            g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval ); 
-         else if (gradFunc [ kpar] != 0) { 
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];  
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+            // correct the gradient
+            for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
+
+               // correct gradient for bin volumes
+               if (fUseBinVolume) gradFunc[kpar] *= binVolume; 
+
+               // df/dp * (1.  - y/f )
+               if (fval > 0)  
+                  g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval ); 
+               else if (gradFunc [ kpar] != 0) { 
+                  const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                  const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                  double gg = kdmax1 * gradFunc[ kpar ];  
+                  if ( gg > 0) gg = std::min( gg, kdmax2);
+                  else gg = std::max(gg, - kdmax2);
+                  g[kpar] -= gg;
+               }
+            }            
          }
-      }            
+      }
+
+   private: 
+
+      const IGradModelFunction & fFunc; 
+      const BinData & fData; 
+      const double * fParams; 
+      bool fUseBinIntegral; 
+      bool fUseBinVolume; 
+      double fWrefVolume; 
+   };
 
-      // copy result 
-      std::copy(g.begin(), g.end(), grad);
-   }
+}
+
+void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, 
+                                          ExecutionPolicy executionPolicy, unsigned int nThreads) { 
+   // evaluate the gradient of the Poisson log likelihood function
+
+   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
+   assert (fg != 0); // must be called by a grad function
+   const IGradModelFunction & func = *fg; 
+
+   unsigned int n = data.Size();
+
+   unsigned int npar = func.NPar(); 
+   std::vector<double> g( npar); 
+
+   PoissonLogLGradientTask task(func, data, p); 
+   FitUtilParallel::Evaluate(task, n, &g[0], executionPolicy, nThreads); 
+
+   // copy result 
+   if (n > 0) std::copy(g.begin(), g.end(), grad);
 }
    
 }
 
 } // end namespace ROOT
-
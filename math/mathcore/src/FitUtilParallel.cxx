@@ -8,293 +8,115 @@
  *                                                                    *
  **********************************************************************/
 
-// Implementation file for class FitUtil
-
-#ifdef ROOT_FIT_PARALLEL
+// Implementation file for the parallel evaluation of the fit method functions
 
 #include "Fit/FitUtilParallel.h"
 
-#include "Fit/BinData.h"
-#include "Fit/UnBinData.h"
-#include "Fit/FitUtil.h"
-
-#include "Math/IParamFunction.h"
-
-int ncalls = 0; 
+#include "TThreadTeam.h"
 
-#include <limits>
-#include <cmath>
-#include <numeric>
+#include <vector>
+#include <algorithm>
 
 //#define DEBUG
 #ifdef DEBUG
-#include <iostream> 
+#include <iostream>
 #endif
 
-#ifdef USE_PTHREAD
-
-#include <pthread.h>
-
-
-#define NUMBER_OF_THREADS 2
-
-#else 
-#include <omp.h>
-// maximum number of threads for the array
-#define MAX_THREAD 8
-
-#endif
-
-namespace ROOT { 
-
-   namespace Fit { 
-
-      namespace FitUtilParallel { 
-
-#ifdef USE_PTHREAD
-
-class ThreadData { 
-
-public: 
-
-   ThreadData() : 
-      fBegin(0),fEnd(0) ,
-      fData(0),
-      fFunc(0)
-   {}
-   
-   ThreadData(unsigned int i1, unsigned int i2, const BinData & data, IModelFunction &func) : 
-      fBegin(i1), fEnd(i2), 
-      fData(&data),
-      fFunc(&func)
-   {}
-
-   void Set(unsigned int nrej, double sum) { 
-      fNRej = nrej; 
-      fSum = sum; 
-   }
-
-   const BinData & Data() const { return *fData; }
-
-   IModelFunction & Func() { return *fFunc; }
-
-   double Sum() const { return fSum; } 
-
-   unsigned int NRej() const { return fNRej; } 
-
-   unsigned int Begin() const { return fBegin; } 
-   unsigned int End() const { return fEnd; } 
-   
-private: 
-
-   const unsigned int fBegin; 
-   const unsigned int fEnd; 
-   const BinData * fData; 
-   IModelFunction * fFunc; 
-   double fSum;
-   unsigned int fNRej; 
-};
-
-
-// function used by the threads
-void *EvaluateResidual(void * ptr) { 
-
-   ThreadData * t = (ThreadData *) ptr; 
-
-   unsigned int istart = t->Begin();
-   unsigned int iend = t->End(); 
-   double chi2 = 0;
-   unsigned int nRejected = 0;
-   const int nthreads = NUMBER_OF_THREADS; 
-
-   const BinData & data = t->Data();
-   IModelFunction & func = t->Func();
-   for (unsigned int i = istart; i < iend; i+=nthreads) { 
-      const double * x = data.Coords(i); 
-      double y = data.Value(i);
-      double invError = data.InvError(i);
-      double fval = 0; 
-      fval = func ( x ); 
-
-// #ifdef DEBUG      
-//       std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
-//       for (int ipar = 0; ipar < func.NPar(); ++ipar) 
-//          std::cout << p[ipar] << "\t";
-//       std::cout << "\tfval = " << fval << std::endl; 
-// #endif
-
-      // avoid singularity in the function (infinity and nan ) in the chi2 sum 
-      // eventually add possibility of excluding some points (like singularity) 
-      if (fval > - std::numeric_limits<double>::max() && fval < std::numeric_limits<double>::max() ) { 
-         // calculat chi2 point
-         double tmp = ( y -fval )* invError;  	  
-         chi2 += tmp*tmp;
-      }
-      else 
-         nRejected++; 
-      
-   }
-
-#ifdef DEBUG
-   std::cout << "end loop " << istart << "  " << iend << " chi2 = " << chi2 << " nrej " << nRejected << std::endl; 
-#endif
-   t->Set(nRejected,chi2);
-   return 0;
+namespace ROOT {
+
+   namespace Fit {
+
+      namespace FitUtilParallel {
+
+         // evaluation of the chunks of one task, shared by the threads:
+         // the part i of the job evaluates the chunks i, i+nparts, i+2*nparts, ...
+         class ChunkJob : public TThreadTeam::TJob {
+
+         public:
+
+            ChunkJob(const ChunkTask & task, unsigned int n) :
+               fTask(task),
+               fN(n),
+               fNSums(task.NSums() ),
+               fNChunks( (n + kChunkSize - 1) / kChunkSize ),
+               fNParts(1),
+               fSums( fNChunks * task.NSums() )
+            {}
+
+            unsigned int NChunks() const { return fNChunks; }
+
+            // evaluate all the chunks in nparts parts run concurrently
+            void RunParts(unsigned int nparts) {
+               fNParts = nparts;
+               TThreadTeam::Run(*this, nparts);
+            }
+
+            void Run(UInt_t ipart) {
+               for (unsigned int i = ipart; i < fNChunks; i += fNParts) RunChunk(i);
+            }
+
+            // evaluate the chunk ichunk, its sums are stored in its own slot
+            void RunChunk(unsigned int ichunk) {
+               unsigned int begin = ichunk * kChunkSize;
+               unsigned int end = std::min(begin + kChunkSize, fN);
+               fTask.Evaluate(begin, end, &fSums[ichunk * fNSums]);
+            }
+
+            // add the sums of the chunks pairwise in the chunk order: the result
+            // depends only on the chunk size, not on which thread evaluated a chunk
+            void Reduce(double * sums) const {
+               for (unsigned int k = 0; k < fNSums; ++k)
+                  sums[k] += PairwiseSum(k, 0, fNChunks);
+            }
+
+         private:
+
+            double PairwiseSum(unsigned int k, unsigned int first, unsigned int last) const {
+               if (last - first == 1) return fSums[first * fNSums + k];
+               unsigned int mid = first + (last - first) / 2;
+               return PairwiseSum(k, first, mid) + PairwiseSum(k, mid, last);
+            }
+
+            const ChunkTask & fTask;
+            unsigned int fN;
+            unsigned int fNSums;
+            unsigned int fNChunks;
+            unsigned int fNParts;          // number of parts evaluating the chunks
+            std::vector<double> fSums;     // sums of each chunk
+         };
+
+//______________________________________________________________________________
+unsigned int DefaultNThreads() {
+   // number of threads used by default by the kMultithread policy
+   return TThreadTeam::GetNCores();
 }
 
-double EvaluateChi2(IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {  
-   // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints 
-   // the actual number of used points
-
-   const int nthreads = NUMBER_OF_THREADS; 
-   
-   unsigned int n = data.Size();
+//______________________________________________________________________________
+void Evaluate(const ChunkTask & task, unsigned int n, double * sums, ExecutionPolicy policy, unsigned int nThreads) {
+   // compute the sums of the task on the n data points, which are added to sums.
+   // In the serial case the task is evaluated on all the points at once
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-#endif
-
-   func.SetParameters(p); 
-
-   // start the threads
-   pthread_t   thread[nthreads];
-   ThreadData *  td[nthreads]; 
-   unsigned int istart = 0; 
-   for (int ithread = 0; ithread < nthreads; ++ithread) { 
-//       int n_th = n/nthreads;
-//       if (ithread == 0 ) n_th += n%nthreads;
-//       int iend = istart + n_th;
-      int iend = n; 
-      istart = ithread;  
-      td[ithread] = new ThreadData(istart,iend,data,func);
-      pthread_create(&thread[ithread], NULL, EvaluateResidual, td[ithread]); 
-      //istart = iend;
+   if (policy == kSerial) {
+      task.Evaluate(0, n, sums);
+      return;
    }
+   if (n == 0) return;
 
-   for (int ithread = 0; ithread < nthreads; ++ithread)  
-      pthread_join(thread[ithread], NULL); 
-
-   // sum finally the results of the various threads
-
-   double chi2 = 0; 
-   int nRejected = 0;
-   for (int ithread = 0; ithread < nthreads; ++ithread) { 
-      nRejected += td[ithread]->NRej();
-      chi2 += td[ithread]->Sum();
-      delete td[ithread]; 
-   }
-   
-
-#ifdef DEBUG
-   std::cout << "chi2 = " << chi2 << " n = " << nRejected << std::endl;
-#endif
-   
-   nPoints = n - nRejected;
-   return chi2;
-
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// use open MP 
-#else 
-
-double EvaluateChi2(IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) { 
-   return FitUtil::EvaluateChi2(func,data,p,nPoints); 
-}
-
-
-// use openMP (log-likelihood calculation)
-
-inline double EvalLogF(double fval) { 
-   // evaluate the log with a protections against negative argument to the log 
-   // smooth linear extrapolation below function values smaller than  epsilon
-   // (better than a simple cut-off)
-   const static double epsilon = 2.*std::numeric_limits<double>::min();
-   if(fval<= epsilon) 
-      return fval/epsilon + std::log(epsilon) - 1; 
-   else      
-      return std::log(fval);
-}
-
-
-double EvaluateLogL(IModelFunction & func, const UnBinData & data, const double * p, unsigned int &nPoints) {  
-   // evaluate the LogLikelihood 
-
-   unsigned int n = data.Size();
-
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   //std::cout << "func pointer is " << typeid(func).name() << std::endl;
-   std::cout << "\tpar = [ " << func.NPar() << " ] =  "; 
-   for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
-      std::cout << p[ipar] << ", ";
-   std::cout <<"---------------------------\n";
-#endif
-
-   double logl = 0;
-   int nRejected = 0; 
-//   func.SetParameters(p); 
-
-   //std::vector<double> sum( MAX_THREAD ); 
-
-
-#pragma omp parallel
-#pragma omp for reduction (+:logl,nRejected)
-//#pragma omp for reduction (+:logl,nRejected) schedule (static, 10)
-//#pragma omp reduction (+:nRejected) 
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-
-      //int ith = omp_get_thread_num();
-      //func.SetParameters(p); 
-
-      const double * x = data.Coords(i);
-      double fval = func ( x, p  ); // this is thread safe passing the params 
-
-      if (fval < 0) { 
-         nRejected++; // reject points with negative pdf (cannot exist)
-      }
-      else 
-         //sum[ith] += EvalLogF( fval); 
-         logl += EvalLogF( fval); 
-
-#ifdef DEBUG      
-#pragma omp critical 
-      {     std::cout << " ==== i = " << i << " thread " << omp_get_thread_num() 
-                      << "fval = " << fval << " logl = " << logl << std::endl;}
-//       std::cout << "x [ " << data.PointSize() << " ] = "; 
-//       for (unsigned int j = 0; j < data.PointSize(); ++j)
-//          std::cout << x[j] << "\t"; 
-#endif
-   }
-   
-   // reset the number of fitting data points
-   if (nRejected != 0)  nPoints = n - nRejected;
+   ChunkJob job(task, n);
+   if (nThreads == 0) nThreads = DefaultNThreads();
+   nThreads = std::min(nThreads, job.NChunks() );
 
 #ifdef DEBUG
-   ncalls++;
-   int pr = std::cout.precision(15);
-   std::cout << "ncalls " << ncalls << " Logl = " << logl << " np = " << nPoints << std::endl;
-   std::cout.precision(pr);
-   assert(ncalls<3);
+   std::cout << "FitUtilParallel::Evaluate " << n << " points in " << job.NChunks() << " chunks with "
+             << nThreads << " threads" << std::endl;
 #endif
 
-   // logl = std::accumulate(sum.begin(), sum.end(),0. );
-
-   double result = - logl; 
-   return result;
+   job.RunParts(nThreads);
+   job.Reduce(sums);
 }
 
-#endif
-
-
       } // end namespace FitUtilParallel
 
    } // end namespace Fit
 
 } // end namespace ROOT
-
-
-
-
-#endif
@@ -332,6 +332,7 @@ bool Fitter::DoLeastSquareFit(const BinData & data) {
    if (!fUseGradient) { 
       // do minimzation without using the gradient
       Chi2FCN<BaseFunc> chi2(data,*fFunc); 
+      chi2.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
       fFitType = chi2.Type();
       return DoMinimization (chi2); 
    } 
@@ -342,6 +343,7 @@ bool Fitter::DoLeastSquareFit(const BinData & data) {
       IGradModelFunction * gradFun = dynamic_cast<IGradModelFunction *>(fFunc); 
       if (gradFun != 0) { 
          Chi2FCN<BaseGradFunc> chi2(data,*gradFun); 
+         chi2.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
          fFitType = chi2.Type();
          return DoMinimization (chi2); 
       }
@@ -378,10 +380,12 @@ bool Fitter::DoLikelihoodFit(const BinData & data, bool extended) {
 
    // create a chi2 function to be used for the equivalent chi-square
    Chi2FCN<BaseFunc> chi2(data,*fFunc); 
+   chi2.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
 
    if (!fUseGradient) { 
       // do minimization without using the gradient
       PoissonLikelihoodFCN<BaseFunc> logl(data,*fFunc, useWeight, extended); 
+      logl.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false; 
@@ -405,6 +409,7 @@ bool Fitter::DoLikelihoodFit(const BinData & data, bool extended) {
          MATH_WARN_MSG("Fitter::DoLikelihoodFit","Not-extended binned fit with gradient not yet supported - do an extended fit");        
       }
       PoissonLikelihoodFCN<BaseGradFunc> logl(data,*gradFun, useWeight, true); 
+      logl.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -449,6 +454,7 @@ bool Fitter::DoLikelihoodFit(const UnBinData & data, bool extended) {
    if (!fUseGradient) { 
       // do minimization without using the gradient
       LogLikelihoodFCN<BaseFunc> logl(data,*fFunc, useWeight, extended); 
+      logl.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
       fFitType = logl.Type();
       if (!DoMinimization (logl) ) return false;
       if (useWeight) { 
@@ -467,6 +473,7 @@ bool Fitter::DoLikelihoodFit(const UnBinData & data, bool extended) {
             MATH_WARN_MSG("Fitter::DoLikelihoodFit","Extended unbinned fit with gradient not yet supported - do a not-extended fit");        
          }
          LogLikelihoodFCN<BaseGradFunc> logl(data,*gradFun,useWeight, extended); 
+         logl.SetExecutionPolicy(fConfig.GetExecutionPolicy(), fConfig.NThreads() );
          fFitType = logl.Type();
          if (!DoMinimization (logl) ) return false;
          if (useWeight) { 
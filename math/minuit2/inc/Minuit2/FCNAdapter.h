@@ -36,10 +36,20 @@ public:
 
    FCNAdapter(const Function & f, double up = 1.) : 
       fFunc(f) , 
-      fUp (up)
+      fUp (up) , 
+      fOwnedFunc(0)
    {}
 
-   ~FCNAdapter() {}
+   ~FCNAdapter() { delete fOwnedFunc; }
+
+   /// copy of the adapter owning a copy of the function (Function::Clone)
+   FCNBase * Clone() const { 
+      Function * f = dynamic_cast<Function *>(fFunc.Clone() );
+      if (f == 0) return 0;
+      FCNAdapter * fcn = new FCNAdapter(*f, fUp);
+      fcn->fOwnedFunc = f;
+      return fcn;
+   }
 
   
    double operator()(const std::vector<double>& v) const { 
@@ -58,8 +68,12 @@ public:
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
 
 private:
+   FCNAdapter(const FCNAdapter &);
+   FCNAdapter & operator=(const FCNAdapter &);
+
    const Function & fFunc; 
    double fUp; 
+   Function * fOwnedFunc;   // function owned by the copies made by Clone
 };
 
    } // end namespace Minuit2
@@ -111,6 +111,15 @@ public:
    */ 
    virtual void SetErrorDef(double ) {}; 
 
+   /** 
+       copy of the function, used by the threads computing the numerical derivatives 
+       concurrently (see MnStrategy::SetNThreads). The copy and the original function must 
+       support being evaluated at the same time by different threads. 
+       By default the function cannot be copied (return 0) and the derivatives are computed 
+       in sequence. 
+   */ 
+   virtual FCNBase * Clone() const { return 0; }
+
 };
 
   }  // namespace Minuit2
@@ -42,11 +42,21 @@ public:
    FCNGradAdapter(const Function & f, double up = 1.) : 
       fFunc(f) , 
       fUp (up) , 
-      fGrad(std::vector<double>(fFunc.NDim() ) ) 
+      fGrad(std::vector<double>(fFunc.NDim() ) ) , 
+      fOwnedFunc(0)
 
    {}
 
-   ~FCNGradAdapter() {}
+   ~FCNGradAdapter() { delete fOwnedFunc; }
+
+   /// copy of the adapter owning a copy of the function (Function::Clone)
+   FCNBase * Clone() const { 
+      Function * f = dynamic_cast<Function *>(fFunc.Clone() );
+      if (f == 0) return 0;
+      FCNGradAdapter * fcn = new FCNGradAdapter(*f, fUp);
+      fcn->fOwnedFunc = f;
+      return fcn;
+   }
 
   
    double operator()(const std::vector<double>& v) const { 
@@ -74,9 +84,13 @@ public:
    bool CheckGradient() const { return false; } 
 
 private:
+   FCNGradAdapter(const FCNGradAdapter &);
+   FCNGradAdapter & operator=(const FCNGradAdapter &);
+
    const Function & fFunc; 
    double fUp; 
    mutable std::vector<double> fGrad; 
+   Function * fOwnedFunc;   // function owned by the copies made by Clone
 };
 
    } // end namespace Minuit2
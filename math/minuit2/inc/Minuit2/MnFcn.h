@@ -29,18 +29,33 @@ class FCNBase;
    might be given if the class is  instantiated later on, for example for a set of different minimizaitons
    Normally the derived class MnUserFCN should be instantiated with performs in addition the transformatiopn 
    internal-> external parameters 
+   For the parallel calculation of the numerical derivatives (see MnThreadProcess and 
+   MnStrategy::SetNThreads) the class keeps a copy of the FCN for each thread other than
+   the calling one, obtained with FCNBase::Clone, and counts the calls of each thread separately.
  */
 class MnFcn {
 
 public:
 
    /// constructor of 
-   explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fNumCall(ncall) {}
+   explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fCannotCopy(false), fNumCall(ncall) {}
+
+   /// copy constructor: the copies of the FCN used by the threads are not copied
+   MnFcn(const MnFcn& fcn) : fFCN(fcn.fFCN), fCannotCopy(fcn.fCannotCopy), fNumCall(fcn.NumOfCalls()) {}
 
   virtual ~MnFcn();
 
   virtual double operator()(const MnAlgebraicVector&) const;
-  unsigned int NumOfCalls() const {return fNumCall;}
+  unsigned int NumOfCalls() const;
+
+  /// create the copies of the FCN used by the threads 1,...,nthreads-1 of a parallel calculation.
+  /// Return false if the FCN cannot be copied (FCNBase::Clone returns 0): the copy is then
+  /// not tried again
+  bool InitThreads(unsigned int nthreads) const;
+
+  /// evaluate the FCN in the thread ithread of a parallel calculation, with the copy of the FCN
+  /// of the thread (the FCN itself for the thread 0). InitThreads must have been called before
+  double ThreadEval(unsigned int ithread, const MnAlgebraicVector&) const;
 
   //
   //forward interface
@@ -50,9 +65,19 @@ public:
 
   const FCNBase& Fcn() const {return fFCN;}
 
+protected:
+
+  /// conversion of the vector of internal values to the vector of parameters of the FCN
+  virtual std::vector<double> Transform(const MnAlgebraicVector&) const;
+
 private:
 
+  MnFcn& operator=(const MnFcn&);
+
   const FCNBase& fFCN;
+  mutable std::vector<FCNBase*> fThreadFcns;   // copies of the FCN for the threads 1,2,...
+  mutable std::vector<int> fThreadNumCalls;    // number of calls made by the threads 1,2,...
+  mutable bool fCannotCopy;                    // the FCN cannot be copied
 
 protected:
 
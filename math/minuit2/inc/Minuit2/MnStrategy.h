@@ -48,6 +48,7 @@ public:
    unsigned int HessianGradientNCycles() const {return fHessGradNCyc;}
 
    int StorageLevel() const { return fStoreLevel; }
+   unsigned int NThreads() const { return fNThreads; }
  
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
@@ -69,6 +70,11 @@ public:
    // set storage level of iteration quantities 
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set the number of threads computing concurrently the derivatives of the numerical gradient 
+   // and the elements of the Hessian, each with its own copy of the FCN (FCNBase::Clone)
+   // 1 = serial calculation (default), 0 = one thread per core
+   void SetNThreads(unsigned int n) { fNThreads = n; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +87,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel; 
+   unsigned int fNThreads;
 };
 
   }  // namespace Minuit2
@@ -0,0 +1,74 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnThreadProcess
+#define ROOT_Minuit2_MnThreadProcess
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   Shared memory version of MPIProcess: the nelements elements of a calculation
+   (the parameters of the numerical gradient, the elements of the Hessian) are
+   partitioned in contiguous ranges, one for each thread, and the ranges are
+   computed concurrently by Run in the threads of the TThreadTeam, kept between the calls.
+   The range of the thread 0 is computed by the calling thread. Each thread evaluates the FCN with its own copy
+   (see MnFcn::ThreadEval), so that the results do not depend on the number of threads.
+   The standalone Minuit2 (built without ROOT) computes the ranges in sequence.
+ */
+class MnThreadProcess {
+
+public:
+
+   /// computation of a range of elements by one thread
+   class Task {
+   public:
+      virtual ~Task() {}
+      /// compute the elements [begin, end) in the thread ithread
+      virtual void Run(unsigned int ithread, unsigned int begin, unsigned int end) = 0;
+   };
+
+   /// partition nelements in nthreads ranges (number of cores if nthreads is zero)
+   MnThreadProcess(unsigned int nelements, unsigned int nthreads);
+
+   ~MnThreadProcess() {}
+
+   unsigned int NThreads() const { return fNThreads; }
+
+   inline unsigned int NumElements4Job(unsigned int ithread) const
+   { return fNumElements4JobIn + ((ithread < fNumElements4JobOut) ? 1 : 0); }
+
+   inline unsigned int StartElementIndex(unsigned int ithread) const
+   { return ((ithread < fNumElements4JobOut) ? (ithread*NumElements4Job(ithread)) :
+             (fNelements - (fNThreads-ithread)*NumElements4Job(ithread))); }
+
+   inline unsigned int EndElementIndex(unsigned int ithread) const
+   { return StartElementIndex(ithread) + NumElements4Job(ithread); }
+
+   /// compute the ranges of all the threads and wait for their end
+   void Run(Task & task) const;
+
+   /// number of available cores
+   static unsigned int DefaultNThreads();
+
+private:
+
+   unsigned int fNelements;
+   unsigned int fNThreads;
+   unsigned int fNumElements4JobIn;
+   unsigned int fNumElements4JobOut;
+
+};
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnThreadProcess
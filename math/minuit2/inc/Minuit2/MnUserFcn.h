@@ -32,7 +32,9 @@ public:
 
   ~MnUserFcn() {}
 
-  virtual double operator()(const MnAlgebraicVector&) const;
+protected:
+
+  virtual std::vector<double> Transform(const MnAlgebraicVector&) const;
 
 private:
 
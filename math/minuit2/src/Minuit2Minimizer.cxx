@@ -459,6 +459,11 @@ bool Minuit2Minimizer::Minimize() {
       int storageLevel = 1; 
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
+
+      // threads computing the numerical derivatives (0 = one per core)
+      int nThreads = 1;
+      ret = minuit2Opt->GetValue("NThreads",nThreads);
+      if (ret && nThreads >= 0) strategy.SetNThreads(nThreads);
       
    }
 
@@ -1009,7 +1014,7 @@ bool Minuit2Minimizer::Hesse( ) {
       return false; 
    }
 
-   int strategy = Strategy();
+   int strategyLevel = Strategy();
    int maxfcn = MaxFunctionCalls(); 
 
    // switch off Minuit2 printing
@@ -1020,6 +1025,13 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
+   // threads computing the numerical derivatives (0 = one per core)
+   ROOT::Minuit2::MnStrategy strategy(strategyLevel);
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int nThreads = 1;
+   if (minuit2Opt && minuit2Opt->GetValue("NThreads",nThreads) && nThreads >= 0) 
+      strategy.SetNThreads(nThreads);
+
    ROOT::Minuit2::MnHesse hesse( strategy );
 
    // case when function minimum exists
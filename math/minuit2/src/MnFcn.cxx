@@ -10,6 +10,7 @@
 #include "Minuit2/MnFcn.h"
 #include "Minuit2/FCNBase.h"
 #include "Minuit2/MnVectorTransform.h"
+#include "Minuit2/MnPrint.h"
 
 namespace ROOT {
 
@@ -18,12 +19,49 @@ namespace ROOT {
 
 MnFcn::~MnFcn() {
    //   std::cout<<"Total number of calls to FCN: "<<fNumCall<<std::endl;
+   for (unsigned int i = 0; i < fThreadFcns.size(); ++i) delete fThreadFcns[i];
 }
 
 double MnFcn::operator()(const MnAlgebraicVector& v) const {
    // evaluate FCN converting from from MnAlgebraicVector to std::vector
    fNumCall++;
-   return fFCN(MnVectorTransform()(v));
+   return fFCN(Transform(v));
+}
+
+std::vector<double> MnFcn::Transform(const MnAlgebraicVector& v) const {
+   // convert from MnAlgebraicVector to std::vector
+   return MnVectorTransform()(v);
+}
+
+unsigned int MnFcn::NumOfCalls() const {
+   // number of calls, including the ones made by the threads of the parallel calculations
+   int ncall = fNumCall;
+   for (unsigned int i = 0; i < fThreadNumCalls.size(); ++i) ncall += fThreadNumCalls[i];
+   return ncall;
+}
+
+bool MnFcn::InitThreads(unsigned int nthreads) const {
+   // create the missing copies of the FCN for the threads 1,...,nthreads-1.
+   // Must be called by the thread using the MnFcn, before starting the other threads
+   if (fCannotCopy) return false;
+   while (fThreadFcns.size() + 1 < nthreads) {
+      FCNBase * fcn = fFCN.Clone();
+      if (fcn == 0) {
+         MN_INFO_MSG("MnFcn: FCN cannot be copied - the derivatives are computed by one thread");
+         fCannotCopy = true;
+         return false;
+      }
+      fThreadFcns.push_back(fcn);
+      fThreadNumCalls.push_back(0);
+   }
+   return true;
+}
+
+double MnFcn::ThreadEval(unsigned int ithread, const MnAlgebraicVector& v) const {
+   // evaluate the FCN copy of the thread ithread; each thread counts its own calls
+   if (ithread == 0) return (*this)(v);
+   fThreadNumCalls[ithread-1]++;
+   return (*fThreadFcns[ithread-1])(Transform(v));
 }
 
 // double MnFcn::operator()(const std::vector<double>& par) const {
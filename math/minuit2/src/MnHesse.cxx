@@ -26,12 +26,180 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "Minuit2/MnThreadProcess.h"
+
+#include <vector>
+#include <algorithm>
 
 namespace ROOT {
 
    namespace Minuit2 {
 
 
+namespace {
+
+// compute the diagonal element i of the Hessian (g2(i)) and the corresponding first derivative, step 
+// and function value used for the off-diagonal elements, evaluating the FCN in the thread ithread 
+// (see MnFcn::ThreadEval). x is the copy of the parameters used by the thread. 
+// Return false if the second derivative is zero
+bool HesseDiagonal(const MnHesse& hesse, const MnFcn& mfcn, unsigned int ithread, const MnUserTransformation& trafo, 
+                   MnAlgebraicVector& x, unsigned int i, double amin, double aimsag, 
+                   MnAlgebraicVector& g2, MnAlgebraicVector& grd, MnAlgebraicVector& gst, 
+                   MnAlgebraicVector& dirin, MnAlgebraicVector& yy) {
+
+   const MnMachinePrecision& prec = trafo.Precision();
+
+   double xtf = x(i);
+   double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
+   double d = fabs(gst(i));
+   if(d < dmin) d = dmin;
+
+#ifdef DEBUG
+   std::cout << "\nDerivative parameter  " << i << " d = " << d << " dmin = " << dmin << std::endl;
+#endif
+
+   
+   for(unsigned int icyc = 0; icyc < hesse.Ncycles(); icyc++) {
+      double sag = 0.;
+      double fs1 = 0.;
+      double fs2 = 0.;
+      for(unsigned int multpy = 0; multpy < 5; multpy++) {
+         x(i) = xtf + d;
+         fs1 = mfcn.ThreadEval(ithread, x);
+         x(i) = xtf - d;
+         fs2 = mfcn.ThreadEval(ithread, x);
+         x(i) = xtf;
+         sag = 0.5*(fs1+fs2-2.*amin);
+
+#ifdef DEBUG
+         std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl; 
+#endif
+         //  Now as F77 Minuit - check taht sag is not zero
+         if (sag != 0) goto L30; // break
+         if(trafo.Parameter(i).HasLimits()) {
+            if(d > 0.5) goto L26;
+            d *= 10.;
+            if(d > 0.5) d = 0.51;
+            continue;
+         }
+         d *= 10.;
+      }
+      
+L26:  
+      // the second derivative is zero
+      return false;
+      
+L30:      
+         double g2bfor = g2(i);
+      g2(i) = 2.*sag/(d*d);
+      grd(i) = (fs1-fs2)/(2.*d);
+      gst(i) = d;
+      dirin(i) = d;
+      yy(i) = fs1;
+      double dlast = d;
+      d = sqrt(2.*aimsag/fabs(g2(i)));
+      if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
+      if(d < dmin) d = dmin;
+
+#ifdef DEBUG
+      std::cout << "\t g1 = " << grd(i) << " g2 = " << g2(i) << " step = " << gst(i) << " d = " << d 
+                << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(g2(i)-g2bfor)/g2(i) << std::endl;
+#endif
+
+      
+      // see if converged
+      if(fabs((d-dlast)/d) < hesse.Tolerstp()) break;
+      if(fabs((g2(i)-g2bfor)/g2(i)) < hesse.TolerG2()) break; 
+      d = std::min(d, 10.*dlast);
+      d = std::max(d, 0.1*dlast);   
+   }
+   return true;
+}
+
+// computation of the diagonal elements [first+begin, first+end) of the Hessian by one thread
+class HesseDiagonalTask : public MnThreadProcess::Task {
+
+public:
+
+   HesseDiagonalTask(const MnHesse& hesse, const MnFcn& mfcn, const MnUserTransformation& trafo, 
+                     const MnAlgebraicVector& par, double amin, double aimsag, 
+                     MnAlgebraicVector& g2, MnAlgebraicVector& grd, MnAlgebraicVector& gst, 
+                     MnAlgebraicVector& dirin, MnAlgebraicVector& yy, std::vector<int>& status, 
+                     unsigned int first) : 
+      fHesse(hesse), fFcn(mfcn), fTrafo(trafo), fPar(par), fAmin(amin), fAimsag(aimsag), 
+      fG2(g2), fGrd(grd), fGst(gst), fDirin(dirin), fYY(yy), fStatus(status), fFirst(first) {}
+
+   void Run(unsigned int ithread, unsigned int begin, unsigned int end) {
+      // each thread modifies its own copy of the parameters
+      MnAlgebraicVector x = fPar;
+      for (unsigned int i = fFirst + begin; i < fFirst + end; i++) 
+         fStatus[i] = HesseDiagonal(fHesse, fFcn, ithread, fTrafo, x, i, fAmin, fAimsag, fG2, fGrd, fGst, fDirin, fYY);
+   }
+
+private:
+
+   const MnHesse& fHesse;
+   const MnFcn& fFcn;
+   const MnUserTransformation& fTrafo;
+   const MnAlgebraicVector& fPar;
+   double fAmin;
+   double fAimsag;
+   MnAlgebraicVector& fG2;
+   MnAlgebraicVector& fGrd;
+   MnAlgebraicVector& fGst;
+   MnAlgebraicVector& fDirin;
+   MnAlgebraicVector& fYY;
+   std::vector<int>& fStatus;   // result of HesseDiagonal for each parameter
+   unsigned int fFirst;         // first parameter of the batch
+};
+
+// computation of the off-diagonal elements [begin, end) of the Hessian by one thread. 
+// The elements (i,j), i < j, are numbered row by row
+class HesseOffDiagonalTask : public MnThreadProcess::Task {
+
+public:
+
+   HesseOffDiagonalTask(const MnFcn& mfcn, const MnAlgebraicVector& par, double amin, 
+                        const MnAlgebraicVector& dirin, const MnAlgebraicVector& yy, MnAlgebraicSymMatrix& vhmat) : 
+      fFcn(mfcn), fPar(par), fAmin(amin), fDirin(dirin), fYY(yy), fVhmat(vhmat) {}
+
+   void Run(unsigned int ithread, unsigned int begin, unsigned int end) {
+      unsigned int n = fPar.size();
+      MnAlgebraicVector x = fPar;
+      // row and column of the element begin
+      unsigned int i = 0;
+      unsigned int k = begin;
+      while (k >= n-1-i) {
+         k -= n-1-i;
+         i++;
+      }
+      unsigned int j = i+1+k;
+      for (unsigned int in = begin; in < end; in++) {
+         x(i) += fDirin(i);
+         x(j) += fDirin(j);
+         double fs1 = fFcn.ThreadEval(ithread, x);
+         fVhmat(i,j) = (fs1 + fAmin - fYY(i) - fYY(j))/(fDirin(i)*fDirin(j));
+         x(i) = fPar(i);
+         x(j) = fPar(j);
+         if (++j == n) {
+            i++;
+            j = i+1;
+         }
+      }
+   }
+
+private:
+
+   const MnFcn& fFcn;
+   const MnAlgebraicVector& fPar;
+   double fAmin;
+   const MnAlgebraicVector& fDirin;
+   const MnAlgebraicVector& fYY;
+   MnAlgebraicSymMatrix& fVhmat;
+};
+
+}
+
 MnUserParameterState MnHesse::operator()(const FCNBase& fcn, const std::vector<double>& par, const std::vector<double>& err, unsigned int maxcalls) const { 
    // interface from vector of params and errors
    return (*this)(fcn, MnUserParameterState(par, err), maxcalls);
@@ -127,45 +295,27 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
    
+   // with several threads the diagonal and then the off-diagonal elements are shared among the 
+   // threads, each evaluating its own copy of the FCN. The serial (or MPI) calculation is used 
+   // if the FCN cannot be copied
+   MnThreadProcess diagproc(n, fStrategy.NThreads());
+   MnThreadProcess offdiagproc(n*(n-1)/2, fStrategy.NThreads());
+   bool useThreads = (diagproc.NThreads() > 1 || offdiagproc.NThreads() > 1) && 
+      mfcn.InitThreads(std::max(diagproc.NThreads(), offdiagproc.NThreads()) );
+   std::vector<int> diagStatus(n, 1);
+   unsigned int nbatch = diagproc.NThreads();
+   
    for(unsigned int i = 0; i < n; i++) {
       
-      double xtf = x(i);
-      double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
-      double d = fabs(gst(i));
-      if(d < dmin) d = dmin;
-
-#ifdef DEBUG
-      std::cout << "\nDerivative parameter  " << i << " d = " << d << " dmin = " << dmin << std::endl;
-#endif
-
-      
-      for(unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
-         double sag = 0.;
-         double fs1 = 0.;
-         double fs2 = 0.;
-         for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
-            sag = 0.5*(fs1+fs2-2.*amin);
-
-#ifdef DEBUG
-            std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl; 
-#endif
-            //  Now as F77 Minuit - check taht sag is not zero
-            if (sag != 0) goto L30; // break
-            if(trafo.Parameter(i).HasLimits()) {
-               if(d > 0.5) goto L26;
-               d *= 10.;
-               if(d > 0.5) d = 0.51;
-               continue;
-            }
-            d *= 10.;
-         }
-         
-L26:  
+      // with threads the diagonal elements are computed in batches of one parameter per thread, 
+      // so that the maximum number of calls below is checked after each batch
+      if (useThreads && i % nbatch == 0) {
+         HesseDiagonalTask task(*this, mfcn, trafo, x, amin, aimsag, g2, grd, gst, dirin, yy, diagStatus, i);
+         MnThreadProcess(std::min(nbatch, n - i), nbatch).Run(task);
+      }
+      bool ok = (useThreads) ? diagStatus[i] != 0 : 
+         HesseDiagonal(*this, mfcn, 0, trafo, x, i, amin, aimsag, g2, grd, gst, dirin, yy);
+      if (!ok) {
 #ifdef WARNINGMSG
 
          // get parameter name for i
@@ -183,30 +333,6 @@ L26:
          }
          
          return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
-         
-L30:      
-            double g2bfor = g2(i);
-         g2(i) = 2.*sag/(d*d);
-         grd(i) = (fs1-fs2)/(2.*d);
-         gst(i) = d;
-         dirin(i) = d;
-         yy(i) = fs1;
-         double dlast = d;
-         d = sqrt(2.*aimsag/fabs(g2(i)));
-         if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
-         if(d < dmin) d = dmin;
-
-#ifdef DEBUG
-         std::cout << "\t g1 = " << grd(i) << " g2 = " << g2(i) << " step = " << gst(i) << " d = " << d 
-                   << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(g2(i)-g2bfor)/g2(i) << std::endl;
-#endif
-
-         
-         // see if converged
-         if(fabs((d-dlast)/d) < Tolerstp()) break;
-         if(fabs((g2(i)-g2bfor)/g2(i)) < TolerG2()) break; 
-         d = std::min(d, 10.*dlast);
-         d = std::max(d, 0.1*dlast);   
       }
       vhmat(i,i) = g2(i);
       if(mfcn.NumOfCalls()  > maxcalls) {
@@ -241,39 +367,45 @@ L30:
    }
    
    //off-diagonal Elements  
-   // initial starting values
-   MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
-   unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-   unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
+   if (useThreads) {
+      HesseOffDiagonalTask task(mfcn, x, amin, dirin, yy, vhmat);
+      offdiagproc.Run(task);
+   }
+   else {
+      // initial starting values
+      MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
+      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-   unsigned int offsetVect = 0;
-   for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-      if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+      unsigned int offsetVect = 0;
+      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-   for (unsigned int in = startParIndexOffDiagonal;
-        in<endParIndexOffDiagonal; in++) {
+      for (unsigned int in = startParIndexOffDiagonal;
+           in<endParIndexOffDiagonal; in++) {
 
-      int i = (in+offsetVect)/(n-1);
-      if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-      int j = (in+offsetVect)%(n-1)+1;
+         int i = (in+offsetVect)/(n-1);
+         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+         int j = (in+offsetVect)%(n-1)+1;
 
-      if ((i+1)==j || in==startParIndexOffDiagonal)
-         x(i) += dirin(i);
+         if ((i+1)==j || in==startParIndexOffDiagonal)
+            x(i) += dirin(i);
       
-      x(j) += dirin(j);
+         x(j) += dirin(j);
       
-      double fs1 = mfcn(x);
-      double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-      vhmat(i,j) = elem;
+         double fs1 = mfcn(x);
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
       
-      x(j) -= dirin(j);
+         x(j) -= dirin(j);
       
-      if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-         x(i) -= dirin(i);
+         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+            x(i) -= dirin(i);
       
-   }
+      }
    
-   mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+      mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+   }
 
    //verify if matrix pos-def (still 2nd derivative)
 
@@ -0,0 +1,82 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/MnThreadProcess.h"
+
+#ifdef USE_ROOT_ERROR  // the standalone Minuit2 computes the ranges in sequence
+#include "TThreadTeam.h"
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+#ifdef USE_ROOT_ERROR
+
+namespace {
+
+   // the range of each thread of a MnThreadProcess as a part of a TThreadTeam job
+   class RangeJob : public TThreadTeam::TJob {
+
+   public:
+
+      RangeJob(const MnThreadProcess & proc, MnThreadProcess::Task & task) :
+         fProc(proc), fTask(task) {}
+
+      void Run(UInt_t ithread) {
+         fTask.Run(ithread, fProc.StartElementIndex(ithread), fProc.EndElementIndex(ithread));
+      }
+
+   private:
+
+      const MnThreadProcess & fProc;
+      MnThreadProcess::Task & fTask;
+   };
+
+}
+
+#endif
+
+MnThreadProcess::MnThreadProcess(unsigned int nelements, unsigned int nthreads) :
+   fNelements(nelements), fNThreads(nthreads)
+{
+   // partition the elements among the threads: there are no more threads than elements
+   if (fNThreads == 0) fNThreads = DefaultNThreads();
+   if (fNThreads > fNelements) fNThreads = fNelements;
+   if (fNThreads == 0) fNThreads = 1;
+   fNumElements4JobIn = fNelements / fNThreads;
+   fNumElements4JobOut = fNelements % fNThreads;
+}
+
+void MnThreadProcess::Run(Task & task) const {
+   // compute the ranges of all the threads: the range of the thread 0 in the calling thread,
+   // the other ones in the threads of the TThreadTeam (or in sequence by the calling thread
+   // when the team is busy with another computation)
+
+#ifdef USE_ROOT_ERROR
+   RangeJob job(*this, task);
+   TThreadTeam::Run(job, fNThreads);
+#else
+   for (unsigned int i = 0; i < fNThreads; ++i)
+      task.Run(i, StartElementIndex(i), EndElementIndex(i));
+#endif
+}
+
+unsigned int MnThreadProcess::DefaultNThreads() {
+   // number of threads used when zero threads are requested
+#ifdef USE_ROOT_ERROR
+   return TThreadTeam::GetNCores();
+#else
+   return 1;
+#endif
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
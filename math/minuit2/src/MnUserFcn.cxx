@@ -16,9 +16,8 @@ namespace ROOT {
    namespace Minuit2 {
 
 
-double MnUserFcn::operator()(const MnAlgebraicVector& v) const {
-   // call Fcn function transforming from a MnAlgebraicVector of internal values to a std::vector of external ones 
-   fNumCall++;
+std::vector<double> MnUserFcn::Transform(const MnAlgebraicVector& v) const {
+   // transform from a MnAlgebraicVector of internal values to a std::vector of external ones 
 
    // calling fTransform() like here was not thread safe because it was using a cached vector
    //return Fcn()( fTransform(v) );
@@ -39,7 +38,7 @@ double MnUserFcn::operator()(const MnAlgebraicVector& v) const {
          vpar[ext] = v(i);
       }
    }
-   return Fcn()(vpar); 
+   return vpar; 
 }
 
    }  // namespace Minuit2
@@ -32,12 +32,113 @@
 #include <math.h>
 
 #include "Minuit2/MPIProcess.h"
+#include "Minuit2/MnThreadProcess.h"
 
 namespace ROOT {
 
    namespace Minuit2 {
 
 
+namespace {
+
+// compute the first and second derivatives and the step for the parameter i, evaluating the FCN
+// in the thread ithread (see MnFcn::ThreadEval). x is the copy of the parameters used by the thread
+void Derivative(const Numerical2PGradientCalculator& calc, unsigned int ithread, unsigned int i, MnAlgebraicVector& x,
+                double fcnmin, double dfmin, double vrysml,
+                MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) {
+
+   double eps2 = calc.Precision().Eps2(); 
+   unsigned int ncycle = calc.Ncycle();
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd(i)*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep(i)));
+      //       std::cout<<"step: "<<step;
+      if(calc.Trafo().Parameter(calc.Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep(i));
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < calc.StepTolerance()) {
+         //  	std::cout<<"(step-stepb4)/step"<<std::endl;
+         //  	std::cout<<"j= "<<j<<std::endl;
+         //  	std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep(i) = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+      
+      x(i) = xtf + step;
+      double fs1 = calc.Fcn().ThreadEval(ithread, x);
+      x(i) = xtf - step;
+      double fs2 = calc.Fcn().ThreadEval(ithread, x);
+      x(i) = xtf;
+      
+      double grdb4 = grd(i);
+      grd(i) = 0.5*(fs1 - fs2)/step;
+      g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
+
+#ifdef DEBUG
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2 
+                << " grd " << grd(i) << " g2 " << g2(i) << std::endl; 
+      std::cout.precision(pr);
+#endif
+      
+      if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < calc.GradTolerance())  {
+         //  	std::cout<<"j= "<<j<<std::endl;
+         //  	std::cout<<"step= "<<step<<std::endl;
+         //  	std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //  	std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
+   }
+}
+
+// computation of the derivatives of the parameters [begin, end) by one thread
+class DerivativeTask : public MnThreadProcess::Task {
+
+public:
+
+   DerivativeTask(const Numerical2PGradientCalculator& calc, const MnAlgebraicVector& par,
+                  double fcnmin, double dfmin, double vrysml,
+                  MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) :
+      fCalc(calc), fPar(par), fFcnmin(fcnmin), fDfmin(dfmin), fVrysml(vrysml),
+      fGrd(grd), fG2(g2), fGstep(gstep) {}
+
+   void Run(unsigned int ithread, unsigned int begin, unsigned int end) {
+      // each thread modifies its own copy of the parameters
+      MnAlgebraicVector x = fPar;
+      for (unsigned int i = begin; i < end; i++)
+         Derivative(fCalc, ithread, i, x, fFcnmin, fDfmin, fVrysml, fGrd, fG2, fGstep);
+   }
+
+private:
+
+   const Numerical2PGradientCalculator& fCalc;
+   const MnAlgebraicVector& fPar;
+   double fFcnmin;
+   double fDfmin;
+   double fVrysml;
+   MnAlgebraicVector& fGrd;
+   MnAlgebraicVector& fG2;
+   MnAlgebraicVector& fGstep;
+};
+
+}
+
 FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParameters& par) const {
    // calculate gradient using Initial gradient calculator and from MinimumParameters object
 
@@ -94,12 +195,20 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    //    std::cout << " ncycle " << Ncycle() << std::endl;
    
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
+   // with several threads the parameters are shared among the threads, each evaluating 
+   // its own copy of the FCN. The serial (or MPI) calculation is used if the FCN cannot be copied
+   MnThreadProcess threadproc(n, Strategy().NThreads());
+   if (threadproc.NThreads() > 1 && Fcn().InitThreads(threadproc.NThreads())) {
+      DerivativeTask task(*this, par.Vec(), fcnmin, dfmin, vrysml, grd, g2, gstep);
+      threadproc.Run(task);
+      return FunctionGradient(grd, g2, gstep);
+   }
+
 #ifndef _OPENMP
    MPIProcess mpiproc(n,0);
 #endif
@@ -142,62 +251,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       MnAlgebraicVector x = par.Vec();
 #endif
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //  	std::cout<<"(step-stepb4)/step"<<std::endl;
-            //  	std::cout<<"j= "<<j<<std::endl;
-            //  	std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-         
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-         
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
-
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2 
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl; 
-         std::cout.precision(pr);
-#endif
-         
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //  	std::cout<<"j= "<<j<<std::endl;
-            //  	std::cout<<"step= "<<step<<std::endl;
-            //  	std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //  	std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
-      
+      Derivative(*this, 0, i, x, fcnmin, dfmin, vrysml, grd, g2, gstep);
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -46,6 +46,7 @@ protected:
   TIterator* _coefIter ;  //! do not persist
 
   Double_t evaluate() const;
+  Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const;
 
   ClassDef(RooPolynomial,1) // Polynomial PDF
 };
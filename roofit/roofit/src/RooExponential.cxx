@@ -59,6 +59,22 @@ Double_t RooExponential::evaluate() const{
 }
 
 
+//_____________________________________________________________________________
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const
+{
+  // Calculate the values of a batch of events, see RooAbsReal::evaluateBatch()
+
+  const Double_t* xVal = x.arg().getValBatch(begin,batchSize,x.nset()) ;
+  const Double_t* cVal = c.arg().getValBatch(begin,batchSize,c.nset()) ;
+  if (!xVal || !cVal) return kFALSE ;
+
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    output[i] = exp(cVal[i]*xVal[i]) ;
+  }
+  return kTRUE ;
+}
+
+
 //_____________________________________________________________________________
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
@@ -72,6 +72,26 @@ Double_t RooGaussian::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const
+{
+  // Calculate the values of a batch of events, see RooAbsReal::evaluateBatch()
+
+  const Double_t* xVal = x.arg().getValBatch(begin,batchSize,x.nset()) ;
+  const Double_t* meanVal = mean.arg().getValBatch(begin,batchSize,mean.nset()) ;
+  const Double_t* sigmaVal = sigma.arg().getValBatch(begin,batchSize,sigma.nset()) ;
+  if (!xVal || !meanVal || !sigmaVal) return kFALSE ;
+
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    Double_t arg = xVal[i] - meanVal[i] ;
+    Double_t sig = sigmaVal[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 Int_t RooGaussian::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
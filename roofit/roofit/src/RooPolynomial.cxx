@@ -144,6 +144,37 @@ Double_t RooPolynomial::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const 
+{
+  // Calculate the values of a batch of events, see RooAbsReal::evaluateBatch().
+  // The terms are added in the same order as in evaluate()
+
+  const Double_t* xVal = _x.arg().getValBatch(begin,batchSize,_x.nset()) ;
+  if (!xVal) return kFALSE ;
+
+  Int_t order(_lowestOrder) ;
+  Double_t sum0(order<1 ? 0 : 1) ;
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    output[i] = sum0 ;
+  }
+
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  const RooArgSet* nset = _coefList.nset() ;
+  while((coef=(RooAbsReal*)ci.next())) {
+    const Double_t* coefVal = coef->getValBatch(begin,batchSize,nset) ;
+    if (!coefVal) return kFALSE ;
+    for (Int_t i=0 ; i<batchSize ; i++) {
+      output[i] += coefVal[i]*TMath::Power(xVal[i],order) ;
+    }
+    order++ ;
+  }
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
@@ -126,6 +126,7 @@
 #pragma link C++ class RooAbsStudy+ ;
 #pragma link C++ class RooGenFitStudy+ ;
 #pragma link C++ class RooProofDriverSelector+ ;
+#pragma link C++ class RooForkedLoop+ ;
 #pragma link C++ class std::list<RooAbsStudy*>+ ;
 #pragma link C++ class std::map<string,RooDataSet*>+ ;
 #pragma link C++ class std::map<string,RooDataHist*>+ ;
@@ -59,6 +59,7 @@ public:
 protected:
 
   Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
+  virtual Bool_t shareDataSlave(RooAbsTestStatistic& other) ;
   void initSlave(RooAbsReal& real, RooAbsData& indata, const RooArgSet& projDeps, const char* rangeName, 
 		 const char* addCoefRangeName)  ;
 
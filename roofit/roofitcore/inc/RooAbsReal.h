@@ -48,6 +48,7 @@ class TH3F;
 
 #include <list>
 #include <string>
+#include <vector>
 #include <iostream>
 
 class RooAbsReal : public RooAbsArg {
@@ -73,6 +74,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Values for a batch of events of the data columns attached by RooVectorDataStore::attachBatchColumns
+  virtual const Double_t* getValBatch(Int_t begin, Int_t batchSize, const RooArgSet* normSet=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -363,6 +367,8 @@ protected:
     return kFALSE ;
   }
   virtual Double_t evaluate() const = 0 ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const ;
+  Double_t* batchBuffer(Int_t batchSize) const ;
 
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
@@ -389,6 +395,9 @@ protected:
   mutable Char_t  _sbyteValue ; //! Transient cache for signed byte values from tree branches 
   mutable UInt_t  _uintValue  ; //! Transient cache for unsigned integer values from tree branches 
 
+  const Double_t* _batchColumn ; //! Data column holding the values of this object in batch evaluation
+  mutable std::vector<Double_t> _batchBuffer ; //! Values of a batch of events computed by getValBatch()
+
   friend class RooAbsPdf ;
   friend class RooAbsAnaConvPdf ;
   friend class RooRealProxy ;
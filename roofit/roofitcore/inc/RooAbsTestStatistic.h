@@ -57,6 +57,15 @@ public:
 
   Bool_t setData(RooAbsData& data, Bool_t cloneData=kTRUE) ;
 
+  // Parallel calculation strategy used when nCPU>1
+  enum MPMode { Threads, Processes } ;
+  static void setDefaultMPMode(MPMode mode) ;
+  static MPMode defaultMPMode() ;
+  MPMode mpMode() const { 
+    // Return parallel calculation strategy of this instance
+    return _mpMode ; 
+  }
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -105,6 +114,7 @@ protected:
   Bool_t _verbose ;                // Verbose messaging if true
 
   virtual Bool_t setDataSlave(RooAbsData& /*data*/, Bool_t /*cloneData*/=kTRUE, Bool_t /*ownNewDataAnyway*/=kFALSE) { return kTRUE ; }
+  virtual Bool_t shareDataSlave(RooAbsTestStatistic& other) ;
 
   //private:  
 
@@ -114,6 +124,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void calculateThreads() const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -132,6 +144,12 @@ protected:
 
   Bool_t         _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
 
+  // Threaded parallel mode data (the partitions are stored in _gofArray)
+  MPMode         _mpMode ;         //! Parallel calculation strategy
+  mutable Bool_t _threadsReady ;   //! Partitions have been calculated once since the last change of their caches
+
+  static MPMode  _defaultMPMode ;  // Default parallel calculation strategy
+
   ClassDef(RooAbsTestStatistic,1) // Abstract base class for real-valued test statistics
 };
 
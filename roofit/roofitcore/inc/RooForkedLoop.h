@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2005, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_FORKED_LOOP
+#define ROO_FORKED_LOOP
+
+#include "Rtypes.h"
+
+class TList ;
+
+class RooForkedLoop {
+public:
+
+  // Interface of the loops run by RooForkedLoop::run
+  class Task {
+  public:
+    virtual ~Task() {}
+    // Process the iterations [begin,end) and add the result objects to 'output'.
+    // Called in a forked worker process, or in the calling process
+    virtual void process(Int_t begin, Int_t end, TList& output) = 0 ;
+    // Merge the results of the iterations [begin,end) in the calling process. The
+    // objects kept must be removed from 'output', the remaining ones are deleted
+    virtual void collect(Int_t begin, Int_t end, TList& output) = 0 ;
+  } ;
+
+  static void run(Task& task, Int_t nIter, Int_t nWorkers) ;
+
+  virtual ~RooForkedLoop() {} ;
+
+private:
+  RooForkedLoop() ;
+  ClassDef(RooForkedLoop,0) // Execution of a loop by blocks in forked worker processes
+};
+
+#endif
@@ -103,6 +103,7 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  void runSample(Bool_t generate, Bool_t fit, Int_t sampleNum, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat, Int_t prescale) ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -142,6 +143,8 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  Int_t       _nCPU             ; // Number of processes running the samples (0: serial without per-sample seeds)
+  UInt_t      _toySeed          ; //! Seed of the series of samples of the current run
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
@@ -151,6 +154,9 @@ protected:
 
 private:
 
+  class ForkTask ;
+  friend class ForkTask ;
+
   RooMCStudy(const RooMCStudy&) ;
 	
   ClassDef(RooMCStudy,0) // A general purpose toy Monte Carlo study manager
@@ -20,11 +20,13 @@
 #include "RooCmdArg.h"
 #include "RooAbsPdf.h"
 
+class RooVectorDataStore ;
+
 class RooNLLVar : public RooAbsOptTestStatistic {
 public:
 
   // Constructors, assignment etc
-  RooNLLVar() { _first = kTRUE ; }
+  RooNLLVar() { _first = kTRUE ; _batchMode = kFALSE ; }
   RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooCmdArg& arg1                , const RooCmdArg& arg2=RooCmdArg::none(),const RooCmdArg& arg3=RooCmdArg::none(),
 	    const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),const RooCmdArg& arg6=RooCmdArg::none(),
@@ -44,13 +46,18 @@ public:
   virtual RooAbsTestStatistic* create(const char *name, const char *title, RooAbsReal& pdf, RooAbsData& adata,
 				      const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName=0, 
 				      Int_t nCPU=1, Bool_t interleave=kFALSE, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE) {
-    return new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE) ;
+    RooNLLVar* nll = new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE) ;
+    nll->_batchMode = _batchMode ;
+    return nll ;
   }
   
   virtual ~RooNLLVar();
 
   void applyWeightSquared(Bool_t flag) ; 
 
+  void batchMode(Bool_t flag) ;
+  Bool_t batchMode() const { return _batchMode ; }
+
   virtual Double_t defaultErrorLevel() const { return 0.5 ; }
 
 protected:
@@ -61,10 +68,17 @@ protected:
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  void evaluateEvents(Int_t firstEvent, Int_t lastEvent, Int_t stepSize, Double_t& result, Double_t& sumWeight) const ;
+  void evaluateBatches(RooVectorDataStore& store, Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& sumWeight) const ;
+  RooVectorDataStore* batchStore() const ;
+
+  static const Int_t _batchSize ; // Number of events evaluated at once in batch mode
+
   Bool_t _weightSq ; // Apply weights squared?
+  Bool_t _batchMode ; // Evaluate the p.d.f by batches of events?
   mutable Bool_t _first ; //!
   
-  ClassDef(RooNLLVar,1) // Function representing (extended) -log(L) of p.d.f and dataset
+  ClassDef(RooNLLVar,2) // Function representing (extended) -log(L) of p.d.f and dataset
 };
 
 #endif
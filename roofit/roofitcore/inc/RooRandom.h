@@ -32,6 +32,8 @@ public:
   static UInt_t integer(UInt_t max, TRandom *generator= randomGenerator());
   static Double_t gaussian(TRandom *generator= randomGenerator());
 
+  static UInt_t toySeed(UInt_t seed, UInt_t index) ;
+
   static RooQuasiRandomGenerator *quasiGenerator();
   static Bool_t quasi(UInt_t dimension, Double_t vector[],
 		      RooQuasiRandomGenerator *generator= quasiGenerator());
@@ -39,6 +39,7 @@ public:
   void setVerbose(Bool_t clientFlag=kTRUE, Bool_t serverFlag=kTRUE) ;
 
   void applyNLLWeightSquared(Bool_t flag) ;
+  void applyNLLBatchMode(Bool_t flag) ;
 
   protected:
 
@@ -51,13 +52,15 @@ public:
   State _state ;
 
   enum Message { SendReal=0, SendCat=1, Calculate=2, Retrieve=3, ReturnValue=4, Terminate=5, 
-		 ConstOpt=6, Verbose=7, RetrieveErrors=8, SendError=9, LogEvalError=10, ApplyNLLW2=11 } ;
+		 ConstOpt=6, Verbose=7, RetrieveErrors=8, SendError=9, LogEvalError=10, ApplyNLLW2=11, 
+		 ApplyNLLBatchMode=12 } ;
   
   void initialize() ; 
   void initVars() ;
   void serverLoop() ;
 
   void doApplyNLLW2(Bool_t flag) ;
+  void doApplyNLLBatchMode(Bool_t flag) ;
 
   RooRealProxy _arg ; // Function to calculate in parallel process
 
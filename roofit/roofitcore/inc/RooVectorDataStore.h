@@ -104,6 +104,13 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Batch evaluation interface used by RooNLLVar
+  void attachBatchColumns(Bool_t flag) ;
+  const Double_t* weightArray() const ;
+
+  // Column sharing used by the threaded partitions of a RooAbsTestStatistic
+  Bool_t shareColumns(const RooVectorDataStore& other) ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -129,12 +136,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=100) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity) ; 
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=100) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity) ; 
     }
 
@@ -143,7 +150,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf)   {
+      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nShared(0)   {
+      // A copy of a vector sharing its values owns a copy of them
+      if (other._nShared>0) _vec.assign(other._vec0,other._vec0+other._nShared) ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
@@ -159,10 +168,20 @@ public:
       _buf = other._buf ;
       _nativeBuf = other._nativeBuf ;
       _vec = other._vec ;
+      if (other._nShared>0) _vec.assign(other._vec0,other._vec0+other._nShared) ;
+      _nShared = 0 ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       return *this ;
     }
 
+    void shareValues(const RealVector& other) {
+      // Read the values of other instead of the own ones, which are released.
+      // Other must outlive this vector and its values must not change
+      std::vector<Double_t>().swap(_vec) ;
+      _vec0 = other._vec0 ;
+      _nShared = other.size() ;
+    }
+
     void setNset(RooArgSet* newNset) { _nset = newNset ; }
     RooArgSet* nset() const { return _nset ; }
 
@@ -216,7 +235,7 @@ public:
       *_nativeBuf = *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _nShared>0 ? _nShared : _vec.size() ; }
 
     void resize(Int_t siz) {
       _vec.resize(siz) ;
@@ -233,6 +252,7 @@ public:
     Double_t* _buf ; //!
     Double_t* _nativeBuf ; //!
     Double_t* _vec0 ; //!
+    Int_t _nShared ; //! Number of values shared with another vector
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
     ClassDef(RealVector,1) // STL-vector-based Data Storage class
@@ -374,13 +394,13 @@ public:
   class CatVector {
   public:
     CatVector(UInt_t initialCapacity=100) : 
-      _cat(0), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(0), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0)
     {
       _vec.reserve(initialCapacity) ;
     }
 
     CatVector(RooAbsCategory* cat, UInt_t initialCapacity=100) : 
-      _cat(cat), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(cat), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0)
     {
       _vec.reserve(initialCapacity) ;
     }
@@ -389,8 +409,9 @@ public:
     }
 
     CatVector(const CatVector& other, RooAbsCategory* cat=0) : 
-      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec) 
+      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec), _nShared(0) 
       {
+	if (other._nShared>0) _vec.assign(other._vec0,other._vec0+other._nShared) ;
 	_vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       }
 
@@ -400,10 +421,20 @@ public:
       _buf = other._buf ;
       _nativeBuf = other._nativeBuf ;
       _vec = other._vec ;
+      if (other._nShared>0) _vec.assign(other._vec0,other._vec0+other._nShared) ;
+      _nShared = 0 ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       return *this ;
     }
 
+    void shareValues(const CatVector& other) {
+      // Read the values of other instead of the own ones, which are released.
+      // Other must outlive this vector and its values must not change
+      std::vector<RooCatType>().swap(_vec) ;
+      _vec0 = other._vec0 ;
+      _nShared = other.size() ;
+    }
+
     void setBuffer(RooCatType* newBuf) { 
       _buf = newBuf ; 
       if (_nativeBuf==0) _nativeBuf=newBuf ;
@@ -430,7 +461,7 @@ public:
     inline void getNative(Int_t idx) const { 
       _nativeBuf->assignFast(*(_vec0+idx)) ;
     }
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _nShared>0 ? _nShared : _vec.size() ; }
 
     void resize(Int_t siz) {
       _vec.resize(siz) ;
@@ -448,6 +479,7 @@ public:
     RooCatType* _nativeBuf ;  //!
     std::vector<RooCatType> _vec ;
     RooCatType* _vec0 ; //!
+    Int_t _nShared ; //! Number of values shared with another vector
     ClassDef(CatVector,1) // STL-vector-based Data Storage class
   } ;
   
@@ -837,6 +837,35 @@ Bool_t RooAbsOptTestStatistic::setDataSlave(RooAbsData& indata, Bool_t cloneData
 
 
 
+//_____________________________________________________________________________
+Bool_t RooAbsOptTestStatistic::shareDataSlave(RooAbsTestStatistic& other) 
+{
+  // Read the data of other, a test statistic of the same function on the same data
+  // (the partitions of a threaded parallel calculation), instead of the own copy, 
+  // which is released. The values are still loaded in the observables of our own
+  // function clone. Only unbinned datasets with a vector storage support it. 
+  // Return kTRUE if the data is shared
+
+  if (operMode()!=Slave) {
+    return RooAbsTestStatistic::shareDataSlave(other) ;
+  }
+
+  RooAbsOptTestStatistic* otherOpt = dynamic_cast<RooAbsOptTestStatistic*>(&other) ;
+  if (!otherOpt || otherOpt->operMode()!=Slave || !dynamic_cast<RooDataSet*>(_dataClone) || !dynamic_cast<RooDataSet*>(otherOpt->_dataClone)) {
+    return kFALSE ;
+  }
+
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  RooVectorDataStore* otherVstore = dynamic_cast<RooVectorDataStore*>(otherOpt->_dataClone->store()) ;
+  if (!vstore || !otherVstore) {
+    return kFALSE ;
+  }
+
+  return vstore->shareColumns(*otherVstore) ;
+}
+
+
+
 
 //_____________________________________________________________________________
 RooAbsData& RooAbsOptTestStatistic::data() 
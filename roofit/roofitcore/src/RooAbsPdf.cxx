@@ -302,6 +302,55 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+//_____________________________________________________________________________
+const Double_t* RooAbsPdf::getValBatch(Int_t begin, Int_t batchSize, const RooArgSet* nset) const
+{
+  // Return the values normalized over the observables in 'nset' for a batch of 
+  // events of the attached data columns, see RooAbsReal::getValBatch(). A null
+  // pointer is also returned if any of the values is invalid, so that the errors 
+  // are reported by the evaluation of the events one by one. The batch evaluation
+  // of unnormalized values is not supported.
+
+  // Values cached in a data column by the constant term optimization
+  if (_batchColumn) {
+    return _batchColumn + begin ;
+  }
+
+  if (!nset) {
+    return 0 ;
+  }
+
+  if (nset!=_normSet || _norm==0) {
+    syncNormalization(nset) ;
+  }
+
+  Double_t normVal(_norm->getVal()) ;
+  if (normVal<=0.) {
+    return 0 ;
+  }
+
+  Double_t* output = batchBuffer(batchSize) ;
+  if (!evaluateBatch(output,begin,batchSize)) {
+    return 0 ;
+  }
+
+  // Negative and NaN values are errors, see traceEvalPdf()
+  Bool_t error(kFALSE) ;
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    error |= !(output[i]>=0) ;
+  }
+  if (error) {
+    return 0 ;
+  }
+
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    output[i] /= normVal ;
+  }
+  return output ;
+}
+
+
+
 //_____________________________________________________________________________
 Double_t RooAbsPdf::analyticalIntegralWN(Int_t code, const RooArgSet* normSet, const char* rangeName) const
 {
@@ -719,6 +768,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooCmdArg& arg1, const
   //                                        If none are specified the constrained parameters are used
   // Verbose(Bool_t flag)           -- Constrols RooFit informational messages in likelihood construction
   // CloneData(Bool flag)           -- Use clone of dataset in NLL (default is true)
+  // BatchMode(Bool_t flag)         -- Evaluate the p.d.f by batches of events read from the dataset columns
+  //                                   (see RooNLLVar::batchMode()), off by default
   // 
   // 
   
@@ -759,6 +810,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData",2,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineSet("projDepSet","ProjectedObservables",0,0) ;
   pc.defineSet("cPars","Constrain",0,0) ;
   pc.defineSet("glObs","GlobalObservables",0,0) ;
@@ -784,6 +836,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Bool_t verbose = pc.getInt("verbose") ;
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -847,7 +900,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     // Simple case: default range, or single restricted range
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
-    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+    RooNLLVar* nllVar = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+    nllVar->batchMode(batchMode) ;
+    nll = nllVar ;
 
   } else {
     // Composite case: multiple ranges
@@ -857,7 +912,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+      nllComp->batchMode(batchMode) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -935,6 +991,8 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooCmdArg& arg1, const Ro
   // GlobalObservables(const RooArgSet&) -- Define the set of normalization observables to be used for the constraint terms.
   //                                        If none are specified the constrained parameters are used
   // ExternalConstraints(const RooArgSet& ) -- Include given external constraints to likelihood
+  // BatchMode(Bool_t flag)          -- Evaluate the p.d.f by batches of events read from the dataset columns
+  //                                    (see RooNLLVar::batchMode()), off by default
   //
   // Options to control flow of fit procedure
   // ----------------------------------------
@@ -1008,7 +1066,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,BatchMode") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
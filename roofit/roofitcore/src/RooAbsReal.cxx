@@ -93,10 +93,19 @@
 #include "TF3.h"
 #include "TMatrixD.h"
 #include "TVector.h"
+#include "TVirtualMutex.h"
 
 #include <sstream>
 
 using namespace std ;
+
+namespace {
+
+  // Serializes the updates of the evaluation error log, which may be made 
+  // concurrently by the partitions of a threaded test statistic
+  TVirtualMutex* gEvalErrorMutex = 0 ;
+
+}
  
 ClassImp(RooAbsReal)
 ;
@@ -110,7 +119,7 @@ map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_ev
 
 
 //_____________________________________________________________________________
-RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+RooAbsReal::RooAbsReal() : _batchColumn(0), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
 {
   // coverity[UNINIT_CTOR]
   // Default constructor
@@ -121,7 +130,7 @@ RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectCo
 //_____________________________________________________________________________
 RooAbsReal::RooAbsReal(const char *name, const char *title, const char *unit) : 
   RooAbsArg(name,title), _plotMin(0), _plotMax(0), _plotBins(100), 
-  _value(0),  _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+  _value(0),  _unit(unit), _forceNumInt(kFALSE), _batchColumn(0), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
 {
   // Constructor with unit label
   setValueDirty() ;
@@ -135,7 +144,7 @@ RooAbsReal::RooAbsReal(const char *name, const char *title, const char *unit) :
 RooAbsReal::RooAbsReal(const char *name, const char *title, Double_t inMinVal,
 		       Double_t inMaxVal, const char *unit) :
   RooAbsArg(name,title), _plotMin(inMinVal), _plotMax(inMaxVal), _plotBins(100),
-  _value(0), _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+  _value(0), _unit(unit), _forceNumInt(kFALSE), _batchColumn(0), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
 {
   // Constructor with plot range and unit label
   setValueDirty() ;
@@ -149,7 +158,7 @@ RooAbsReal::RooAbsReal(const char *name, const char *title, Double_t inMinVal,
 RooAbsReal::RooAbsReal(const RooAbsReal& other, const char* name) : 
   RooAbsArg(other,name), _plotMin(other._plotMin), _plotMax(other._plotMax), 
   _plotBins(other._plotBins), _value(other._value), _unit(other._unit), _forceNumInt(other._forceNumInt), 
-  _treeVar(other._treeVar), _selectComp(other._selectComp), _lastNSet(0)
+  _batchColumn(0), _treeVar(other._treeVar), _selectComp(other._selectComp), _lastNSet(0)
 {
   // coverity[UNINIT_CTOR]
   // Copy constructor
@@ -233,6 +242,67 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+
+//_____________________________________________________________________________
+const Double_t* RooAbsReal::getValBatch(Int_t begin, Int_t batchSize, const RooArgSet* nset) const
+{
+  // Return the values of this object for the 'batchSize' events starting at event 'begin' 
+  // of the data columns attached by RooVectorDataStore::attachBatchColumns(). The values
+  // are read directly from the column of this object if it has one, otherwise they are
+  // computed at once by evaluateBatch() in a buffer owned by this object, which remains
+  // valid until the next call. A null pointer is returned if this object or one of its
+  // servers does not support the batch evaluation, in which case the caller should
+  // evaluate the events one by one with getVal()
+
+  if (_batchColumn) {
+    return _batchColumn + begin ;
+  }
+
+  if (nset && nset!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(nset) ;    
+    _lastNSet = (RooArgSet*) nset ;
+  }
+
+  Double_t* output = batchBuffer(batchSize) ;
+  return evaluateBatch(output,begin,batchSize) ? output : 0 ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooAbsReal::evaluateBatch(Double_t* output, Int_t /*begin*/, Int_t batchSize) const
+{
+  // Compute the values of this object for a batch of events into 'output', see getValBatch().
+  // Derived classes supporting the batch evaluation overload this method with a loop over
+  // the batches of their servers. The default implementation only handles the objects
+  // without servers, i.e. the parameters, which have the same value for all events, and
+  // returns kFALSE for any other object.
+
+  if (_serverList.GetSize()>0) {
+    return kFALSE ;
+  }
+
+  Double_t value = evaluate() ;
+  for (Int_t i=0 ; i<batchSize ; i++) {
+    output[i] = value ;
+  }
+  return kTRUE ;
+}
+
+
+
+//_____________________________________________________________________________
+Double_t* RooAbsReal::batchBuffer(Int_t batchSize) const
+{
+  // Return the buffer receiving the values of a batch of 'batchSize' events
+
+  if ((Int_t)_batchBuffer.size()<batchSize || _batchBuffer.empty()) {
+    _batchBuffer.resize(batchSize>0 ? batchSize : 1) ;
+  }
+  return &_batchBuffer[0] ;
+}
+
+
 //_____________________________________________________________________________
 Int_t RooAbsReal::numEvalErrorItems() 
 { 
@@ -3349,6 +3419,7 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
   }
 
   if (_evalErrorMode==CountErrors) {
+    R__LOCKGUARD2(gEvalErrorMutex) ;
     _evalErrorCount++ ;
     return ;
   }
@@ -3367,6 +3438,7 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     ee.setServerValues(serverValueString) ;
   } 
 
+  R__LOCKGUARD2(gEvalErrorMutex) ;
   if (_evalErrorMode==PrintErrors) {
    oocoutE((TObject*)0,Eval) << "RooAbsReal::logEvalError(" << "<STATIC>" << ") evaluation error, " << endl 
 		   << " origin       : " << origName << endl 
@@ -3404,6 +3476,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   }
 
   if (_evalErrorMode==CountErrors) {
+    R__LOCKGUARD2(gEvalErrorMutex) ;
     _evalErrorCount++ ;
     return ;
   }
@@ -3441,6 +3514,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   ostringstream oss2 ;
   printStream(oss2,kName|kClassName|kArgs,kInline)  ;
 
+  R__LOCKGUARD2(gEvalErrorMutex) ;
   if (_evalErrorMode==PrintErrors) {
    coutE(Eval) << "RooAbsReal::logEvalError(" << GetName() << ") evaluation error, " << endl 
 	       << " origin       : " << oss2.str() << endl 
@@ -4070,7 +4144,7 @@ RooAbsReal* RooAbsReal::createChi2(RooDataHist& data, const RooCmdArg& arg1,  co
   //  Options to control construction of the chi^2
   //  ------------------------------------------
   //  DataError(RooAbsData::ErrorType)  -- Choose between Poisson errors and Sum-of-weights errors
-  //  NumCPU(Int_t)                     -- Activate parallel processing feature on N processes
+  //  NumCPU(Int_t)                     -- Activate parallel processing feature on N threads or processes
   //  Range()                           -- Calculate Chi2 only in selected region
 
   string name = Form("chi2_%s_%s",GetName(),data.GetName()) ;
@@ -28,8 +28,12 @@
 // statistic values for the PDF components of the simultaneous PDF and
 // organizes multi-processor parallel calculation of test statistic
 // values. For the latter, the test statistic value is calculated in
-// partitions in parallel executing processes and a posteriori
-// combined in the main thread.
+// partitions and a posteriori combined in the main thread. By default
+// the partitions are calculated by forked server processes through
+// RooRealMPFE front-ends. Alternatively (see setDefaultMPMode()), they
+// are calculated by parallel threads of the calling process, each with
+// its own clone of the function, and read the same copy of the data
+// (with the vector data storage).
 // END_HTML
 //
 
@@ -49,12 +53,35 @@
 #include "RooMsgService.h"
 
 #include <string>
+#include <vector>
+
+#include "TThreadTeam.h"
 
 using namespace std;
 
 ClassImp(RooAbsTestStatistic)
 ;
 
+RooAbsTestStatistic::MPMode RooAbsTestStatistic::_defaultMPMode = RooAbsTestStatistic::Processes ;
+
+
+
+namespace {
+
+  // Calculation of the partitions of a test statistic in threaded parallel mode, 
+  // partition i being the part i of the TThreadTeam job. Partition 0 is calculated
+  // by the calling thread
+  class PartitionJob : public TThreadTeam::TJob {
+  public:
+    PartitionJob(pRooAbsTestStatistic* gofArray) : _gofArray(gofArray) {}
+    void Run(UInt_t ipart) { _gofArray[ipart]->getVal() ; }
+  private:
+    pRooAbsTestStatistic* _gofArray ; // Partitions
+  } ;
+
+}
+
+
 
 //_____________________________________________________________________________
 RooAbsTestStatistic::RooAbsTestStatistic()
@@ -77,6 +104,8 @@ RooAbsTestStatistic::RooAbsTestStatistic()
   _simCount = 0 ;
   _splitRange = 0 ;
   _verbose = kFALSE ;
+  _mpMode = _defaultMPMode ;
+  _threadsReady = kFALSE ;
 }
 
 
@@ -99,13 +128,16 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
-  _mpinterl(interleave)
+  _mpinterl(interleave),
+  _mpMode(_defaultMPMode),
+  _threadsReady(kFALSE)
 {
   // Constructor taking function (real), a dataset (data), a set of projected observables (projSet). If
   // rangeName is not null, only events in the dataset inside the range will be used in the test
   // statistic calculation. If addCoefRangeName is not null, all RooAddPdf component of 'real' will be
   // instructed to fix their fraction definitions to the given named range. If nCPU is greater than
-  // 1 the test statistic calculation will be paralellized over multiple processes. By default the data
+  // 1 the test statistic calculation will be paralellized over multiple threads or processes (see
+  // setDefaultMPMode()). By default the data
   // is split with 'bulk' partitioning (each process calculates a contigious block of fraction 1/nCPU
   // of the data). For binned data this approach may be suboptimal as the number of bins with >0 entries
   // in each processing block many vary greatly thereby distributing the workload rather unevenly.
@@ -164,7 +196,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofArray(0),
   _nCPU(other._nCPU),
   _mpfeArray(0),
-  _mpinterl(other._mpinterl)
+  _mpinterl(other._mpinterl),
+  _mpMode(other._mpMode),
+  _threadsReady(kFALSE)
 {
   // Copy constructor
 
@@ -208,10 +242,18 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 
   if (_gofOpMode==MPMaster && _init) {
     Int_t i ;
-    for (i=0 ; i<_nCPU ; i++) {
-      delete _mpfeArray[i] ;
+    if (_mpfeArray) {
+      for (i=0 ; i<_nCPU ; i++) {
+	delete _mpfeArray[i] ;
+      }
+      delete[] _mpfeArray ;
+    } else {
+      // Partition 0 holds the data read by the others
+      for (i=_nGof-1 ; i>=0 ; i--) {
+	delete _gofArray[i] ;
+      }
+      delete[] _gofArray ;
     }
-    delete[] _mpfeArray ;
   }
 
   if (_gofOpMode==SimMaster && _init) {
@@ -236,7 +278,7 @@ Double_t RooAbsTestStatistic::evaluate() const
   // is calculated from on a RooSimultaneous, the test statistic calculation
   // is performed separately on each simultaneous p.d.f component and associated
   // data and then combined. If the test statistic calculation is parallelized
-  // partitions are calculated in nCPU processes and a posteriori combined.
+  // partitions are calculated in nCPU threads or processes and a posteriori combined.
 
   // One-time Initialization
   if (!_init) {
@@ -256,6 +298,13 @@ Double_t RooAbsTestStatistic::evaluate() const
 
     return ret ;
 
+  } else if (_gofOpMode==MPMaster && _mpMode==Threads) {
+
+    // Calculate partitions in parallel threads
+    calculateThreads() ;
+    Double_t ret = combinedValue((RooAbsReal**)_gofArray,_nGof)/globalNormalization() ;
+    return ret ;
+
   } else if (_gofOpMode==MPMaster) {
 
     // Start calculations in parallel
@@ -340,6 +389,15 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
       }
     }
 
+  } else if (_gofOpMode==MPMaster && _gofArray) {
+
+    // Forward to partitions
+    Int_t i ;
+    for (i=0 ; i<_nGof ; i++) {
+      _gofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange) ;
+    }
+    _threadsReady = kFALSE ;
+
   }
   return kFALSE ;
 }
@@ -352,7 +410,7 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
   // Add extra information on component test statistics when printing
   // itself as part of a tree structure
 
-  if (_gofOpMode==SimMaster) {
+  if (_gofOpMode==SimMaster || (_gofOpMode==MPMaster && _gofArray)) {
     // Forward to slaves
     Int_t i ;
     os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
@@ -383,10 +441,15 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (i=0 ; i<_nGof ; i++) {
       if (_gofArray[i]) _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
     }
-  } else if (_gofOpMode==MPMaster) {
+  } else if (_gofOpMode==MPMaster && _mpfeArray) {
     for (i=0 ; i<_nCPU ; i++) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
     }
+  } else if (_gofOpMode==MPMaster) {
+    for (i=0 ; i<_nGof ; i++) {
+      _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
+    }
+    _threadsReady = kFALSE ;
   }
 }
 
@@ -413,8 +476,15 @@ void RooAbsTestStatistic::setMPSet(Int_t inSetNum, Int_t inNumSets)
 //_____________________________________________________________________________
 void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
 {
-  // Initialize multi-processor calculation mode. Create component test statistics in separate
-  // processed that are connected to this process through a RooAbsRealMPFE front-end class.
+  // Initialize multi-processor calculation mode. In threaded mode, create one component test 
+  // statistic for each partition, calculated by its own thread. Otherwise create component test 
+  // statistics in separate processed that are connected to this process through a RooAbsRealMPFE 
+  // front-end class.
+
+  if (_mpMode==Threads) {
+    initThreadMode(real,data,projDeps,rangeName,addCoefRangeName) ;
+    return ;
+  }
 
   Int_t i ;
   _mpfeArray = new pRooRealMPFE[_nCPU] ;
@@ -443,6 +513,113 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+//_____________________________________________________________________________
+void RooAbsTestStatistic::initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  // Initialize threaded parallel calculation mode. Create one component test statistic for
+  // each partition, with its own clone of the function. The partitions other than the first
+  // one read the data of the first one instead of their own copy, if its storage allows it.
+  // The partitions are calculated by the threads of the TThreadTeam.
+
+  _nGof = _nCPU ;
+  _gofArray = new pRooAbsTestStatistic[_nGof] ;
+
+  Int_t i ;
+  Int_t nShared(0) ;
+  for (i=0 ; i<_nGof ; i++) {
+    _gofArray[i] = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange) ;
+    _gofArray[i]->recursiveRedirectServers(_paramSet) ;
+    _gofArray[i]->setMPSet(i,_nGof) ;
+    if (i>0 && _gofArray[i]->shareDataSlave(*_gofArray[0])) {
+      nShared++ ;
+    }
+  }
+
+  coutI(Eval) << "RooAbsTestStatistic::initThreadMode(" << GetName() << ") calculating " << _nGof 
+	      << " partitions in parallel threads, " << nShared << " of them reading the data of partition #0" << endl ;
+
+  _threadsReady = kFALSE ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::calculateThreads() const
+{
+  // Calculate the partitions of the threaded parallel mode. The first calculation after 
+  // the initialization and after each change of the optimization of the partitions is 
+  // made in sequence by the calling thread, as it creates the caches of the functions 
+  // (normalization integrals etc...) which must not be done concurrently
+
+  if (!_threadsReady) {
+    for (Int_t i=0 ; i<_nGof ; i++) {
+      _gofArray[i]->getVal() ;
+    }
+    _threadsReady = kTRUE ;
+    return ;
+  }
+
+  PartitionJob job(_gofArray) ;
+  TThreadTeam::Run(job,_nGof) ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooAbsTestStatistic::shareDataSlave(RooAbsTestStatistic& other) 
+{
+  // Let the component test statistics read the data of the corresponding components
+  // of other, a test statistic of the same function on the same data, instead of their
+  // own copy. Return kTRUE if all components share their data
+
+  if (_gofOpMode==Slave || other._gofOpMode!=_gofOpMode) {
+    return kFALSE ;
+  }
+
+  initialize() ;
+  other.initialize() ;
+  if (!_gofArray || !other._gofArray || _nGof!=other._nGof) {
+    return kFALSE ;
+  }
+
+  Bool_t ret(kTRUE) ;
+  for (Int_t i=0 ; i<_nGof ; i++) {
+    if (!_gofArray[i]->shareDataSlave(*other._gofArray[i])) {
+      ret = kFALSE ;
+    }
+  }
+  return ret ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::setDefaultMPMode(MPMode mode) 
+{
+  // Set the strategy used to calculate the partitions of the test statistics created
+  // with nCPU>1 (RooFit::NumCPU()). With Processes (the default), each partition is
+  // calculated by a forked process, with its own copy of the function and of the data,
+  // through a RooRealMPFE front-end. With Threads, the partitions are calculated by
+  // threads of the calling process, each with its own clone of the function, and all
+  // read the same copy of the data if it is stored in a vector data store. The functions
+  // must then support the concurrent evaluation of distinct clones: the threads are only
+  // safe for functions that do not create objects from the RooArgSet memory pool or log
+  // messages through RooMsgService while they are evaluated
+
+  _defaultMPMode = mode ;
+}
+
+
+
+//_____________________________________________________________________________
+RooAbsTestStatistic::MPMode RooAbsTestStatistic::defaultMPMode() 
+{
+  // Return the strategy used to calculate the partitions of the new test statistics
+  return _defaultMPMode ;
+}
+
+
+
 //_____________________________________________________________________________
 void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 				      const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
@@ -843,6 +843,68 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+
+//_____________________________________________________________________________
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t begin, Int_t batchSize) const 
+{
+  // Calculate the values of a batch of events, see RooAbsReal::evaluateBatch().
+  // The coefficients are computed once for the whole batch: they must not 
+  // depend on the observables
+
+  const RooArgSet* nset = _normSet ; 
+
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  if (nset) {
+    RooFIter ci = _coefList.fwdIterator() ;
+    RooAbsArg* coef ;
+    while((coef = ci.next())) {
+      if (coef->dependsOnValue(*nset)) {
+	return kFALSE ;
+      }
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  for (Int_t k=0 ; k<batchSize ; k++) {
+    output[k] = 0 ;
+  }
+
+  // Do running sum of coef/pdf pairs in the same order as evaluate()
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    const Double_t* pdfVal = pdf->getValBatch(begin,batchSize,nset) ;
+    if (!pdfVal) {
+      return kFALSE ;
+    }
+    if (pdf->isSelectedComp()) {
+      Double_t coef = _coefCache[i] ;
+      if (cache->_needSupNorm) {
+	Double_t snormVal = ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() ;
+	for (Int_t k=0 ; k<batchSize ; k++) {
+	  output[k] += pdfVal[k]*coef/snormVal ;
+	}
+      } else {
+	for (Int_t k=0 ; k<batchSize ; k++) {
+	  output[k] += pdfVal[k]*coef ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
 //_____________________________________________________________________________
 void RooAddPdf::resetErrorCounters(Int_t resetValue)
 {
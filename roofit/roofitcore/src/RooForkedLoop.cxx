@@ -0,0 +1,201 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2005, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// RooForkedLoop executes the iterations of a loop, such as the toy experiments
+// of RooMCStudy or RooStats::ToyMCSampler, in parallel in forked worker processes.
+// <p>
+// The iterations are partitioned in contiguous blocks, one per worker. Each worker
+// is a copy of the calling process, and thus works on its own copy of the p.d.f.s,
+// datasets and random number generators, so that no RooFit object needs to be
+// shared between workers. The worker processes its block through RooForkedLoop::Task::process()
+// and sends the result objects back to the calling process through a pipe, where they are merged
+// by RooForkedLoop::Task::collect() in the order of the blocks. The first block is processed by the
+// calling process itself. A block whose worker cannot be started or fails is processed by the
+// calling process as well. On the platforms without fork() all blocks are processed in sequence.
+// END_HTML
+//
+
+#include "RooFit.h"
+#include "Riostream.h"
+
+#include "RooForkedLoop.h"
+#include "RooMsgService.h"
+
+#include "TList.h"
+#include "TBufferFile.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace std;
+
+ClassImp(RooForkedLoop)
+  ;
+
+
+#ifndef _WIN32
+
+namespace {
+
+  //_____________________________________________________________________________
+  Bool_t WriteAll(int fd, const char* buf, Long64_t len)
+  {
+    // Write 'len' bytes to the pipe 'fd', which may take several writes
+    while (len>0) {
+      ssize_t n = write(fd,buf,len) ;
+      if (n<0) {
+	if (errno==EINTR) continue ;
+	return kFALSE ;
+      }
+      buf += n ;
+      len -= n ;
+    }
+    return kTRUE ;
+  }
+
+  //_____________________________________________________________________________
+  Bool_t ReadAll(int fd, char* buf, Long64_t len)
+  {
+    // Read 'len' bytes from the pipe 'fd', which may take several reads
+    while (len>0) {
+      ssize_t n = read(fd,buf,len) ;
+      if (n<0 && errno==EINTR) continue ;
+      if (n<=0) return kFALSE ;
+      buf += n ;
+      len -= n ;
+    }
+    return kTRUE ;
+  }
+
+  //_____________________________________________________________________________
+  TList* Receive(int fd)
+  {
+    // Read the output list sent by a worker on the pipe 'fd'. Return
+    // a null pointer if the worker did not send a complete list
+
+    Int_t len(0) ;
+    if (!ReadAll(fd,(char*)&len,sizeof(len)) || len<=0) return 0 ;
+    char* data = new char[len] ;
+    if (!ReadAll(fd,data,len)) {
+      delete[] data ;
+      return 0 ;
+    }
+    TBufferFile buf(TBuffer::kRead,len,data,kTRUE) ;
+    return (TList*) buf.ReadObject(TList::Class()) ;
+  }
+
+}
+
+#endif
+
+
+
+//_____________________________________________________________________________
+void RooForkedLoop::run(Task& task, Int_t nIter, Int_t nWorkers)
+{
+  // Process the iterations [0,nIter) of 'task' with 'nWorkers' processes, the
+  // calling process included. The results of all blocks are collected in the
+  // calling process, in the order of the iterations, when this function returns
+
+  if (nIter<=0) return ;
+  if (nWorkers>nIter) nWorkers = nIter ;
+  if (nWorkers<1) nWorkers = 1 ;
+
+  vector<Int_t> first(nWorkers+1) ;
+  for (Int_t k=0 ; k<=nWorkers ; k++) {
+    first[k] = Int_t((Long64_t(nIter)*k)/nWorkers) ;
+  }
+
+#ifndef _WIN32
+  vector<pid_t> pid(nWorkers,0) ;
+  vector<int> fd(nWorkers,-1) ;
+
+  // Flush the output buffers, which would otherwise be written by each worker
+  cout.flush() ;
+  fflush(stdout) ;
+
+  for (Int_t k=1 ; k<nWorkers ; k++) {
+    int p[2] ;
+    if (pipe(p)!=0) {
+      perror("pipe") ;
+      continue ;
+    }
+    pid_t child = fork() ;
+
+    if (child==0) {
+
+      // Worker process: process the block and send back its output
+      close(p[0]) ;
+      for (Int_t j=1 ; j<k ; j++) {
+	if (fd[j]>=0) close(fd[j]) ;
+      }
+      TList output ;
+      task.process(first[k],first[k+1],output) ;
+      TBufferFile buf(TBuffer::kWrite) ;
+      buf.WriteObject(&output) ;
+      Int_t len = buf.Length() ;
+      if (!WriteAll(p[1],(const char*)&len,sizeof(len)) || !WriteAll(p[1],buf.Buffer(),len)) {
+	perror("write") ;
+      }
+      close(p[1]) ;
+      cout.flush() ;
+      fflush(stdout) ;
+      _exit(0) ;
+
+    }
+
+    close(p[1]) ;
+    if (child<0) {
+      oocoutW((TObject*)0,Generation) << "RooForkedLoop::run: fork() of worker " << k << " failed, its iterations are processed by the calling process" << endl ;
+      close(p[0]) ;
+      continue ;
+    }
+    pid[k] = child ;
+    fd[k] = p[0] ;
+  }
+#endif
+
+  for (Int_t k=0 ; k<nWorkers ; k++) {
+    TList* output(0) ;
+#ifndef _WIN32
+    if (fd[k]>=0) {
+      output = Receive(fd[k]) ;
+      close(fd[k]) ;
+      waitpid(pid[k],0,0) ;
+      if (!output) {
+	oocoutW((TObject*)0,Generation) << "RooForkedLoop::run: worker " << k << " failed, its iterations are processed by the calling process" << endl ;
+      }
+    }
+#endif
+    if (!output) {
+      output = new TList ;
+      task.process(first[k],first[k+1],*output) ;
+    }
+    task.collect(first[k],first[k+1],*output) ;
+    output->Delete() ;
+    delete output ;
+  }
+}
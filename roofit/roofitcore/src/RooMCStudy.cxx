@@ -64,6 +64,7 @@
 #include "RooPullVar.h"
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
+#include "RooForkedLoop.h"
 
 using namespace std ;
 
@@ -107,6 +108,11 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   //                                      events does not exactly match the number of events in the prototype dataset
   //                                      at the cost of reduced precision
   //                                      with mu equal to the specified number of events
+  // NumCPU(Int_t nCPU)                -- Generate and fit the samples with nCPU forked processes. Each process works 
+  //                                      on its own copy of the models and merges its results back in the fit results 
+  //                                      dataset. The random generator is reseeded for each sample with a seed derived
+  //                                      from the sample number and from a seed drawn once per run from RooRandom, 
+  //                                      so that the results do not depend on the number of processes
 
   // Stuff all arguments in a list
   RooLinkedList cmdList;
@@ -128,6 +134,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   pc.defineInt("verboseGen","Verbose",0,0) ;
   pc.defineInt("extendedGen","Extended",0,0) ;
   pc.defineInt("binGenData","Binned",0,0) ;
+  pc.defineInt("nCPU","NumCPU",0,0) ;
   pc.defineString("fitOpts","FitOptions",0,"") ;
   pc.defineInt("dummy","FitOptArgs",0,0) ;
   pc.defineMutex("FitOptions","FitOptArgs") ; // can have either classic or new-style fit options
@@ -156,6 +163,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   _extendedGen = pc.getInt("extendedGen") ;
   _binGenData = pc.getInt("binGenData") ;
   _randProto = pc.getInt("randProtoData") ;
+  _nCPU = pc.getInt("nCPU") ;
 
   // Process constraints specifications
   const RooArgSet* cParsTmp = pc.getSet("cPars") ;
@@ -323,7 +331,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nCPU(0)
 {
   // OBSOLETE, RETAINED FOR BACKWARD COMPATIBILY. PLEASE
   // USE CONSTRUCTOR WITH NAMED ARGUMENTS
@@ -445,6 +454,91 @@ void RooMCStudy::addModule(RooAbsMCStudyModule& module)
 
 
 
+//_____________________________________________________________________________
+class RooMCStudy::ForkTask : public RooForkedLoop::Task {
+public:
+  // Processing of the samples of a run by blocks in the worker processes of
+  // RooForkedLoop. The iteration i is the sample nSamples-1-i, as in a serial run
+
+  ForkTask(RooMCStudy& mc, Bool_t doGenerate, Bool_t doFit, Int_t nSamples, Int_t nEvtPerSample, 
+	   Bool_t keepGenData, const char* asciiFilePat, Int_t prescale) : 
+    _mc(mc), _doGenerate(doGenerate), _doFit(doFit), _nSamples(nSamples), _nEvtPerSample(nEvtPerSample), 
+    _keepGenData(keepGenData), _asciiFilePat(asciiFilePat), _prescale(prescale) {}
+
+  virtual void process(Int_t begin, Int_t end, TList& output) {
+    // Run the samples of the block with empty results datasets, which are
+    // returned in 'output' followed by the new fit results and generated data sets
+
+    RooDataSet* fitParData = _mc._fitParData ;
+    RooDataSet* genParData = _mc._genParData ;
+    Int_t nFitRes = _mc._fitResList.GetSize() ;
+    Int_t nGenData = _mc._genDataList.GetSize() ;
+
+    _mc._fitParData = (RooDataSet*) fitParData->emptyClone() ;
+    if (genParData) {
+      _mc._genParData = (RooDataSet*) genParData->emptyClone() ;
+    }
+
+    for (Int_t i=begin ; i<end ; i++) {
+      _mc.runSample(_doGenerate,_doFit,_nSamples-1-i,_nEvtPerSample,_keepGenData,_asciiFilePat,_prescale) ;
+    }
+
+    output.Add(_mc._fitParData) ;
+    if (genParData) {
+      output.Add(_mc._genParData) ;
+    }
+    while (_mc._fitResList.GetSize()>nFitRes) {
+      output.Add(_mc._fitResList.RemoveAt(nFitRes)) ;
+    }
+    while (_mc._genDataList.GetSize()>nGenData) {
+      output.Add(_mc._genDataList.RemoveAt(nGenData)) ;
+    }
+
+    _mc._fitParData = fitParData ;
+    _mc._genParData = genParData ;
+  }
+
+  virtual void collect(Int_t /*begin*/, Int_t /*end*/, TList& output) {
+    // Append the results of the block to those of the study
+
+    TIterator* iter = output.MakeIterator() ;
+    RooDataSet* fitParData = (RooDataSet*) iter->Next() ;
+    if (fitParData) {
+      _mc._fitParData->append(*fitParData) ;
+    }
+    if (_mc._genParData) {
+      RooDataSet* genParData = (RooDataSet*) iter->Next() ;
+      if (genParData) {
+	_mc._genParData->append(*genParData) ;
+      }
+    }
+    TList kept ;
+    TObject* obj ;
+    while((obj=iter->Next())) {
+      kept.Add(obj) ;
+      if (obj->InheritsFrom(RooFitResult::Class())) {
+	_mc._fitResList.Add(obj) ;
+      } else {
+	_mc._genDataList.Add(obj) ;
+      }
+    }
+    delete iter ;
+    output.RemoveAll(&kept) ;
+  }
+
+private:
+  RooMCStudy& _mc ;
+  Bool_t _doGenerate ;
+  Bool_t _doFit ;
+  Int_t _nSamples ;
+  Int_t _nEvtPerSample ;
+  Bool_t _keepGenData ;
+  const char* _asciiFilePat ;
+  Int_t _prescale ;
+} ;
+
+
+
 //_____________________________________________________________________________
 Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) 
 {
@@ -459,6 +553,10 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
   // When fitting only, data sets may optionally be read from ascii files, using the same file
   // pattern.
   //
+  // If the NumCPU(n) option was given to the constructor, the samples are distributed in
+  // n blocks over n processes, see RooForkedLoop. The random generator is reseeded for each
+  // sample so that the results of the run only depend on the state of RooRandom at its start.
+  //
 
   RooFit::MsgLevel oldLevel(RooFit::FATAL) ;
   if (_silence) {
@@ -473,138 +571,27 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
   
   Int_t prescale = nSamples>100 ? Int_t(nSamples/100) : 1 ;
 
-  while(nSamples--) {
-    
-    if (nSamples%prescale==0) {
-      oocoutP(_fitModel,Generation) << "RooMCStudy::run: " ;
-      if (doGenerate) ooccoutI(_fitModel,Generation) << "Generating " ;
-      if (doGenerate && DoFit) ooccoutI(_fitModel,Generation) << "and " ;
-      if (DoFit) ooccoutI(_fitModel,Generation) << "fitting " ;
-      ooccoutP(_fitModel,Generation) << "sample " << nSamples << endl ;
-    }
-
-    _genSample = 0;
-    Bool_t existingData = kFALSE ;
-    if (doGenerate) {
-      // Generate sample
-      Int_t nEvt(nEvtPerSample) ;
-
-      // Reset generator parameters to initial values
-      *_genParams = *_genInitParams ;
-
-      // If constraints are present, sample generator values from constraints
-      if (_constrPdf) {
-	RooDataSet* tmp = _constrGenContext->generate(1) ;
-	*_genParams = *tmp->get() ;
-	delete tmp ;
-      }
-
-      // Save generated parameters if required
-      if (_genParData) {
-	_genParData->add(*_genParams) ;
-      }
-
-      // Call module before-generation hook
-      list<RooAbsMCStudyModule*>::iterator iter2 ;
-      for (iter2=_modList.begin() ; iter2!= _modList.end() ; ++iter2) {
-	(*iter2)->processBeforeGen(nSamples) ;
-      }  
-
-      if (_binGenData) {
+  // Seed of the series, the generator is reseeded with a seed derived from it for each sample
+  if (_nCPU>0) {
+    _toySeed = RooRandom::integer(kMaxUInt) ;
+  }
 
-	// Calculate the number of (extended) events for this run
-	if (_extendedGen) {
-	  _nExpGen = _genModel->expectedEvents(&_dependents) ;
-	  nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
-	}	
+  // The study modules keep their state in this process, they require a serial run
+  if (_nCPU>1 && !_modList.empty()) {
+    oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING study modules require a serial run, the samples are not processed in parallel" << endl ;
+  }
 
-	// Binned generation
-	_genSample = _genModel->generateBinned(_dependents,nEvt) ;
+  if (_nCPU>1 && _modList.empty()) {
 
-      } else {
+    ForkTask task(*this,doGenerate,DoFit,nSamples,nEvtPerSample,keepGenData,asciiFilePat,prescale) ;
+    RooForkedLoop::run(task,nSamples,_nCPU) ;
 
-	// Calculate the number of (extended) events for this run
-	if (_extendedGen) {
-	  _nExpGen = _genModel->expectedEvents(&_dependents) ;
-	  nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
-	}
-	
-	// Optional randomization of protodata for this run
-	if (_randProto && _genProtoData && _genProtoData->numEntries()!=nEvt) {
-	  oocoutI(_fitModel,Generation) << "RooMCStudy: (Re)randomizing event order in prototype dataset (Nevt=" << nEvt << ")" << endl ;
-	  Int_t* newOrder = _genModel->randomizeProtoOrder(_genProtoData->numEntries(),nEvt) ;
-	  _genContext->setProtoDataOrder(newOrder) ;
-	  delete[] newOrder ;
-	}
-
-	cout << "RooMCStudy: now generating " << nEvt << " events" << endl ;
-	
-	// Actual generation of events
-	if (nEvt>0) {
-	  _genSample = _genContext->generate(nEvt) ;
-	} else {
-	  // Make empty dataset
-	  _genSample = new RooDataSet("emptySample","emptySample",_dependents) ;
-	}	
-      } 
+  } else {
 
-	
-    //} else if (asciiFilePat && &asciiFilePat) { //warning: the address of 'asciiFilePat' will always evaluate as 'true'
-    } else if (asciiFilePat) {
-
-      // Load sample from ASCII file
-      char asciiFile[1024] ;
-      snprintf(asciiFile,1024,asciiFilePat,nSamples) ;
-      RooArgList depList(_allDependents) ;
-      _genSample = RooDataSet::read(asciiFile,depList,"q") ;      
-      
-    } else {
-      
-      // Load sample from internal list
-      _genSample = (RooDataSet*) _genDataList.At(nSamples) ;
-      existingData = kTRUE ;
-      if (!_genSample) {
-   	oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING: Sample #" << nSamples << " not loaded, skipping" << endl ;
-   	continue ;
-      }
+    while(nSamples--) {
+      runSample(doGenerate,DoFit,nSamples,nEvtPerSample,keepGenData,asciiFilePat,prescale) ;
     }
 
-    // Save number of generated events
-    _ngenVar->setVal(_genSample->sumEntries()) ;
-
-    // Call module between generation and fitting hook
-    list<RooAbsMCStudyModule*>::iterator iter3 ;
-    for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
-      (*iter3)->processBetweenGenAndFit(nSamples) ;
-    }  
-    
-    if (DoFit) fitSample(_genSample) ;
-
-    // Call module between generation and fitting hook
-    for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
-      (*iter3)->processAfterFit(nSamples) ;
-    }  
-    
-    // Optionally write to ascii file
-    if (doGenerate && asciiFilePat && *asciiFilePat) {
-      char asciiFile[1024] ;
-      snprintf(asciiFile,1024,asciiFilePat,nSamples) ;
-      RooDataSet* unbinnedData = dynamic_cast<RooDataSet*>(_genSample) ;
-      if (unbinnedData) {
-	unbinnedData->write(asciiFile) ;
-      } else {
-	coutE(InputArguments) << "RooMCStudy::run(" << GetName() << ") ERROR: ASCII writing of binned datasets is not supported" << endl ;
-      }
-    }
-    
-    // Add to list or delete
-    if (!existingData) {
-      if (keepGenData) {
-	_genDataList.Add(_genSample) ;
-      } else {
-	delete _genSample ;
-      }
-    }
   }
 
   for (iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
@@ -642,6 +629,152 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
 
 
 
+//_____________________________________________________________________________
+void RooMCStudy::runSample(Bool_t doGenerate, Bool_t DoFit, Int_t sampleNum, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat, Int_t prescale) 
+{
+  // Generate and/or fit, according to flags, the sample number 'sampleNum'. The results are
+  // appended to the fit results dataset, the generated data sets are kept if 'keepGenData' is set.
+  // See run() for the description of the other arguments
+
+  // Independent random number stream for each sample in a parallel run
+  if (_nCPU>0) {
+    RooRandom::randomGenerator()->SetSeed(RooRandom::toySeed(_toySeed,sampleNum)) ;
+  }
+  
+  if (sampleNum%prescale==0) {
+    oocoutP(_fitModel,Generation) << "RooMCStudy::run: " ;
+    if (doGenerate) ooccoutI(_fitModel,Generation) << "Generating " ;
+    if (doGenerate && DoFit) ooccoutI(_fitModel,Generation) << "and " ;
+    if (DoFit) ooccoutI(_fitModel,Generation) << "fitting " ;
+    ooccoutP(_fitModel,Generation) << "sample " << sampleNum << endl ;
+  }
+
+  _genSample = 0;
+  Bool_t existingData = kFALSE ;
+  if (doGenerate) {
+    // Generate sample
+    Int_t nEvt(nEvtPerSample) ;
+
+    // Reset generator parameters to initial values
+    *_genParams = *_genInitParams ;
+
+    // If constraints are present, sample generator values from constraints
+    if (_constrPdf) {
+      RooDataSet* tmp = _constrGenContext->generate(1) ;
+      *_genParams = *tmp->get() ;
+      delete tmp ;
+    }
+
+    // Save generated parameters if required
+    if (_genParData) {
+      _genParData->add(*_genParams) ;
+    }
+
+    // Call module before-generation hook
+    list<RooAbsMCStudyModule*>::iterator iter2 ;
+    for (iter2=_modList.begin() ; iter2!= _modList.end() ; ++iter2) {
+      (*iter2)->processBeforeGen(sampleNum) ;
+    }  
+
+    if (_binGenData) {
+
+      // Calculate the number of (extended) events for this run
+      if (_extendedGen) {
+        _nExpGen = _genModel->expectedEvents(&_dependents) ;
+        nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
+      }	
+
+      // Binned generation
+      _genSample = _genModel->generateBinned(_dependents,nEvt) ;
+
+    } else {
+
+      // Calculate the number of (extended) events for this run
+      if (_extendedGen) {
+        _nExpGen = _genModel->expectedEvents(&_dependents) ;
+        nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
+      }
+      
+      // Optional randomization of protodata for this run
+      if (_randProto && _genProtoData && _genProtoData->numEntries()!=nEvt) {
+        oocoutI(_fitModel,Generation) << "RooMCStudy: (Re)randomizing event order in prototype dataset (Nevt=" << nEvt << ")" << endl ;
+        Int_t* newOrder = _genModel->randomizeProtoOrder(_genProtoData->numEntries(),nEvt) ;
+        _genContext->setProtoDataOrder(newOrder) ;
+        delete[] newOrder ;
+      }
+
+      cout << "RooMCStudy: now generating " << nEvt << " events" << endl ;
+      
+      // Actual generation of events
+      if (nEvt>0) {
+        _genSample = _genContext->generate(nEvt) ;
+      } else {
+        // Make empty dataset
+        _genSample = new RooDataSet("emptySample","emptySample",_dependents) ;
+      }	
+    } 
+
+      
+  //} else if (asciiFilePat && &asciiFilePat) { //warning: the address of 'asciiFilePat' will always evaluate as 'true'
+  } else if (asciiFilePat) {
+
+    // Load sample from ASCII file
+    char asciiFile[1024] ;
+    snprintf(asciiFile,1024,asciiFilePat,sampleNum) ;
+    RooArgList depList(_allDependents) ;
+    _genSample = RooDataSet::read(asciiFile,depList,"q") ;      
+    
+  } else {
+    
+    // Load sample from internal list
+    _genSample = (RooDataSet*) _genDataList.At(sampleNum) ;
+    existingData = kTRUE ;
+    if (!_genSample) {
+      oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING: Sample #" << sampleNum << " not loaded, skipping" << endl ;
+      return ;
+    }
+  }
+
+  // Save number of generated events
+  _ngenVar->setVal(_genSample->sumEntries()) ;
+
+  // Call module between generation and fitting hook
+  list<RooAbsMCStudyModule*>::iterator iter3 ;
+  for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
+    (*iter3)->processBetweenGenAndFit(sampleNum) ;
+  }  
+  
+  if (DoFit) fitSample(_genSample) ;
+
+  // Call module between generation and fitting hook
+  for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
+    (*iter3)->processAfterFit(sampleNum) ;
+  }  
+  
+  // Optionally write to ascii file
+  if (doGenerate && asciiFilePat && *asciiFilePat) {
+    char asciiFile[1024] ;
+    snprintf(asciiFile,1024,asciiFilePat,sampleNum) ;
+    RooDataSet* unbinnedData = dynamic_cast<RooDataSet*>(_genSample) ;
+    if (unbinnedData) {
+      unbinnedData->write(asciiFile) ;
+    } else {
+      coutE(InputArguments) << "RooMCStudy::run(" << GetName() << ") ERROR: ASCII writing of binned datasets is not supported" << endl ;
+    }
+  }
+  
+  // Add to list or delete
+  if (!existingData) {
+    if (keepGenData) {
+      _genDataList.Add(_genSample) ;
+    } else {
+      delete _genSample ;
+    }
+  }
+}
+
+
+
 //_____________________________________________________________________________
 Bool_t RooMCStudy::generateAndFit(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) 
 {
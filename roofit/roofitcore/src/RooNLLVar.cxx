@@ -35,6 +35,8 @@
 #include "RooCmdConfig.h"
 #include "RooMsgService.h"
 #include "RooAbsDataStore.h"
+#include "RooVectorDataStore.h"
+#include "RooDataSet.h"
 #include "RooRealMPFE.h"
 
 #include "RooRealVar.h"
@@ -47,6 +49,9 @@ ClassImp(RooNLLVar)
 
 RooArgSet RooNLLVar::_emptySet ;
 
+// 1024 events keep the batches of values of a few p.d.f components in the L1 cache
+const Int_t RooNLLVar::_batchSize = 1024 ;
+
 
 //_____________________________________________________________________________
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
@@ -74,10 +79,12 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   //  ConditionalObservables() -- Define conditional observables 
   //  Verbose()      -- Verbose output of GOF framework classes
   //  CloneData()    -- Clone input dataset for internal use (default is kTRUE)
+  //  BatchMode()    -- Evaluate the p.d.f by batches of events (see batchMode())
 
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
@@ -85,6 +92,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
   _extended = pc.getInt("extended") ;
   _weightSq = kFALSE ;
+  _batchMode = pc.getInt("batchMode") ;
   _first = kTRUE ;
 
 }
@@ -98,6 +106,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE)
 {
   // Construct likelihood from given p.d.f and (binned or unbinned dataset)
@@ -114,6 +123,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE)
 {
   // Construct likelihood from given p.d.f and (binned or unbinned dataset)
@@ -129,6 +139,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchMode(other._batchMode),
   _first(kTRUE)
 {
   // Copy constructor
@@ -153,13 +164,13 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
     _weightSq = flag ; 
     setValueDirty() ; 
 
-  } else if ( _gofOpMode==MPMaster) {
+  } else if ( _gofOpMode==MPMaster && _mpfeArray) {
 
     for (Int_t i=0 ; i<_nCPU ; i++) {
       _mpfeArray[i]->applyNLLWeightSquared(flag) ;
     }    
 
-  } else if ( _gofOpMode==SimMaster) {
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MPMaster) {
 
     for (Int_t i=0 ; i<_nGof ; i++) {
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag) ;
@@ -170,6 +181,40 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
 
 
 
+//_____________________________________________________________________________
+void RooNLLVar::batchMode(Bool_t flag) 
+{ 
+  // Activate or deactivate the batch evaluation of the likelihood. In batch mode
+  // the p.d.f is evaluated on batches of events read directly from the columns 
+  // of the dataset, each component computing its values for a whole batch in one 
+  // loop (see RooAbsReal::getValBatch()) instead of going through the p.d.f graph
+  // for each event. It applies to unbinned datasets with the vector storage
+  // without conditional observables. A batch that the p.d.f cannot evaluate in this
+  // mode, because some of its components do not support it or because some 
+  // values are invalid, is evaluated event by event.
+
+  _batchMode = flag ;
+
+  // The partitions and components created at initialization inherit the flag
+  if (!_init) return ;
+
+  if ( _gofOpMode==MPMaster && _mpfeArray) {
+
+    for (Int_t i=0 ; i<_nCPU ; i++) {
+      _mpfeArray[i]->applyNLLBatchMode(flag) ;
+    }    
+
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MPMaster) {
+
+    for (Int_t i=0 ; i<_nGof ; i++) {
+      ((RooNLLVar*)_gofArray[i])->batchMode(flag) ;
+    }
+
+  }
+} 
+
+
+
 //_____________________________________________________________________________
 Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const 
 {
@@ -188,32 +233,11 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
   _dataClone->store()->recalculateCache( _projDeps, firstEvent, lastEvent, stepSize ) ;
 
   Double_t sumWeight(0) ;
-  for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
-    
-    // get the data values for this event
-    //Double_t wgt = _dataClone->weight(i) ;
-    //if (wgt==0) continue ;
-
-    _dataClone->get(i) ;
-    //cout << "NLL - now loading event #" << i << endl ;
-//     _funcObsSet->Print("v") ;
-    
-
-    if (!_dataClone->valid()) {
-      continue ;
-    }
-
-    if (_dataClone->weight()==0) continue ;
-
-
-    Double_t eventWeight = _dataClone->weight() ;
-    if (_weightSq) eventWeight *= eventWeight ;
-
-    Double_t term = eventWeight * pdfClone->getLogVal(_normSet);
-//     cout << "term[" << i << "] = " << term << endl ;
-    sumWeight += eventWeight ;
-
-    result-= term;
+  RooVectorDataStore* store = (stepSize==1) ? batchStore() : 0 ;
+  if (store) {
+    evaluateBatches(*store,firstEvent,lastEvent,result,sumWeight) ;
+  } else {
+    evaluateEvents(firstEvent,lastEvent,stepSize,result,sumWeight) ;
   }
   
   // include the extended maximum likelihood term, if requested
@@ -256,3 +280,108 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+//_____________________________________________________________________________
+void RooNLLVar::evaluateEvents(Int_t firstEvent, Int_t lastEvent, Int_t stepSize, Double_t& result, Double_t& sumWeight) const 
+{
+  // Subtract from result the weighted log-likelihood terms of the events from firstEvent
+  // to lastEvent processed with a step size of 'stepSize', evaluated event by event
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+
+  for (Int_t i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    
+    // get the data values for this event
+    //Double_t wgt = _dataClone->weight(i) ;
+    //if (wgt==0) continue ;
+
+    _dataClone->get(i) ;
+    //cout << "NLL - now loading event #" << i << endl ;
+//     _funcObsSet->Print("v") ;
+    
+
+    if (!_dataClone->valid()) {
+      continue ;
+    }
+
+    if (_dataClone->weight()==0) continue ;
+
+
+    Double_t eventWeight = _dataClone->weight() ;
+    if (_weightSq) eventWeight *= eventWeight ;
+
+    Double_t term = eventWeight * pdfClone->getLogVal(_normSet);
+//     cout << "term[" << i << "] = " << term << endl ;
+    sumWeight += eventWeight ;
+
+    result-= term;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+RooVectorDataStore* RooNLLVar::batchStore() const 
+{
+  // Return the vector store of the dataset if the likelihood can be 
+  // evaluated by batches of events, or a null pointer otherwise
+
+  if (!_batchMode || (_projDeps && _projDeps->getSize()>0)) {
+    return 0 ;
+  }
+
+  // Binned datasets have their own weights and validity ranges
+  if (!dynamic_cast<RooDataSet*>(_dataClone)) {
+    return 0 ;
+  }
+
+  RooVectorDataStore* store = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  if (!store || (store->isWeighted() && !store->weightArray())) {
+    return 0 ;
+  }
+  return store ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooNLLVar::evaluateBatches(RooVectorDataStore& store, Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& sumWeight) const 
+{
+  // Subtract from result the weighted log-likelihood terms of the events from firstEvent
+  // to lastEvent, evaluated by batches of _batchSize events from the data columns. The
+  // terms are added in the same order as by evaluateEvents(). A batch that cannot be
+  // evaluated at once is evaluated event by event, which reports the evaluation errors
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  const Double_t* weights = store.weightArray() ;
+
+  store.attachBatchColumns(kTRUE) ;
+
+  for (Int_t begin=firstEvent ; begin<lastEvent ; begin+=_batchSize) {
+
+    Int_t n = (lastEvent-begin<_batchSize) ? lastEvent-begin : _batchSize ;
+    const Double_t* probs = pdfClone->getValBatch(begin,n,_normSet) ;
+
+    // Zero probabilities are reported by getLogVal()
+    Bool_t valid = (probs!=0) ;
+    for (Int_t i=0 ; valid && i<n ; i++) {
+      valid = (probs[i]>0) ;
+    }
+    if (!valid) {
+      evaluateEvents(begin,begin+n,1,result,sumWeight) ;
+      continue ;
+    }
+
+    for (Int_t i=0 ; i<n ; i++) {
+      Double_t eventWeight = weights ? weights[begin+i] : 1 ;
+      if (eventWeight==0) continue ;
+      if (_weightSq) eventWeight *= eventWeight ;
+
+      Double_t term = eventWeight * log(probs[i]) ;
+      sumWeight += eventWeight ;
+
+      result-= term ;
+    }
+  }
+
+  store.attachBatchColumns(kFALSE) ;
+}
@@ -99,6 +99,25 @@ Double_t RooRandom::gaussian(TRandom *generator)
 }
 
 
+//_____________________________________________________________________________
+UInt_t RooRandom::toySeed(UInt_t seed, UInt_t index) 
+{
+  // Return the seed of the random generator for the toy experiment 'index'
+  // of a series started with 'seed'. The seeds of the successive toys are 
+  // decorrelated by a 64-bit integer hash, so that each toy has an independent
+  // random number stream that does not depend on the order in which the toys
+  // are processed (e.g. by parallel workers). The returned seed is never zero,
+  // which would let TRandom3 choose a time-dependent seed
+
+  ULong64_t z = (ULong64_t(seed)<<32) + index + 0x9E3779B97F4A7C15ULL ;
+  z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL ;
+  z = (z ^ (z>>27)) * 0x94D049BB133111EBULL ;
+  z = z ^ (z>>31) ;
+  UInt_t ret = UInt_t(z ^ (z>>32)) ;
+  return ret ? ret : 1 ;
+}
+
+
 //_____________________________________________________________________________
 Bool_t RooRandom::quasi(UInt_t dimension, Double_t vector[], RooQuasiRandomGenerator *generator) 
 {
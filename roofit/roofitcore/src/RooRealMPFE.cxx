@@ -319,6 +319,18 @@ void RooRealMPFE::serverLoop()
       }
       break ;
 
+    case ApplyNLLBatchMode:
+      {
+      Bool_t flag ;
+      UInt_t tmp1 = read(_pipeToServer[0],&flag,sizeof(Bool_t)) ;
+      if (tmp1<sizeof(Bool_t)) perror("read") ;
+      if (_verboseServer) cout << "RooRealMPFE::serverLoop(" << GetName() 
+			       << ") IPC fromClient> ApplyNLLBatchMode " << (flag?1:0) << endl ; 
+      
+      doApplyNLLBatchMode(flag) ;
+      }
+      break ;
+
     case Terminate: 
       if (_verboseServer) cout << "RooRealMPFE::serverLoop(" << GetName() 
 			       << ") IPC fromClient> Terminate" << endl ; 
@@ -721,3 +733,35 @@ void RooRealMPFE::doApplyNLLW2(Bool_t flag)
     nll->applyWeightSquared(flag) ;
   }  
 }
+
+
+
+//_____________________________________________________________________________
+void RooRealMPFE::applyNLLBatchMode(Bool_t flag) 
+{
+  // Control the batch evaluation of the likelihood calculated
+  // on the server side, see RooNLLVar::batchMode()
+
+#ifndef _WIN32
+  if (_state==Client) {
+    Message msg = ApplyNLLBatchMode ;
+    UInt_t tmp1 = write(_pipeToServer[1],&msg,sizeof(msg)) ;
+    UInt_t tmp2 = write(_pipeToServer[1],&flag,sizeof(Bool_t)) ;
+    if (tmp1+tmp2<sizeof(Message)+sizeof(Bool_t)) perror("write") ;
+    if (_verboseServer) cout << "RooRealMPFE::applyNLLBatchMode(" << GetName() 
+			     << ") IPC toServer> ApplyNLLBatchMode " << (flag?1:0) << endl ;      
+  } 
+#endif // _WIN32
+  doApplyNLLBatchMode(flag) ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooRealMPFE::doApplyNLLBatchMode(Bool_t flag) 
+{
+  RooNLLVar* nll = dynamic_cast<RooNLLVar*>(_arg.absArg()) ;
+  if (nll) {
+    nll->batchMode(flag) ;
+  }  
+}
@@ -1397,6 +1397,120 @@ void RooVectorDataStore::resetBuffers()
 
 
 
+//_____________________________________________________________________________
+void RooVectorDataStore::attachBatchColumns(Bool_t flag) 
+{
+  // Attach (flag=kTRUE) or detach the value columns of this store and of its
+  // cache to the objects into which they are loaded, so that these objects 
+  // return their columns in RooAbsReal::getValBatch(). The columns must be
+  // detached before any change of the contents of the store.
+
+  std::vector<RealVector*>::iterator iter = _realStoreList.begin() ;
+  for (; iter!=_realStoreList.end() ; ++iter) {
+    RooAbsReal* real = (*iter)->_real ;
+    if (real) {
+      real->_batchColumn = (flag && (*iter)->size()>0) ? (*iter)->_vec0 : 0 ;
+    }
+  }
+
+  std::vector<RealFullVector*>::iterator iter2 = _realfStoreList.begin() ;
+  for (; iter2!=_realfStoreList.end() ; ++iter2) {
+    RooAbsReal* real = (*iter2)->_real ;
+    if (real) {
+      real->_batchColumn = (flag && (*iter2)->size()>0) ? (*iter2)->_vec0 : 0 ;
+    }
+  }
+
+  if (_cache) {
+    _cache->attachBatchColumns(flag) ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+const Double_t* RooVectorDataStore::weightArray() const 
+{
+  // Return the array of the event weights, or a null pointer if the
+  // events are not weighted
+
+  if (_extWgtArray) {
+    return _extWgtArray ;
+  }
+
+  if (_wgtVar) {
+    std::vector<RealVector*>::const_iterator iter = _realStoreList.begin() ;
+    for (; iter!=_realStoreList.end() ; ++iter) {
+      if (std::string((*iter)->bufArg()->GetName())==_wgtVar->GetName() && (*iter)->size()>0) {
+	return (*iter)->_vec0 ;
+      }
+    }
+    std::vector<RealFullVector*>::const_iterator iter2 = _realfStoreList.begin() ;
+    for (; iter2!=_realfStoreList.end() ; ++iter2) {
+      if (std::string((*iter2)->bufArg()->GetName())==_wgtVar->GetName() && (*iter2)->size()>0) {
+	return (*iter2)->_vec0 ;
+      }
+    }
+  }
+
+  return 0 ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooVectorDataStore::shareColumns(const RooVectorDataStore& other) 
+{
+  // Release the values of the columns of this store and read instead those 
+  // of the columns of the same name of other, which must hold the same entries.
+  // This lets several stores, each loading the values into its own objects, 
+  // read the same data without copying it. Other must outlive this store and 
+  // neither store may be modified afterwards. The columns of the cache are not shared.
+  // Return kFALSE if the stores do not have the same number of entries
+
+  if (_nEntries!=other._nEntries) {
+    return kFALSE ;
+  }
+
+  std::vector<RealVector*>::iterator iter = _realStoreList.begin() ;
+  for (; iter!=_realStoreList.end() ; ++iter) {
+    std::vector<RealVector*>::const_iterator oiter = other._realStoreList.begin() ;
+    for (; oiter!=other._realStoreList.end() ; ++oiter) {
+      if (std::string((*oiter)->bufArg()->GetName())==(*iter)->bufArg()->GetName() && (*oiter)->size()==_nEntries) {
+	(*iter)->shareValues(**oiter) ;
+	break ;
+      }
+    }
+  }
+
+  // The error columns of the full reals keep their own values
+  std::vector<RealFullVector*>::iterator iter2 = _realfStoreList.begin() ;
+  for (; iter2!=_realfStoreList.end() ; ++iter2) {
+    std::vector<RealFullVector*>::const_iterator oiter2 = other._realfStoreList.begin() ;
+    for (; oiter2!=other._realfStoreList.end() ; ++oiter2) {
+      if (std::string((*oiter2)->bufArg()->GetName())==(*iter2)->bufArg()->GetName() && (*oiter2)->size()==_nEntries) {
+	(*iter2)->shareValues(**oiter2) ;
+	break ;
+      }
+    }
+  }
+
+  std::vector<CatVector*>::iterator iter3 = _catStoreList.begin() ;
+  for (; iter3!=_catStoreList.end() ; ++iter3) {
+    std::vector<CatVector*>::const_iterator oiter3 = other._catStoreList.begin() ;
+    for (; oiter3!=other._catStoreList.end() ; ++oiter3) {
+      if (std::string((*oiter3)->bufArg()->GetName())==(*iter3)->bufArg()->GetName() && (*oiter3)->size()==_nEntries) {
+	(*iter3)->shareValues(**oiter3) ;
+	break ;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 void RooVectorDataStore::dump()
 {
@@ -1408,9 +1522,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << (*iter)->_vec0[i] << " " ;
     }
     cout << endl ;
   }    
@@ -1420,9 +1534,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << (*iter2)->_vec0[i] << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -27,6 +27,14 @@ For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
 </p>
+
+<p>
+Alternatively, SetNumWorkers(n) distributes the toys over n forked processes
+on the local machine (see RooForkedLoop), without the need of a PROOF session.
+Each toy then has its own random number stream, seeded from the toy number
+and from a seed drawn from RooRandom at the start of the run, so that the
+sampling distribution does not depend on the number of workers.
+</p>
 END_HTML
 */
 //
@@ -257,6 +265,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // number of forked processes generating the toys when proof is not used.
+      // Zero (the default) means a serial run without reseeding of the toys
+      void SetNumWorkers(Int_t nWorkers) { fNWorkers = nWorkers; }
+      Int_t GetNumWorkers(void) const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
       
    protected:
@@ -269,6 +282,9 @@ class ToyMCSampler: public TestStatSampler {
       // helper method for clearing  the cache
       virtual void ClearCache();
 
+      // run with the forked processes set by SetNumWorkers
+      RooDataSet* GetSamplingDistributionsForked(RooArgSet& paramPoint);
+
 
       // densities, snapshots, and test statistics to reweight to
       RooAbsPdf *fPdf; // model (can be alt or null)
@@ -302,6 +318,10 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
       
       ProofConfig *fProofConfig;   //!
+
+      Int_t fNWorkers;             //! number of forked processes (see SetNumWorkers)
+      UInt_t fToySeed;             //! seed of the toys of a forked run (0: no reseeding)
+      Int_t fFirstToy;             //! number of the first toy processed by GetSamplingDistributionsSingleWorker
       
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -318,6 +338,10 @@ class ToyMCSampler: public TestStatSampler {
       static Bool_t fgAlwaysUseMultiGen ;  // Use PrepareMultiGen always
       Bool_t fUseMultiGen ; // Use PrepareMultiGen?
 
+   private:
+      class ForkTask;
+      friend class ForkTask;
+
    protected:
    ClassDef(ToyMCSampler,3) // A simple implementation of the TestStatSampler interface
 };
@@ -32,6 +32,7 @@
 #include "RooStats/DetailedOutputAggregator.h"
 #include "RooSimultaneous.h"
 #include "RooCategory.h"
+#include "RooForkedLoop.h"
 
 #include "TMath.h"
 
@@ -156,6 +157,9 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
+   fToySeed = 0;
+   fFirstToy = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -195,6 +199,9 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) :
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
+   fToySeed = 0;
+   fFirstToy = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -301,8 +308,10 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    // Use for serial and parallel runs.
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if(fNWorkers > 0) return GetSamplingDistributionsForked(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
 
    // ======= P A R A L L E L   R U N =======
@@ -339,6 +348,109 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+// Generation of the toys by blocks in the processes of RooForkedLoop. Each
+// block is a serial run of GetSamplingDistributionsSingleWorker.
+class ToyMCSampler::ForkTask : public RooForkedLoop::Task {
+
+   public:
+      ForkTask(ToyMCSampler& sampler, RooArgSet& paramPoint) :
+         fSampler(sampler), fParamPoint(paramPoint), fNuisPoint(0), fNPoints(0), fOutput(0)
+      {
+         if (fSampler.fNuisanceParametersSampler)
+            fNuisPoint = (RooArgSet*)fSampler.fNuisancePars->snapshot();
+      }
+      virtual ~ForkTask() {
+         delete fNuisPoint;
+      }
+
+      virtual void process(Int_t begin, Int_t end, TList& output) {
+         SkipNuisancePoints(begin);
+         fSampler.fFirstToy = begin;
+         fSampler.fNToys = end - begin;
+         RooDataSet* r = fSampler.GetSamplingDistributionsSingleWorker(fParamPoint);
+         fNPoints = end;
+         if (r) output.Add(r);
+      }
+
+      virtual void collect(Int_t /*begin*/, Int_t /*end*/, TList& output) {
+         RooDataSet* r = (RooDataSet*)output.First();
+         if (!r) return;
+         if (!fOutput) {
+            fOutput = r;
+            output.Remove(r);
+         } else {
+            fOutput->append(*r);
+         }
+      }
+
+      // Advance the nuisance parameter points of this process to the toy 'first'.
+      // The points are drawn once, before forking, and each toy takes the next one,
+      // as in a serial run
+      void SkipNuisancePoints(Int_t first) {
+         Double_t weight;
+         for (; fNuisPoint && fNPoints < first; ++fNPoints)
+            fSampler.fNuisanceParametersSampler->NextPoint(*fNuisPoint, weight);
+      }
+
+      RooDataSet* Output() const { return fOutput; }
+
+   private:
+      ToyMCSampler& fSampler;
+      RooArgSet& fParamPoint;
+      RooArgSet* fNuisPoint;     // receives the skipped nuisance parameter points
+      Int_t fNPoints;            // number of nuisance parameter points taken in this process
+      RooDataSet* fOutput;       // merged sampling distributions
+};
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsForked(RooArgSet& paramPointIn)
+{
+   // Generate the toys with fNWorkers forked processes (see SetNumWorkers).
+   // The toys are partitioned in contiguous blocks, each generated by a
+   // serial run in its own process, and the results are merged in the
+   // order of the toys.
+
+   CheckConfig();
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   Int_t nToys = fNToys;
+   Int_t totToys = fNToys;
+   if (fMaxToys < totToys) totToys = (Int_t)fMaxToys;
+
+   // the nuisance parameter points are drawn before forking, so that
+   // they are the same in all the workers
+   if(!fNuisanceParametersSampler && fPriorNuisance && fNuisancePars) {
+      RooArgSet *allVars = fPdf->getVariables();
+      RooArgSet *saveAll = (RooArgSet*) allVars->snapshot();
+      *allVars = paramPointIn;
+      fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, totToys, fExpectedNuisancePar);
+      *allVars = *saveAll;
+      delete saveAll;
+      delete allVars;
+   }
+
+   // seed of the toys of this run
+   fToySeed = RooRandom::integer(kMaxUInt);
+   if (fToySeed == 0) fToySeed = 1;
+
+   ForkTask task(*this, paramPointIn);
+   RooForkedLoop::run(task, totToys, fNWorkers);
+   task.SkipNuisancePoints(totToys);
+
+   // reset the number of toys
+   fNToys = nToys;
+   fToySeed = 0;
+   fFirstToy = 0;
+
+   return task.Output();
+}
+
 RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramPointIn)
 {
    // This is the main function for serial runs. It is called automatically
@@ -372,6 +484,9 @@ RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramP
       // need to check at the beginning for case that zero toys are requested
       if (toysInTails >= fToysInTails  &&  i+1 > fNToys) break;
 
+      // independent random number stream for each toy of a forked run
+      if (fToySeed) RooRandom::randomGenerator()->SetSeed(RooRandom::toySeed(fToySeed, fFirstToy + i));
+
       // status update
       if ( i% 500 == 0 && i>0 ) {
          oocoutP((TObject*)0,Generation) << "generated toys: " << i << " / " << fNToys;
@@ -87,6 +87,7 @@
 
 
 ClassImp(EventHeader)
+ClassImp(EventTag)
 ClassImp(Event)
 ClassImp(Track)
 ClassImp(HistogramManager)
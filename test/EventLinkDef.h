@@ -4,9 +4,11 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
-#pragma link C++ class EventHeader+;
+#pragma link C++ options=specialized class EventHeader+;
+#pragma link C++ options=specialized class EventTag+;
 #pragma link C++ class Event+;
 #pragma link C++ class HistogramManager+;
 #pragma link C++ class Track+;
+#pragma link C++ class std::vector<EventHeader*>+;
 
 #endif
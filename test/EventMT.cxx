@@ -84,6 +84,7 @@
 
 
 ClassImp(EventHeader)
+ClassImp(EventTag)
 ClassImp(Event)
 ClassImp(Track)
 ClassImp(HistogramManager)
@@ -101,6 +101,22 @@ public:
    ClassDef(EventHeader,1)  //Event Header
 };
 
+class EventTag : public TObject {
+
+private:
+   Int_t   fTrigger;    //Trigger mask
+   Float_t fWeight;     //Event weight
+
+public:
+   EventTag() : fTrigger(0), fWeight(0) { }
+   virtual ~EventTag() { }
+   void    Set(Int_t trigger, Float_t weight) { fTrigger = trigger; fWeight = weight; }
+   Int_t   GetTrigger() const { return fTrigger; }
+   Float_t GetWeight() const { return fWeight; }
+
+   ClassDef(EventTag,1)  //Event Tag
+};
+
 
 class Event : public TObject {
 
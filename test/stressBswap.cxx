@@ -0,0 +1,152 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A benchmark of the byte swapping of the arrays of basic types___
+//
+//   For Short_t, Int_t, Long64_t, Float_t and Double_t, an array is
+//   converted from the big endian format of the ROOT files:
+//     - element by element with frombuf, as TBufferFile used to do,
+//     - with TBufferFile::ReadFastArray, using each of the byte swapping
+//       kernels supported by the processor (see Bswaparray.h),
+//   and converted back to the file format with TBufferFile::WriteFastArray.
+//   The throughputs are reported in MB/s and the arrays read with the
+//   kernels are compared with the ones read element by element.
+//
+//   To run in batch mode, do
+//     stressBswap
+//     stressBswap 100
+//   Here the parameter is the number of times each array of 1M
+//   elements is converted. The default value is 50.
+//
+//   An example of output:
+// ******************************************************************
+// *  Starting  Byte Swapping Benchmark                             *
+// ******************************************************************
+// type       frombuf  Read scalar    Read SSSE3     Read AVX2   Write AVX2
+// Short_t     1534.2       1630.4        7911.5       11823.0      11420.7
+// ...
+// Test1: Short_t arrays converted by all the kernels ------------- OK
+// ...
+// ******************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "Bswaparray.h"
+#include "Bytes.h"
+#include "TBufferFile.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "stressCommon.h"
+
+namespace {
+   const Int_t kNelements = 1000000;
+
+   //______________________________________________________________________________
+   Double_t Throughput(Double_t nbytes, TStopwatch &timer)
+   {
+      Double_t t = timer.RealTime();
+      return t > 0 ? nbytes / t / 1e6 : 0;
+   }
+}
+
+//______________________________________________________________________________
+template <typename T>
+Bool_t BenchType(const char *name, Int_t ntimes, Int_t nkernels)
+{
+   // Measure the throughputs for one type and check that all the kernels
+   // give the same result as frombuf. Returns true if they do.
+
+   const Int_t nbytes = kNelements * sizeof(T);
+
+   // The file format representation of the array. An offset of one byte
+   // makes the reading unaligned, as it usually is in the baskets.
+   // The values are not random bytes, to avoid the signaling NaNs.
+   TBufferFile wbuf(TBuffer::kWrite, nbytes + 16);
+   std::vector<char> raw(nbytes + 1);
+   char *file = &raw[1];
+   char *cur = file;
+   for (Int_t i = 0; i < kNelements; ++i) {
+      tobuf(cur, T((rand() % 20001 - 10000) * 1.25));
+   }
+
+   // Before: element by element
+   std::vector<T> ref(kNelements);
+   TStopwatch timer;
+   for (Int_t k = 0; k < ntimes; ++k) {
+      cur = file;
+      for (Int_t i = 0; i < kNelements; ++i) frombuf(cur, &ref[i]);
+   }
+   timer.Stop();
+   printf("%-10s %9.1f", name, Throughput(Double_t(nbytes) * ntimes, timer));
+
+   // After: TBufferFile::ReadFastArray with each kernel
+   TBufferFile rbuf(TBuffer::kRead, nbytes + 1, &raw[0], kFALSE);
+   std::vector<T> res(kNelements);
+   Bool_t ok = kTRUE;
+   for (Int_t kernel = 0; kernel < nkernels; ++kernel) {
+      R__SetBswapKernel(kernel);
+      memset(&res[0], 0, nbytes);
+      timer.Start();
+      for (Int_t k = 0; k < ntimes; ++k) {
+         rbuf.SetBufferOffset(1);
+         rbuf.ReadFastArray(&res[0], kNelements);
+      }
+      timer.Stop();
+      printf("  %12.1f", Throughput(Double_t(nbytes) * ntimes, timer));
+      if (memcmp(&res[0], &ref[0], nbytes) != 0) ok = kFALSE;
+   }
+
+   // And back with the best kernel
+   timer.Start();
+   for (Int_t k = 0; k < ntimes; ++k) {
+      wbuf.SetBufferOffset(1);
+      wbuf.WriteFastArray(&res[0], kNelements);
+   }
+   timer.Stop();
+   printf("  %11.1f\n", Throughput(Double_t(nbytes) * ntimes, timer));
+   if (memcmp(wbuf.Buffer() + 1, file, nbytes) != 0) ok = kFALSE;
+
+   return ok;
+}
+
+//______________________________________________________________________________
+Int_t stressBswap(Int_t ntimes = 50)
+{
+   PrintBanner("Byte Swapping Benchmark");
+
+   // The kernels supported by this processor
+   Int_t best = R__SetBswapKernel(kBswapAVX2);
+   Int_t nkernels = best + 1;
+
+   printf("type       frombuf");
+   for (Int_t kernel = 0; kernel < nkernels; ++kernel) {
+      printf("  %12s", TString::Format("Read %s", R__GetBswapKernelName(kernel)).Data());
+   }
+   printf("  %11s\n", TString::Format("Write %s", R__GetBswapKernelName(best)).Data());
+
+   const char *names[] = { "Short_t", "Int_t", "Long64_t", "Float_t", "Double_t" };
+   Bool_t ok[5];
+   ok[0] = BenchType<Short_t>(names[0], ntimes, nkernels);
+   ok[1] = BenchType<Int_t>(names[1], ntimes, nkernels);
+   ok[2] = BenchType<Long64_t>(names[2], ntimes, nkernels);
+   ok[3] = BenchType<Float_t>(names[3], ntimes, nkernels);
+   ok[4] = BenchType<Double_t>(names[4], ntimes, nkernels);
+
+   Int_t nfailed = 0;
+   for (Int_t i = 0; i < 5; ++i) {
+      PrintResult(i + 1, TString::Format("%s arrays converted by all the kernels", names[i]), ok[i]);
+      if (!ok[i]) ++nfailed;
+   }
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t ntimes = 50;
+   if (argc > 1) ntimes = atoi(argv[1]);
+   return stressBswap(ntimes);
+}
@@ -0,0 +1,222 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the memory allocations when reading split collections___
+//
+//   A tree is written with a split TClonesArray of TNamed and a split
+//   std::vector<EventHeader*> whose sizes change from entry to entry.
+//   The tree is read with the elements of the vectors reused from one
+//   entry to the next one (TBranchElement::SetRecycleElements(kTRUE))
+//   and without (the default), counting the calls to operator new after
+//   the first entries.
+//   The values read must be the ones written, and the recycling must
+//   bring the number of allocations per entry close to zero, the objects
+//   of the TClonesArray being kept by the array in both cases.
+//
+//   To run in batch mode, do
+//     stressCollectionRead
+//     stressCollectionRead 100000
+//   Here the parameter is the number of entries.
+//   The default value is 20000.
+//
+// An example of output:
+// ******************************************************************
+// *  Starting  Collection Reading Stress Test                      *
+// ******************************************************************
+// Allocations per entry with recycling:   0.0420, without:  15.4987
+// Test1: Values read with the elements recycled ------------------- OK
+// Test2: Values read without recycling ---------------------------- OK
+// Test3: Allocations per entry with the elements recycled ---------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <new>
+#include <vector>
+#include "TBranchElement.h"
+#include "TClonesArray.h"
+#include "TFile.h"
+#include "TNamed.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "Event.h"
+#include "stressCommon.h"
+
+namespace {
+   Bool_t   gCount = kFALSE;   // True when the allocations are counted
+   Long64_t gNalloc = 0;       // Number of calls to operator new
+}
+
+#if __cplusplus >= 201103L
+#define R__THROW_BAD_ALLOC
+#else
+#define R__THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+//______________________________________________________________________________
+void *operator new(size_t size) R__THROW_BAD_ALLOC
+{
+   if (gCount) ++gNalloc;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+//______________________________________________________________________________
+void *operator new[](size_t size) R__THROW_BAD_ALLOC
+{
+   return operator new(size);
+}
+
+//______________________________________________________________________________
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+//______________________________________________________________________________
+void operator delete[](void *p) throw()
+{
+   free(p);
+}
+
+namespace {
+
+   //______________________________________________________________________________
+   Int_t Size(Long64_t entry)
+   {
+      // Number of elements of the collections of entry.
+
+      return 5 + entry % 20;
+   }
+
+   //______________________________________________________________________________
+   void WriteTree(const char *filename, Long64_t nentries)
+   {
+      // Write the test tree in filename.
+
+      TFile f(filename, "RECREATE");
+      TTree tree("T", "split collections");
+      TClonesArray *named = new TClonesArray("TNamed");
+      std::vector<EventHeader*> *headers = new std::vector<EventHeader*>;
+      tree.Branch("named", &named, 32000, 99);
+      tree.Branch("headers", &headers, 32000, 199);
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         named->Clear();
+         for (std::vector<EventHeader*>::iterator iter = headers->begin(); iter != headers->end(); ++iter) {
+            delete *iter;
+         }
+         headers->clear();
+         for (Int_t i = 0; i < Size(entry); ++i) {
+            new ((*named)[i]) TNamed(TString::Format("n%d", i).Data(), "t");
+            EventHeader *hdr = new EventHeader;
+            hdr->Set(i, Int_t(entry), Int_t(entry % 7));
+            headers->push_back(hdr);
+         }
+         tree.Fill();
+      }
+      tree.Write();
+      f.Close();
+      for (std::vector<EventHeader*>::iterator iter = headers->begin(); iter != headers->end(); ++iter) {
+         delete *iter;
+      }
+      delete headers;
+      delete named;
+   }
+
+   //______________________________________________________________________________
+   Bool_t ReadTree(const char *filename, Bool_t recycle, Double_t &allocs)
+   {
+      // Read the test tree, check the values and return in allocs the number
+      // of allocations per entry after the first 10% of the entries.
+
+      Bool_t saved = TBranchElement::GetRecycleElements();
+      TBranchElement::SetRecycleElements(recycle);
+      TFile f(filename);
+      TTree *tree = 0;
+      f.GetObject("T", tree);
+      if (!tree) {
+         TBranchElement::SetRecycleElements(saved);
+         return kFALSE;
+      }
+      TClonesArray *named = 0;
+      std::vector<EventHeader*> *headers = 0;
+      tree->SetBranchAddress("named", &named);
+      tree->SetBranchAddress("headers", &headers);
+
+      Bool_t ok = kTRUE;
+      Long64_t nentries = tree->GetEntries();
+      Long64_t first = nentries / 10;
+      gNalloc = 0;
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         gCount = (entry >= first);
+         tree->GetEntry(entry);
+         gCount = kFALSE;
+         Int_t n = Size(entry);
+         if (named->GetEntriesFast() != n || (Int_t)headers->size() != n) {
+            ok = kFALSE;
+            continue;
+         }
+         for (Int_t i = 0; i < n; ++i) {
+            TNamed *obj = (TNamed*)named->UncheckedAt(i);
+            EventHeader *hdr = (*headers)[i];
+            if (TString::Format("n%d", i) != obj->GetName()) ok = kFALSE;
+            if (!hdr || hdr->GetEvtNum() != i || hdr->GetRun() != Int_t(entry) || hdr->GetDate() != Int_t(entry % 7)) {
+               ok = kFALSE;
+            }
+         }
+      }
+      allocs = Double_t(gNalloc) / (nentries - first);
+
+      tree->ResetBranchAddresses();
+      for (std::vector<EventHeader*>::iterator iter = headers->begin(); iter != headers->end(); ++iter) {
+         delete *iter;
+      }
+      delete headers;
+      delete named;
+      delete tree;
+      TBranchElement::SetRecycleElements(saved);
+      return ok;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressCollectionRead(Long64_t nentries = 20000)
+{
+   PrintBanner("Collection Reading Stress Test");
+
+   if (nentries < 100) nentries = 100;
+   const char *filename = "stressCollectionRead.root";
+   WriteTree(filename, nentries);
+
+   Double_t recycled = 0, plain = 0;
+   Bool_t okRecycled = ReadTree(filename, kTRUE, recycled);
+   Bool_t okPlain = ReadTree(filename, kFALSE, plain);
+   printf("Allocations per entry with recycling: %8.4f, without: %8.4f\n", recycled, plain);
+   Int_t nfailed = 0;
+
+   PrintResult(1, "Values read with the elements recycled", okRecycled);
+   if (!okRecycled) ++nfailed;
+
+   PrintResult(2, "Values read without recycling", okPlain);
+   if (!okPlain) ++nfailed;
+
+   // Only the baskets read from the file may still need memory
+   Bool_t ok = recycled < 1 && recycled < plain;
+   PrintResult(3, "Allocations per entry with the elements recycled", ok);
+   if (!ok) ++nfailed;
+
+   gSystem->Unlink(filename);
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Long64_t nentries = 20000;
+   if (argc > 1) nentries = atoi(argv[1]);
+   return stressCollectionRead(nentries);
+}
@@ -0,0 +1,41 @@
+// @(#)root/test:$Id$
+#ifndef ROOT_stressCommon
+#define ROOT_stressCommon
+
+// Printing of the banner and of the numbered results shared by the
+// stress tests of the form
+// ******************************************************************
+// *  Starting  Some Stress Test                                    *
+// ******************************************************************
+// Test1: Title of the test ---------------------------------------- OK
+// ******************************************************************
+
+#include <stdio.h>
+
+#include "TString.h"
+
+//______________________________________________________________________________
+inline void PrintBannerLine()
+{
+   printf("******************************************************************\n");
+}
+
+//______________________________________________________________________________
+inline void PrintBanner(const char *title)
+{
+   TString line = TString::Format("*  Starting  %s ", title);
+   while (line.Length() < 65) line += " ";
+   PrintBannerLine();
+   printf("%s*\n", line.Data());
+   PrintBannerLine();
+}
+
+//______________________________________________________________________________
+inline void PrintResult(Int_t test, const char *title, Bool_t ok)
+{
+   TString line = TString::Format("Test%d: %s ", test, title);
+   while (line.Length() < 64) line += "-";
+   printf("%s %s\n", line.Data(), ok ? "OK" : "FAILED");
+}
+
+#endif
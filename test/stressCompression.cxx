@@ -0,0 +1,277 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A round-trip and throughput test of the compression algorithms___
+//
+//   For each of the compression algorithms (ZLIB, LZMA, LZ4 and ZSTD)
+//   a TTree with a realistic mix of branches (floats with limited
+//   precision, counters, variable size arrays) is written to a file
+//   and read back. The content read back is compared with the content
+//   written and the compression factor, the write time and the read
+//   (decompression) throughput are reported.
+//   Finally the TTree is written with the parallel compression of the
+//   baskets and the layout of the file is compared with the one obtained
+//   with the sequential compression.
+//
+//   To run in batch mode, do
+//     stressCompression
+//     stressCompression 100000
+//   Here the parameter is the number of entries in each TTree.
+//   The default value is 50000.
+//
+//   An example of output when all tests pass:
+// ******************************************************************
+// *  Starting  Compression Stress Test (ZLIB, LZMA, LZ4, ZSTD)     *
+// ******************************************************************
+// algo  level   file size  factor   write [s]   read [s]  read [MB/s]
+// ZLIB      1     5291744    2.27        0.85       0.13       91.52
+// ...
+// Test1: Round trip of ZLIB compressed TTree ---------------------- OK
+// ...
+// ******************************************************************
+
+#include <stdlib.h>
+#include "Compression.h"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TSystem.h"
+
+namespace {
+   const Int_t kMaxTracks = 64;
+
+   struct Event_t {
+      Int_t    fRun;
+      Int_t    fEvent;
+      Int_t    fNtrack;
+      Float_t  fTemperature;
+      Double_t fWeight;
+      Float_t  fPx[kMaxTracks];
+      Float_t  fPy[kMaxTracks];
+      Float_t  fPz[kMaxTracks];
+      Short_t  fCharge[kMaxTracks];
+   };
+
+   //______________________________________________________________________________
+   void MakeEvent(TRandom &rnd, Int_t ientry, Event_t &ev)
+   {
+      // Fill the event with content resembling reconstructed data:
+      // slowly changing run numbers, limited precision measurements and
+      // a variable number of tracks.
+
+      ev.fRun = 1000 + ientry / 10000;
+      ev.fEvent = ientry;
+      ev.fNtrack = rnd.Poisson(20);
+      if (ev.fNtrack > kMaxTracks) ev.fNtrack = kMaxTracks;
+      ev.fTemperature = 20 + 0.01 * (Int_t)(100 * rnd.Gaus(0, 0.5));
+      ev.fWeight = rnd.Exp(1.);
+      for (Int_t t = 0; t < ev.fNtrack; ++t) {
+         ev.fPx[t] = 0.001 * (Int_t)(1000 * rnd.Gaus(0, 2));
+         ev.fPy[t] = 0.001 * (Int_t)(1000 * rnd.Gaus(0, 2));
+         ev.fPz[t] = 0.001 * (Int_t)(1000 * rnd.Gaus(0, 10));
+         ev.fCharge[t] = rnd.Rndm() > 0.5 ? 1 : -1;
+      }
+   }
+}
+
+//______________________________________________________________________________
+Bool_t TestAlgorithm(ROOT::ECompressionAlgorithm algo, const char *name,
+                     Int_t level, Int_t nentries)
+{
+   // Write and read back a TTree compressed with the given algorithm.
+   // Returns kFALSE if the content read back differs from the one written.
+
+   TString filename = TString::Format("stressCompression_%s.root", name);
+   Event_t ev;
+   TStopwatch timer;
+
+   // Write
+   timer.Start();
+   TFile *f = TFile::Open(filename, "RECREATE");
+   f->SetCompressionSettings(ROOT::CompressionSettings(algo, level));
+   TTree *tree = new TTree("T", "compression test tree");
+   tree->Branch("run", &ev.fRun, "run/I");
+   tree->Branch("event", &ev.fEvent, "event/I");
+   tree->Branch("ntrack", &ev.fNtrack, "ntrack/I");
+   tree->Branch("temperature", &ev.fTemperature, "temperature/F");
+   tree->Branch("weight", &ev.fWeight, "weight/D");
+   tree->Branch("px", ev.fPx, "px[ntrack]/F");
+   tree->Branch("py", ev.fPy, "py[ntrack]/F");
+   tree->Branch("pz", ev.fPz, "pz[ntrack]/F");
+   tree->Branch("charge", ev.fCharge, "charge[ntrack]/S");
+   TRandom3 rnd(4357);
+   for (Int_t i = 0; i < nentries; ++i) {
+      MakeEvent(rnd, i, ev);
+      tree->Fill();
+   }
+   Long64_t totbytes = tree->GetTotBytes();
+   f->Write();
+   delete f;
+   Double_t writeTime = timer.RealTime();
+
+   // Read (decompress) and compare with the generated content
+   Bool_t ok = kTRUE;
+   Event_t ref;
+   timer.Start();
+   f = TFile::Open(filename);
+   if (!f || f->IsZombie()) return kFALSE;
+   Long64_t filesize = f->GetSize();
+   tree = (TTree*)f->Get("T");
+   if (!tree || tree->GetEntries() != nentries) ok = kFALSE;
+   if (ok) {
+      tree->SetBranchAddress("run", &ev.fRun);
+      tree->SetBranchAddress("event", &ev.fEvent);
+      tree->SetBranchAddress("ntrack", &ev.fNtrack);
+      tree->SetBranchAddress("temperature", &ev.fTemperature);
+      tree->SetBranchAddress("weight", &ev.fWeight);
+      tree->SetBranchAddress("px", ev.fPx);
+      tree->SetBranchAddress("py", ev.fPy);
+      tree->SetBranchAddress("pz", ev.fPz);
+      tree->SetBranchAddress("charge", ev.fCharge);
+      rnd.SetSeed(4357);
+      for (Int_t i = 0; i < nentries && ok; ++i) {
+         tree->GetEntry(i);
+         MakeEvent(rnd, i, ref);
+         if (ev.fRun != ref.fRun || ev.fEvent != ref.fEvent ||
+             ev.fNtrack != ref.fNtrack || ev.fTemperature != ref.fTemperature ||
+             ev.fWeight != ref.fWeight) {
+            ok = kFALSE;
+         }
+         for (Int_t t = 0; ok && t < ev.fNtrack; ++t) {
+            if (ev.fPx[t] != ref.fPx[t] || ev.fPy[t] != ref.fPy[t] ||
+                ev.fPz[t] != ref.fPz[t] || ev.fCharge[t] != ref.fCharge[t]) {
+               ok = kFALSE;
+            }
+         }
+      }
+   }
+   delete f;
+   Double_t readTime = timer.RealTime();
+
+   printf("%-5s %5d %11lld %7.2f %11.2f %10.2f %11.2f\n", name, level, filesize,
+          filesize ? Double_t(totbytes) / filesize : 0., writeTime, readTime,
+          readTime > 0 ? totbytes / readTime / 1e6 : 0.);
+
+   gSystem->Unlink(filename);
+   return ok;
+}
+
+//______________________________________________________________________________
+void WriteTree(const char *filename, Bool_t parallel, Int_t nentries)
+{
+   // Write the test TTree with ZLIB, with or without the parallel compression
+   // of the baskets.
+
+   Event_t ev;
+   TFile *f = TFile::Open(filename, "RECREATE");
+   f->SetCompressionSettings(ROOT::CompressionSettings(ROOT::kZLIB, 1));
+   TTree *tree = new TTree("T", "compression test tree");
+   tree->SetParallelCompression(parallel);
+   tree->Branch("run", &ev.fRun, "run/I");
+   tree->Branch("event", &ev.fEvent, "event/I");
+   tree->Branch("ntrack", &ev.fNtrack, "ntrack/I");
+   tree->Branch("temperature", &ev.fTemperature, "temperature/F");
+   tree->Branch("weight", &ev.fWeight, "weight/D");
+   tree->Branch("px", ev.fPx, "px[ntrack]/F");
+   tree->Branch("py", ev.fPy, "py[ntrack]/F");
+   tree->Branch("pz", ev.fPz, "pz[ntrack]/F");
+   tree->Branch("charge", ev.fCharge, "charge[ntrack]/S");
+   TRandom3 rnd(4357);
+   for (Int_t i = 0; i < nentries; ++i) {
+      MakeEvent(rnd, i, ev);
+      tree->Fill();
+   }
+   f->Write();
+   delete f;
+}
+
+//______________________________________________________________________________
+Bool_t TestParallelCompression(Int_t nentries)
+{
+   // Write the same TTree with the sequential and with the parallel
+   // compression of the baskets (TTree::SetParallelCompression) and check
+   // that the baskets have the same location and size in both files.
+
+   TStopwatch timer;
+   timer.Start();
+   WriteTree("stressCompression_seq.root", kFALSE, nentries);
+   Double_t seqTime = timer.RealTime();
+   timer.Start();
+   WriteTree("stressCompression_par.root", kTRUE, nentries);
+   Double_t parTime = timer.RealTime();
+   printf("ZLIB sequential write [s] %.2f, parallel write [s] %.2f\n", seqTime, parTime);
+
+   Bool_t ok = kTRUE;
+   TFile *fseq = TFile::Open("stressCompression_seq.root");
+   TFile *fpar = TFile::Open("stressCompression_par.root");
+   TTree *tseq = fseq ? (TTree*)fseq->Get("T") : 0;
+   TTree *tpar = fpar ? (TTree*)fpar->Get("T") : 0;
+   if (!tseq || !tpar || fseq->GetSize() != fpar->GetSize() ||
+       tseq->GetZipBytes() != tpar->GetZipBytes()) {
+      ok = kFALSE;
+   }
+   if (ok) {
+      TObjArray *lseq = tseq->GetListOfBranches();
+      TObjArray *lpar = tpar->GetListOfBranches();
+      for (Int_t b = 0; ok && b < lseq->GetEntriesFast(); ++b) {
+         TBranch *bseq = (TBranch*)lseq->UncheckedAt(b);
+         TBranch *bpar = (TBranch*)lpar->UncheckedAt(b);
+         if (bseq->GetWriteBasket() != bpar->GetWriteBasket()) ok = kFALSE;
+         for (Int_t i = 0; ok && i < bseq->GetWriteBasket(); ++i) {
+            if (bseq->GetBasketSeek(i) != bpar->GetBasketSeek(i) ||
+                bseq->GetBasketBytes()[i] != bpar->GetBasketBytes()[i]) {
+               ok = kFALSE;
+            }
+         }
+      }
+   }
+   delete fseq;
+   delete fpar;
+   gSystem->Unlink("stressCompression_seq.root");
+   gSystem->Unlink("stressCompression_par.root");
+   return ok;
+}
+
+//______________________________________________________________________________
+Int_t stressCompression(Int_t nentries = 50000)
+{
+   // Run the round trip test for all the compression algorithms.
+
+   printf("******************************************************************\n");
+   printf("*  Starting  Compression Stress Test (ZLIB, LZMA, LZ4, ZSTD)     *\n");
+   printf("******************************************************************\n");
+   printf("algo  level   file size  factor   write [s]   read [s]  read [MB/s]\n");
+
+   const ROOT::ECompressionAlgorithm algos[] = { ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4, ROOT::kZSTD };
+   const char *names[] = { "ZLIB", "LZMA", "LZ4", "ZSTD" };
+   const Int_t nalgos = sizeof(algos) / sizeof(algos[0]);
+   Bool_t results[nalgos];
+   for (Int_t i = 0; i < nalgos; ++i) {
+      results[i] = TestAlgorithm(algos[i], names[i], 1, nentries);
+   }
+   Int_t nfailed = 0;
+   for (Int_t i = 0; i < nalgos; ++i) {
+      TString title = TString::Format("Test%d: Round trip of %s compressed TTree ", i + 1, names[i]);
+      while (title.Length() < 60) title += "-";
+      printf("%s %s\n", title.Data(), results[i] ? "OK" : "FAILED");
+      if (!results[i]) ++nfailed;
+   }
+   Bool_t parallel = TestParallelCompression(nentries);
+   TString title = TString::Format("Test%d: Parallel compression gives the same layout ", nalgos + 1);
+   while (title.Length() < 60) title += "-";
+   printf("%s %s\n", title.Data(), parallel ? "OK" : "FAILED");
+   if (!parallel) ++nfailed;
+   printf("******************************************************************\n");
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nentries = 50000;
+   if (argc > 1) nentries = atoi(argv[1]);
+   return stressCompression(nentries);
+}
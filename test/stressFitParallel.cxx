@@ -0,0 +1,193 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the multithreaded evaluation of the fit functions___
+//
+//   Chi2, binned and unbinned likelihood fits of a TF1 are done
+//   with ROOT::Fit::Fitter in the serial mode and with the execution
+//   policy ROOT::Fit::kMultithread using 1, 2 and 4 threads. The
+//   multithreaded fits must give identical results whatever the
+//   number of threads, and the same results as the serial fit up to
+//   the rounding errors. The chi2 gradient computed with several
+//   threads is also compared. Finally a chi2 fit is done with Minuit2
+//   computing the numerical derivatives and the Hessian with 1, 2 and
+//   4 threads (option NThreads of Minuit2), which must give identical
+//   parameters and errors.
+//
+//   To run in batch mode, do
+//     stressFitParallel
+//     stressFitParallel 1000000
+//   Here the parameter is the number of points.
+//   The default value is 100000.
+//
+// ******************************************************************
+// *  Starting  Multithreaded Fit Stress Test                       *
+// ******************************************************************
+// Test1: Chi2 fit ------------------------------------------------- OK
+// Test2: Binned likelihood fit ------------------------------------ OK
+// Test3: Unbinned likelihood fit ---------------------------------- OK
+// Test4: Chi2 gradient -------------------------------------------- OK
+// Test5: Minuit2 derivatives computed by several threads ----------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <vector>
+#include "TF1.h"
+#include "TH1D.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "Fit/BinData.h"
+#include "Fit/Fitter.h"
+#include "Fit/FitUtil.h"
+#include "Fit/UnBinData.h"
+#include "HFitInterface.h"
+#include "Math/Factory.h"
+#include "Math/Minimizer.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/IOptions.h"
+#include "Math/WrappedMultiTF1.h"
+#include "stressCommon.h"
+
+namespace {
+
+   const Int_t kNThreads[] = { 1, 2, 4 };
+
+   //______________________________________________________________________________
+   template <class Data>
+   Bool_t FitParameters(const Data &data, TF1 &f, Bool_t likelihood, ROOT::Fit::ExecutionPolicy policy,
+                        UInt_t nthreads, std::vector<Double_t> &pars)
+   {
+      // Fit data with f and return the fitted parameters.
+
+      ROOT::Math::WrappedMultiTF1 wf(f, 1);
+      ROOT::Fit::Fitter fitter;
+      fitter.SetFunction(wf, kFALSE);
+      fitter.Config().SetExecutionPolicy(policy, nthreads);
+      Bool_t ok = likelihood ? fitter.LikelihoodFit(data) : fitter.Fit(data);
+      if (!ok) return kFALSE;
+      pars.assign(fitter.Result().GetParams(), fitter.Result().GetParams() + f.GetNpar());
+      return kTRUE;
+   }
+
+   //______________________________________________________________________________
+   template <class Data>
+   Bool_t SameFits(const Data &data, TF1 &f, Bool_t likelihood)
+   {
+      // Compare the serial fit with the multithreaded ones.
+
+      std::vector<Double_t> ref, mt1, mt;
+      if (!FitParameters(data, f, likelihood, ROOT::Fit::kSerial, 1, ref)) return kFALSE;
+      for (UInt_t i = 0; i < sizeof(kNThreads) / sizeof(Int_t); ++i) {
+         if (!FitParameters(data, f, likelihood, ROOT::Fit::kMultithread, kNThreads[i], mt)) return kFALSE;
+         if (i == 0) mt1 = mt;
+         if (mt != mt1) return kFALSE;
+      }
+      for (UInt_t k = 0; k < ref.size(); ++k) {
+         if (TMath::Abs(ref[k] - mt1[k]) > 1e-6 * (TMath::Abs(ref[k]) + 1)) return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   //______________________________________________________________________________
+   Bool_t Minuit2Fit(const ROOT::Fit::BinData &data, TF1 &f, Int_t nthreads, std::vector<Double_t> &res)
+   {
+      // Fit data with Minuit2 using nthreads threads for the derivatives and
+      // return the fitted parameters followed by their errors.
+
+      ROOT::Math::MinimizerOptions::Default("Minuit2").SetValue("NThreads", nthreads);
+      ROOT::Math::WrappedMultiTF1 wf(f, 1);
+      ROOT::Fit::Fitter fitter;
+      fitter.Config().SetMinimizer("Minuit2");
+      fitter.SetFunction(wf, kFALSE);
+      Bool_t ok = fitter.Fit(data);
+      ROOT::Math::MinimizerOptions::Default("Minuit2").SetValue("NThreads", 1);
+      if (!ok) return kFALSE;
+      res.assign(fitter.Result().GetParams(), fitter.Result().GetParams() + f.GetNpar());
+      res.insert(res.end(), fitter.Result().GetErrors(), fitter.Result().GetErrors() + f.GetNpar());
+      return kTRUE;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressFitParallel(Int_t npoints = 100000)
+{
+   PrintBanner("Multithreaded Fit Stress Test");
+
+   TH1::AddDirectory(kFALSE);
+   TRandom3 rnd(1);
+   TH1D h("h", "gaus+pol1", 10000, -5, 5);
+   ROOT::Fit::UnBinData udata(npoints, 1);
+   for (Int_t i = 0; i < npoints; ++i) {
+      Double_t x = (rnd.Rndm() < 0.7) ? rnd.Gaus(0.5, 1.2) : rnd.Uniform(-5, 5);
+      h.Fill(x);
+      if (x > -5 && x < 5) udata.Add(x);
+   }
+   ROOT::Fit::DataOptions opt;
+   ROOT::Fit::BinData bdata(opt);
+   ROOT::Fit::FillData(bdata, &h);
+
+   TF1 f("f", "gaus(0)+pol1(3)", -5, 5);
+   Int_t nfailed = 0;
+
+   f.SetParameters(npoints / 4000., 0.3, 1, npoints / 30000., 0);
+   Bool_t ok = SameFits(bdata, f, kFALSE);
+   PrintResult(1, "Chi2 fit", ok);
+   if (!ok) ++nfailed;
+
+   f.SetParameters(npoints / 4000., 0.3, 1, npoints / 30000., 0);
+   ok = SameFits(bdata, f, kTRUE);
+   PrintResult(2, "Binned likelihood fit", ok);
+   if (!ok) ++nfailed;
+
+   TF1 pdf("pdf", "[0]*exp(-0.5*((x-[1])/[2])^2)/(sqrt(2*pi)*[2])+(1-[0])/10", -5, 5);
+   pdf.SetParameters(0.6, 0.3, 1);
+   ok = SameFits(udata, pdf, kTRUE);
+   PrintResult(3, "Unbinned likelihood fit", ok);
+   if (!ok) ++nfailed;
+
+   ROOT::Math::WrappedMultiTF1 wf(f, 1);
+   std::vector<Double_t> p(f.GetParameters(), f.GetParameters() + f.GetNpar());
+   std::vector<Double_t> ref(p.size()), g1(p.size()), g(p.size());
+   UInt_t nused;
+   ROOT::Fit::FitUtil::EvaluateChi2Gradient(wf, bdata, &p[0], &ref[0], nused);
+   ROOT::Fit::FitUtil::EvaluateChi2Gradient(wf, bdata, &p[0], &g1[0], nused, ROOT::Fit::kMultithread, 1);
+   ok = kTRUE;
+   for (UInt_t i = 1; i < sizeof(kNThreads) / sizeof(Int_t); ++i) {
+      ROOT::Fit::FitUtil::EvaluateChi2Gradient(wf, bdata, &p[0], &g[0], nused, ROOT::Fit::kMultithread, kNThreads[i]);
+      if (g != g1) ok = kFALSE;
+   }
+   for (UInt_t k = 0; k < p.size(); ++k) {
+      if (TMath::Abs(ref[k] - g1[k]) > 1e-9 * (TMath::Abs(ref[k]) + 1)) ok = kFALSE;
+   }
+   PrintResult(4, "Chi2 gradient", ok);
+   if (!ok) ++nfailed;
+
+   // Minuit2 is an optional library
+   ROOT::Math::Minimizer *minuit2 = ROOT::Math::Factory::CreateMinimizer("Minuit2");
+   if (minuit2) {
+      delete minuit2;
+      std::vector<Double_t> m1, m;
+      f.SetParameters(npoints / 4000., 0.3, 1, npoints / 30000., 0);
+      ok = Minuit2Fit(bdata, f, 1, m1);
+      for (UInt_t i = 1; ok && i < sizeof(kNThreads) / sizeof(Int_t); ++i) {
+         ok = Minuit2Fit(bdata, f, kNThreads[i], m) && m == m1;
+      }
+      PrintResult(5, "Minuit2 derivatives computed by several threads", ok);
+      if (!ok) ++nfailed;
+   } else {
+      printf("Test5: Minuit2 is not available, test skipped\n");
+   }
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t npoints = 100000;
+   if (argc > 1) npoints = atoi(argv[1]);
+   return stressFitParallel(npoints);
+}
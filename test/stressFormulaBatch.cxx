@@ -0,0 +1,174 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the evaluation of functions by blocks of points___
+//
+//   TF1::EvalParBatch and ROOT::Math::WrappedMultiTF1::EvalParBatch
+//   are compared with the evaluation point by point with EvalPar,
+//   for the predefined functions, for formulas made of several
+//   operators and for functions evaluated point by point (C++
+//   functions, operator ?:). Finally the chi2 and the likelihood
+//   computed by ROOT::Fit::FitUtil, which evaluates the function
+//   by blocks, are compared with the same sums computed point by
+//   point.
+//
+//   To run in batch mode, do
+//     stressFormulaBatch
+//     stressFormulaBatch 100000
+//   Here the parameter is the number of points.
+//   The default value is 10000.
+//
+// ******************************************************************
+// *  Starting  Function Batch Evaluation Stress Test               *
+// ******************************************************************
+// Test1: Predefined functions gaus, expo, landau, polN ------------ OK
+// Test2: Formulas with several operators ------------------------- OK
+// Test3: Functions evaluated point by point ----------------------- OK
+// Test4: Two dimensional functions -------------------------------- OK
+// Test5: Chi2 and likelihood of FitUtil --------------------------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <vector>
+#include "TF1.h"
+#include "TF2.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "Fit/BinData.h"
+#include "Fit/FitUtil.h"
+#include "Fit/UnBinData.h"
+#include "Math/WrappedMultiTF1.h"
+#include "stressCommon.h"
+
+namespace {
+
+   //______________________________________________________________________________
+   Double_t UserFunction(Double_t *x, Double_t *p)
+   {
+      return p[0] + p[1]*TMath::Sin(x[0]);
+   }
+
+   //______________________________________________________________________________
+   Bool_t Close(Double_t a, Double_t b)
+   {
+      return TMath::Abs(a - b) <= 1e-12 * (TMath::Abs(a) + TMath::Abs(b)) || a == b;
+   }
+
+   //______________________________________________________________________________
+   Bool_t SameValues(TF1 &f, const std::vector<Double_t> &x, Int_t ndim)
+   {
+      // Compare EvalParBatch with EvalPar at the points x.
+
+      Int_t n = x.size() / ndim;
+      std::vector<Double_t> res(n);
+      f.EvalParBatch(n, &x[0], ndim, &res[0]);
+      for (Int_t i = 0; i < n; ++i) {
+         if (!Close(f.EvalPar(&x[i*ndim]), res[i])) return kFALSE;
+      }
+      // Same with the parameters given and through the wrapper
+      std::vector<Double_t> p(f.GetParameters(), f.GetParameters() + f.GetNpar());
+      for (UInt_t k = 0; k < p.size(); ++k) p[k] *= 1.1;
+      ROOT::Math::WrappedMultiTF1 wf(f, ndim);
+      wf.EvalParBatch(n, &x[0], p.empty() ? 0 : &p[0], &res[0]);
+      for (Int_t i = 0; i < n; ++i) {
+         if (!Close(wf(&x[i*ndim], p.empty() ? 0 : &p[0]), res[i])) return kFALSE;
+      }
+      return kTRUE;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressFormulaBatch(Int_t npoints = 10000)
+{
+   PrintBanner("Function Batch Evaluation Stress Test");
+
+   TRandom3 rnd(1);
+   std::vector<Double_t> x1(npoints), x2(2*npoints);
+   for (Int_t i = 0; i < npoints; ++i) x1[i] = rnd.Uniform(-5, 5);
+   for (Int_t i = 0; i < 2*npoints; ++i) x2[i] = rnd.Uniform(-5, 5);
+
+   Int_t nfailed = 0;
+
+   TF1 fgaus("fgaus", "gaus", -5, 5);
+   fgaus.SetParameters(10, 0.5, 1.5);
+   TF1 fgausn("fgausn", "gausn", -5, 5);
+   fgausn.SetParameters(10, 0.5, 1.5);
+   TF1 fexpo("fexpo", "expo", -5, 5);
+   fexpo.SetParameters(1, -0.3);
+   TF1 flandau("flandau", "landau", -5, 5);
+   flandau.SetParameters(3, 0.2, 0.8);
+   TF1 fpol("fpol", "pol4", -5, 5);
+   fpol.SetParameters(1, -2, 0.5, 0.1, -0.02);
+   Bool_t ok = SameValues(fgaus, x1, 1) && SameValues(fgausn, x1, 1) && SameValues(fexpo, x1, 1) &&
+               SameValues(flandau, x1, 1) && SameValues(fpol, x1, 1);
+   PrintResult(1, "Predefined functions gaus, expo, landau, polN", ok);
+   if (!ok) ++nfailed;
+
+   TF1 fsum("fsum", "gaus(0)+pol1(3)", -5, 5);
+   fsum.SetParameters(10, 0.5, 1.5, 2, 0.1);
+   TF1 fmath("fmath", "[0]*sqrt(x)+log(x*x)/[1]-exp(-x)*cos(x)+abs(x)^[2]+(x>0)*[3]", -5, 5);
+   fmath.SetParameters(1, 2, 1.5, 3);
+   TF1 flogic("flogic", "(x>-1 && x<1)*[0] + (x<-3 || x>3)*[1] + sign(x) + int(x) + pi", -5, 5);
+   flogic.SetParameters(2, 3);
+   ok = SameValues(fsum, x1, 1) && SameValues(fmath, x1, 1) && SameValues(flogic, x1, 1);
+   PrintResult(2, "Formulas with several operators", ok);
+   if (!ok) ++nfailed;
+
+   TF1 fuser("fuser", UserFunction, -5, 5, 2);
+   fuser.SetParameters(1, 2);
+   TF1 fcond("fcond", "x>0 ? [0]*x : [1]", -5, 5);
+   fcond.SetParameters(2, -1);
+   // The right sides of && and || must not be evaluated at the integer
+   // points where they divide by zero
+   TF1 fguard("fguard", "(int(x)!=0 && 7%int(x)>1)*[0] + (x==0 || 1/x>0.5)*[1]", -5, 5);
+   fguard.SetParameters(2, 3);
+   std::vector<Double_t> xguard(x1);
+   for (Int_t i = 0; i < npoints; i += 10) xguard[i] = Int_t(xguard[i]);
+   ok = SameValues(fuser, x1, 1) && SameValues(fcond, x1, 1) && SameValues(fguard, xguard, 1);
+   PrintResult(3, "Functions evaluated point by point", ok);
+   if (!ok) ++nfailed;
+
+   TF2 fxy("fxy", "xygaus", -5, 5, -5, 5);
+   fxy.SetParameters(5, 0.5, 1.5, -0.5, 2);
+   TF2 fprod("fprod", "[0]*x*y+ygaus(1)", -5, 5, -5, 5);
+   fprod.SetParameters(0.3, 5, 0.5, 1.5);
+   ok = SameValues(fxy, x2, 2) && SameValues(fprod, x2, 2);
+   PrintResult(4, "Two dimensional functions", ok);
+   if (!ok) ++nfailed;
+
+   // Chi2 and likelihood computed by FitUtil, by blocks of points
+   ROOT::Fit::BinData bdata(npoints, 1);
+   ROOT::Fit::UnBinData udata(npoints, 1);
+   for (Int_t i = 0; i < npoints; ++i) {
+      bdata.Add(x1[i], rnd.Poisson(fsum.Eval(x1[i])) + 1, 1.5);
+      udata.Add(x1[i]);
+   }
+   ROOT::Math::WrappedMultiTF1 wsum(fsum, 1);
+   const Double_t *p = fsum.GetParameters();
+   Double_t chi2 = 0, logl = 0;
+   for (Int_t i = 0; i < npoints; ++i) {
+      Double_t y, invError;
+      const Double_t *x = bdata.GetPoint(i, y, invError);
+      Double_t res = (y - fsum.EvalPar(x, p)) * invError;
+      chi2 += res * res;
+      logl += ROOT::Math::Util::EvalLog(fsum.EvalPar(udata.Coords(i), p));
+   }
+   UInt_t nused;
+   ok = Close(ROOT::Fit::FitUtil::EvaluateChi2(wsum, bdata, p, nused), chi2) &&
+        Close(ROOT::Fit::FitUtil::EvaluateLogL(wsum, udata, p, 0, false, nused), -logl);
+   PrintResult(5, "Chi2 and likelihood of FitUtil", ok);
+   if (!ok) ++nfailed;
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t npoints = 10000;
+   if (argc > 1) npoints = atoi(argv[1]);
+   return stressFormulaBatch(npoints);
+}
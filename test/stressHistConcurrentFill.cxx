@@ -0,0 +1,156 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the concurrent filling of histograms___
+//
+//   A TH1F, a TH2D with weights and a TH3I are filled at the same
+//   time by several threads, with TH1::SetConcurrentFill, and
+//   compared with the same histograms filled by a single thread:
+//   the bin contents, the sums of squares of weights and the number
+//   of entries must be identical, the statistics (mean, RMS, ...)
+//   equal up to the rounding errors.
+//
+//   To run in batch mode, do
+//     stressHistConcurrentFill
+//     stressHistConcurrentFill 1000000
+//   Here the parameter is the number of fills of each thread.
+//   The default value is 200000.
+//
+// ******************************************************************
+// *  Starting  Concurrent Histogram Filling Stress Test            *
+// ******************************************************************
+// Test1: TH1F filled by 4 threads --------------------------------- OK
+// Test2: TH2D filled with weights by 4 threads -------------------- OK
+// Test3: TH3I filled by 4 threads --------------------------------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <vector>
+#include "TH1F.h"
+#include "TH2D.h"
+#include "TH3I.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "TThread.h"
+#include "stressCommon.h"
+
+namespace {
+   const Int_t kNThreads = 4;
+
+   struct TFillArgs {
+      Int_t  fSeed;
+      Int_t  fNFills;
+      TH1F  *fH1;
+      TH2D  *fH2;
+      TH3I  *fH3;
+   };
+
+   //______________________________________________________________________________
+   void *FillHistograms(void *arg)
+   {
+      // Fill the histograms with the random numbers of the seed. The
+      // weights are multiples of 0.5 so that the sums do not depend on
+      // the order of the additions.
+
+      TFillArgs *args = (TFillArgs*)arg;
+      TRandom3 rnd(args->fSeed);
+      for (Int_t i = 0; i < args->fNFills; ++i) {
+         Double_t x = rnd.Gaus(0, 2);
+         Double_t y = rnd.Gaus(0, 2);
+         Double_t z = rnd.Gaus(0, 2);
+         Double_t w = 0.5 * rnd.Integer(4);
+         args->fH1->Fill(x);
+         args->fH2->Fill(x, y, w);
+         args->fH3->Fill(x, y, z);
+      }
+      return 0;
+   }
+}
+
+//______________________________________________________________________________
+Bool_t SameHistogram(TH1 *ref, TH1 *res)
+{
+   // Compare the contents and the statistics of two histograms.
+
+   if (res->IsConcurrentFill() || ref->GetEntries() != res->GetEntries()) return kFALSE;
+   for (Int_t bin = 0; bin < ref->GetNcells(); ++bin) {
+      if (ref->GetBinContent(bin) != res->GetBinContent(bin)) return kFALSE;
+      if (ref->GetBinError(bin) != res->GetBinError(bin)) return kFALSE;
+   }
+   Double_t sref[TH1::kNstat] = {0}, sres[TH1::kNstat] = {0};
+   ref->GetStats(sref);
+   res->GetStats(sres);
+   for (Int_t i = 0; i < TH1::kNstat; ++i) {
+      if (TMath::Abs(sref[i] - sres[i]) > 1e-9 * (TMath::Abs(sref[i]) + 1)) return kFALSE;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t stressHistConcurrentFill(Int_t nfills = 200000)
+{
+   PrintBanner("Concurrent Histogram Filling Stress Test");
+
+   TH1::AddDirectory(kFALSE);
+   TH1F ref1("ref1", "x", 100, -5, 5);
+   TH2D ref2("ref2", "y:x", 50, -5, 5, 50, -5, 5);
+   TH3I ref3("ref3", "z:y:x", 20, -5, 5, 20, -5, 5, 20, -5, 5);
+   ref2.Sumw2();
+   TH1F h1("h1", "x", 100, -5, 5);
+   TH2D h2("h2", "y:x", 50, -5, 5, 50, -5, 5);
+   TH3I h3("h3", "z:y:x", 20, -5, 5, 20, -5, 5, 20, -5, 5);
+   h2.Sumw2();
+
+   std::vector<TFillArgs> args(kNThreads);
+   for (Int_t i = 0; i < kNThreads; ++i) {
+      args[i].fSeed = i + 1;
+      args[i].fNFills = nfills;
+      args[i].fH1 = &ref1;
+      args[i].fH2 = &ref2;
+      args[i].fH3 = &ref3;
+      FillHistograms(&args[i]);
+      args[i].fH1 = &h1;
+      args[i].fH2 = &h2;
+      args[i].fH3 = &h3;
+   }
+
+   TThread::Initialize();
+   Bool_t on = h1.SetConcurrentFill() && h2.SetConcurrentFill() && h3.SetConcurrentFill();
+   std::vector<TThread*> threads(kNThreads);
+   for (Int_t i = 0; i < kNThreads; ++i) {
+      threads[i] = new TThread(TString::Format("stressHistConcurrentFill_%d", i),
+                               (TThread::VoidRtnFunc_t)&FillHistograms, &args[i]);
+      threads[i]->Run();
+   }
+   for (Int_t i = 0; i < kNThreads; ++i) {
+      threads[i]->Join();
+      delete threads[i];
+   }
+   h1.SetConcurrentFill(kFALSE);
+   h2.SetConcurrentFill(kFALSE);
+   h3.SetConcurrentFill(kFALSE);
+
+   Int_t nfailed = 0;
+   Bool_t ok = on && SameHistogram(&ref1, &h1);
+   PrintResult(1, TString::Format("TH1F filled by %d threads", kNThreads), ok);
+   if (!ok) ++nfailed;
+   ok = on && SameHistogram(&ref2, &h2);
+   PrintResult(2, TString::Format("TH2D filled with weights by %d threads", kNThreads), ok);
+   if (!ok) ++nfailed;
+   ok = on && SameHistogram(&ref3, &h3);
+   PrintResult(3, TString::Format("TH3I filled by %d threads", kNThreads), ok);
+   if (!ok) ++nfailed;
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nfills = 200000;
+   if (argc > 1) nfills = atoi(argv[1]);
+   return stressHistConcurrentFill(nfills);
+}
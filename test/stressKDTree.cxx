@@ -0,0 +1,231 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test and benchmark of the TMVA kd-tree laid out in arrays___
+//
+//   The training events of a toy sample are stored in a TMVA::KDTree,
+//   in the kNN::Node tree that MethodKNN used to search and in the
+//   BinarySearchTree that MethodPDERS used to search. The k nearest
+//   neighbours of the test events found in the kd-tree, one event at a
+//   time and by blocks of events shared among threads, are compared
+//   with the ones found in the kNN::Node tree, and the events found in
+//   the volumes of PDERS with the ones found in the BinarySearchTree.
+//   The time taken by the searches in each tree is reported.
+//
+//   To run in batch mode, do
+//     stressKDTree
+//     stressKDTree 100000 4
+//   Here the parameters are the number of training events (the
+//   default value is 50000) and the number of threads of the block
+//   searches (the default value 0 means one per core).
+//
+// An example of output:
+// ******************************************************************
+// *  Starting  TMVA KDTree Stress Test                             *
+// ******************************************************************
+// kNN searches:    node tree   0.3359 s, kd-tree   0.0567 s, threads   0.0152 s
+// Volume searches: binary tree 0.2210 s, kd-tree   0.0411 s
+// Test1: Nearest neighbours of the kNN::Node tree ----------------- OK
+// Test2: Nearest neighbours of the blocks of events ---------------- OK
+// Test3: Events in the volumes of the BinarySearchTree ------------- OK
+// Test4: Volume searches with a maximum number of events ---------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <list>
+#include <vector>
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TMVA/BinarySearchTree.h"
+#include "TMVA/Event.h"
+#include "TMVA/KDTree.h"
+#include "TMVA/ModulekNN.h"
+#include "TMVA/NodekNN.h"
+#include "TMVA/Volume.h"
+#include "stressCommon.h"
+
+namespace {
+
+   const UInt_t kNVars = 4;   // number of variables of the events
+   const UInt_t kNFind = 22;  // number of neighbours searched (the default nkNN of MethodKNN, plus 2)
+
+   //______________________________________________________________________________
+   void Generate(TRandom3 &rndm, UInt_t nevents, std::vector<Float_t> &values)
+   {
+      // Correlated gaussian variables of different widths, as in the TMVA examples.
+
+      values.resize(nevents * kNVars);
+      for (UInt_t i = 0; i < nevents; ++i) {
+         const Double_t x = rndm.Gaus();
+         for (UInt_t ivar = 0; ivar < kNVars; ++ivar) {
+            values[i * kNVars + ivar] = (ivar + 1) * (0.5 * x + rndm.Gaus());
+         }
+      }
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressKDTree(UInt_t ntrain = 50000, UInt_t nthreads = 0)
+{
+   PrintBanner("TMVA KDTree Stress Test");
+
+   if (ntrain < 1000) ntrain = 1000;
+   const UInt_t ntest = ntrain / 10;
+
+   TRandom3 rndm(4357);
+   std::vector<Float_t> train, test;
+   Generate(rndm, ntrain, train);
+   Generate(rndm, ntest, test);
+   std::vector<Double_t> weights(ntrain);
+   for (UInt_t i = 0; i < ntrain; ++i) weights[i] = 1 + i % 3;
+
+   // The three trees
+   TMVA::KDTree kdtree;
+   kdtree.Build(train, kNVars, weights);
+
+   std::vector<TMVA::kNN::Event> knnEvents;
+   for (UInt_t i = 0; i < ntrain; ++i) {
+      TMVA::kNN::VarVec vars(train.begin() + i * kNVars, train.begin() + (i + 1) * kNVars);
+      knnEvents.push_back(TMVA::kNN::Event(vars, weights[i], 1));
+   }
+   TMVA::kNN::Node<TMVA::kNN::Event> *nodeTree = new TMVA::kNN::Node<TMVA::kNN::Event>(0, knnEvents[0], 0);
+   for (UInt_t i = 1; i < ntrain; ++i) nodeTree->Add(knnEvents[i], 0);
+
+   std::vector<TMVA::Event*> events;
+   for (UInt_t i = 0; i < ntrain; ++i) {
+      std::vector<Float_t> vars(train.begin() + i * kNVars, train.begin() + (i + 1) * kNVars);
+      events.push_back(new TMVA::Event(vars, 0, weights[i]));
+   }
+   TMVA::BinarySearchTree *binaryTree = new TMVA::BinarySearchTree();
+   binaryTree->Fill(events);
+
+   // The k nearest neighbours of the test events
+   TStopwatch timer;
+   std::vector<TMVA::kNN::List> nodeLists(ntest);
+   for (UInt_t i = 0; i < ntest; ++i) {
+      TMVA::kNN::Event query(TMVA::kNN::VarVec(test.begin() + i * kNVars, test.begin() + (i + 1) * kNVars), 1, 3);
+      TMVA::kNN::Find<TMVA::kNN::Event>(nodeLists[i], nodeTree, query, kNFind);
+   }
+   timer.Stop();
+   Double_t tnode = timer.RealTime();
+
+   timer.Start();
+   std::vector< std::vector<TMVA::KDTree::Neighbour> > kdLists(ntest);
+   for (UInt_t i = 0; i < ntest; ++i) kdtree.FindNearest(&test[i * kNVars], kNFind, kdLists[i]);
+   timer.Stop();
+   Double_t tkd = timer.RealTime();
+
+   timer.Start();
+   std::vector<TMVA::KDTree::Neighbour> block;
+   kdtree.FindNearest(&test[0], ntest, kNFind, block, nthreads);
+   timer.Stop();
+   Double_t tblock = timer.RealTime();
+   printf("kNN searches:    node tree %8.4f s, kd-tree %8.4f s, threads %8.4f s\n", tnode, tkd, tblock);
+
+   // The volumes of MethodPDERS around the test events (the sizes of the volumes
+   // change from one event to the next, as in the adaptive volume range mode)
+   std::vector<TMVA::Volume*> volumes;
+   for (UInt_t i = 0; i < ntest; ++i) {
+      std::vector<Double_t> lower(kNVars), upper(kNVars);
+      const Double_t scale = 0.05 * (1 + i % 10);
+      for (UInt_t ivar = 0; ivar < kNVars; ++ivar) {
+         lower[ivar] = test[i * kNVars + ivar] - scale * (ivar + 1);
+         upper[ivar] = test[i * kNVars + ivar] + scale * (ivar + 1);
+      }
+      volumes.push_back(new TMVA::Volume(&lower[0], &upper[0], kNVars));
+   }
+
+   timer.Start();
+   std::vector<Double_t> binarySums(ntest);
+   std::vector<UInt_t> binaryCounts(ntest);
+   for (UInt_t i = 0; i < ntest; ++i) {
+      std::vector<const TMVA::BinarySearchTreeNode*> found;
+      binarySums[i] = binaryTree->SearchVolume(volumes[i], &found);
+      binaryCounts[i] = found.size();
+   }
+   timer.Stop();
+   Double_t tbinary = timer.RealTime();
+
+   timer.Start();
+   std::vector<Double_t> kdSums(ntest);
+   std::vector<UInt_t> kdCounts(ntest);
+   for (UInt_t i = 0; i < ntest; ++i) {
+      std::vector<UInt_t> found;
+      kdSums[i] = kdtree.SearchVolume(&(*volumes[i]->fLower)[0], &(*volumes[i]->fUpper)[0], &found);
+      kdCounts[i] = found.size();
+   }
+   timer.Stop();
+   Double_t tkdvol = timer.RealTime();
+   printf("Volume searches: binary tree %6.4f s, kd-tree %8.4f s\n", tbinary, tkdvol);
+
+   Int_t nfailed = 0;
+
+   // Same distances as the kNN::Node tree (the neighbours at the same distance may differ)
+   Bool_t ok = kTRUE;
+   for (UInt_t i = 0; i < ntest && ok; ++i) {
+      if (nodeLists[i].size() != kNFind || kdLists[i].size() != kNFind) {
+         ok = kFALSE;
+         break;
+      }
+      UInt_t j = 0;
+      for (TMVA::kNN::List::const_iterator it = nodeLists[i].begin(); it != nodeLists[i].end(); ++it, ++j) {
+         if (it->second != kdLists[i][j].first) ok = kFALSE;
+      }
+   }
+   PrintResult(1, "Nearest neighbours of the kNN::Node tree", ok);
+   if (!ok) ++nfailed;
+
+   // The blocks of events give the same neighbours
+   ok = (block.size() == ntest * kNFind);
+   for (UInt_t i = 0; i < ntest && ok; ++i) {
+      for (UInt_t j = 0; j < kNFind; ++j) {
+         if (block[i * kNFind + j] != kdLists[i][j]) ok = kFALSE;
+      }
+   }
+   PrintResult(2, "Nearest neighbours of the blocks of events", ok);
+   if (!ok) ++nfailed;
+
+   // Same events in the volumes as the BinarySearchTree (the weights are integers)
+   ok = kTRUE;
+   for (UInt_t i = 0; i < ntest; ++i) {
+      if (binarySums[i] != kdSums[i] || binaryCounts[i] != kdCounts[i]) ok = kFALSE;
+   }
+   PrintResult(3, "Events in the volumes of the BinarySearchTree", ok);
+   if (!ok) ++nfailed;
+
+   // The volume searches stopping at the maximum number of events
+   ok = kTRUE;
+   for (UInt_t i = 0; i < ntest; ++i) {
+      const UInt_t limit = 1 + i % 100;
+      std::vector<const TMVA::BinarySearchTreeNode*> binaryFound;
+      std::vector<UInt_t> kdFound;
+      Int_t nbinary = binaryTree->SearchVolumeWithMaxLimit(volumes[i], &binaryFound, limit);
+      UInt_t nkd = kdtree.SearchVolumeWithMaxLimit(&(*volumes[i]->fLower)[0], &(*volumes[i]->fUpper)[0], &kdFound, limit);
+      if (UInt_t(nbinary) != nkd || kdFound.size() != nkd) ok = kFALSE;
+   }
+   PrintResult(4, "Volume searches with a maximum number of events", ok);
+   if (!ok) ++nfailed;
+
+   for (UInt_t i = 0; i < volumes.size(); ++i) {
+      volumes[i]->Delete();
+      delete volumes[i];
+   }
+   delete binaryTree;
+   for (UInt_t i = 0; i < events.size(); ++i) delete events[i];
+   delete nodeTree;
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   UInt_t ntrain = 50000;
+   UInt_t nthreads = 0;
+   if (argc > 1) ntrain = atoi(argv[1]);
+   if (argc > 2) nthreads = atoi(argv[2]);
+   return stressKDTree(ntrain, nthreads);
+}
@@ -0,0 +1,295 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the keys index of the directories___
+//
+//   Two files are written with the same objects: a top directory with
+//   nkeys TNamed, a part of them written with several cycles, and a
+//   subdirectory with nkeys/10 TNamed. The first file has the keys index
+//   of the directories (TDirectoryFile::SetKeysIndexThreshold), the second
+//   one has no index. The files are opened in read mode and the objects and
+//   keys found in the first file through the index, before the lists of keys
+//   are read, are compared with the ones found in the second file. The time
+//   to open each file and read one object is reported. The first file is
+//   then updated with a new object: the keys record and its index are
+//   written again and the old index must be found in the free segments.
+//
+//   To run in batch mode, do
+//     stressKeysIndex
+//     stressKeysIndex 100000
+//   Here the parameter is the number of keys of the top directory.
+//   The default value is 20000.
+//
+// An example of output:
+// ******************************************************************
+// *  Starting  Keys Index Stress Test                              *
+// ******************************************************************
+// Open and Get with index:   0.0004 s, without index:   0.0210 s
+// Test1: Objects found through the index -------------------------- OK
+// Test2: Cycles of the keys found through the index ---------------- OK
+// Test3: Subdirectory read through the index ---------------------- OK
+// Test4: Keys list read after the index lookups -------------------- OK
+// Test5: Objects found through the index after an update --------- OK
+// Test6: Free segments after an update --------------------------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <vector>
+#include "Bytes.h"
+#include "TDirectoryFile.h"
+#include "TFile.h"
+#include "TFree.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "stressCommon.h"
+
+namespace {
+
+   //______________________________________________________________________________
+   void WriteFile(const char *filename, Int_t nkeys, Int_t threshold)
+   {
+      // Write the test objects in filename, with the keys index if the
+      // directories have at least threshold keys (no index if 0).
+
+      Int_t saved = TDirectoryFile::GetKeysIndexThreshold();
+      TDirectoryFile::SetKeysIndexThreshold(threshold);
+      TFile f(filename, "RECREATE");
+      for (Int_t i = 0; i < nkeys; ++i) {
+         TNamed obj(TString::Format("obj%d", i), TString::Format("title%d", i));
+         obj.Write();
+         // every 7th object has 3 cycles, with the cycle in the title
+         if (i % 7 == 0) {
+            for (Int_t c = 2; c <= 3; ++c) {
+               obj.SetTitle(TString::Format("title%d;%d", i, c));
+               obj.Write();
+            }
+         }
+      }
+      TDirectory *sub = f.mkdir("sub");
+      sub->cd();
+      for (Int_t i = 0; i < nkeys / 10; ++i) {
+         TNamed obj(TString::Format("sub%d", i), TString::Format("subtitle%d", i));
+         obj.Write();
+      }
+      f.Write();
+      f.Close();
+      TDirectoryFile::SetKeysIndexThreshold(saved);
+   }
+
+   //______________________________________________________________________________
+   TString Title(TDirectory *dir, const char *namecycle)
+   {
+      // Return the title of the object namecycle of dir, "none" if not found.
+
+      TNamed *obj = 0;
+      dir->GetObject(namecycle, obj);
+      if (!obj) return "none";
+      TString title = obj->GetTitle();
+      delete obj;
+      return title;
+   }
+
+   //______________________________________________________________________________
+   Short_t KeyCycle(TDirectory *dir, const char *name, Short_t cycle)
+   {
+      // Return the cycle of the key returned by GetKey, -1 if not found.
+
+      TKey *key = dir->GetKey(name, cycle);
+      return key ? key->GetCycle() : -1;
+   }
+
+   //______________________________________________________________________________
+   Double_t OpenAndGet(const char *filename, const char *name)
+   {
+      // Return the time to open filename and read the object name.
+
+      TStopwatch timer;
+      TFile *f = TFile::Open(filename);
+      if (!f) return -1;
+      TNamed *obj = 0;
+      f->GetObject(name, obj);
+      timer.Stop();
+      delete obj;
+      delete f;
+      return timer.RealTime();
+   }
+
+   //______________________________________________________________________________
+   Bool_t IndexLocation(TFile *f, Long64_t &seek, Int_t &nbytes)
+   {
+      // Read the location of the keys index of the top directory of f in the
+      // trailer ending its keys record. Return kFALSE if there is no index.
+
+      const Int_t ntrailer = 24;
+      char trailer[ntrailer];
+      if (f->ReadBuffer(trailer, f->GetSeekKeys() + f->GetNbytesKeys() - ntrailer, ntrailer)) return kFALSE;
+      char *buffer = trailer;
+      Int_t keylen, nkeys;
+      UInt_t magic;
+      frombuf(buffer, &seek);
+      frombuf(buffer, &nbytes);
+      frombuf(buffer, &keylen);
+      frombuf(buffer, &nkeys);
+      frombuf(buffer, &magic);
+      return magic == 0x4b494458 && seek > 0 && nbytes > 0;
+   }
+
+   //______________________________________________________________________________
+   Bool_t IsFree(TFile *f, Long64_t first, Long64_t last)
+   {
+      // Return kTRUE if each byte of [first,last] is in a free segment of f (opened
+      // in update mode), or in the keys record or the keys index of its top directory,
+      // which may have been written in the segments freed by the update.
+
+      std::vector<Long64_t> firsts, lasts;
+      TIter next(f->GetListOfFree());
+      TFree *segment;
+      while ((segment = (TFree*)next())) {
+         firsts.push_back(segment->GetFirst());
+         lasts.push_back(segment->GetLast());
+      }
+      firsts.push_back(f->GetSeekKeys());
+      lasts.push_back(f->GetSeekKeys() + f->GetNbytesKeys() - 1);
+      Long64_t seek;
+      Int_t nbytes;
+      if (IndexLocation(f, seek, nbytes)) {
+         firsts.push_back(seek);
+         lasts.push_back(seek + nbytes - 1);
+      }
+      Long64_t pos = first;
+      while (pos <= last) {
+         UInt_t i = 0;
+         while (i < firsts.size() && (pos < firsts[i] || pos > lasts[i])) ++i;
+         if (i == firsts.size()) return kFALSE;
+         pos = lasts[i] + 1;
+      }
+      return kTRUE;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressKeysIndex(Int_t nkeys = 20000)
+{
+   PrintBanner("Keys Index Stress Test");
+
+   if (nkeys < 100) nkeys = 100;
+   const char *indexed = "stressKeysIndex_index.root";
+   const char *plain = "stressKeysIndex_plain.root";
+   WriteFile(indexed, nkeys, 10);
+   WriteFile(plain, nkeys, 0);
+
+   TString last = TString::Format("obj%d", nkeys - 1);
+   Double_t tindex = OpenAndGet(indexed, last);
+   Double_t tplain = OpenAndGet(plain, last);
+   printf("Open and Get with index: %8.4f s, without index: %8.4f s\n", tindex, tplain);
+
+   TFile *fi = TFile::Open(indexed);
+   TFile *fp = TFile::Open(plain);
+   if (!fi || !fp) {
+      printf("Cannot open the test files\n");
+      return 1;
+   }
+   Int_t nfailed = 0;
+
+   // The objects, including the ones which do not exist
+   Bool_t ok = (fi->GetNkeys() == fp->GetNkeys());
+   for (Int_t i = 0; i < nkeys + 10; i += 3) {
+      TString name = TString::Format("obj%d", i);
+      if (Title(fi, name) != Title(fp, name)) ok = kFALSE;
+   }
+   PrintResult(1, "Objects found through the index", ok);
+   if (!ok) ++nfailed;
+
+   // The cycles, with Get (exact cycle) and GetKey (highest cycle up to the given one)
+   ok = kTRUE;
+   for (Int_t i = 0; i < nkeys; i += 7) {
+      TString name = TString::Format("obj%d", i);
+      for (Int_t c = 1; c <= 4; ++c) {
+         TString namecycle = TString::Format("%s;%d", name.Data(), c);
+         if (Title(fi, namecycle) != Title(fp, namecycle)) ok = kFALSE;
+         if (KeyCycle(fi, name, c) != KeyCycle(fp, name, c)) ok = kFALSE;
+      }
+      if (KeyCycle(fi, name, 9999) != 3) ok = kFALSE;
+      if (fi->FindKey(name + ";2") == 0 || fi->FindKey(name + ";2")->GetCycle() != 2) ok = kFALSE;
+   }
+   PrintResult(2, "Cycles of the keys found through the index", ok);
+   if (!ok) ++nfailed;
+
+   // The subdirectory, itself found through the index
+   ok = kTRUE;
+   for (Int_t i = 0; i < nkeys / 10; i += 5) {
+      TString name = TString::Format("sub/sub%d", i);
+      if (Title(fi, name) != Title(fp, name) || Title(fi, name) == "none") ok = kFALSE;
+   }
+   PrintResult(3, "Subdirectory read through the index", ok);
+   if (!ok) ++nfailed;
+
+   // The list of keys read after the lookups
+   ok = (fi->GetListOfKeys()->GetSize() == fp->GetListOfKeys()->GetSize());
+   ok = ok && (fi->GetNkeys() == fp->GetNkeys());
+   TIter next(fp->GetListOfKeys());
+   TKey *key;
+   while (ok && (key = (TKey*)next())) {
+      TKey *other = fi->GetKey(key->GetName(), key->GetCycle());
+      if (!other || other->GetCycle() != key->GetCycle() || other->GetNbytes() != key->GetNbytes()) {
+         ok = kFALSE;
+      }
+   }
+   PrintResult(4, "Keys list read after the index lookups", ok);
+   if (!ok) ++nfailed;
+
+   // Update of the file with the index: the keys record and the index are
+   // written again, the old ones are freed
+   Long64_t seekindex = 0;
+   Int_t nbytesindex = 0;
+   Bool_t hasindex = IndexLocation(fi, seekindex, nbytesindex);
+   Int_t nkeysfile = fi->GetNkeys();
+   TString lastTitle = Title(fp, last);
+   delete fi;
+   delete fp;
+
+   Int_t saved = TDirectoryFile::GetKeysIndexThreshold();
+   TDirectoryFile::SetKeysIndexThreshold(10);
+   TFile *fu = TFile::Open(indexed, "UPDATE");
+   if (fu) {
+      TNamed added("added", "added title");
+      added.Write();
+      delete fu;
+   }
+   TDirectoryFile::SetKeysIndexThreshold(saved);
+
+   fi = TFile::Open(indexed);
+   ok = hasindex && fi && fi->GetNkeys() == nkeysfile + 1;
+   ok = ok && Title(fi, "added") == "added title" && Title(fi, last) == lastTitle;
+   ok = ok && Title(fi, "obj0;2") == "title0;2" && Title(fi, "sub/sub0") == "subtitle0";
+   PrintResult(5, "Objects found through the index after an update", ok);
+   if (!ok) ++nfailed;
+   delete fi;
+
+   fu = TFile::Open(indexed, "UPDATE");
+   Long64_t seeknew = 0;
+   Int_t nbytesnew = 0;
+   ok = hasindex && fu && IndexLocation(fu, seeknew, nbytesnew);
+   ok = ok && IsFree(fu, seekindex, seekindex + nbytesindex - 1);
+   PrintResult(6, "Free segments after an update", ok);
+   if (!ok) ++nfailed;
+   delete fu;
+
+   gSystem->Unlink(indexed);
+   gSystem->Unlink(plain);
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nkeys = 20000;
+   if (argc > 1) nkeys = atoi(argv[1]);
+   return stressKeysIndex(nkeys);
+}
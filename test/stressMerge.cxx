@@ -0,0 +1,173 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the parallel merging of files by TFileMerger___
+//
+//   Files holding histograms (in the top directory and in a
+//   sub-directory) and a TTree are written, then merged by a
+//   TFileMerger with one process, as hadd does, and with several
+//   processes (TFileMerger::SetNProcesses, hadd -j). The bin contents
+//   of the merged histograms and the entries of the merged TTrees,
+//   in their order, are compared.
+//
+//   To run in batch mode, do
+//     stressMerge
+//     stressMerge 20 8
+//   Here the parameters are the number of input files (the default
+//   value is 12) and the number of processes of the parallel merge
+//   (the default value is 4).
+//
+//   An example of output:
+// ******************************************************************
+// *  Starting  TFileMerger Parallel Merge Test                     *
+// ******************************************************************
+// Test1: Serial merge of the files -------------------------------- OK
+// Test2: Parallel merge of the files ------------------------------ OK
+// Test3: Histograms of the parallel merge -------------------------- OK
+// Test4: Trees of the parallel merge ------------------------------ OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include "TFile.h"
+#include "TFileMerger.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "stressCommon.h"
+
+namespace {
+
+   //______________________________________________________________________________
+   void WriteInput(const char *filename, Int_t ifile)
+   {
+      // Histograms filled with unit weights, so that the merged bin
+      // contents do not depend on the order of the sums, and a TTree
+      // whose entries record the file and the entry number.
+
+      TFile f(filename, "RECREATE");
+      TRandom3 rndm(1000 + ifile);
+      TH1F h1("h1", "h1", 100, -4, 4);
+      TDirectory *dir = f.mkdir("dir");
+      dir->cd();
+      TH2F h2("h2", "h2", 40, -4, 4, 40, -4, 4);
+      f.cd();
+      TTree tree("T", "T");
+      Int_t file = ifile, entry;
+      Float_t x;
+      tree.Branch("file", &file, "file/I");
+      tree.Branch("entry", &entry, "entry/I");
+      tree.Branch("x", &x, "x/F");
+      const Int_t nentries = 1000 + 100 * ifile;
+      for (entry = 0; entry < nentries; ++entry) {
+         x = rndm.Gaus();
+         h1.Fill(x);
+         h2.Fill(x, rndm.Gaus());
+         tree.Fill();
+      }
+      f.Write();
+   }
+
+   //______________________________________________________________________________
+   Bool_t Merge(const char *output, Int_t ninputs, Int_t nprocesses)
+   {
+      // Merge the input files as hadd does.
+
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.SetPrintLevel(0);
+      merger.SetNProcesses(nprocesses);
+      if (!merger.OutputFile(output, kTRUE, 1)) return kFALSE;
+      for (Int_t i = 0; i < ninputs; ++i) {
+         if (!merger.AddFile(TString::Format("stressMerge_%d.root", i), kFALSE)) return kFALSE;
+      }
+      return merger.Merge();
+   }
+
+   //______________________________________________________________________________
+   Bool_t SameHistogram(TFile &f1, TFile &f2, const char *name)
+   {
+      TH1 *h1 = (TH1*)f1.Get(name);
+      TH1 *h2 = (TH1*)f2.Get(name);
+      if (!h1 || !h2 || h1->GetNcells() != h2->GetNcells()) return kFALSE;
+      if (h1->GetEntries() != h2->GetEntries()) return kFALSE;
+      for (Int_t bin = 0; bin < h1->GetNcells(); ++bin) {
+         if (h1->GetBinContent(bin) != h2->GetBinContent(bin)) return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   //______________________________________________________________________________
+   Bool_t SameTree(TFile &f1, TFile &f2, Long64_t nexpected)
+   {
+      TTree *t1 = (TTree*)f1.Get("T");
+      TTree *t2 = (TTree*)f2.Get("T");
+      if (!t1 || !t2 || t1->GetEntries() != nexpected || t2->GetEntries() != nexpected) return kFALSE;
+      Int_t file1, entry1, file2, entry2;
+      Float_t x1, x2;
+      t1->SetBranchAddress("file", &file1);
+      t1->SetBranchAddress("entry", &entry1);
+      t1->SetBranchAddress("x", &x1);
+      t2->SetBranchAddress("file", &file2);
+      t2->SetBranchAddress("entry", &entry2);
+      t2->SetBranchAddress("x", &x2);
+      for (Long64_t i = 0; i < nexpected; ++i) {
+         t1->GetEntry(i);
+         t2->GetEntry(i);
+         if (file1 != file2 || entry1 != entry2 || x1 != x2) return kFALSE;
+      }
+      return kTRUE;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressMerge(Int_t ninputs = 12, Int_t nprocesses = 4)
+{
+   PrintBanner("TFileMerger Parallel Merge Test");
+
+   if (ninputs < 2) ninputs = 2;
+   Long64_t nentries = 0;
+   for (Int_t i = 0; i < ninputs; ++i) {
+      WriteInput(TString::Format("stressMerge_%d.root", i), i);
+      nentries += 1000 + 100 * i;
+   }
+
+   Int_t nfailed = 0;
+   Bool_t okSerial = Merge("stressMerge_serial.root", ninputs, 1);
+   PrintResult(1, "Serial merge of the files", okSerial);
+   if (!okSerial) ++nfailed;
+   Bool_t okParallel = Merge("stressMerge_parallel.root", ninputs, nprocesses);
+   PrintResult(2, "Parallel merge of the files", okParallel);
+   if (!okParallel) ++nfailed;
+
+   Bool_t okHist = kFALSE, okTree = kFALSE;
+   if (okSerial && okParallel) {
+      TFile serial("stressMerge_serial.root");
+      TFile parallel("stressMerge_parallel.root");
+      okHist = SameHistogram(serial, parallel, "h1") && SameHistogram(serial, parallel, "dir/h2");
+      okTree = SameTree(serial, parallel, nentries);
+   }
+   PrintResult(3, "Histograms of the parallel merge", okHist);
+   if (!okHist) ++nfailed;
+   PrintResult(4, "Trees of the parallel merge", okTree);
+   if (!okTree) ++nfailed;
+
+   for (Int_t i = 0; i < ninputs; ++i) gSystem->Unlink(TString::Format("stressMerge_%d.root", i));
+   gSystem->Unlink("stressMerge_serial.root");
+   gSystem->Unlink("stressMerge_parallel.root");
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t ninputs = 12;
+   Int_t nprocesses = 4;
+   if (argc > 1) ninputs = atoi(argv[1]);
+   if (argc > 2) nprocesses = atoi(argv[2]);
+   return stressMerge(ninputs, nprocesses);
+}
@@ -6453,3 +6453,293 @@ public:
   }
 } ;
 
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit test #805
+// 
+// Evaluation of the likelihood by batches of events (BatchMode()),
+// compared to the evaluation event by event
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooAddPdf.h"
+#include "RooNLLVar.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic805 : public RooUnitTest
+{
+public: 
+  TestBasic805(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood evaluated by batches of events",refFile,writeRef,verbose) {} ;
+
+  Bool_t sameNLL(RooAbsReal& nll, RooAbsReal& nllBatch) {
+    Double_t ref = nll.getVal() ;
+    Double_t val = nllBatch.getVal() ;
+    return TMath::Abs(val-ref) <= 1e-10*TMath::Abs(ref) ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // -------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+
+  RooRealVar mean("mean","mean",5,0,10) ;
+  RooRealVar sigma("sigma","sigma",0.7,0.1,5) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar a1("a1","a1",0.05,0,1) ;
+  RooPolynomial poly("poly","poly",x,a1) ;
+
+  RooRealVar f1("f1","f1",0.3,0,1) ;
+  RooRealVar f2("f2","f2",0.5,0,1) ;
+  RooAddPdf model("model","model",RooArgList(gauss,expo,poly),RooArgList(f1,f2)) ;
+
+  // The number of events is not a multiple of the batch size
+  RooDataSet* data = model.generate(x,5001) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  // Likelihoods evaluated event by event and by batches of events
+  RooNLLVar nll("nll","nll",model,*data) ;
+  RooNLLVar nllBatch("nllBatch","nllBatch",model,*data,BatchMode()) ;
+
+  Bool_t ok = sameNLL(nll,nllBatch) ;
+
+  // Change the parameters
+  mean.setVal(4.8) ; sigma.setVal(0.9) ; c.setVal(-0.5) ; a1.setVal(0.2) ; f1.setVal(0.25) ;
+  ok &= sameNLL(nll,nllBatch) ;
+
+  // Weighted events, with squared weights
+  RooRealVar w("w","w",0,10) ;
+  RooDataSet wdata("wdata","wdata",RooArgSet(x,w),WeightVar(w)) ;
+  for (Int_t i=0 ; i<data->numEntries() ; i++) {
+    x.setVal(data->get(i)->getRealValue("x")) ;
+    wdata.add(RooArgSet(x),0.5+(i%3)) ;
+  }
+  RooNLLVar wnll("wnll","wnll",model,wdata) ;
+  RooNLLVar wnllBatch("wnllBatch","wnllBatch",model,wdata,BatchMode()) ;
+  ok &= sameNLL(wnll,wnllBatch) ;
+  wnll.applyWeightSquared(kTRUE) ;
+  wnllBatch.applyWeightSquared(kTRUE) ;
+  ok &= sameNLL(wnll,wnllBatch) ;
+
+  delete data ;
+
+  return ok ;
+  }
+} ;
+/////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit test #806
+// 
+// Parallel calculation of the likelihood by threads (NumCPU() with
+// the Threads parallel mode), with bulk and interleaved partitions and
+// with a simultaneous p.d.f, compared to the serial calculation
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooSimultaneous.h"
+#include "RooNLLVar.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic806 : public RooUnitTest
+{
+public: 
+  TestBasic806(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood calculated by parallel threads",refFile,writeRef,verbose) {} ;
+
+  Bool_t sameNLL(RooAbsReal& nll, RooAbsReal& nllMT) {
+    Double_t ref = nll.getVal() ;
+    Double_t val = nllMT.getVal() ;
+    return TMath::Abs(val-ref) <= 1e-10*TMath::Abs(ref) ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // -------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+
+  RooRealVar mean("mean","mean",5,0,10) ;
+  RooRealVar sigma("sigma","sigma",0.7,0.1,5) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar f("f","f",0.3,0,1) ;
+  RooAddPdf model("model","model",RooArgList(gauss,expo),f) ;
+
+  RooDataSet* data = model.generate(x,2001) ;
+
+  // The partitions are calculated by threads instead of forked processes
+  RooAbsTestStatistic::MPMode mpMode = RooAbsTestStatistic::defaultMPMode() ;
+  RooAbsTestStatistic::setDefaultMPMode(RooAbsTestStatistic::Threads) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  // Serial likelihood and likelihoods calculated by 3 threads
+  RooNLLVar nll("nll","nll",model,*data) ;
+  RooNLLVar nllMT("nllMT","nllMT",model,*data,NumCPU(3)) ;
+  RooNLLVar nllMTi("nllMTi","nllMTi",model,*data,NumCPU(3,kTRUE)) ;
+
+  Bool_t ok = sameNLL(nll,nllMT) && sameNLL(nll,nllMTi) ;
+
+  // Change the parameters, several times to use the threads
+  for (Int_t i=0 ; i<3 ; i++) {
+    mean.setVal(4.8+0.1*i) ; sigma.setVal(0.9) ; c.setVal(-0.5) ; f.setVal(0.25) ;
+    ok &= sameNLL(nll,nllMT) && sameNLL(nll,nllMTi) ;
+  }
+
+  // Fit with the threaded likelihood, including the constant term optimization
+  mean.setVal(5) ; sigma.setVal(0.7) ; c.setVal(-0.3) ; f.setVal(0.3) ;
+  RooFitResult* r = model.fitTo(*data,Save(),PrintLevel(-1)) ;
+  mean.setVal(5) ; sigma.setVal(0.7) ; c.setVal(-0.3) ; f.setVal(0.3) ;
+  RooFitResult* rMT = model.fitTo(*data,Save(),PrintLevel(-1),NumCPU(3)) ;
+  const RooArgList& pars = r->floatParsFinal() ;
+  const RooArgList& parsMT = rMT->floatParsFinal() ;
+  for (Int_t i=0 ; i<pars.getSize() ; i++) {
+    RooRealVar* par = (RooRealVar*) pars.at(i) ;
+    RooRealVar* parMT = (RooRealVar*) parsMT.at(i) ;
+    ok &= TMath::Abs(par->getVal()-parMT->getVal()) <= 1e-3*par->getError() ;
+  }
+  delete r ;
+  delete rMT ;
+
+  // Simultaneous p.d.f
+  RooCategory sample("sample","sample") ;
+  sample.defineType("signal") ;
+  sample.defineType("background") ;
+  RooDataSet* data2 = expo.generate(x,1000) ;
+  RooDataSet combData("combData","combData",x,Index(sample),Import("signal",*data),Import("background",*data2)) ;
+  RooSimultaneous simPdf("simPdf","simPdf",sample) ;
+  simPdf.addPdf(model,"signal") ;
+  simPdf.addPdf(expo,"background") ;
+
+  RooNLLVar simNll("simNll","simNll",simPdf,combData) ;
+  RooNLLVar simNllMT("simNllMT","simNllMT",simPdf,combData,NumCPU(3)) ;
+  ok &= sameNLL(simNll,simNllMT) ;
+  c.setVal(-0.4) ; f.setVal(0.35) ;
+  ok &= sameNLL(simNll,simNllMT) ;
+
+  RooAbsTestStatistic::setDefaultMPMode(mpMode) ;
+  delete data ;
+  delete data2 ;
+
+  return ok ;
+  }
+} ;
+/////////////////////////////////////////////////////////////////////////
+//
+// 'MONTE CARLO STUDIES' RooFit test #807
+// 
+// Toy MC study generated and fitted by forked processes (NumCPU()).
+// The fit results and the generated samples must not depend on
+// the number of processes
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooMCStudy.h"
+#include "RooRandom.h"
+#include "TRandom.h"
+
+using namespace RooFit ;
+
+
+class TestBasic807 : public RooUnitTest
+{
+public: 
+  TestBasic807(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Toy MC study run by parallel processes",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",0,10) ;
+
+  RooRealVar mean("mean","mean",5,0,10) ;
+  RooRealVar sigma("sigma","sigma",0.7,0.1,5) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar f("f","f",0.3,0,1) ;
+  RooAddPdf model("model","model",RooArgList(gauss,expo),f) ;
+
+
+  // R u n   t h e   s t u d y   w i t h   1   a n d   3   p r o c e s s e s
+  // -------------------------------------------------------------------------
+
+  RooMCStudy mcs1(model,x,Silence(),FitOptions(Save(kTRUE),PrintEvalErrors(0)),NumCPU(1)) ;
+  RooMCStudy mcs3(model,x,Silence(),FitOptions(Save(kTRUE),PrintEvalErrors(0)),NumCPU(3)) ;
+
+  RooRandom::randomGenerator()->SetSeed(4357) ;
+  mcs1.generateAndFit(10,500,kTRUE) ;
+  RooRandom::randomGenerator()->SetSeed(4357) ;
+  mcs3.generateAndFit(10,500,kTRUE) ;
+
+  // The fitted parameters, their errors and the generated samples must be identical
+  const RooDataSet& fp1 = mcs1.fitParDataSet() ;
+  const RooDataSet& fp3 = mcs3.fitParDataSet() ;
+  Bool_t ok = fp1.numEntries()==fp3.numEntries() && fp1.numEntries()>0 ;
+  for (Int_t i=0 ; ok && i<fp1.numEntries() ; i++) {
+    RooArgList row1(*fp1.get(i)) ;
+    RooArgList row3(*fp3.get(i)) ;
+    for (Int_t j=0 ; j<row1.getSize() ; j++) {
+      RooRealVar* v1 = dynamic_cast<RooRealVar*>(row1.at(j)) ;
+      RooRealVar* v3 = dynamic_cast<RooRealVar*>(row3.find(row1.at(j)->GetName())) ;
+      if (!v1) continue ;
+      ok &= v3 && v1->getVal()==v3->getVal() && v1->getError()==v3->getError() ;
+    }
+  }
+  for (Int_t i=0 ; ok && i<10 ; i++) {
+    ok &= mcs3.genData(i) && mcs1.genData(i)->numEntries()==mcs3.genData(i)->numEntries() ;
+    ok &= mcs3.fitResult(i) && mcs1.fitResult(i)->minNll()==mcs3.fitResult(i)->minNll() ;
+  }
+
+  return ok ;
+  }
+} ;
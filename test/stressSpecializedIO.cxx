@@ -0,0 +1,154 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the streamers specialized for the class layout___
+//
+//   The classes EventHeader and EventTag (which derives from TObject)
+//   of the Event example are selected in EventLinkDef.h with the option
+//   'specialized': rootcling generates the streamer of their data
+//   members, which TStreamerInfo uses instead of its actions when the
+//   StreamerInfo describes the layout of the class. Headers and tags
+//   are written in a buffer with the specialized streamers and with the
+//   StreamerInfo actions (TStreamerInfo::UseSpecialized), the two
+//   buffers must be identical and each one must be read back with both
+//   methods. The time to write and read the headers and tags with each
+//   method is reported.
+//
+//   To run in batch mode, do
+//     stressSpecializedIO
+//     stressSpecializedIO 1000000
+//   Here the parameter is the number of headers and tags.
+//   The default value is 200000.
+//
+// An example of output:
+// ******************************************************************
+// *  Starting  Specialized Streamers Stress Test                   *
+// ******************************************************************
+// Write+Read specialized:   0.0213 s, StreamerInfo actions:   0.0405 s
+// Test1: Specialized streamer of the class layout used ------------- OK
+// Test2: Same buffer written by both streamers -------------------- OK
+// Test3: Buffer read by the specialized streamer ------------------ OK
+// Test4: Buffer read by the StreamerInfo actions ------------------ OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TStopwatch.h"
+#include "TStreamerInfo.h"
+#include "TString.h"
+#include "Event.h"
+#include "stressCommon.h"
+
+namespace {
+
+   //______________________________________________________________________________
+   void Write(TBufferFile &buf, Int_t n, Bool_t specialized)
+   {
+      // Write n headers and tags in buf, with the specialized streamers or
+      // the actions. The tags have a unique ID and some have a user bit set,
+      // streamed by their TObject base.
+
+      TStreamerInfo::UseSpecialized(specialized);
+      EventHeader hdr;
+      EventTag tag;
+      for (Int_t i = 0; i < n; ++i) {
+         hdr.Set(i, 200 + i % 13, 960312 + i % 7);
+         hdr.Streamer(buf);
+         tag.Set(i % 255, 0.5 * i);
+         tag.SetUniqueID(i);
+         tag.SetBit(BIT(15), i % 3 == 0);
+         tag.Streamer(buf);
+      }
+      TStreamerInfo::UseSpecialized(kTRUE);
+   }
+
+   //______________________________________________________________________________
+   Bool_t Read(const TBufferFile &buf, Int_t n, Bool_t specialized)
+   {
+      // Read the n headers and tags of buf, with the specialized streamers
+      // or the actions, and check their values.
+
+      TStreamerInfo::UseSpecialized(specialized);
+      TBufferFile in(TBuffer::kRead, buf.Length(), const_cast<char*>(buf.Buffer()), kFALSE);
+      Bool_t ok = kTRUE;
+      EventHeader hdr;
+      EventTag tag;
+      for (Int_t i = 0; i < n; ++i) {
+         hdr.Streamer(in);
+         if (hdr.GetEvtNum() != i || hdr.GetRun() != 200 + i % 13 || hdr.GetDate() != 960312 + i % 7) ok = kFALSE;
+         tag.Streamer(in);
+         if (tag.GetTrigger() != i % 255 || tag.GetWeight() != Float_t(0.5 * i)) ok = kFALSE;
+         if (tag.GetUniqueID() != UInt_t(i) || tag.TestBit(BIT(15)) != (i % 3 == 0)) ok = kFALSE;
+      }
+      TStreamerInfo::UseSpecialized(kTRUE);
+      return ok && in.Length() == buf.Length();
+   }
+
+   //______________________________________________________________________________
+   Double_t WriteAndRead(Int_t n, Bool_t specialized)
+   {
+      // Return the time to write and read n headers and tags.
+
+      TStopwatch timer;
+      TBufferFile buf(TBuffer::kWrite);
+      Write(buf, n, specialized);
+      Read(buf, n, specialized);
+      timer.Stop();
+      return timer.RealTime();
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressSpecializedIO(Int_t n = 200000)
+{
+   PrintBanner("Specialized Streamers Stress Test");
+
+   if (n < 1) n = 1;
+   Int_t nfailed = 0;
+
+   TBufferFile special(TBuffer::kWrite);
+   TBufferFile actions(TBuffer::kWrite);
+   Write(special, n, kTRUE);
+   Write(actions, n, kFALSE);
+
+   Double_t tspecial = WriteAndRead(n, kTRUE);
+   Double_t tactions = WriteAndRead(n, kFALSE);
+   printf("Write+Read specialized: %8.4f s, StreamerInfo actions: %8.4f s\n", tspecial, tactions);
+
+   TStreamerInfo *info = (TStreamerInfo*)EventHeader::Class()->GetStreamerInfo();
+   TStreamerInfo *tagInfo = (TStreamerInfo*)EventTag::Class()->GetStreamerInfo();
+   Bool_t ok = EventHeader::Class()->GetSpecializedStreamerFunc() != 0
+               && info && info->GetSpecializedStreamerFunc() != 0
+               && EventTag::Class()->GetSpecializedStreamerFunc() != 0
+               && tagInfo && tagInfo->GetSpecializedStreamerFunc() != 0;
+   PrintResult(1, "Specialized streamer of the class layout used", ok);
+   if (!ok) ++nfailed;
+
+   ok = special.Length() == actions.Length()
+        && memcmp(special.Buffer(), actions.Buffer(), special.Length()) == 0;
+   PrintResult(2, "Same buffer written by both streamers", ok);
+   if (!ok) ++nfailed;
+
+   ok = Read(special, n, kTRUE) && Read(actions, n, kTRUE);
+   PrintResult(3, "Buffer read by the specialized streamer", ok);
+   if (!ok) ++nfailed;
+
+   ok = Read(special, n, kFALSE) && Read(actions, n, kFALSE);
+   PrintResult(4, "Buffer read by the StreamerInfo actions", ok);
+   if (!ok) ++nfailed;
+
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t n = 200000;
+   if (argc > 1) n = atoi(argv[1]);
+   return stressSpecializedIO(n);
+}
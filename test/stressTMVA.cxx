@@ -1826,6 +1826,7 @@ namespace UnitTesting
 #include "TMath.h"
 #include "TMVA/MethodBase.h"
 #include "TMVA/Reader.h"
+#include "TMVA/ThreadExecutor.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -1834,6 +1835,36 @@ using namespace std;
 using namespace UnitTesting;
 using namespace TMVA;
 
+namespace {
+
+   // evaluates the events of a block with a Reader shared by the threads, each one with its own context
+   class ConcurrentReaderTask : public TMVA::ThreadExecutor::Task {
+   public:
+      ConcurrentReaderTask( const TMVA::Reader& reader, const TString& methodTag, double aux,
+                            const vector<float>& inputs, UInt_t nvar, vector<double>& mvaValues ) :
+         fReader(reader), fMethodTag(methodTag), fAux(aux), fInputs(inputs), fNVar(nvar), fMvaValues(mvaValues) {}
+
+      void Process( UInt_t /* iblock */, UInt_t begin, UInt_t end )
+      {
+         TMVA::EvaluationContext context;
+         vector<float> input( fNVar );
+         for (UInt_t ievt=begin; ievt<end; ievt++) {
+            for (UInt_t i=0; i<fNVar; i++) input[i] = fInputs[ievt*fNVar+i];
+            fMvaValues[ievt] = fReader.EvaluateMVA( input, fMethodTag, context, fAux );
+         }
+      }
+
+   private:
+      const TMVA::Reader&  fReader;
+      const TString&       fMethodTag;
+      double               fAux;
+      const vector<float>& fInputs;
+      UInt_t               fNVar;
+      vector<double>&      fMvaValues;
+   };
+
+}
+
 MethodUnitTestWithROCLimits::MethodUnitTestWithROCLimits(const Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption,
 														double lowLimit, double upLimit,
                                                          const std::string & /* xname */ ,const std::string & /* filename */ , std::ostream* /* sptr */ ) :
@@ -1953,8 +1984,11 @@ void MethodUnitTestWithROCLimits::run()
   if (outputFile) delete outputFile;
   
   // Reader tests
-  const int nTest=6; // 3 reader usages + 3 tests with additional readers
+  const int nTest=8; // 3 reader usages + 3 tests with additional readers + block evaluation + concurrent evaluation
   float testTreeVal,readerVal=0.;
+  vector<float>  blockInput;
+  vector<double> blockVal;
+  vector<float>  blockTestTreeVal;
   vector<float>  testvar(_VariableNames->size());
   vector<float>  dummy(_VariableNames->size());
   vector<float>  dummy2(_VariableNames->size());
@@ -1996,7 +2030,7 @@ void MethodUnitTestWithROCLimits::run()
            reader[iTest]->AddVariable( _VariableNames->at(i),&testvar[i]);
         reader[iTest] ->BookMVA( readerName, weightfile) ;
      }
-     else if (iTest==1 || iTest ==2) {
+     else if (iTest==1 || iTest ==2 || iTest==6 || iTest==7) {
         reader[iTest] = new TMVA::Reader( *_VariableNames, readerOption );
         reader[iTest] ->BookMVA( readerName, weightfile) ;
      }
@@ -2076,6 +2110,14 @@ void MethodUnitTestWithROCLimits::run()
            else readerVal=reader[iTest]->EvaluateMVA( readerName);  
            dummy5 += reader2->EvaluateMVA( readerName2);
         }
+        else if (iTest==6){ // events evaluated together after the loop
+           blockInput.insert( blockInput.end(), testvarFloat.begin(), testvarFloat.end() );
+           blockTestTreeVal.push_back( testTreeVal );
+           continue;
+        }
+        else if (iTest==7){ // events of the block evaluated by several threads after the loop
+           continue;
+        }
         else {
            std::cout << "ERROR, undefined iTest value "<<iTest<<endl;
            exit(1);
@@ -2089,6 +2131,33 @@ void MethodUnitTestWithROCLimits::run()
         if (iTest ==0 ) previousVal=readerVal;
      }
 
+     if (iTest==6){
+        if (_methodType==Types::kCuts)
+           reader[iTest]->EvaluateMVA( blockInput, blockVal, readerName, effS );
+        else reader[iTest]->EvaluateMVA( blockInput, blockVal, readerName );
+        test_(blockVal.size()==blockTestTreeVal.size());
+        if (_methodType!=Types::kCuts){
+           for (UInt_t ievt=0;ievt<blockVal.size() && ievt<blockTestTreeVal.size();ievt++){
+              diff = TMath::Abs(blockVal[ievt]-blockTestTreeVal[ievt]);
+              maxdiff = diff > maxdiff ? diff : maxdiff;
+              sumdiff += diff;
+           }
+        }
+     }
+
+     if (iTest==7){
+        vector<double> concurrentVal( blockTestTreeVal.size() );
+        ConcurrentReaderTask task( *reader[iTest], readerName, effS, blockInput, _VariableNames->size(), concurrentVal );
+        TMVA::ThreadExecutor::Run( task, concurrentVal.size(), 4 );
+        if (_methodType!=Types::kCuts){
+           for (UInt_t ievt=0;ievt<concurrentVal.size();ievt++){
+              diff = TMath::Abs(concurrentVal[ievt]-blockTestTreeVal[ievt]);
+              maxdiff = diff > maxdiff ? diff : maxdiff;
+              sumdiff += diff;
+           }
+        }
+     }
+
   }
   Bool_t ok=false;
   sumdiff=sumdiff/nevt;
@@ -2770,6 +2839,7 @@ void addClassificationTests( UnitTestSuite& TMVA_test, bool full=true)
                                                                 baseFDAstring+"FitMethod=SA:MaxCalls=5000:KernelTemp=IncAdaptive:InitialTemp=1e+6:MinTemp=1e-6:Eps=1e-10:UseDefaultScale" , 0.88, 0.98) );
    TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kMLP, "MLP", "H:!V:NeuronType=tanh:VarTransform=N:NCycles=200:HiddenLayers=N+5:TestRate=5:!UseRegulator" , 0.88, 0.98) );
    TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kMLP, "MLPBFGS", "H:!V:NeuronType=tanh:VarTransform=N:NCycles=200:HiddenLayers=N+5:TestRate=5:TrainingMethod=BFGS:!UseRegulator" , 0.88, 0.98) );
+   TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kMLP, "MLPDense", "H:!V:NeuronType=tanh:VarTransform=N:NCycles=200:HiddenLayers=N+5:TestRate=5:BPMode=batch:BatchSize=20:UseDenseLayers:NThreads=4:!UseRegulator" , 0.85, 0.98) );
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kMLP, "MLPBNN", "H:!V:NeuronType=tanh:VarTransform=N:NCycles=200:HiddenLayers=N+5:TestRate=5:TrainingMethod=BFGS:UseRegulator" , 0.88, 0.98) ); // BFGS training with bayesian regulators
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kCFMlpANN, "CFMlpANN", "!H:!V:NCycles=200:HiddenLayers=N+1,N"  , 0.7, 0.98) ); // n_cycles:#nodes:#nodes:...
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kTMlpANN, "TMlpANN", "!H:!V:NCycles=200:HiddenLayers=N+1,N:LearningMethod=BFGS:ValidationFraction=0.3"  , 0.7, 0.98) ); // n_cycles:#nodes:#nodes:...
@@ -2778,6 +2848,8 @@ void addClassificationTests( UnitTestSuite& TMVA_test, bool full=true)
                                                       "!H:!V:NTrees=400:BoostType=Grad:Shrinkage=0.30:UseBaggedGrad:GradBaggingFraction=0.6:SeparationType=GiniIndex:nCuts=20:NNodesMax=7" , 0.88, 0.98) );
    TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDT",
                                                       "!H:!V:NTrees=400:nEventsMin=100:MaxDepth=3:BoostType=AdaBoost:SeparationType=GiniIndex:nCuts=10:PruneMethod=NoPruning" , 0.88, 0.98) );
+   TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTH",
+                                                      "!H:!V:NTrees=400:BoostType=Grad:Shrinkage=0.30:UseBaggedGrad:GradBaggingFraction=0.6:SeparationType=GiniIndex:nCuts=63:NNodesMax=7:UseHistogramSplits:NThreads=4" , 0.88, 0.98) );
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTB",
                                                                 "!H:!V:NTrees=400:nEventsMin=100:BoostType=Bagging:SeparationType=GiniIndex:nCuts=20:PruneMethod=NoPruning" , 0.8, 0.98) );
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTD",
@@ -2793,6 +2865,7 @@ void addRegressionTests( UnitTestSuite& TMVA_test, bool full=true)
    TMVA_test.addTest(new RegressionUnitTestWithDeviation( TMVA::Types::kMLP, "MLPBFGSN", "!H:!V:VarTransform=Norm:NeuronType=tanh:NCycles=300:HiddenLayers=N+20:TestRate=6:TrainingMethod=BFGS:Sampling=0.3:SamplingEpoch=0.8:ConvergenceImprove=1e-7:ConvergenceTests=15:!UseRegulator:VarTransform=N" , 0.4, 0.85, 0.3, 0.55 ));
    if (full) TMVA_test.addTest(new RegressionUnitTestWithDeviation( TMVA::Types::kBDT, "BDTG","!H:!V:NTrees=1000::BoostType=Grad:Shrinkage=0.3:!UseBaggedGrad:SeparationType=GiniIndex:nCuts=20:nEventsMin=20:NNodesMax=7" ,  5., 8., 3., 5. ));
    TMVA_test.addTest(new RegressionUnitTestWithDeviation( TMVA::Types::kBDT, "BDTG2","!H:!V:NTrees=2000::BoostType=Grad:Shrinkage=0.1:UseBaggedGrad:GradBaggingFraction=0.5:nCuts=20:MaxDepth=3:NNodesMax=15" ,  2., 5., 1., 3. ));
+   TMVA_test.addTest(new RegressionUnitTestWithDeviation( TMVA::Types::kBDT, "BDTGH","!H:!V:NTrees=2000::BoostType=Grad:Shrinkage=0.1:UseBaggedGrad:GradBaggingFraction=0.5:nCuts=63:MaxDepth=3:NNodesMax=15:UseHistogramSplits:NThreads=4" ,  2., 5., 1., 3. ));
 
    if (!full) return;
 
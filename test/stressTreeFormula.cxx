@@ -0,0 +1,178 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the compiled evaluation of TTreeFormula___
+//
+//   The expressions of a set of TTreeFormula, reading a memory
+//   resident TTree with scalar and variable size array branches, are
+//   evaluated for all the entries and all the instances with the
+//   interpreted stack machine of TTreeFormula::EvalInstance, then
+//   with TTreeFormula::SetJitCompilation. The values must be equal.
+//   The expressions using strings or the operator ?: must fall back
+//   to the interpreter.
+//
+//   To run in batch mode, do
+//     stressTreeFormula
+//     stressTreeFormula 20000
+//   Here the parameter is the number of entries of the tree.
+//   The default value is 5000.
+//
+// ******************************************************************
+// *  Starting  TTreeFormula Compilation Stress Test                *
+// ******************************************************************
+// Test1: Arithmetic and mathematical functions -------------------- OK
+// Test2: Comparisons, && and || ----------------------------------- OK
+// Test3: Variable size arrays and Sum$ ---------------------------- OK
+// Test4: Aliases -------------------------------------------------- OK
+// Test5: Fallback to the interpreter ------------------------------ OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <vector>
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#include "stressCommon.h"
+
+namespace {
+
+   //______________________________________________________________________________
+   TTree *MakeTree(Int_t nentries)
+   {
+      // Fill a memory resident tree.
+
+      TTree *tree = new TTree("T", "formula test tree");
+      tree->SetDirectory(0);
+      Float_t px, py, eta;
+      Int_t n, flags;
+      Double_t e[20];
+      tree->Branch("px", &px, "px/F");
+      tree->Branch("py", &py, "py/F");
+      tree->Branch("eta", &eta, "eta/F");
+      tree->Branch("flags", &flags, "flags/I");
+      tree->Branch("n", &n, "n/I");
+      tree->Branch("e", e, "e[n]/D");
+      TRandom3 rnd(1);
+      for (Int_t i = 0; i < nentries; ++i) {
+         px = rnd.Gaus(0, 10);
+         py = rnd.Gaus(0, 10);
+         eta = rnd.Uniform(-4, 4);
+         flags = rnd.Integer(256);
+         n = rnd.Integer(20);
+         for (Int_t j = 0; j < n; ++j) e[j] = rnd.Exp(5) - 1;
+         tree->Fill();
+      }
+      tree->SetAlias("pt", "sqrt(px*px+py*py)");
+      tree->SetAlias("good", "pt>5 && abs(eta)<2.5");
+      return tree;
+   }
+
+   //______________________________________________________________________________
+   void Evaluate(TTree *tree, const char *expression, std::vector<Double_t> &values, Bool_t &compiled)
+   {
+      // Evaluate expression for all the entries and instances of tree.
+
+      TTreeFormula formula("formula", expression, tree);
+      values.clear();
+      for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+         tree->LoadTree(entry);
+         formula.ResetLoading();
+         Int_t ndata = formula.GetNdata();
+         for (Int_t i = 0; i < ndata; ++i) values.push_back(formula.EvalInstance(i));
+      }
+      compiled = formula.IsJitCompiled();
+   }
+
+   //______________________________________________________________________________
+   Bool_t SameValues(TTree *tree, const char **expressions, Bool_t expectCompiled)
+   {
+      // Compare the interpreted and the compiled evaluations of expressions.
+      // The compiler may contract a*b+c, so the values are compared up to
+      // the rounding errors.
+
+      for (Int_t k = 0; expressions[k]; ++k) {
+         std::vector<Double_t> ref, res;
+         Bool_t compiled;
+         TTreeFormula::SetJitCompilation(kFALSE);
+         Evaluate(tree, expressions[k], ref, compiled);
+         TTreeFormula::SetJitCompilation(kTRUE);
+         Evaluate(tree, expressions[k], res, compiled);
+         TTreeFormula::SetJitCompilation(kFALSE);
+         if (compiled != expectCompiled || ref.empty() || ref.size() != res.size()) return kFALSE;
+         for (UInt_t i = 0; i < ref.size(); ++i) {
+            if (TMath::Abs(ref[i] - res[i]) > 1e-12 * (TMath::Abs(ref[i]) + 1)) return kFALSE;
+         }
+      }
+      return kTRUE;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressTreeFormula(Int_t nentries = 5000)
+{
+   PrintBanner("TTreeFormula Compilation Stress Test");
+
+   TTree *tree = MakeTree(nentries);
+
+   const char *arithmetic[] = {
+      "px*py+2.5*eta-1/3.",
+      "sqrt(px*px+py*py)/(eta+0.5)",
+      "log(px)+log10(abs(py))+exp(eta*300)",
+      "atan2(py,px)+tan(px)+acos(eta/3)+asin(eta)",
+      "acosh(px)+asinh(py)+atanh(eta/4)+tanh(py)",
+      "pow(abs(px),1.5)-fmod(py,3)+sign(eta)*int(px)+pi",
+      "flags%7+(flags&15)+(flags|3)+(flags<<2)+(flags>>1)+min(px,py)-max(px,eta)",
+      0 };
+   const char *logical[] = {
+      "px>0 && py<0",
+      "px>0 || abs(eta)>=1",
+      "!(px==py) && (eta<=1 || px!=0) && flags>100",
+      0 };
+   const char *arrays[] = {
+      "e*px",
+      "e[2]+e[0]*eta",
+      "Sum$(e>2)+Length$(e)+Iteration$",
+      "px>0 && e>1",
+      0 };
+   const char *aliases[] = {
+      "pt*eta",
+      "good*pt",
+      "good || e>3",
+      0 };
+   const char *fallback[] = {
+      "px>0 ? py : eta",
+      0 };
+
+   Int_t nfailed = 0;
+   Bool_t ok = SameValues(tree, arithmetic, kTRUE);
+   PrintResult(1, "Arithmetic and mathematical functions", ok);
+   if (!ok) ++nfailed;
+   ok = SameValues(tree, logical, kTRUE);
+   PrintResult(2, "Comparisons, && and ||", ok);
+   if (!ok) ++nfailed;
+   ok = SameValues(tree, arrays, kTRUE);
+   PrintResult(3, "Variable size arrays and Sum$", ok);
+   if (!ok) ++nfailed;
+   ok = SameValues(tree, aliases, kTRUE);
+   PrintResult(4, "Aliases", ok);
+   if (!ok) ++nfailed;
+   ok = SameValues(tree, fallback, kFALSE);
+   PrintResult(5, "Fallback to the interpreter", ok);
+   if (!ok) ++nfailed;
+
+   PrintBannerLine();
+
+   delete tree;
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nentries = 5000;
+   if (argc > 1) nentries = atoi(argv[1]);
+   return stressTreeFormula(nentries);
+}
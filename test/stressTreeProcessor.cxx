@@ -0,0 +1,264 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the multi-threaded processing of a TChain___
+//
+//   Two files with a TTree are written, then a TChain made of both is
+//   processed with TThreadedTreeProcessor and TTreeReader, with one and
+//   with several threads. The number of entries processed, a sum and a
+//   histogram filled by the workers are compared with the values
+//   obtained by a plain sequential loop on the TChain.
+//   The branches of the first file are also read column-wise with
+//   TBranch::GetBulkEntries and compared with the entry-wise reading.
+//   Finally a compressed and an uncompressed file are read with the
+//   TFile option MMAP and compared with the normal reading.
+//
+//   To run in batch mode, do
+//     stressTreeProcessor
+//     stressTreeProcessor 200000
+//   Here the parameter is the number of entries in each file.
+//   The default value is 100000.
+//
+// ******************************************************************
+// *  Starting  TThreadedTreeProcessor Stress Test                  *
+// ******************************************************************
+// Test1: Ranges are aligned on the clusters and cover the chain --- OK
+// Test2: Processing with one thread ------------------------------- OK
+// Test3: Processing with 4 threads -------------------------------- OK
+// Test4: Bulk reading of the branches with GetBulkEntries -------- OK
+// Test5: Reading of memory mapped files --------------------------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include "TChain.h"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+#include "TBranch.h"
+#include "TSystem.h"
+#include "TThreadedTreeProcessor.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "stressCommon.h"
+
+namespace {
+
+   class TSumWorker : public TThreadedTreeProcessor::TWorker {
+   public:
+      TTreeReaderValue<Float_t> *fX;
+      TTreeReaderValue<Int_t>   *fN;
+      TH1D                      *fHist;
+      Double_t                   fSum;
+      Long64_t                   fCount;
+
+      TSumWorker() : fX(0), fN(0), fSum(0), fCount(0) {
+         fHist = new TH1D("hx", "x", 50, -5, 5);
+         fHist->SetDirectory(0);
+      }
+      ~TSumWorker() { delete fX; delete fN; delete fHist; }
+
+      TWorker *MakeCopy() const { return new TSumWorker; }
+      void Init(TTreeReader &reader) {
+         delete fX;
+         delete fN;
+         fX = new TTreeReaderValue<Float_t>(reader, "x");
+         fN = new TTreeReaderValue<Int_t>(reader, "n");
+      }
+      void Process(Long64_t) {
+         fHist->Fill(**fX);
+         fSum += **fN;
+         ++fCount;
+      }
+      void Merge(TWorker &other) {
+         TSumWorker &o = (TSumWorker&)other;
+         fHist->Add(o.fHist);
+         fSum += o.fSum;
+         fCount += o.fCount;
+      }
+   };
+
+   //______________________________________________________________________________
+   void WriteFile(const char *filename, Int_t seed, Int_t nentries, Int_t compress = 1)
+   {
+      // Write a TTree with small clusters.
+
+      TFile f(filename, "RECREATE", "", compress);
+      TTree tree("T", "processor test tree");
+      tree.SetAutoFlush(1000);
+      Float_t x;
+      Int_t n;
+      tree.Branch("x", &x, "x/F");
+      tree.Branch("n", &n, "n/I");
+      TRandom3 rnd(seed);
+      for (Int_t i = 0; i < nentries; ++i) {
+         x = rnd.Gaus();
+         n = rnd.Poisson(10);
+         tree.Fill();
+      }
+      tree.Write();
+   }
+}
+
+//______________________________________________________________________________
+Bool_t SameResult(TSumWorker &ref, TSumWorker &res)
+{
+   // Compare the results of two workers. The sum of integers does not
+   // depend on the order of the additions.
+
+   if (ref.fCount != res.fCount || ref.fSum != res.fSum) return kFALSE;
+   for (Int_t bin = 0; bin <= ref.fHist->GetNbinsX() + 1; ++bin) {
+      if (ref.fHist->GetBinContent(bin) != res.fHist->GetBinContent(bin)) return kFALSE;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t TestBulkRead(const char *filename)
+{
+   // Read the branches x and n with GetBulkEntries and compare with the
+   // values read entry by entry.
+
+   TFile f(filename);
+   TTree *tree = 0;
+   f.GetObject("T", tree);
+   if (!tree) return kFALSE;
+   Long64_t nentries = tree->GetEntries();
+   std::vector<Float_t> xs(nentries);
+   std::vector<Int_t> ns(nentries);
+   TBranch *bx = tree->GetBranch("x");
+   TBranch *bn = tree->GetBranch("n");
+   Long64_t entry = 0;
+   while (entry < nentries) {
+      Int_t nread = bx->GetBulkEntries(entry, &xs[entry], nentries - entry);
+      if (nread <= 0) return kFALSE;
+      entry += nread;
+   }
+   // Read the second branch in small chunks, not aligned on the baskets.
+   entry = 0;
+   while (entry < nentries) {
+      Int_t nread = bn->GetBulkEntries(entry, &ns[entry], TMath::Min(nentries - entry, (Long64_t)77));
+      if (nread <= 0) return kFALSE;
+      entry += nread;
+   }
+   Float_t x;
+   Int_t n;
+   tree->SetBranchAddress("x", &x);
+   tree->SetBranchAddress("n", &n);
+   for (entry = 0; entry < nentries; ++entry) {
+      tree->GetEntry(entry);
+      if (x != xs[entry] || n != ns[entry]) return kFALSE;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t TestMappedRead(const char *filename)
+{
+   // Read the TTree of filename with and without the option MMAP and
+   // compare the values.
+
+   TFile f(filename);
+   TFile fm(filename, "MMAP");
+   TTree *tree = 0, *treem = 0;
+   f.GetObject("T", tree);
+   fm.GetObject("T", treem);
+   if (!tree || !treem) return kFALSE;
+#ifndef WIN32
+   if (!fm.IsMapped()) return kFALSE;
+#endif
+   Long64_t nentries = tree->GetEntries();
+   if (treem->GetEntries() != nentries) return kFALSE;
+   Float_t x, xm;
+   Int_t n, nm;
+   tree->SetBranchAddress("x", &x);
+   tree->SetBranchAddress("n", &n);
+   treem->SetBranchAddress("x", &xm);
+   treem->SetBranchAddress("n", &nm);
+   for (Long64_t entry = 0; entry < nentries; ++entry) {
+      tree->GetEntry(entry);
+      treem->GetEntry(entry);
+      if (x != xm || n != nm) return kFALSE;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t stressTreeProcessor(Int_t nentries = 100000)
+{
+   PrintBanner("TThreadedTreeProcessor Stress Test");
+
+   WriteFile("stressTreeProcessor_1.root", 1, nentries);
+   WriteFile("stressTreeProcessor_2.root", 2, nentries / 2 + 123);
+
+   TChain chain("T");
+   chain.Add("stressTreeProcessor_1.root");
+   chain.Add("stressTreeProcessor_2.root");
+
+   // Sequential reference
+   TSumWorker ref;
+   TTreeReader reader(&chain);
+   ref.Init(reader);
+   while (reader.Next()) ref.Process(reader.GetCurrentEntry());
+
+   Int_t nfailed = 0;
+
+   // Test1: the ranges cover all the entries and start on a cluster boundary
+   TThreadedTreeProcessor proc(&chain);
+   proc.SetMinRangeSize(2500);
+   const std::vector<TThreadedTreeProcessor::TRange> &ranges = proc.GetRanges();
+   Bool_t ok = !ranges.empty();
+   Long64_t total = 0;
+   for (UInt_t i = 0; ok && i < ranges.size(); ++i) {
+      if (ranges[i].fFirst % 1000 != 0 || ranges[i].fEnd <= ranges[i].fFirst) ok = kFALSE;
+      if (i > 0 && ranges[i].fFile == ranges[i-1].fFile && ranges[i].fFirst != ranges[i-1].fEnd) ok = kFALSE;
+      total += ranges[i].fEnd - ranges[i].fFirst;
+   }
+   if (total != chain.GetEntries()) ok = kFALSE;
+   PrintResult(1, "Ranges are aligned on the clusters and cover the chain", ok);
+   if (!ok) ++nfailed;
+
+   // Test2: one thread
+   TSumWorker res1;
+   proc.SetNThreads(1);
+   ok = proc.Process(res1) == chain.GetEntries() && SameResult(ref, res1);
+   PrintResult(2, "Processing with one thread", ok);
+   if (!ok) ++nfailed;
+
+   // Test3: several threads
+   TSumWorker res4;
+   proc.SetNThreads(4);
+   ok = proc.Process(res4) == chain.GetEntries() && SameResult(ref, res4);
+   PrintResult(3, "Processing with 4 threads", ok);
+   if (!ok) ++nfailed;
+
+   // Test4: column-wise reading
+   ok = TestBulkRead("stressTreeProcessor_1.root");
+   PrintResult(4, "Bulk reading of the branches with GetBulkEntries", ok);
+   if (!ok) ++nfailed;
+
+   // Test5: memory mapped files, with compressed and uncompressed baskets
+   WriteFile("stressTreeProcessor_3.root", 3, nentries / 4, 0);
+   ok = TestMappedRead("stressTreeProcessor_1.root") &&
+        TestMappedRead("stressTreeProcessor_3.root");
+   PrintResult(5, "Reading of memory mapped files", ok);
+   if (!ok) ++nfailed;
+
+   PrintBannerLine();
+
+   gSystem->Unlink("stressTreeProcessor_1.root");
+   gSystem->Unlink("stressTreeProcessor_2.root");
+   gSystem->Unlink("stressTreeProcessor_3.root");
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nentries = 100000;
+   if (argc > 1) nentries = atoi(argv[1]);
+   return stressTreeProcessor(nentries);
+}
@@ -0,0 +1,165 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A test of the advised vector reads of the local files___
+//
+//   A file with a TTree of random values is written, then lists of
+//   blocks at random positions (some closer than the readahead size,
+//   which ReadBuffers merges, some far apart) are read with
+//   TFile::ReadBuffers, without and with the advice of all the reads
+//   to the kernel (TFile::SetAsyncVectorReads). The bytes read, and
+//   the number of bytes accounted by the file, are compared with the
+//   ones of single ReadBuffer calls. The time taken by each path is
+//   reported; on platforms other than Linux both paths read the blocks
+//   without advice.
+//
+//   To run in batch mode, do
+//     stressVectorRead
+//     stressVectorRead 200
+//   Here the parameter is the number of lists of blocks read by each
+//   path. The default value is 100.
+//
+//   An example of output:
+// ******************************************************************
+// *  Starting  Vector Read Test                                    *
+// ******************************************************************
+// Read 100 lists of 300 blocks (983.0 MB): plain x.xx s, advised x.xx s
+// Test1: Blocks read without advice ------------------------------ OK
+// Test2: Blocks read with the advice of all the reads ------------ OK
+// Test3: Bytes accounted by the advised reads -------------------- OK
+// ******************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "stressCommon.h"
+
+namespace {
+   const Int_t kNBlocks = 300;   // number of blocks of each list
+
+   //______________________________________________________________________________
+   void WriteFile(const char *filename)
+   {
+      // A TTree of 20 branches of random doubles, about 60 MB.
+
+      TFile f(filename, "RECREATE");
+      TTree tree("T", "random values");
+      Double_t x[20];
+      for (Int_t i = 0; i < 20; ++i) tree.Branch(TString::Format("x%d", i), &x[i], 4000);
+      TRandom3 rndm(4357);
+      for (Int_t ientry = 0; ientry < 400000; ++ientry) {
+         for (Int_t i = 0; i < 20; ++i) x[i] = rndm.Rndm();
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   //______________________________________________________________________________
+   Long64_t MakeBlocks(TRandom3 &rndm, Long64_t end, std::vector<Long64_t> &pos, std::vector<Int_t> &len)
+   {
+      // Sorted blocks of 1 to 64 kB, separated by gaps of 0 to 4 kB or
+      // 0 to 512 kB.
+      // Returns the total number of bytes of the blocks.
+
+      pos.clear();
+      len.clear();
+      Long64_t cur = 0, total = 0;
+      while ((Int_t)pos.size() < kNBlocks) {
+         cur += (rndm.Rndm() < 0.5) ? rndm.Integer(4096) : rndm.Integer(1 << 19);
+         Int_t n = 1 + rndm.Integer(1 << 16);
+         if (cur + n > end) break;
+         pos.push_back(cur);
+         len.push_back(n);
+         total += n;
+         cur += n;
+      }
+      return total;
+   }
+}
+
+//______________________________________________________________________________
+Int_t stressVectorRead(Int_t nlists = 100)
+{
+   PrintBanner("Vector Read Test");
+
+   const char *filename = "stressVectorRead.root";
+   WriteFile(filename);
+   TFile *f = TFile::Open(filename);
+   if (!f || f->IsZombie()) {
+      printf("cannot open %s\n", filename);
+      return 1;
+   }
+
+   TRandom3 rndm(65539);
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   Bool_t okSync = kTRUE, okAsync = kTRUE, okBytes = kTRUE;
+   Double_t tsync = 0, tasync = 0, mbytes = 0;
+   Int_t nblocks = 0;
+   for (Int_t ilist = 0; ilist < nlists; ++ilist) {
+      Long64_t total = MakeBlocks(rndm, f->GetEND(), pos, len);
+      Int_t nbuf = pos.size();
+      nblocks += nbuf;
+      mbytes += total / 1e6;
+
+      // The reference: one ReadBuffer per block
+      std::vector<char> ref(total), sync(total), async(total);
+      Long64_t k = 0;
+      for (Int_t i = 0; i < nbuf; ++i) {
+         f->Seek(pos[i]);
+         f->ReadBuffer(&ref[k], len[i]);
+         k += len[i];
+      }
+
+      TFile::SetAsyncVectorReads(kFALSE);
+      Long64_t before = f->GetBytesRead();
+      TStopwatch timer;
+      if (f->ReadBuffers(&sync[0], &pos[0], &len[0], nbuf)) okSync = kFALSE;
+      timer.Stop();
+      tsync += timer.RealTime();
+      Long64_t bytesSync = f->GetBytesRead() - before;
+
+      TFile::SetAsyncVectorReads(kTRUE);
+      before = f->GetBytesRead();
+      timer.Start();
+      if (f->ReadBuffers(&async[0], &pos[0], &len[0], nbuf)) okAsync = kFALSE;
+      timer.Stop();
+      tasync += timer.RealTime();
+      Long64_t bytesAsync = f->GetBytesRead() - before;
+
+      if (memcmp(&sync[0], &ref[0], total) != 0) okSync = kFALSE;
+      if (memcmp(&async[0], &ref[0], total) != 0) okAsync = kFALSE;
+      if (bytesAsync != bytesSync) okBytes = kFALSE;
+   }
+   TFile::SetAsyncVectorReads(kTRUE);
+   delete f;
+   gSystem->Unlink(filename);
+
+   printf("Read %d lists of %d blocks (%.1f MB): plain %.2f s, advised %.2f s\n",
+          nlists, nlists ? nblocks / nlists : 0, mbytes, tsync, tasync);
+
+   Int_t nfailed = 0;
+   PrintResult(1, "Blocks read without advice", okSync);
+   if (!okSync) ++nfailed;
+   PrintResult(2, "Blocks read with the advice of all the reads", okAsync);
+   if (!okAsync) ++nfailed;
+   PrintResult(3, "Bytes accounted by the advised reads", okBytes);
+   if (!okBytes) ++nfailed;
+   PrintBannerLine();
+   return nfailed;
+}
+
+//______________________________________________________________________________
+int main(int argc, char *argv[])
+{
+   Int_t nlists = 100;
+   if (argc > 1) nlists = atoi(argv[1]);
+   return stressVectorRead(nlists);
+}
@@ -28,6 +28,7 @@
 #pragma link C++ class TMVA::RegressionVariance+;
 #pragma link C++ class TMVA::Tools+;
 #pragma link C++ class TMVA::Reader+;
+#pragma link C++ class TMVA::EvaluationContext+;
 #pragma link C++ class TMVA::GeneticAlgorithm+;
 #pragma link C++ class TMVA::GeneticGenes+;
 #pragma link C++ class TMVA::GeneticPopulation+;
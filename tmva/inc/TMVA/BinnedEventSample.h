@@ -0,0 +1,89 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : BinnedEventSample                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Training events with their input variables replaced by the index of      *
+ *      their quantile bin, for the histogram based decision tree training        *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_BinnedEventSample
+#define ROOT_TMVA_BinnedEventSample
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// BinnedEventSample                                                    //
+//                                                                      //
+// The range of each input variable is divided into bins holding about  //
+// the same number of events (quantile bins, at most one bin per        //
+// distinct value) and the value of each event is replaced by the index //
+// of its bin. The bin indices are stored by column, one per variable.  //
+// A cut between two bins lies between the largest value of the lower   //
+// bin and the smallest value of the upper one, so that an event goes   //
+// to the same side of the cut with its value and with its bin index.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class Event;
+
+   class BinnedEventSample {
+
+   public:
+
+      // bin the variables of the events in at most nBins bins (at most 65536),
+      // the variables are sorted by nThreads threads (0: one per core)
+      BinnedEventSample( const std::vector<const TMVA::Event*>& events, UInt_t nBins, UInt_t nThreads = 1 );
+      ~BinnedEventSample() {}
+
+      UInt_t GetNEvents() const { return fEvents.size(); }
+      UInt_t GetNVars()   const { return fBins.size(); }
+
+      const TMVA::Event* GetEvent( UInt_t iev ) const { return fEvents[iev]; }
+      const std::vector<const TMVA::Event*>& GetEvents() const { return fEvents; }
+
+      // number of bins of the variable ivar
+      UInt_t   GetNBins( UInt_t ivar ) const { return fBinMax[ivar].size(); }
+      // bin indices of the events for the variable ivar
+      const UShort_t* GetBins( UInt_t ivar ) const { return &fBins[ivar][0]; }
+      UShort_t GetBin( UInt_t ivar, UInt_t iev ) const { return fBins[ivar][iev]; }
+
+      // smallest and largest values of the events in the bin ibin
+      Float_t  GetBinMin( UInt_t ivar, UInt_t ibin ) const { return fBinMin[ivar][ibin]; }
+      Float_t  GetBinMax( UInt_t ivar, UInt_t ibin ) const { return fBinMax[ivar][ibin]; }
+
+      // cut separating the bins 0..ibin (values <= cut) from the bins above (values > cut)
+      Float_t  GetCutValue( UInt_t ivar, UInt_t ibin ) const;
+
+   private:
+
+      std::vector<const TMVA::Event*>       fEvents;  // the binned events
+      std::vector< std::vector<UShort_t> >  fBins;    // bin index of each event, per variable
+      std::vector< std::vector<Float_t> >   fBinMin;  // smallest value in each bin, per variable
+      std::vector< std::vector<Float_t> >   fBinMax;  // largest value in each bin, per variable
+   };
+
+} // namespace TMVA
+
+#endif
@@ -68,6 +68,7 @@ class TRandom3;
 namespace TMVA {
 
    class Event;
+   class BinnedEventSample;
 
    class DecisionTree : public BinaryTree {
 
@@ -110,6 +111,9 @@ namespace TMVA {
 //                        DecisionTreeNode *node = NULL);
       UInt_t BuildTree( const EventConstList & eventSample,
                         DecisionTreeNode *node = NULL);
+      // building of a tree from the quantile bins of the variables of the events "rows"
+      // of the binned sample: the cuts are searched on histograms of the bins
+      UInt_t BuildTree( const BinnedEventSample & binned, const std::vector<UInt_t> & rows );
       // determine the way how a node is split (which variable, which cut value)
 
       Double_t TrainNode( const EventConstList & eventSample,  DecisionTreeNode *node ) { return TrainNodeFast( eventSample, node ); }
@@ -197,6 +201,8 @@ namespace TMVA {
       inline void SetMinLinCorrForFisher(Double_t min){fMinLinCorrForFisher = min;}
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
       inline void SetPairNegWeightsInNode(){fPairNegWeightsInNode=kTRUE;}
+      // number of threads filling and scanning the histograms of the binned training (0: one per core)
+      inline void SetNThreads(UInt_t n){fNThreads = n;}
 
    private:
       // utility functions
@@ -207,6 +213,15 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      // histogram based training on a binned sample: node of the rows [begin,end) of fBinnedRows,
+      // hist holds the histograms of the bins of all the variables for these rows
+      void     BuildBinnedNode( const BinnedEventSample & binned, UInt_t begin, UInt_t end,
+                                std::vector<Double_t> & hist, DecisionTreeNode *node );
+      void     FillBinnedHistograms( const BinnedEventSample & binned, UInt_t begin, UInt_t end,
+                                     std::vector<Double_t> & hist ) const;
+      Double_t TrainNodeBinned( const BinnedEventSample & binned, const std::vector<Double_t> & hist,
+                                DecisionTreeNode *node, Int_t & cutBin );
+
       UInt_t    fNvars;          // number of variables used to separate S and B
       Int_t     fNCuts;          // number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
@@ -241,6 +256,14 @@ namespace TMVA {
       Bool_t     fPairNegWeightsInNode;  // randomly pair miscl. ev. with neg. and pos. weights in node and don't boost them
       static const Int_t  fgDebugLevel = 0;     // debug level determining some printout/control plots etc.
       Int_t     fTreeID;        // just an ID number given to the tree.. makes debugging easier as tree knows who he is.
+      UInt_t    fNThreads;      // number of threads used in the binned training
+
+      std::vector<UInt_t>   fBinnedRows;      //! rows of the binned sample, grouped by node during the binned training
+      std::vector<UInt_t>   fBinnedScratch;   //! buffer of the partition of the rows
+      std::vector<Double_t> fBinnedWeight;    //! weight of each row of the binned sample
+      std::vector<Double_t> fBinnedTarget;    //! regression target of each row of the binned sample
+      std::vector<Char_t>   fBinnedIsSignal;  //! rows of the signal class (Char_t rather than Bool_t for performance)
+      std::vector<UInt_t>   fBinnedOffset;    //! first bin of each variable in the histograms
 
       Types::EAnalysisType  fAnalysisType;   // kClassification(=0=false) or kRegression(=1=true)
 
@@ -0,0 +1,109 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : DenseNetwork                                                          *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Layers of a feed-forward network stored as dense weight matrices, for    *
+ *      the back-propagation of batches of events                                 *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_DenseNetwork
+#define ROOT_TMVA_DenseNetwork
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// DenseNetwork                                                         //
+//                                                                      //
+// The synapses between two layers are stored in a matrix with one row  //
+// per neuron of the lower layer (its bias neuron last) and one column  //
+// per neuron of the upper layer, i.e. in the order of the synapses of  //
+// MethodANNBase. The events of a batch go through the network by tiles //
+// of events, each layer being a matrix-matrix product, and the tiles   //
+// are shared among threads. The gradient of a batch is accumulated     //
+// like the error fields of the synapses in the batch mode of the       //
+// MethodMLP back-propagation, and applied with the learning rate of    //
+// each synapse. A copy of the trained network evaluates single events  //
+// for several threads at a time (see EvaluationContext).               //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class DenseNetwork {
+
+   public:
+
+      enum EActivation { kLinear = 0, kSigmoid, kTanh, kRadial };
+
+      // errors of the output neurons for the events of a batch
+      class ErrorFunction {
+      public:
+         virtual ~ErrorFunction() {}
+         // errors of the outputs of the event iev of the batch (called by several threads)
+         virtual void GetErrors( UInt_t iev, const Double_t* outputs, Double_t* errors ) const = 0;
+      };
+
+      // layout: number of neurons of each layer, without the bias neurons
+      DenseNetwork( const std::vector<UInt_t>& layout, EActivation hidden, EActivation output );
+      ~DenseNetwork() {}
+
+      UInt_t GetNLayers()  const { return fLayout.size(); }
+      UInt_t GetNInputs()  const { return fLayout.front(); }
+      UInt_t GetNOutputs() const { return fLayout.back(); }
+      UInt_t GetNWeights() const { return fWeights.size(); }
+
+      // weights and learning rates of the synapses, in the order of the synapses of MethodANNBase
+      std::vector<Double_t>&       GetWeights()             { return fWeights; }
+      const std::vector<Double_t>& GetWeights()       const { return fWeights; }
+      std::vector<Double_t>&       GetLearningRates()       { return fLearnRates; }
+
+      // add the gradient of the errors of nEvents events, whose input values are stored
+      // one event after the other, to the gradient of the batch; each event counts as
+      // nUpdates updates of the synapses. The events are shared by nThreads threads
+      // (0: one per core)
+      void   AccumulateGradient( const Double_t* inputs, UInt_t nEvents, const ErrorFunction& errors,
+                                 UInt_t nUpdates, UInt_t nThreads );
+
+      // move each weight by -learning rate * gradient/updates and reset the gradient
+      void   AdjustWeights();
+
+      // output values of the network for the input values of one event; the values of the
+      // hidden layers are kept in buffer, so that several threads may evaluate the network
+      void   Evaluate( const Double_t* inputs, Double_t* outputs, std::vector<Double_t>& buffer ) const;
+
+   private:
+
+      std::vector<UInt_t>      fLayout;      // number of neurons of the layers, without bias
+      std::vector<UInt_t>      fOffset;      // first weight of the matrix between the layers l and l+1
+      EActivation              fHidden;      // activation of the hidden neurons
+      EActivation              fOutput;      // activation of the output neurons
+      std::vector<Double_t>    fWeights;     // the weight matrices
+      std::vector<Double_t>    fLearnRates;  // learning rate of each weight
+      std::vector<Double_t>    fGradient;    // gradient accumulated since the last adjustment
+      UInt_t                   fNUpdates;    // number of updates accumulated in the gradient
+      std::vector< std::vector<Double_t> > fBlockGradient; // gradients of the thread blocks
+   };
+
+} // namespace TMVA
+
+#endif
@@ -0,0 +1,81 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EvaluationContext                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Buffers of one thread evaluating the methods of a Reader shared with     *
+ *      other threads                                                             *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_EvaluationContext
+#define ROOT_TMVA_EvaluationContext
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EvaluationContext                                                    //
+//                                                                      //
+// The trained methods of a Reader are not modified when they evaluate  //
+// an event through                                                     //
+//    Reader::EvaluateMVA( inputs, methodTag, context )                 //
+// all the values computed for the event (input event, transformed      //
+// events, values of the neurons, ...) being kept in the context. Each  //
+// thread evaluating the methods of the Reader uses its own context,    //
+// which can be kept from one event to the next.                        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+#ifndef ROOT_TMVA_Event
+#include "TMVA/Event.h"
+#endif
+
+namespace TMVA {
+
+   class EvaluationContext {
+
+   public:
+
+      enum { kNBuffers = 2 }; // number of work spaces
+
+      EvaluationContext();
+      ~EvaluationContext() {}
+
+      // the event with the given input values
+      const Event* SetInputs( const std::vector<Float_t>& inputs );
+
+      // the events receiving the variable transformations, one per transformation
+      std::vector<Event>&    GetTransformedEvents()   { return fTransformedEvents; }
+
+      // work space ibuf (< kNBuffers) of the methods
+      std::vector<Double_t>& GetBuffer( UInt_t ibuf ) { return fBuffers[ibuf]; }
+
+   private:
+
+      Event                 fInput;               //! the input values
+      std::vector<Event>    fTransformedEvents;   //! the transformed events
+      std::vector<Double_t> fBuffers[kNBuffers];  //! work space of the methods
+
+      ClassDef(EvaluationContext,0) // Buffers of a thread evaluating the methods of a Reader
+   };
+
+} // namespace TMVA
+
+#endif
@@ -0,0 +1,93 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : FlatForest                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Decision trees of a forest flattened into contiguous arrays, for the     *
+ *      evaluation of blocks of events without following the node pointers      *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_FlatForest
+#define ROOT_TMVA_FlatForest
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// FlatForest                                                           //
+//                                                                      //
+// The nodes of all the trees are stored in arrays (variable index,     //
+// cut value, index of the daughters, leaf value), the two daughters of //
+// a node next to each other and the trees in breadth-first order. An   //
+// event goes from a node to the daughter at index                      //
+//    daughter + ((value > cut) != inverted)                            //
+// and a leaf is its own daughter (its cut is +infinity), so that all   //
+// the events of a block take the same number of steps through a tree  //
+// (its depth) and the loop over the events has no branch. The leaf     //
+// values are the ones returned by DecisionTree::CheckEvent.            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class DecisionTree;
+   class Event;
+
+   class FlatForest {
+
+   public:
+
+      FlatForest();
+      ~FlatForest() {}
+
+      // flatten the trees, with the leaf values of CheckEvent( ev, useYesNoLeaf );
+      // returns false (and an empty forest) if a tree uses Fisher cuts
+      Bool_t Build( const std::vector<DecisionTree*>& forest, Bool_t useYesNoLeaf );
+      void   Clear();
+
+      UInt_t GetNTrees() const { return fRoot.size(); }
+      UInt_t GetNNodes() const { return fSelector.size(); }
+
+      // sum over the trees firstTree, firstTree+step, ... below lastTree of the leaf
+      // values (times treeWeights[itree] if given) of the event
+      Double_t GetSum( const Event* ev, UInt_t firstTree, UInt_t lastTree, UInt_t step = 1,
+                       const Double_t* treeWeights = 0 ) const;
+
+      // same for nEvents events whose nVars variables are stored one event after the
+      // other in values; the sums are added to sums[0..nEvents)
+      void     AddSums( const Float_t* values, UInt_t nEvents, UInt_t nVars,
+                        UInt_t firstTree, UInt_t lastTree, UInt_t step,
+                        const Double_t* treeWeights, Double_t* sums ) const;
+
+   private:
+
+      std::vector<UInt_t>   fSelector;  // variable cut on by the node
+      std::vector<Float_t>  fCut;       // cut value of the node (+infinity for the leaves)
+      std::vector<UInt_t>   fInverted;  // 1 if the events above the cut go left (cut type kFALSE)
+      std::vector<UInt_t>   fDaughter;  // index of the left daughter, the right one follows (the leaf itself for the leaves)
+      std::vector<Double_t> fValue;     // leaf value (0 for the intermediate nodes)
+      std::vector<UInt_t>   fRoot;      // index of the root node of each tree
+      std::vector<UInt_t>   fDepth;     // depth of each tree
+   };
+
+} // namespace TMVA
+
+#endif
@@ -0,0 +1,121 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : KDTree                                                                *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Balanced kd-tree of points stored in contiguous arrays, for the range     *
+ *      searches of PDERS and the nearest neighbour searches of kNN               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_KDTree
+#define ROOT_TMVA_KDTree
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// KDTree                                                               //
+//                                                                      //
+// As in TKDTree, the tree is complete and has no node pointers: the    //
+// daughters of the node i are the nodes 2i+1 and 2i+2, and the leaves  //
+// are the last nodes. Each node splits its points at their median in  //
+// the variable of largest spread, so that all the leaves hold at most //
+// a bucket of points. The points are copied in the order of the        //
+// leaves, those of a node being contiguous (between the boundaries    //
+// fBegin and fEnd of the node), and each node keeps the bounding box  //
+// and the sum of the weights of its points: a search skips the nodes  //
+// whose box is outside the volume (or farther than the current k-th   //
+// neighbour) and takes whole the nodes whose box is inside the volume. //
+//                                                                      //
+// The searches do not change the tree and may be called by several    //
+// threads at a time; the batch search of the nearest neighbours        //
+// shares its events among threads (see ThreadExecutor).                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class KDTree {
+
+   public:
+
+      // a neighbour: squared distance to the query point and index of the point in Build
+      typedef std::pair<Float_t, UInt_t> Neighbour;
+
+      KDTree();
+      ~KDTree() {}
+
+      // store the points whose nVars coordinates are stored one point after the other,
+      // with their weights; the leaves hold at most bucketSize points
+      void     Build( const std::vector<Float_t>& points, UInt_t nVars,
+                      const std::vector<Double_t>& weights, UInt_t bucketSize = 16 );
+      void     Clear();
+
+      UInt_t   GetNPoints() const { return fIndex.size(); }
+      UInt_t   GetNVars()   const { return fNVars; }
+      UInt_t   GetNNodes()  const { return fBegin.size(); }
+
+      // sum of the weights of the points x with lower < x <= upper in all the variables
+      // (the volumes of BinarySearchTree); the indices of the points are added to points
+      Double_t SearchVolume( const Double_t* lower, const Double_t* upper,
+                             std::vector<UInt_t>* points = 0 ) const;
+
+      // same but stops at maxPoints points; returns the number of points found
+      UInt_t   SearchVolumeWithMaxLimit( const Double_t* lower, const Double_t* upper,
+                                         std::vector<UInt_t>* points, UInt_t maxPoints ) const;
+
+      // the k points nearest to x (euclidean distance), sorted by distance, the points
+      // at the same distance by index
+      void     FindNearest( const Float_t* x, UInt_t k, std::vector<Neighbour>& neighbours ) const;
+
+      // same for the nEvents points whose nVars coordinates are stored one point after the
+      // other in x: the neighbour j of the event i is neighbours[i*k+j] (index GetNPoints()
+      // when the tree has less than k points); the events are shared by nThreads threads
+      // (0: one per core)
+      void     FindNearest( const Float_t* x, UInt_t nEvents, UInt_t k,
+                            std::vector<Neighbour>& neighbours, UInt_t nThreads ) const;
+
+   private:
+
+      Bool_t   IsLeaf( UInt_t inode ) const { return inode >= fFirstLeaf; }
+
+      // -1 if the box of the node is outside the volume, 1 if inside, 0 otherwise
+      Int_t    Overlap( UInt_t inode, const Double_t* lower, const Double_t* upper ) const;
+
+      // squared distance between x and the box of the node
+      Float_t  BoxDistance( UInt_t inode, const Float_t* x ) const;
+
+      UInt_t                fNVars;      // number of coordinates of the points
+      UInt_t                fFirstLeaf;  // index of the first leaf
+      std::vector<UInt_t>   fBegin;      // first point of each node
+      std::vector<UInt_t>   fEnd;        // end of the points of each node
+      std::vector<Float_t>  fMin;        // lower corner of the box of each node
+      std::vector<Float_t>  fMax;        // upper corner of the box of each node
+      std::vector<Double_t> fSumW;       // sum of the weights of the points of each node
+      std::vector<Float_t>  fPoints;     // coordinates of the points, in the order of the leaves
+      std::vector<Double_t> fWeights;    // weights of the points
+      std::vector<UInt_t>   fIndex;      // index of the points in Build
+   };
+
+} // namespace TMVA
+
+#endif
@@ -59,6 +59,8 @@
 namespace TMVA {
 
    class SeparationBase;
+   class BinnedEventSample;
+   class FlatForest;
 
    class MethodBDT : public MethodBase {
 
@@ -108,11 +110,18 @@ namespace TMVA {
 
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0);
+      // calculate the MVA values of a block of events with the flattened forest
+      void     GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues );
+      // calculate the MVA value with the flattened forest, for several threads at a time
+      Bool_t   SupportsConcurrentEvaluation() const { return fFlatForest != NULL; }
+      Double_t GetMvaValueConcurrent( const TMVA::Event* const ev, EvaluationContext& context ) const;
 
    private:
       Double_t GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t useNTrees );
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
       void     BoostMonitor(Int_t iTree);
+      // (re)build the flattened copy of the forest used for the evaluation
+      void     BuildFlatForest();
 
    public:
       const std::vector<Float_t>& GetMulticlassValues();
@@ -199,14 +208,20 @@ namespace TMVA {
       void UpdateTargetsRegression( std::vector<const TMVA::Event*>&,Bool_t first=kFALSE);
       Double_t GetGradBoostMVA(const TMVA::Event *e, UInt_t nTrees);
       void GetRandomSubSample();
+      // grow the tree on the training sample (or the bagged subsample), from the binned sample if any
+      UInt_t GrowTree( DecisionTree *dt, Bool_t useSubSample );
       Double_t GetWeightedQuantile(std::vector<std::pair<Double_t, Double_t> > vec, const Double_t quantile, const Double_t SumOfWeights = 0.0);
 
       std::vector<const TMVA::Event*>       fEventSample;     // the training events
       std::vector<const TMVA::Event*>       fValidationSample;// the Validation events
       std::vector<const TMVA::Event*>       fSubSample;       // subsample for bagged grad boost
+      std::vector<UInt_t>                   fEventSampleRows; // rows of the training events in the binned sample
+      std::vector<UInt_t>                   fSubSampleRows;   // rows of the subsample events in the binned sample
+      BinnedEventSample*                    fBinnedSample;    // training events with their variables replaced by quantile bins
       Int_t                           fNTrees;          // number of decision trees requested
       std::vector<DecisionTree*>      fForest;          // the collection of decision trees
       std::vector<double>             fBoostWeights;    // the weights applied in the individual boosts
+      FlatForest*                     fFlatForest;      // the trees flattened for the evaluation (NULL if not available)
       Bool_t                          fRenormByClass;   // individually re-normalize each event class to the original size after boosting
       Double_t                        fSigToBkgFraction;// Signal to Background fraction assumed during training
       TString                         fBoostType;       // string specifying the boost type
@@ -228,6 +243,8 @@ namespace TMVA {
       TString                         fMinNodeSizeS;    // string containing min percentage of training events in node
 
       Int_t                           fNCuts;           // grid used in cut applied in node splitting
+      Bool_t                          fUseHistogramSplits; // search the node splits on quantile bins of the variables computed once for the training
+      UInt_t                          fNThreads;        // number of threads used in the binned training (0: one per core)
       Bool_t                          fUseFisherCuts;   // use multivariate splits using the Fisher criterium
       Double_t                        fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t                          fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
@@ -275,7 +292,7 @@ namespace TMVA {
 
 
       void                             DeterminePreselectionCuts(const std::vector<const TMVA::Event*>& eventSample);
-      Double_t                         ApplyPreselectionCuts(const Event* ev);
+      Double_t                         ApplyPreselectionCuts(const Event* ev) const;
       
       std::vector<Double_t> fLowSigCut;
       std::vector<Double_t> fLowBkgCut;
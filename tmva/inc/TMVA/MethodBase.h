@@ -68,6 +68,9 @@
 #ifndef ROOT_TMVA_TransformationHandler
 #include "TMVA/TransformationHandler.h"
 #endif
+#ifndef ROOT_TMVA_EvaluationContext
+#include "TMVA/EvaluationContext.h"
+#endif
 #ifndef ROOT_TMVA_OptimizeConfigParameters
 #include "TMVA/OptimizeConfigParameters.h"
 #endif
@@ -176,6 +179,16 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // responses of the events whose GetNvar() variables are stored one event after
+      // the other in inputs (no error estimate); the default evaluates them one by one
+      virtual void     GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues );
+
+      // classification response of the (untransformed) event ev computed in the buffers
+      // of the context, without changing the method: several threads may call it at the
+      // same time, each with its own context; only for the methods which support it
+      virtual Bool_t   SupportsConcurrentEvaluation() const { return kFALSE; }
+      virtual Double_t GetMvaValueConcurrent( const TMVA::Event* const ev, EvaluationContext& context ) const;
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
@@ -373,6 +386,7 @@ namespace TMVA {
       UInt_t           GetNEvents      () const { return Data()->GetNEvents(); }
       const Event*     GetEvent        () const;
       const Event*     GetEvent        ( const TMVA::Event* ev ) const;
+      const Event*     GetEvent        ( const TMVA::Event* ev, EvaluationContext& context ) const;
       const Event*     GetEvent        ( Long64_t ievt ) const;
       const Event*     GetEvent        ( Long64_t ievt , Types::ETreeType type ) const;
       const Event*     GetTrainingEvent( Long64_t ievt ) const;
@@ -666,6 +680,11 @@ inline const TMVA::Event* TMVA::MethodBase::GetEvent( const TMVA::Event* ev ) co
    return GetTransformationHandler().Transform(ev);
 }
 
+inline const TMVA::Event* TMVA::MethodBase::GetEvent( const TMVA::Event* ev, EvaluationContext& context ) const 
+{
+   return GetTransformationHandler().Transform(ev, context.GetTransformedEvents());
+}
+
 inline const TMVA::Event* TMVA::MethodBase::GetEvent() const 
 {
    if(fTmpEvent)
@@ -88,6 +88,9 @@ namespace TMVA {
 
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+      // the same, for several threads at a time
+      Bool_t   SupportsConcurrentEvaluation() const { return kTRUE; }
+      Double_t GetMvaValueConcurrent( const TMVA::Event* const ev, EvaluationContext& context ) const;
 
       enum EFisherMethod { kFisher, kMahalanobis };
       EFisherMethod GetFisherMethod( void ) { return fFisherMethod; }
@@ -78,6 +78,7 @@ namespace TMVA
       void Train( void );
 
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+      void     GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues );
       const std::vector<Float_t>& GetRegressionValues();
 
       using MethodBase::ReadWeightsFromStream;
@@ -121,6 +122,9 @@ namespace TMVA
       
       double getLDAValue(const kNN::List &rlist, const kNN::Event &event_knn);
 
+      // classifier response computed from the k-nearest neighbors of the event
+      Double_t getResponse(const kNN::List &rlist, const kNN::Event &event_knn);
+
    private:
 
       // number of events (sumOfWeights)
@@ -141,6 +145,7 @@ namespace TMVA
       Bool_t fUseKernel;      // use polynomial kernel weight function
       Bool_t fUseWeight;      // use weights to count kNN
       Bool_t fUseLDA;         // use local linear discriminat analysis to compute MVA
+      UInt_t fNThreads;       // number of threads searching the neighbors in GetMvaValues (0: one per core)
 
       kNN::EventVec fEvent;   //! (untouched) events used for learning
 
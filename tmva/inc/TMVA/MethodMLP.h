@@ -90,6 +90,8 @@
 
 namespace TMVA {
 
+   class DenseNetwork;
+
    class MethodMLP : public MethodANNBase, public IFitterTarget, public ConvergenceTest {
 
    public:
@@ -120,6 +122,11 @@ namespace TMVA {
 
       bool     HasInverseHessian() { return fCalculateErrors; }
       Double_t GetMvaValue( Double_t* err=0, Double_t* errUpper=0 );
+      // the same (without error) with the dense copy of the network, for several threads at a time
+      Bool_t   SupportsConcurrentEvaluation() const { return fEvaluationNetwork != 0; }
+      Double_t GetMvaValueConcurrent( const TMVA::Event* const ev, EvaluationContext& context ) const;
+
+      void     ReadWeightsFromXML( void* wghtnode );
 
    protected:
 
@@ -172,6 +179,13 @@ namespace TMVA {
       void     UpdateSynapses();
       void     AdjustSynapseWeights();
 
+      // mini-batch backpropagation with dense weight matrices
+      DenseNetwork* CreateDenseNetwork( Bool_t quiet = kFALSE ) const;
+      void     BuildEvaluationNetwork();
+      void     TrainOneEpochDense();
+      void     AccumulateDenseGradient( std::vector<Double_t>& inputs, std::vector<Double_t>& targets,
+                                        std::vector<Double_t>& desired, std::vector<Double_t>& weights );
+
       // faster backpropagation
       void     TrainOneEventFast( Int_t ievt, Float_t*& branchVar, Int_t& type );
 
@@ -219,6 +233,10 @@ namespace TMVA {
       Int_t           fBatchSize;      // batch size, only matters if in batch learning mode
       Int_t           fTestRate;       // test for overtraining performed at each #th epochs
       Bool_t          fEpochMon;       // create and fill epoch-wise monitoring histograms (makes outputfile big!)
+      Bool_t          fUseDenseLayers; // batch mode with the layers as dense weight matrices
+      UInt_t          fNThreads;       // number of threads of the dense batch mode (0: one per core)
+      DenseNetwork*   fDenseNetwork;   // the network as dense weight matrices (only during the training)
+      DenseNetwork*   fEvaluationNetwork; // copy of the trained network for the concurrent evaluation
       
       // genetic algorithm variables
       Int_t           fGA_nsteps;      // GA settings: number of steps
@@ -59,10 +59,13 @@
 #endif
 #endif
 
+class TMutex;
+
 namespace TMVA {
 
    class Volume;
    class Event;
+   class KDTree;
 
    class MethodPDERS : public MethodBase {
 
@@ -97,6 +100,7 @@ namespace TMVA {
 
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+      void     GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues );
 
       // calculate the MVA value
       const std::vector<Float_t>& GetRegressionValues();
@@ -148,6 +152,16 @@ namespace TMVA {
 
       // create binary search trees for signal and background
       void CreateBinarySearchTree( Types::ETreeType type );
+
+      // copy the events of the binary search tree into the kd-tree searched by the volumes
+      void BuildKDTree();
+
+      // sum of weights (number) of the events in the volume, as in BinarySearchTree
+      Double_t SearchVolume( Volume* volume, std::vector<const BinarySearchTreeNode*>* events = 0 ) const;
+      Int_t    SearchVolumeWithMaxLimit( Volume* volume, std::vector<const BinarySearchTreeNode*>* events, Int_t maxPoints ) const;
+
+      // evaluation of blocks of events by several threads
+      class VolumeTask;
       
       // get sample of training events
       void GetSample( const Event &e, std::vector<const BinarySearchTreeNode*>& events, Volume *volume);
@@ -183,6 +197,10 @@ namespace TMVA {
       } fKernelEstimator;
 
       BinarySearchTree*  fBinaryTree;   // binary tree
+      KDTree*            fKDTree;       //! events of the binary tree laid out in arrays, for the searches
+      std::vector<const BinarySearchTreeNode*> fKDNode; //! node of the binary tree of each event of fKDTree
+      UInt_t             fNThreads;     // number of threads evaluating the blocks of events (0: one per core)
+      TMutex*            fMutex;        //! serializes the warnings of the threads
 
       std::vector<Float_t>*   fDelta;         // size of volume
       std::vector<Float_t>*   fShift;         // volume center
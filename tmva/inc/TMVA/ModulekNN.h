@@ -52,6 +52,9 @@
 #ifndef ROOT_TMVA_NodekNN
 #include "TMVA/NodekNN.h"
 #endif
+#ifndef ROOT_TMVA_KDTree
+#include "TMVA/KDTree.h"
+#endif
 
 namespace TMVA {
 
@@ -125,6 +128,11 @@ namespace TMVA {
 
          Bool_t Find(Event event, UInt_t nfind = 100, const std::string &option = "count") const;
          Bool_t Find(UInt_t nfind, const std::string &option) const;
+
+         // nfind nearest neighbours of each of the events whose variables are stored
+         // one event after the other in values, searched by nThreads threads (0: one
+         // per core); the neighbours of the event i are stored in lists[i]
+         Bool_t Find(const VarVec &values, UInt_t nfind, std::vector<List> &lists, UInt_t nThreads) const;
       
          const EventVec& GetEventVec() const;
 
@@ -154,6 +162,9 @@ namespace TMVA {
 
          Node<Event> *fTree;
 
+         KDTree fKDTree;                           // events of positive weight, for the searches by count
+         std::vector<const Node<Event> *> fKDNode; // node of fTree of each event of fKDTree
+
          std::map<Int_t, Double_t> fVarScale;
 
          mutable List  fkNNList;     // latest result from kNN search
@@ -58,11 +58,16 @@
 #ifndef ROOT_TMVA_DataSetManager
 #include "TMVA/DataSetManager.h"
 #endif
+#ifndef ROOT_TMVA_EvaluationContext
+#include "TMVA/EvaluationContext.h"
+#endif
 
 #include <vector>
 #include <map>
 #include <stdexcept>
 
+class TMutex;
+
 namespace TMVA {
 
    class IMethod;
@@ -102,6 +107,16 @@ namespace TMVA {
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
+      // returns the MVA responses of a block of events, whose variables are stored one
+      // event after the other in inputs (no error is computed)
+      void     EvaluateMVA( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues,
+                            const TString& methodTag, Double_t aux = 0 );
+
+      // returns the MVA response for given event, for several threads sharing the Reader,
+      // each one with its own context (no error is computed)
+      Double_t EvaluateMVA( const std::vector<Float_t>& inputs, const TString& methodTag,
+                            EvaluationContext& context, Double_t aux = 0 ) const;
+
       // returns error on MVA response for given event
       // NOTE: must be called AFTER "EvaluateMVA(...)" call !
       Double_t GetMVAError() const { return fMvaEventError; }
@@ -171,6 +186,8 @@ namespace TMVA {
 
       std::vector<Float_t> fTmpEvalVec; // temporary evaluation vector (if user input is v<double>)
 
+      TMutex* fMutex; //! serializes the evaluation of the methods which cannot be evaluated concurrently
+
       mutable MsgLogger* fLogger;   // message logger
       MsgLogger& Log() const { return *fLogger; }
 
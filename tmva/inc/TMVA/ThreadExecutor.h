@@ -0,0 +1,73 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : ThreadExecutor                                                        *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Execution of the blocks of a loop by the threads of the TThreadTeam       *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_ThreadExecutor
+#define ROOT_TMVA_ThreadExecutor
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// ThreadExecutor                                                       //
+//                                                                      //
+// Executes the items [0,n) of a loop by nThreads blocks of contiguous  //
+// items, as the parts of a TThreadTeam job: block 0 in the calling     //
+// thread and the other ones in the threads of the team. The partition  //
+// of the items only depends on n and nThreads, so that results         //
+// combined in the order of the blocks are reproducible.                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class ThreadExecutor {
+
+   public:
+
+      // interface of the loops executed by ThreadExecutor::Run
+      class Task {
+      public:
+         virtual ~Task() {}
+         // process the items [begin,end) of the block iblock
+         virtual void Process( UInt_t iblock, UInt_t begin, UInt_t end ) = 0;
+      };
+
+      // process the items [0,n) of the task by nThreads blocks (0: one per core, never more
+      // blocks than items); returns when all the blocks are done
+      static void   Run( Task& task, UInt_t n, UInt_t nThreads );
+
+      // first item of the block iblock when n items are split in nBlocks blocks
+      static UInt_t BlockBegin( UInt_t iblock, UInt_t n, UInt_t nBlocks ) { return UInt_t( (ULong64_t(n)*iblock)/nBlocks ); }
+
+      // number of cores of the machine
+      static UInt_t GetNCores();
+
+   private:
+
+      ThreadExecutor() {}
+   };
+
+} // namespace TMVA
+
+#endif
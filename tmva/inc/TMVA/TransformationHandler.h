@@ -75,6 +75,9 @@ namespace TMVA {
       TString GetVariableAxisTitle( const VariableInfo& info ) const;
 
       const Event* Transform(const Event*) const;
+      // transformation into the events of the caller (one per transformation), see
+      // VariableTransformBase::TransformInto
+      const Event* Transform(const Event*, std::vector<Event>& output) const;
       const Event* InverseTransform(const Event*, Bool_t suppressIfNoTargets=true  ) const;
 
       // overrides the reference classes of all added transformations. Handle with care!!!
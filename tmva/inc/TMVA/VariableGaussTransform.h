@@ -93,7 +93,7 @@ namespace TMVA {
       void   Initialize();
       Bool_t PrepareTransformation (const std::vector<Event*>&);
 
-      virtual const Event* Transform(const Event* const, Int_t cls ) const;
+      virtual const Event* TransformInto( const Event* const, Event* output, Int_t cls ) const;
       virtual const Event* InverseTransform(const Event* const, Int_t cls ) const;
 
       void WriteTransformationToStream ( std::ostream& ) const;
@@ -58,7 +58,7 @@ namespace TMVA {
       virtual void AttachXMLTo(void* parent);
       virtual void ReadFromXML( void* trfnode );
 
-      virtual const Event* Transform(const Event* const, Int_t cls ) const;
+      virtual const Event* TransformInto( const Event* const, Event* output, Int_t cls ) const;
       virtual const Event* InverseTransform(const Event* const ev, Int_t cls ) const { return Transform( ev, cls ); }
 
       // writer of function code
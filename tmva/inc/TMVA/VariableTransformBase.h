@@ -77,7 +77,11 @@ namespace TMVA {
 
       virtual void         Initialize() = 0;
       virtual Bool_t       PrepareTransformation (const std::vector<Event*>&  ) = 0;
-      virtual const Event* Transform       ( const Event* const, Int_t cls ) const = 0;
+      virtual const Event* Transform       ( const Event* const, Int_t cls ) const;
+      // transformation into the event output of the caller instead of the event of the
+      // transformation: several threads may transform events at the same time. A derived
+      // class must override Transform or TransformInto (the default of each calls the other)
+      virtual const Event* TransformInto   ( const Event* const, Event* output, Int_t cls ) const;
       virtual const Event* InverseTransform( const Event* const, Int_t cls ) const = 0;
 
       // accessors
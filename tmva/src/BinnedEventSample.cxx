@@ -0,0 +1,107 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : BinnedEventSample                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include <algorithm>
+
+#include "TMVA/BinnedEventSample.h"
+#include "TMVA/Event.h"
+#include "TMVA/ThreadExecutor.h"
+
+namespace {
+
+   // bins the variables [begin,end) of the events
+   class VariableBinner : public TMVA::ThreadExecutor::Task {
+   public:
+      VariableBinner( const std::vector<const TMVA::Event*>& events, UInt_t nBins,
+                      std::vector< std::vector<UShort_t> >& bins,
+                      std::vector< std::vector<Float_t> >& binMin,
+                      std::vector< std::vector<Float_t> >& binMax ) :
+         fEvents(events), fNBins(nBins), fBins(bins), fBinMin(binMin), fBinMax(binMax) {}
+
+      void Process( UInt_t /* iblock */, UInt_t begin, UInt_t end )
+      {
+         const UInt_t nevents = fEvents.size();
+         std::vector<Float_t> sorted( nevents );
+         for (UInt_t ivar=begin; ivar<end; ivar++) {
+            for (UInt_t iev=0; iev<nevents; iev++) sorted[iev] = fEvents[iev]->GetValue(ivar);
+            std::sort( sorted.begin(), sorted.end() );
+
+            // every bin takes its share of the remaining events, and all the events
+            // with the value of its last event (hence no more than fNBins bins)
+            std::vector<Float_t>& bmin = fBinMin[ivar];
+            std::vector<Float_t>& bmax = fBinMax[ivar];
+            UInt_t first = 0;
+            while (first < nevents) {
+               UInt_t nLeft = fNBins - bmax.size();
+               UInt_t last  = first + (nevents - first + nLeft - 1)/nLeft;
+               while (last < nevents && sorted[last] == sorted[last-1]) last++;
+               bmin.push_back( sorted[first] );
+               bmax.push_back( sorted[last-1] );
+               first = last;
+            }
+
+            // the bin of a value is the first one whose largest value is not below it
+            std::vector<UShort_t>& bins = fBins[ivar];
+            bins.resize( nevents );
+            for (UInt_t iev=0; iev<nevents; iev++) {
+               bins[iev] = UShort_t( std::lower_bound( bmax.begin(), bmax.end(), fEvents[iev]->GetValue(ivar) ) - bmax.begin() );
+            }
+         }
+      }
+
+   private:
+      const std::vector<const TMVA::Event*>& fEvents;
+      UInt_t                                 fNBins;
+      std::vector< std::vector<UShort_t> >&  fBins;
+      std::vector< std::vector<Float_t> >&   fBinMin;
+      std::vector< std::vector<Float_t> >&   fBinMax;
+   };
+
+}
+
+//_______________________________________________________________________
+TMVA::BinnedEventSample::BinnedEventSample( const std::vector<const TMVA::Event*>& events, UInt_t nBins, UInt_t nThreads ) :
+   fEvents( events )
+{
+   // compute the quantile bins of each variable and the bin indices of the events
+   if (nBins < 1)     nBins = 1;
+   if (nBins > 65536) nBins = 65536;
+   UInt_t nvars = events.empty() ? 0 : events[0]->GetNVariables();
+   fBins.resize( nvars );
+   fBinMin.resize( nvars );
+   fBinMax.resize( nvars );
+
+   VariableBinner binner( fEvents, nBins, fBins, fBinMin, fBinMax );
+   TMVA::ThreadExecutor::Run( binner, nvars, nThreads );
+}
+
+//_______________________________________________________________________
+Float_t TMVA::BinnedEventSample::GetCutValue( UInt_t ivar, UInt_t ibin ) const
+{
+   // the middle between the bins ibin and ibin+1, or the largest value of ibin if the
+   // middle rounds to the smallest value of ibin+1 (no float between them)
+   const Float_t lo = fBinMax[ivar][ibin];
+   if (ibin+1 >= fBinMin[ivar].size()) return lo;
+   const Float_t hi  = fBinMin[ivar][ibin+1];
+   const Float_t cut = lo + (hi-lo)/2;
+   return (cut < hi) ? cut : lo;
+}
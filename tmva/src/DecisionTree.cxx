@@ -83,6 +83,8 @@
 #include "TMVA/IPruneTool.h"
 #include "TMVA/CostComplexityPruneTool.h"
 #include "TMVA/ExpectedErrorPruneTool.h"
+#include "TMVA/BinnedEventSample.h"
+#include "TMVA/ThreadExecutor.h"
 
 const Int_t TMVA::DecisionTree::fgRandomSeed = 0; // set nonzero for debugging and zero for random seeds
 
@@ -115,6 +117,7 @@ TMVA::DecisionTree::DecisionTree():
    fSigClass       (0),
    fPairNegWeightsInNode(kFALSE),
    fTreeID         (0),
+   fNThreads       (1),
    fAnalysisType   (Types::kClassification)
 {
    // default constructor using the GiniIndex as separation criterion,
@@ -149,7 +152,8 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fMaxDepth       (nMaxDepth),
    fSigClass       (cls),
    fPairNegWeightsInNode(kFALSE),
-   fTreeID         (treeID)
+   fTreeID         (treeID),
+   fNThreads       (1)
 {
    // constructor specifying the separation type, the min number of
    // events in a no that is still subjected to further splitting, the
@@ -199,6 +203,7 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fSigClass   (d.fSigClass),
    fPairNegWeightsInNode(d.fPairNegWeightsInNode),
    fTreeID     (d.fTreeID),
+   fNThreads   (d.fNThreads),
    fAnalysisType(d.fAnalysisType)
 {
    // copy constructor that creates a true copy, i.e. a completely independent tree
@@ -530,6 +535,399 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
    return fNNodes;
 }
 
+//_______________________________________________________________________
+//
+// histogram based training on a BinnedEventSample
+//
+// Each node keeps, for every variable, a histogram of its bins with the
+// sums of the signal and background weights and entries and of the
+// weighted regression targets. The cut scan of a node runs over these
+// histograms only. When a node is split, the histograms of the daughter
+// with fewer events are filled from its events and the ones of the other
+// daughter are obtained by subtracting them from the histograms of the
+// mother. The histograms are filled and scanned per variable in threads.
+//_______________________________________________________________________
+
+namespace {
+
+   // content of a bin of the histograms of the binned training
+   enum EBinStat { kSigW = 0, kBkgW, kSigN, kBkgN, kTarget, kTarget2, kNBinStats };
+
+   // fills the histograms of the variables [begin,end) with the rows of a node
+   class BinnedHistogramFiller : public TMVA::ThreadExecutor::Task {
+   public:
+      BinnedHistogramFiller( const TMVA::BinnedEventSample& binned, const UInt_t* rows, UInt_t nrows,
+                             const Double_t* weight, const Double_t* target, const Char_t* isSignal,
+                             const UInt_t* offset, Bool_t doRegression, Double_t* hist ) :
+         fBinned(binned), fRows(rows), fNRows(nrows), fWeight(weight), fTarget(target), fIsSignal(isSignal),
+         fOffset(offset), fDoRegression(doRegression), fHist(hist) {}
+
+      void Process( UInt_t /* iblock */, UInt_t begin, UInt_t end )
+      {
+         for (UInt_t ivar=begin; ivar<end; ivar++) {
+            const UShort_t* bins = fBinned.GetBins(ivar);
+            Double_t* h = fHist + fOffset[ivar]*kNBinStats;
+            for (UInt_t i=0; i<fNRows; i++) {
+               const UInt_t row = fRows[i];
+               const Double_t w = fWeight[row];
+               Double_t* hb = h + bins[row]*kNBinStats;
+               if (fIsSignal[row]) { hb[kSigW] += w; hb[kSigN]++; }
+               else                { hb[kBkgW] += w; hb[kBkgN]++; }
+               if (fDoRegression) {
+                  hb[kTarget]  += w*fTarget[row];
+                  hb[kTarget2] += w*fTarget[row]*fTarget[row];
+               }
+            }
+         }
+      }
+
+   private:
+      const TMVA::BinnedEventSample& fBinned;
+      const UInt_t*   fRows;
+      UInt_t          fNRows;
+      const Double_t* fWeight;
+      const Double_t* fTarget;
+      const Char_t*   fIsSignal;
+      const UInt_t*   fOffset;
+      Bool_t          fDoRegression;
+      Double_t*       fHist;
+   };
+
+   // finds the best cut of each of the variables [begin,end) on their histograms
+   class BinnedSplitScanner : public TMVA::ThreadExecutor::Task {
+   public:
+      BinnedSplitScanner( const Double_t* hist, const UInt_t* offset, const Bool_t* useVariable,
+                          TMVA::SeparationBase* sepType, TMVA::RegressionVariance* regType,
+                          Double_t minSize, Double_t* gain, Int_t* cutBin ) :
+         fHist(hist), fOffset(offset), fUseVariable(useVariable), fSepType(sepType), fRegType(regType),
+         fMinSize(minSize), fGain(gain), fCutBin(cutBin) {}
+
+      void Process( UInt_t /* iblock */, UInt_t begin, UInt_t end )
+      {
+         for (UInt_t ivar=begin; ivar<end; ivar++) {
+            fGain[ivar]   = -1;
+            fCutBin[ivar] = -1;
+            if (!fUseVariable[ivar]) continue;
+            const UInt_t nBins = fOffset[ivar+1] - fOffset[ivar];
+            const Double_t* h = fHist + fOffset[ivar]*kNBinStats;
+
+            // totals of the node
+            Double_t tot[kNBinStats] = { 0, 0, 0, 0, 0, 0 };
+            for (UInt_t ibin=0; ibin<nBins; ibin++) {
+               for (Int_t k=0; k<kNBinStats; k++) tot[k] += h[ibin*kNBinStats+k];
+            }
+
+            // as in TrainNodeFast, the cumulated bins 0..ibin go to one daughter and
+            // the rest to the other one; the last bin contains all the events
+            Double_t sel[kNBinStats] = { 0, 0, 0, 0, 0, 0 };
+            for (UInt_t ibin=0; ibin+1<nBins; ibin++) {
+               for (Int_t k=0; k<kNBinStats; k++) sel[k] += h[ibin*kNBinStats+k];
+               const Double_t sl = sel[kSigN], bl = sel[kBkgN];
+               const Double_t sr = tot[kSigN]-sl, br = tot[kBkgN]-bl;
+               const Double_t slW = sel[kSigW], blW = sel[kBkgW];
+               const Double_t srW = tot[kSigW]-slW, brW = tot[kBkgW]-blW;
+               if ( ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+                    && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize) ) {
+                  Double_t sepTmp;
+                  if (fRegType != 0) {
+                     sepTmp = fRegType->GetSeparationGain(slW+blW, sel[kTarget], sel[kTarget2],
+                                                          tot[kSigW]+tot[kBkgW], tot[kTarget], tot[kTarget2]);
+                  } else {
+                     sepTmp = fSepType->GetSeparationGain(slW, blW, tot[kSigW], tot[kBkgW]);
+                  }
+                  if (fGain[ivar] < sepTmp) {
+                     fGain[ivar]   = sepTmp;
+                     fCutBin[ivar] = ibin;
+                  }
+               }
+            }
+         }
+      }
+
+   private:
+      const Double_t*           fHist;
+      const UInt_t*             fOffset;
+      const Bool_t*             fUseVariable;
+      TMVA::SeparationBase*     fSepType;
+      TMVA::RegressionVariance* fRegType;
+      Double_t                  fMinSize;
+      Double_t*                 fGain;
+      Int_t*                    fCutBin;
+   };
+
+}
+
+//_______________________________________________________________________
+UInt_t TMVA::DecisionTree::BuildTree( const BinnedEventSample & binned, const std::vector<UInt_t> & rows )
+{
+   // build the tree from the events "rows" of the binned sample; the splits are the
+   // same as the ones TrainNodeFast would find on a grid made of the quantile bins,
+   // the Fisher cuts and the pairing of negative weights in the nodes are not supported
+
+   if (rows.empty()) Log() << kFATAL << ":<BuildTree> eventsample Size == 0 " << Endl;
+   if (fUseFisherCuts || fPairNegWeightsInNode) {
+      Log() << kFATAL << "<BuildTree> the binned training does not support the Fisher cuts "
+            << "nor the pairing of negative weights in the nodes" << Endl;
+   }
+
+   DecisionTreeNode* node = new TMVA::DecisionTreeNode();
+   fNNodes = 1;
+   this->SetRoot(node);
+   this->GetRoot()->SetPos('s');
+   this->GetRoot()->SetDepth(0);
+   this->GetRoot()->SetParentTree(this);
+   fMinSize = fMinNodeSize/100. * rows.size();
+
+   fNvars = binned.GetNVars();
+   fVariableImportance.resize(fNvars);
+
+   // the weights change from one tree to the next (boosting): take them once per tree
+   const UInt_t nrows = binned.GetNEvents();
+   fBinnedWeight.assign(nrows, 0);
+   fBinnedTarget.assign(nrows, 0);
+   fBinnedIsSignal.assign(nrows, 0);
+   for (UInt_t i=0; i<rows.size(); i++) {
+      const Event* evt = binned.GetEvent(rows[i]);
+      fBinnedWeight[rows[i]]   = evt->GetWeight();
+      fBinnedIsSignal[rows[i]] = (evt->GetClass() == fSigClass);
+      if (DoRegression()) fBinnedTarget[rows[i]] = evt->GetTarget(0);
+   }
+   fBinnedOffset.resize(fNvars+1);
+   fBinnedOffset[0] = 0;
+   for (UInt_t ivar=0; ivar<fNvars; ivar++) fBinnedOffset[ivar+1] = fBinnedOffset[ivar] + binned.GetNBins(ivar);
+   fBinnedRows = rows;
+   fBinnedScratch.resize(rows.size());
+
+   std::vector<Double_t> hist(fBinnedOffset[fNvars]*kNBinStats, 0.);
+   FillBinnedHistograms(binned, 0, rows.size(), hist);
+   BuildBinnedNode(binned, 0, rows.size(), hist, node);
+
+   fBinnedRows.clear();    fBinnedScratch.clear();
+   fBinnedWeight.clear();  fBinnedTarget.clear();  fBinnedIsSignal.clear();
+   return fNNodes;
+}
+
+//_______________________________________________________________________
+void TMVA::DecisionTree::FillBinnedHistograms( const BinnedEventSample & binned, UInt_t begin, UInt_t end,
+                                               std::vector<Double_t> & hist ) const
+{
+   // fill the histograms of all the variables with the rows [begin,end) of fBinnedRows
+   BinnedHistogramFiller filler(binned, &fBinnedRows[0]+begin, end-begin,
+                                &fBinnedWeight[0], &fBinnedTarget[0], &fBinnedIsSignal[0],
+                                &fBinnedOffset[0], DoRegression(), &hist[0]);
+   ThreadExecutor::Run(filler, fNvars, fNThreads);
+}
+
+//_______________________________________________________________________
+void TMVA::DecisionTree::BuildBinnedNode( const BinnedEventSample & binned, UInt_t begin, UInt_t end,
+                                          std::vector<Double_t> & hist, TMVA::DecisionTreeNode *node )
+{
+   // equivalent of BuildTree for the node of the rows [begin,end) of fBinnedRows,
+   // whose bins are already histogrammed in hist (which is reused for a daughter)
+
+   const UInt_t nevents = end-begin;
+   Double_t s=0, b=0;
+   Double_t suw=0, buw=0;
+   Double_t sub=0, bub=0; // unboosted!
+   Double_t target=0, target2=0;
+   for (UInt_t i=begin; i<end; i++) {
+      const UInt_t row = fBinnedRows[i];
+      const Double_t weight = fBinnedWeight[row];
+      const Double_t orgWeight = binned.GetEvent(row)->GetOriginalWeight();
+      if (fBinnedIsSignal[row]) { s += weight; suw += 1; sub += orgWeight; }
+      else                      { b += weight; buw += 1; bub += orgWeight; }
+      if (DoRegression()) {
+         target +=weight*fBinnedTarget[row];
+         target2+=weight*fBinnedTarget[row]*fBinnedTarget[row];
+      }
+   }
+
+   node->SetNSigEvents(s);
+   node->SetNBkgEvents(b);
+   node->SetNSigEvents_unweighted(suw);
+   node->SetNBkgEvents_unweighted(buw);
+   node->SetNSigEvents_unboosted(sub);
+   node->SetNBkgEvents_unboosted(bub);
+   node->SetPurity();
+   if (node == this->GetRoot()) {
+      node->SetNEvents(s+b);
+      node->SetNEvents_unweighted(suw+buw);
+      node->SetNEvents_unboosted(sub+bub);
+   }
+   // the range of the node is the one of its first and last non empty bins
+   for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+      const Double_t* h = &hist[fBinnedOffset[ivar]*kNBinStats];
+      const UInt_t nBins = binned.GetNBins(ivar);
+      UInt_t first = 0, last = nBins-1;
+      while (first < last && h[first*kNBinStats+kSigN]+h[first*kNBinStats+kBkgN] == 0) first++;
+      while (last > first && h[last*kNBinStats+kSigN]+h[last*kNBinStats+kBkgN] == 0) last--;
+      node->SetSampleMin(ivar, binned.GetBinMin(ivar, first));
+      node->SetSampleMax(ivar, binned.GetBinMax(ivar, last));
+   }
+
+   Double_t separationGain = 0;
+   Int_t cutBin = -1;
+   if ((nevents >= 2*fMinSize  && s+b >= 2*fMinSize) && fNNodes < fNNodesMax && node->GetDepth() < fMaxDepth
+       && ( ( s!=0 && b !=0 && !DoRegression()) || ( (s+b)!=0 && DoRegression()) ) ) {
+      separationGain = this->TrainNodeBinned(binned, hist, node, cutBin);
+   }
+
+   if (cutBin < 0 || separationGain < std::numeric_limits<double>::epsilon()) { // it is a leaf node
+      if (DoRegression()) {
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(s+b,target,target2));
+         node->SetResponse(target/(s+b));
+         node->SetRMS(TMath::Sqrt(target2/(s+b) - target/(s+b)*target/(s+b)));
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(s,b));
+      }
+      if (node->GetPurity() > fNodePurityLimit) node->SetNodeType(1);
+      else node->SetNodeType(-1);
+      if (node->GetDepth() > this->GetTotalTreeDepth()) this->SetTotalTreeDepth(node->GetDepth());
+      return;
+   }
+
+   // stable partition of the rows: left daughter first, right daughter after
+   const UShort_t* bins = binned.GetBins(node->GetSelector());
+   const Bool_t cutType = node->GetCutType();
+   UInt_t nLeftRows = 0, nRightRows = 0;
+   Double_t nRight=0, nLeft=0;
+   Double_t nRightUnBoosted=0, nLeftUnBoosted=0;
+   for (UInt_t i=begin; i<end; i++) {
+      const UInt_t row = fBinnedRows[i];
+      // same as DecisionTreeNode::GoesRight: value > cut <=> bin > cutBin
+      const Bool_t goesRight = ( (bins[row] > cutBin) == cutType );
+      if (goesRight) {
+         fBinnedScratch[nRightRows++] = row;
+         nRight += fBinnedWeight[row];
+         nRightUnBoosted += binned.GetEvent(row)->GetOriginalWeight();
+      }
+      else {
+         fBinnedRows[begin + nLeftRows++] = row;
+         nLeft += fBinnedWeight[row];
+         nLeftUnBoosted += binned.GetEvent(row)->GetOriginalWeight();
+      }
+   }
+   std::copy(fBinnedScratch.begin(), fBinnedScratch.begin()+nRightRows, fBinnedRows.begin()+begin+nLeftRows);
+
+   if (nLeftRows == 0 || nRightRows == 0) {
+      Log() << kFATAL << "<TrainNode> all events went to the same branch" << Endl
+            << "---                         left:" << nLeftRows
+            << " right:" << nRightRows << Endl;
+   }
+
+   TMVA::DecisionTreeNode *rightNode = new TMVA::DecisionTreeNode(node,'r');
+   fNNodes++;
+   rightNode->SetNEvents(nRight);
+   rightNode->SetNEvents_unboosted(nRightUnBoosted);
+   rightNode->SetNEvents_unweighted(nRightRows);
+
+   TMVA::DecisionTreeNode *leftNode = new TMVA::DecisionTreeNode(node,'l');
+   fNNodes++;
+   leftNode->SetNEvents(nLeft);
+   leftNode->SetNEvents_unboosted(nLeftUnBoosted);
+   leftNode->SetNEvents_unweighted(nLeftRows);
+
+   node->SetNodeType(0);
+   node->SetLeft(leftNode);
+   node->SetRight(rightNode);
+
+   // histograms of the smaller daughter from its rows, of the larger one by subtraction
+   const UInt_t leftBegin = begin, rightBegin = begin+nLeftRows;
+   std::vector<Double_t> small(hist.size(), 0.);
+   if (nLeftRows < nRightRows) FillBinnedHistograms(binned, leftBegin, rightBegin, small);
+   else                        FillBinnedHistograms(binned, rightBegin, end, small);
+   for (UInt_t i=0; i<hist.size(); i++) hist[i] -= small[i];
+
+   // the right daughter first, as in BuildTree
+   if (nLeftRows < nRightRows) {
+      this->BuildBinnedNode(binned, rightBegin, end, hist, rightNode);
+      this->BuildBinnedNode(binned, leftBegin, rightBegin, small, leftNode);
+   } else {
+      this->BuildBinnedNode(binned, rightBegin, end, small, rightNode);
+      this->BuildBinnedNode(binned, leftBegin, rightBegin, hist, leftNode);
+   }
+}
+
+//_______________________________________________________________________
+Double_t TMVA::DecisionTree::TrainNodeBinned( const BinnedEventSample & binned, const std::vector<Double_t> & hist,
+                                              TMVA::DecisionTreeNode *node, Int_t & cutBin )
+{
+   // equivalent of TrainNodeFast on the histograms of the bins of the node: the candidate
+   // cuts are the boundaries between the bins, the variables are scanned in threads
+
+   Bool_t *useVariable = new Bool_t[fNvars+1];
+   UInt_t *mapVariable = new UInt_t[fNvars+1];
+   if (fRandomisedTree) {
+      UInt_t tmp=fUseNvars;
+      GetRandomisedVariables(useVariable,mapVariable,tmp);
+   }
+   else {
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+         useVariable[ivar] = kTRUE;
+         mapVariable[ivar] = ivar;
+      }
+   }
+
+   std::vector<Double_t> separationGain(fNvars);
+   std::vector<Int_t>    varCutBin(fNvars);
+   BinnedSplitScanner scanner(&hist[0], &fBinnedOffset[0], useVariable, fSepType,
+                              DoRegression() ? fRegType : 0, fMinSize,
+                              &separationGain[0], &varCutBin[0]);
+   ThreadExecutor::Run(scanner, fNvars, fNThreads);
+
+   // combine the variables in their order, as the serial scan of TrainNodeFast does
+   Double_t separationGainTotal = -1;
+   Int_t mxVar = -1;
+   cutBin = -1;
+   for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+      if (varCutBin[ivar] >= 0 && separationGainTotal < separationGain[ivar]) {
+         separationGainTotal = separationGain[ivar];
+         mxVar  = ivar;
+         cutBin = varCutBin[ivar];
+      }
+   }
+
+   // the node totals are the same for all the variables, take them from the first one
+   Double_t tot[kNBinStats] = { 0, 0, 0, 0, 0, 0 };
+   for (UInt_t ibin=0; ibin<binned.GetNBins(0); ibin++) {
+      for (Int_t k=0; k<kNBinStats; k++) tot[k] += hist[ibin*kNBinStats+k];
+   }
+   const Double_t nTotS = tot[kSigW], nTotB = tot[kBkgW];
+
+   if (DoRegression()) {
+      node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,tot[kTarget],tot[kTarget2]));
+      node->SetResponse(tot[kTarget]/(nTotS+nTotB));
+      node->SetRMS(TMath::Sqrt(tot[kTarget2]/(nTotS+nTotB) - tot[kTarget]/(nTotS+nTotB)*tot[kTarget]/(nTotS+nTotB)));
+   }
+   else {
+      node->SetSeparationIndex(fSepType->GetSeparationIndex(nTotS,nTotB));
+   }
+
+   if (mxVar >= 0) {
+      Double_t nSelS = 0, nSelB = 0;
+      const Double_t* h = &hist[fBinnedOffset[mxVar]*kNBinStats];
+      for (Int_t ibin=0; ibin<=cutBin; ibin++) {
+         nSelS += h[ibin*kNBinStats+kSigW];
+         nSelB += h[ibin*kNBinStats+kBkgW];
+      }
+      node->SetSelector((UInt_t)mxVar);
+      node->SetCutValue(binned.GetCutValue(mxVar, cutBin));
+      node->SetCutType(nSelS/nTotS > nSelB/nTotB);
+      node->SetSeparationGain(separationGainTotal);
+      node->SetNFisherCoeff(0);
+      fVariableImportance[mxVar] += separationGainTotal*separationGainTotal * (nTotS+nTotB) * (nTotS+nTotB) ;
+   }
+   else {
+      separationGainTotal = 0;
+   }
+
+   delete [] useVariable;
+   delete [] mapVariable;
+
+   return separationGainTotal;
+}
+
 //_______________________________________________________________________
 void TMVA::DecisionTree::FillTree( const std::vector<TMVA::Event*> & eventSample )
   
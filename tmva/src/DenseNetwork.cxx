@@ -0,0 +1,278 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : DenseNetwork                                                          *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include <cmath>
+
+#include "TMVA/DenseNetwork.h"
+#include "TMVA/ThreadExecutor.h"
+
+namespace {
+
+   // number of events going together through the layers
+   const UInt_t kTileSize  = 32;
+   // number of rows of the right matrix kept in cache by the matrix products
+   const UInt_t kBlockSize = 64;
+
+   Double_t Activation( TMVA::DenseNetwork::EActivation type, Double_t x )
+   {
+      // the activation functions of TActivationIdentity, Sigmoid, Tanh and Radial
+      switch (type) {
+      case TMVA::DenseNetwork::kSigmoid: return 1.0/(1.0+std::exp(-x));
+      case TMVA::DenseNetwork::kTanh:    return std::tanh(x);
+      case TMVA::DenseNetwork::kRadial:  return std::exp(-x*x/2.0);
+      default:                           return x;
+      }
+   }
+
+   Double_t Derivative( TMVA::DenseNetwork::EActivation type, Double_t x, Double_t y )
+   {
+      // derivative of the activation function at x, y being its value
+      switch (type) {
+      case TMVA::DenseNetwork::kSigmoid: return y*(1.0-y);
+      case TMVA::DenseNetwork::kTanh:    return 1.0-y*y;
+      case TMVA::DenseNetwork::kRadial:  return -x*y;
+      default:                           return 1.0;
+      }
+   }
+
+   void Multiply( UInt_t m, UInt_t n, UInt_t k, const Double_t* a, UInt_t lda,
+                  const Double_t* b, UInt_t ldb, Double_t* c, UInt_t ldc )
+   {
+      // c(m x n) = a(m x k) b(k x n); the rows of c are sums of rows of b, taken by
+      // blocks of kBlockSize rows which stay in cache for all the rows of a
+      for (UInt_t i=0; i<m; i++) for (UInt_t j=0; j<n; j++) c[i*ldc+j] = 0;
+      for (UInt_t p0=0; p0<k; p0+=kBlockSize) {
+         const UInt_t p1 = (k-p0 < kBlockSize) ? k : p0+kBlockSize;
+         for (UInt_t i=0; i<m; i++) {
+            Double_t* ci = c + i*ldc;
+            for (UInt_t p=p0; p<p1; p++) {
+               const Double_t  aip = a[i*lda+p];
+               const Double_t* bp  = b + p*ldb;
+               for (UInt_t j=0; j<n; j++) ci[j] += aip*bp[j];
+            }
+         }
+      }
+   }
+
+   void MultiplyTransposed( UInt_t m, UInt_t n, UInt_t k, const Double_t* a, UInt_t lda,
+                            const Double_t* b, UInt_t ldb, Double_t* c, UInt_t ldc )
+   {
+      // c(m x n) = a(m x k) b^T, b being n x k
+      for (UInt_t i=0; i<m; i++) {
+         const Double_t* ai = a + i*lda;
+         for (UInt_t j=0; j<n; j++) {
+            const Double_t* bj = b + j*ldb;
+            Double_t sum = 0;
+            for (UInt_t p=0; p<k; p++) sum += ai[p]*bj[p];
+            c[i*ldc+j] = sum;
+         }
+      }
+   }
+
+   void AddTransposedProduct( UInt_t m, UInt_t n, UInt_t k, const Double_t* a, UInt_t lda,
+                              const Double_t* b, UInt_t ldb, Double_t* c, UInt_t ldc )
+   {
+      // c(m x n) += a^T b, a being k x m and b k x n (one outer product per row)
+      for (UInt_t p=0; p<k; p++) {
+         const Double_t* ap = a + p*lda;
+         const Double_t* bp = b + p*ldb;
+         for (UInt_t i=0; i<m; i++) {
+            const Double_t api = ap[i];
+            Double_t* ci = c + i*ldc;
+            for (UInt_t j=0; j<n; j++) ci[j] += api*bp[j];
+         }
+      }
+   }
+
+   // forward and backward propagation of the events [begin,end) of a batch, the
+   // gradient of each block of events being summed separately
+   class BackPropagator : public TMVA::ThreadExecutor::Task {
+   public:
+      BackPropagator( const std::vector<UInt_t>& layout, const std::vector<UInt_t>& offset,
+                      TMVA::DenseNetwork::EActivation hidden, TMVA::DenseNetwork::EActivation output,
+                      const std::vector<Double_t>& weights, const Double_t* inputs,
+                      const TMVA::DenseNetwork::ErrorFunction& errors,
+                      std::vector< std::vector<Double_t> >& blockGradient ) :
+         fLayout(layout), fOffset(offset), fHidden(hidden), fOutput(output), fWeights(weights),
+         fInputs(inputs), fErrors(errors), fBlockGradient(blockGradient) {}
+
+      void Process( UInt_t iblock, UInt_t begin, UInt_t end )
+      {
+         std::vector<Double_t>& grad = fBlockGradient[iblock];
+         grad.assign( fWeights.size(), 0 );
+         const Double_t* weights = &fWeights[0];
+
+         // input values, activations (followed by the bias below the output layer)
+         // and deltas of the neurons of each layer, for a tile of events
+         const UInt_t nLayers = fLayout.size();
+         const UInt_t last    = nLayers-1;
+         std::vector< std::vector<Double_t> > value( nLayers ), act( nLayers ), delta( nLayers );
+         for (UInt_t l=0; l<nLayers; l++) {
+            value[l].resize( kTileSize*fLayout[l] );
+            act[l]  .resize( kTileSize*(fLayout[l] + (l<last ? 1 : 0)) );
+            delta[l].resize( kTileSize*fLayout[l] );
+         }
+
+         for (UInt_t first=begin; first<end; first+=kTileSize) {
+            const UInt_t nt = (end-first < kTileSize) ? end-first : kTileSize;
+
+            // the input layer takes the values of the events
+            const UInt_t nIn = fLayout[0];
+            for (UInt_t t=0; t<nt; t++) {
+               for (UInt_t i=0; i<nIn; i++) act[0][t*(nIn+1)+i] = fInputs[(first+t)*nIn+i];
+               act[0][t*(nIn+1)+nIn] = 1;
+            }
+
+            // forward: one matrix product per layer
+            for (UInt_t l=1; l<nLayers; l++) {
+               const UInt_t nPrev = fLayout[l-1]+1;
+               const UInt_t n     = fLayout[l];
+               const UInt_t width = n + (l<last ? 1 : 0);
+               const TMVA::DenseNetwork::EActivation type = (l==last) ? fOutput : fHidden;
+               Multiply( nt, n, nPrev, &act[l-1][0], nPrev, weights+fOffset[l-1], n, &value[l][0], n );
+               for (UInt_t t=0; t<nt; t++) {
+                  for (UInt_t j=0; j<n; j++) act[l][t*width+j] = Activation( type, value[l][t*n+j] );
+                  if (l<last) act[l][t*width+n] = 1;
+               }
+            }
+
+            // deltas of the output neurons
+            const UInt_t nOut = fLayout[last];
+            for (UInt_t t=0; t<nt; t++) {
+               fErrors.GetErrors( first+t, &act[last][t*nOut], &delta[last][t*nOut] );
+               for (UInt_t j=0; j<nOut; j++) {
+                  delta[last][t*nOut+j] *= Derivative( fOutput, value[last][t*nOut+j], act[last][t*nOut+j] );
+               }
+            }
+
+            // backward: gradient of the weights below each layer, deltas of the layer below
+            for (UInt_t l=last; l>0; l--) {
+               const UInt_t nPrev = fLayout[l-1]+1;
+               const UInt_t n     = fLayout[l];
+               AddTransposedProduct( nPrev, n, nt, &act[l-1][0], nPrev, &delta[l][0], n, &grad[fOffset[l-1]], n );
+               if (l == 1) break;
+               // the bias neuron (last row of the weights) has no delta
+               const UInt_t nh = fLayout[l-1];
+               MultiplyTransposed( nt, nh, n, &delta[l][0], n, weights+fOffset[l-1], n, &delta[l-1][0], nh );
+               for (UInt_t t=0; t<nt; t++) {
+                  for (UInt_t i=0; i<nh; i++) {
+                     delta[l-1][t*nh+i] *= Derivative( fHidden, value[l-1][t*nh+i], act[l-1][t*(nh+1)+i] );
+                  }
+               }
+            }
+         }
+      }
+
+   private:
+      const std::vector<UInt_t>&              fLayout;
+      const std::vector<UInt_t>&              fOffset;
+      TMVA::DenseNetwork::EActivation         fHidden;
+      TMVA::DenseNetwork::EActivation         fOutput;
+      const std::vector<Double_t>&            fWeights;
+      const Double_t*                         fInputs;
+      const TMVA::DenseNetwork::ErrorFunction& fErrors;
+      std::vector< std::vector<Double_t> >&   fBlockGradient;
+   };
+
+}
+
+//_______________________________________________________________________
+TMVA::DenseNetwork::DenseNetwork( const std::vector<UInt_t>& layout, EActivation hidden, EActivation output ) :
+   fLayout( layout ),
+   fHidden( hidden ),
+   fOutput( output ),
+   fNUpdates( 0 )
+{
+   // the weight matrices of the layers (one row per neuron of the lower layer and its
+   // bias, one column per neuron of the upper layer) follow each other
+   UInt_t nWeights = 0;
+   for (UInt_t l=0; l+1<fLayout.size(); l++) {
+      fOffset.push_back( nWeights );
+      nWeights += (fLayout[l]+1)*fLayout[l+1];
+   }
+   fWeights.assign( nWeights, 0 );
+   fLearnRates.assign( nWeights, 0 );
+   fGradient.assign( nWeights, 0 );
+}
+
+//_______________________________________________________________________
+void TMVA::DenseNetwork::AccumulateGradient( const Double_t* inputs, UInt_t nEvents, const ErrorFunction& errors,
+                                             UInt_t nUpdates, UInt_t nThreads )
+{
+   // back-propagate the events by blocks of events, one per thread, and add the
+   // gradients of the blocks in their order
+   if (nEvents == 0 || fLayout.size() < 2) return;
+   UInt_t nBlocks = (nThreads == 0) ? TMVA::ThreadExecutor::GetNCores() : nThreads;
+   if (nBlocks > nEvents) nBlocks = nEvents;
+   if (fBlockGradient.size() < nBlocks) fBlockGradient.resize( nBlocks );
+
+   BackPropagator task( fLayout, fOffset, fHidden, fOutput, fWeights, inputs, errors, fBlockGradient );
+   TMVA::ThreadExecutor::Run( task, nEvents, nBlocks );
+
+   const UInt_t nWeights = fWeights.size();
+   for (UInt_t b=0; b<nBlocks; b++) {
+      const std::vector<Double_t>& grad = fBlockGradient[b];
+      for (UInt_t w=0; w<nWeights; w++) fGradient[w] += grad[w];
+   }
+   fNUpdates += nUpdates*nEvents;
+}
+
+//_______________________________________________________________________
+void TMVA::DenseNetwork::AdjustWeights()
+{
+   // adjust the weights as TSynapse::AdjustWeight, with the mean gradient of the updates
+   if (fNUpdates == 0) return;
+   const UInt_t nWeights = fWeights.size();
+   for (UInt_t w=0; w<nWeights; w++) {
+      fWeights[w] += -fLearnRates[w] * (fGradient[w]/fNUpdates);
+      fGradient[w] = 0;
+   }
+   fNUpdates = 0;
+}
+
+//_______________________________________________________________________
+void TMVA::DenseNetwork::Evaluate( const Double_t* inputs, Double_t* outputs, std::vector<Double_t>& buffer ) const
+{
+   // forward propagation of one event, the activations of each layer below the output
+   // layer (followed by the bias) being stored one layer after the other in buffer
+   const UInt_t nLayers = fLayout.size();
+   if (nLayers < 2) return;
+   const UInt_t last = nLayers-1;
+   UInt_t size = 0;
+   for (UInt_t l=0; l<last; l++) size += fLayout[l]+1;
+   if (buffer.size() < size) buffer.resize( size );
+
+   Double_t* act = &buffer[0];
+   const UInt_t nIn = fLayout[0];
+   for (UInt_t i=0; i<nIn; i++) act[i] = inputs[i];
+   act[nIn] = 1;
+   for (UInt_t l=1; l<nLayers; l++) {
+      const UInt_t nPrev = fLayout[l-1]+1;
+      const UInt_t n     = fLayout[l];
+      const EActivation type = (l==last) ? fOutput : fHidden;
+      Double_t* next = (l==last) ? outputs : act+nPrev;
+      Multiply( 1, n, nPrev, act, nPrev, &fWeights[fOffset[l-1]], n, next, n );
+      for (UInt_t j=0; j<n; j++) next[j] = Activation( type, next[j] );
+      if (l<last) next[n] = 1;
+      act = next;
+   }
+}
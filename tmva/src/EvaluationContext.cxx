@@ -0,0 +1,40 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EvaluationContext                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include "TMVA/EvaluationContext.h"
+
+ClassImp(TMVA::EvaluationContext)
+
+//_______________________________________________________________________
+TMVA::EvaluationContext::EvaluationContext() :
+   fInput( std::vector<Float_t>(), 0 )
+{
+   // the buffers are allocated at the first events
+}
+
+//_______________________________________________________________________
+const TMVA::Event* TMVA::EvaluationContext::SetInputs( const std::vector<Float_t>& inputs )
+{
+   // copy the input values into the input event
+   fInput.GetValues().assign( inputs.begin(), inputs.end() );
+   return &fInput;
+}
@@ -0,0 +1,152 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : FlatForest                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include <limits>
+
+#include "TMVA/FlatForest.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeNode.h"
+#include "TMVA/Event.h"
+
+namespace {
+   // number of events going together through a tree
+   const UInt_t kBlockSize = 16;
+}
+
+//_______________________________________________________________________
+TMVA::FlatForest::FlatForest()
+{
+   // an empty forest
+}
+
+//_______________________________________________________________________
+void TMVA::FlatForest::Clear()
+{
+   // remove all the trees
+   fSelector.clear();
+   fCut.clear();
+   fInverted.clear();
+   fDaughter.clear();
+   fValue.clear();
+   fRoot.clear();
+   fDepth.clear();
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::FlatForest::Build( const std::vector<DecisionTree*>& forest, Bool_t useYesNoLeaf )
+{
+   // flatten the trees; the nodes of a tree are numbered breadth first, as in
+   // CheckEvent a node which is not intermediate (node type 0) is a leaf
+   Clear();
+   std::vector<TMVA::DecisionTreeNode*> nodes;
+   std::vector<UInt_t>                  depths;
+   for (UInt_t itree=0; itree<forest.size(); itree++) {
+      TMVA::DecisionTreeNode* root = forest[itree]->GetRoot();
+      if (root == 0) { Clear(); return kFALSE; }
+      const Bool_t doRegression = forest[itree]->DoRegression();
+
+      const UInt_t first = fSelector.size();
+      UInt_t depth = 0;
+      nodes.assign( 1, root );
+      depths.assign( 1, 0 );
+      for (UInt_t inode=0; inode<nodes.size(); inode++) {
+         const TMVA::DecisionTreeNode* node = nodes[inode];
+         const UInt_t index = first + inode;
+         if (node->GetNodeType() == 0) {
+            if (node->GetNFisherCoeff() != 0 || node->GetLeft() == 0 || node->GetRight() == 0) {
+               Clear();
+               return kFALSE;
+            }
+            fSelector.push_back( node->GetSelector() );
+            fCut.push_back( node->GetCutValue() );
+            fInverted.push_back( node->GetCutType() ? 0 : 1 );
+            fDaughter.push_back( first + nodes.size() );
+            fValue.push_back( 0 );
+            nodes.push_back( (TMVA::DecisionTreeNode*)node->GetLeft() );
+            nodes.push_back( (TMVA::DecisionTreeNode*)node->GetRight() );
+            depths.push_back( depths[inode]+1 );
+            depths.push_back( depths[inode]+1 );
+            if (depths[inode]+1 > depth) depth = depths[inode]+1;
+         }
+         else {
+            fSelector.push_back( 0 );
+            fCut.push_back( std::numeric_limits<Float_t>::infinity() );
+            fInverted.push_back( 0 );
+            fDaughter.push_back( index );
+            if (doRegression)      fValue.push_back( node->GetResponse() );
+            else if (useYesNoLeaf) fValue.push_back( Double_t( node->GetNodeType() ) );
+            else                   fValue.push_back( node->GetPurity() );
+         }
+      }
+      fRoot.push_back( first );
+      fDepth.push_back( depth );
+   }
+   return kTRUE;
+}
+
+//_______________________________________________________________________
+Double_t TMVA::FlatForest::GetSum( const Event* ev, UInt_t firstTree, UInt_t lastTree, UInt_t step,
+                                   const Double_t* treeWeights ) const
+{
+   // sum of the (weighted) leaf values of the event over the trees
+   Double_t sum = 0;
+   AddSums( &(ev->GetValues()[0]), 1, ev->GetNVariables(), firstTree, lastTree, step, treeWeights, &sum );
+   return sum;
+}
+
+//_______________________________________________________________________
+void TMVA::FlatForest::AddSums( const Float_t* values, UInt_t nEvents, UInt_t nVars,
+                                UInt_t firstTree, UInt_t lastTree, UInt_t step,
+                                const Double_t* treeWeights, Double_t* sums ) const
+{
+   // the events go through the trees by blocks of kBlockSize: for each tree, each
+   // block takes depth steps, every step moving all its events down by one level
+   if (lastTree > GetNTrees()) lastTree = GetNTrees();
+   if (step == 0) step = 1;
+
+   const UInt_t*   selector = fSelector.empty() ? 0 : &fSelector[0];
+   const Float_t*  cut      = fCut.empty()      ? 0 : &fCut[0];
+   const UInt_t*   inverted = fInverted.empty() ? 0 : &fInverted[0];
+   const UInt_t*   daughter = fDaughter.empty() ? 0 : &fDaughter[0];
+   const Double_t* value    = fValue.empty()    ? 0 : &fValue[0];
+
+   UInt_t node[kBlockSize];
+   for (UInt_t begin=0; begin<nEvents; begin+=kBlockSize) {
+      const UInt_t   n = (nEvents-begin < kBlockSize) ? nEvents-begin : kBlockSize;
+      const Float_t* x = values + ULong64_t(begin)*nVars;
+      Double_t*      s = sums + begin;
+
+      for (UInt_t itree=firstTree; itree<lastTree; itree+=step) {
+         const UInt_t root  = fRoot[itree];
+         const UInt_t depth = fDepth[itree];
+         for (UInt_t k=0; k<n; k++) node[k] = root;
+         for (UInt_t d=0; d<depth; d++) {
+            for (UInt_t k=0; k<n; k++) {
+               const UInt_t i = node[k];
+               node[k] = daughter[i] + ( UInt_t( x[k*nVars+selector[i]] > cut[i] ) ^ inverted[i] );
+            }
+         }
+         const Double_t w = treeWeights ? treeWeights[itree] : 1.;
+         for (UInt_t k=0; k<n; k++) s[k] += w*value[node[k]];
+      }
+   }
+}
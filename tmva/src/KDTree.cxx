@@ -0,0 +1,338 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : KDTree                                                                *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "TMVA/KDTree.h"
+#include "TMVA/ThreadExecutor.h"
+
+namespace {
+
+   // bound of the number of nodes waiting in the stack of a search (the tree
+   // has less than 2^32 points, and a search keeps at most one node per level)
+   const UInt_t kMaxStack = 64;
+
+   // orders the indices of the points by the coordinate axis
+   class CoordinateLess {
+   public:
+      CoordinateLess( const Float_t* points, UInt_t nVars, UInt_t axis ) :
+         fPoints(points), fNVars(nVars), fAxis(axis) {}
+      bool operator()( UInt_t i, UInt_t j ) const {
+         return fPoints[ULong64_t(i)*fNVars+fAxis] < fPoints[ULong64_t(j)*fNVars+fAxis];
+      }
+   private:
+      const Float_t* fPoints;
+      UInt_t         fNVars;
+      UInt_t         fAxis;
+   };
+
+   inline Bool_t InVolume( const Float_t* x, UInt_t nVars, const Double_t* lower, const Double_t* upper )
+   {
+      // same test as BinarySearchTree::InVolume
+      for (UInt_t ivar=0; ivar<nVars; ivar++) {
+         if (!(lower[ivar] < x[ivar] && upper[ivar] >= x[ivar])) return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   // nearest neighbours of the events [begin,end) of a batch
+   class NearestFinder : public TMVA::ThreadExecutor::Task {
+   public:
+      NearestFinder( const TMVA::KDTree& tree, const Float_t* x, UInt_t k, TMVA::KDTree::Neighbour* output ) :
+         fTree(tree), fX(x), fK(k), fOutput(output) {}
+      void Process( UInt_t /*iblock*/, UInt_t begin, UInt_t end ) {
+         const TMVA::KDTree::Neighbour none( std::numeric_limits<Float_t>::max(), fTree.GetNPoints() );
+         std::vector<TMVA::KDTree::Neighbour> neighbours;
+         neighbours.reserve( fK );
+         for (UInt_t iev=begin; iev<end; iev++) {
+            fTree.FindNearest( fX + ULong64_t(iev)*fTree.GetNVars(), fK, neighbours );
+            TMVA::KDTree::Neighbour* out = fOutput + ULong64_t(iev)*fK;
+            for (UInt_t j=0; j<fK; j++) out[j] = j < neighbours.size() ? neighbours[j] : none;
+         }
+      }
+   private:
+      const TMVA::KDTree&      fTree;
+      const Float_t*           fX;
+      UInt_t                   fK;
+      TMVA::KDTree::Neighbour* fOutput;
+   };
+}
+
+//_______________________________________________________________________
+TMVA::KDTree::KDTree() :
+   fNVars(0),
+   fFirstLeaf(0)
+{
+   // an empty tree
+}
+
+//_______________________________________________________________________
+void TMVA::KDTree::Clear()
+{
+   // remove all the points
+   fFirstLeaf = 0;
+   fBegin.clear();
+   fEnd.clear();
+   fMin.clear();
+   fMax.clear();
+   fSumW.clear();
+   fPoints.clear();
+   fWeights.clear();
+   fIndex.clear();
+}
+
+//_______________________________________________________________________
+void TMVA::KDTree::Build( const std::vector<Float_t>& points, UInt_t nVars,
+                          const std::vector<Double_t>& weights, UInt_t bucketSize )
+{
+   // split the points node by node, in the order of the nodes; the number of
+   // leaves is the smallest power of 2 for which the leaves hold at most
+   // bucketSize points
+   Clear();
+   fNVars = nVars;
+   const UInt_t nPoints = nVars > 0 ? points.size()/nVars : 0;
+   if (nPoints == 0) return;
+   if (bucketSize == 0) bucketSize = 1;
+
+   UInt_t nLeaves = 1;
+   while (ULong64_t(nLeaves)*bucketSize < nPoints) nLeaves *= 2;
+   fFirstLeaf = nLeaves - 1;
+   const UInt_t nNodes = 2*nLeaves - 1;
+   fBegin.resize( nNodes );
+   fEnd.resize( nNodes );
+
+   std::vector<UInt_t> order( nPoints );
+   for (UInt_t i=0; i<nPoints; i++) order[i] = i;
+   fBegin[0] = 0;
+   fEnd[0]   = nPoints;
+   for (UInt_t inode=0; inode<fFirstLeaf; inode++) {
+      const UInt_t begin  = fBegin[inode];
+      const UInt_t end    = fEnd[inode];
+      const UInt_t middle = begin + (end-begin)/2;
+      UInt_t  axis   = 0;
+      Float_t spread = -1;
+      for (UInt_t ivar=0; ivar<nVars && end-begin>1; ivar++) {
+         Float_t xmin = points[ULong64_t(order[begin])*nVars+ivar], xmax = xmin;
+         for (UInt_t i=begin+1; i<end; i++) {
+            const Float_t x = points[ULong64_t(order[i])*nVars+ivar];
+            if (x < xmin) xmin = x;
+            if (x > xmax) xmax = x;
+         }
+         if (xmax-xmin > spread) { spread = xmax-xmin; axis = ivar; }
+      }
+      if (end-begin > 1) std::nth_element( order.begin()+begin, order.begin()+middle, order.begin()+end,
+                                           CoordinateLess( &points[0], nVars, axis ) );
+      fBegin[2*inode+1] = begin;
+      fEnd[2*inode+1]   = middle;
+      fBegin[2*inode+2] = middle;
+      fEnd[2*inode+2]   = end;
+   }
+
+   // the points in the order of the leaves
+   fPoints.resize( ULong64_t(nPoints)*nVars );
+   fWeights.resize( nPoints );
+   fIndex.resize( nPoints );
+   for (UInt_t i=0; i<nPoints; i++) {
+      const UInt_t ipoint = order[i];
+      for (UInt_t ivar=0; ivar<nVars; ivar++) fPoints[ULong64_t(i)*nVars+ivar] = points[ULong64_t(ipoint)*nVars+ivar];
+      fWeights[i] = ipoint < weights.size() ? weights[ipoint] : 1.;
+      fIndex[i]   = ipoint;
+   }
+
+   // boxes and weights of the leaves, then of their mothers
+   fMin.assign( ULong64_t(nNodes)*nVars,  std::numeric_limits<Float_t>::max() );
+   fMax.assign( ULong64_t(nNodes)*nVars, -std::numeric_limits<Float_t>::max() );
+   fSumW.assign( nNodes, 0 );
+   for (UInt_t inode=fFirstLeaf; inode<nNodes; inode++) {
+      Float_t* lo = &fMin[ULong64_t(inode)*nVars];
+      Float_t* hi = &fMax[ULong64_t(inode)*nVars];
+      for (UInt_t i=fBegin[inode]; i<fEnd[inode]; i++) {
+         const Float_t* x = &fPoints[ULong64_t(i)*nVars];
+         for (UInt_t ivar=0; ivar<nVars; ivar++) {
+            if (x[ivar] < lo[ivar]) lo[ivar] = x[ivar];
+            if (x[ivar] > hi[ivar]) hi[ivar] = x[ivar];
+         }
+         fSumW[inode] += fWeights[i];
+      }
+   }
+   for (UInt_t inode=fFirstLeaf; inode-- > 0;) {
+      const UInt_t left = 2*inode+1, right = 2*inode+2;
+      for (UInt_t ivar=0; ivar<nVars; ivar++) {
+         fMin[ULong64_t(inode)*nVars+ivar] = std::min( fMin[ULong64_t(left)*nVars+ivar], fMin[ULong64_t(right)*nVars+ivar] );
+         fMax[ULong64_t(inode)*nVars+ivar] = std::max( fMax[ULong64_t(left)*nVars+ivar], fMax[ULong64_t(right)*nVars+ivar] );
+      }
+      fSumW[inode] = fSumW[left] + fSumW[right];
+   }
+}
+
+//_______________________________________________________________________
+Int_t TMVA::KDTree::Overlap( UInt_t inode, const Double_t* lower, const Double_t* upper ) const
+{
+   // -1 if no point of the node can be in the volume, 1 if all are, 0 otherwise
+   const Float_t* lo = &fMin[ULong64_t(inode)*fNVars];
+   const Float_t* hi = &fMax[ULong64_t(inode)*fNVars];
+   Int_t inside = 1;
+   for (UInt_t ivar=0; ivar<fNVars; ivar++) {
+      if (hi[ivar] <= lower[ivar] || lo[ivar] > upper[ivar]) return -1;
+      if (!(lower[ivar] < lo[ivar] && hi[ivar] <= upper[ivar])) inside = 0;
+   }
+   return inside;
+}
+
+//_______________________________________________________________________
+Float_t TMVA::KDTree::BoxDistance( UInt_t inode, const Float_t* x ) const
+{
+   // squared distance between x and the nearest point of the box of the node,
+   // never larger than the distance computed in FindNearest to its points
+   const Float_t* lo = &fMin[ULong64_t(inode)*fNVars];
+   const Float_t* hi = &fMax[ULong64_t(inode)*fNVars];
+   Float_t dist = 0;
+   for (UInt_t ivar=0; ivar<fNVars; ivar++) {
+      if      (x[ivar] < lo[ivar]) { const Float_t d = lo[ivar]-x[ivar]; dist += d*d; }
+      else if (x[ivar] > hi[ivar]) { const Float_t d = x[ivar]-hi[ivar]; dist += d*d; }
+   }
+   return dist;
+}
+
+//_______________________________________________________________________
+Double_t TMVA::KDTree::SearchVolume( const Double_t* lower, const Double_t* upper,
+                                     std::vector<UInt_t>* points ) const
+{
+   // walk down the nodes overlapping the volume, taking the whole nodes inside
+   if (fIndex.empty()) return 0;
+
+   Double_t count = 0;
+   UInt_t   stack[kMaxStack];
+   UInt_t   nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack > 0) {
+      const UInt_t inode   = stack[--nstack];
+      const Int_t  overlap = Overlap( inode, lower, upper );
+      if (overlap < 0) continue;
+      if (overlap > 0) {
+         count += fSumW[inode];
+         if (points) points->insert( points->end(), fIndex.begin()+fBegin[inode], fIndex.begin()+fEnd[inode] );
+      }
+      else if (IsLeaf( inode )) {
+         for (UInt_t i=fBegin[inode]; i<fEnd[inode]; i++) {
+            if (!InVolume( &fPoints[ULong64_t(i)*fNVars], fNVars, lower, upper )) continue;
+            count += fWeights[i];
+            if (points) points->push_back( fIndex[i] );
+         }
+      }
+      else {
+         stack[nstack++] = 2*inode+2;
+         stack[nstack++] = 2*inode+1;
+      }
+   }
+   return count;
+}
+
+//_______________________________________________________________________
+UInt_t TMVA::KDTree::SearchVolumeWithMaxLimit( const Double_t* lower, const Double_t* upper,
+                                               std::vector<UInt_t>* points, UInt_t maxPoints ) const
+{
+   // same walk as SearchVolume, counting the points
+   if (fIndex.empty()) return 0;
+
+   UInt_t count = 0;
+   UInt_t stack[kMaxStack];
+   UInt_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack > 0 && count < maxPoints) {
+      const UInt_t inode   = stack[--nstack];
+      const Int_t  overlap = Overlap( inode, lower, upper );
+      if (overlap < 0) continue;
+      if (overlap == 0 && !IsLeaf( inode )) {
+         stack[nstack++] = 2*inode+2;
+         stack[nstack++] = 2*inode+1;
+         continue;
+      }
+      for (UInt_t i=fBegin[inode]; i<fEnd[inode] && count<maxPoints; i++) {
+         if (overlap == 0 && !InVolume( &fPoints[ULong64_t(i)*fNVars], fNVars, lower, upper )) continue;
+         count++;
+         if (points) points->push_back( fIndex[i] );
+      }
+   }
+   return count;
+}
+
+//_______________________________________________________________________
+void TMVA::KDTree::FindNearest( const Float_t* x, UInt_t k, std::vector<Neighbour>& neighbours ) const
+{
+   // depth-first search, the nearer daughter first; the neighbours found so far are
+   // kept in a heap whose top is the farthest one, and the nodes whose box is
+   // farther than it are skipped
+   neighbours.clear();
+   if (k == 0 || fIndex.empty()) return;
+
+   UInt_t  stack[kMaxStack];
+   Float_t bound[kMaxStack];
+   UInt_t  nstack = 0;
+   stack[nstack] = 0;
+   bound[nstack++] = BoxDistance( 0, x );
+   while (nstack > 0) {
+      --nstack;
+      const UInt_t inode = stack[nstack];
+      if (neighbours.size() == k && bound[nstack] > neighbours.front().first) continue;
+
+      if (IsLeaf( inode )) {
+         for (UInt_t i=fBegin[inode]; i<fEnd[inode]; i++) {
+            const Float_t* p = &fPoints[ULong64_t(i)*fNVars];
+            Float_t dist = 0;
+            for (UInt_t ivar=0; ivar<fNVars; ivar++) { const Float_t d = p[ivar]-x[ivar]; dist += d*d; }
+            const Neighbour candidate( dist, fIndex[i] );
+            if (neighbours.size() < k) {
+               neighbours.push_back( candidate );
+               std::push_heap( neighbours.begin(), neighbours.end() );
+            }
+            else if (candidate < neighbours.front()) {
+               std::pop_heap( neighbours.begin(), neighbours.end() );
+               neighbours.back() = candidate;
+               std::push_heap( neighbours.begin(), neighbours.end() );
+            }
+         }
+         continue;
+      }
+
+      const UInt_t  left  = 2*inode+1, right = 2*inode+2;
+      const Float_t dleft = BoxDistance( left, x ), dright = BoxDistance( right, x );
+      const Bool_t  leftFirst = dleft <= dright;
+      stack[nstack] = leftFirst ? right : left;
+      bound[nstack++] = leftFirst ? dright : dleft;
+      stack[nstack] = leftFirst ? left : right;
+      bound[nstack++] = leftFirst ? dleft : dright;
+   }
+   std::sort_heap( neighbours.begin(), neighbours.end() );
+}
+
+//_______________________________________________________________________
+void TMVA::KDTree::FindNearest( const Float_t* x, UInt_t nEvents, UInt_t k,
+                                std::vector<Neighbour>& neighbours, UInt_t nThreads ) const
+{
+   // the events are shared by the threads in contiguous blocks
+   neighbours.resize( ULong64_t(nEvents)*k );
+   if (nEvents == 0 || k == 0) return;
+   NearestFinder finder( *this, x, k, &neighbours[0] );
+   ThreadExecutor::Run( finder, nEvents, nThreads );
+}
@@ -133,6 +133,8 @@
 #include "TMVA/LogInterval.h"
 #include "TMVA/PDF.h"
 #include "TMVA/BDTEventWrapper.h"
+#include "TMVA/BinnedEventSample.h"
+#include "TMVA/FlatForest.h"
 
 #include "TMatrixTSym.h"
 
@@ -165,6 +167,8 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fMinNodeSize(5)
    , fMinNodeSizeS("5%")
    , fNCuts(0)
+   , fUseHistogramSplits(kFALSE)
+   , fNThreads(1)
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
@@ -200,6 +204,8 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    // the standard constructor for the "boosted decision trees"
    fMonitorNtuple = NULL;
    fSepType = NULL;
+   fBinnedSample = NULL;
+   fFlatForest = NULL;
 }
 
 //_______________________________________________________________________
@@ -219,6 +225,8 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fMinNodeSize(5)
    , fMinNodeSizeS("5%")
    , fNCuts(0)
+   , fUseHistogramSplits(kFALSE)
+   , fNThreads(1)
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
@@ -253,6 +261,8 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
 {
    fMonitorNtuple = NULL;
    fSepType = NULL;
+   fBinnedSample = NULL;
+   fFlatForest = NULL;
    // constructor for calculating BDT-MVA using previously generated decision trees
    // the result of the previous training (the decision trees) are read in via the
    // weight file. Make sure the the variables correspond to the ones used in
@@ -294,6 +304,10 @@ void TMVA::MethodBDT::DeclareOptions()
    // MinNodeSize:     minimum percentage of training events in a leaf node (leaf criteria, stop splitting)
    // nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
    //                  step size is determined by the events)
+   // UseHistogramSplits  search the cuts of the nodes on nCuts+1 quantile bins of the variables computed
+   //                  once before the training (histogram based training, fast for large samples)
+   // NThreads         number of threads used to fill and scan the histograms of UseHistogramSplits
+   //                  (0: one per core)
    // UseFisherCuts:   use multivariate splits using the Fisher criterion
    // UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
    //                  (from the training) in the leaf node
@@ -378,6 +392,8 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fMinNodeSizeS=tmp, "MinNodeSize", "Minimum percentage of training events required in a leaf node (default: Classification: 5%, Regression: 0.2%)");
    // MinNodeSize:     minimum percentage of training events in a leaf node (leaf criteria, stop splitting)
    DeclareOptionRef(fNCuts, "nCuts", "Number of steps during node cut optimisation");
+   DeclareOptionRef(fUseHistogramSplits=kFALSE, "UseHistogramSplits", "Search the node cuts on nCuts+1 quantile bins of the variables computed once before the training");
+   DeclareOptionRef(fNThreads=1, "NThreads", "Number of threads filling and scanning the histograms with UseHistogramSplits (0: one per core)");
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
@@ -543,6 +559,12 @@ void TMVA::MethodBDT::ProcessOptions()
       Log() << kWARNING << " you specified the option NegWeightTreatment=PairNegWeightsInNode : This option is still considered EXPERIMENTAL !! " << Endl;
    if (fNegWeightTreatment == "pairnegweightsginnode" && fNCuts <= 0) 
       Log() << kFATAL << " sorry, the option NegWeightTreatment=PairNegWeightsInNode is not yet implemented for NCuts < 0" << Endl;
+
+   if (fUseHistogramSplits && (fUseFisherCuts || fPairNegWeightsInNode)) {
+      Log() << kWARNING << "the option UseHistogramSplits cannot be used together with UseFisherCuts or "
+            << "NegWeightTreatment=PairNegWeightsInNode --> I switch it off" << Endl;
+      fUseHistogramSplits = kFALSE;
+   }
 }
 
 
@@ -626,7 +648,9 @@ void TMVA::MethodBDT::Reset( void )
    fForest.clear();
 
    fBoostWeights.clear();
+   delete fFlatForest; fFlatForest=NULL;
    if (fMonitorNtuple) fMonitorNtuple->Delete(); fMonitorNtuple=NULL;
+   delete fBinnedSample; fBinnedSample=NULL;
    fVariableImportance.clear();
    fResiduals.clear();
    // now done in "InitEventSample" which is called in "Train"
@@ -644,6 +668,8 @@ TMVA::MethodBDT::~MethodBDT( void )
    //   for (UInt_t i=0; i<fEventSample.size();      i++) delete fEventSample[i];
    //   for (UInt_t i=0; i<fValidationSample.size(); i++) delete fValidationSample[i];
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
+   delete fFlatForest;
+   delete fBinnedSample;
 }
 
 //_______________________________________________________________________
@@ -751,6 +777,23 @@ void TMVA::MethodBDT::InitEventSample( void )
       else                                            fEventSample[ievt]->SetBoostWeight(normBkg);
    }
 
+   // the quantile bins of the variables do not depend on the boost weights, they are
+   // computed once and used by all the trees
+   if (fUseHistogramSplits && fBinnedSample == NULL) {
+      Int_t nCuts = fNCuts;
+      if (nCuts <= 0) {
+         nCuts = 255;
+         Log() << kINFO << "UseHistogramSplits needs a grid of cuts: nCuts=" << fNCuts
+               << " --> I use " << nCuts << " cuts" << Endl;
+      }
+      Timer timer( GetName() );
+      fBinnedSample = new BinnedEventSample( fEventSample, nCuts+1, fNThreads );
+      fEventSampleRows.resize( fEventSample.size() );
+      for (UInt_t ievt=0; ievt<fEventSample.size(); ievt++) fEventSampleRows[ievt] = ievt;
+      Log() << kINFO << "<InitEventSample> binned " << fEventSample.size() << " events in at most "
+            << nCuts+1 << " quantile bins per variable, elapsed time: " << timer.GetElapsedTime() << Endl;
+   }
+
    //just for debug purposes..
    /*
    sumSigW=0;
@@ -975,6 +1018,9 @@ void TMVA::MethodBDT::Train()
    // BDT training
    TMVA::DecisionTreeNode::fgIsTraining=true;
 
+   // the trees are evaluated node by node while the forest grows
+   delete fFlatForest; fFlatForest=NULL;
+
    // fill the STL Vector with the event sample
    // (needs to be done here and cannot be done in "init" as the options need to be 
    // known). 
@@ -1103,6 +1149,7 @@ void TMVA::MethodBDT::Train()
                                                  fRandomisedTrees, fUseNvars, fUsePoissonNvars, fNNodesMax, fMaxDepth,
                                                  itree*nClasses+i, fNodePurityLimit, itree*nClasses+i));
             if (fPairNegWeightsInNode) fForest.back()->SetPairNegWeightsInNode();
+            fForest.back()->SetNThreads(fNThreads);
             if (fUseFisherCuts) {
                fForest.back()->SetUseFisherCuts();
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
@@ -1111,11 +1158,11 @@ void TMVA::MethodBDT::Train()
             // the minimum linear correlation between two variables demanded for use in fisher criterion in node splitting
 
             if (fBaggedGradBoost){
-               nNodesBeforePruning = fForest.back()->BuildTree(fSubSample);
+               nNodesBeforePruning = GrowTree(fForest.back(), kTRUE);
                fBoostWeights.push_back(this->Boost(fSubSample, fForest.back(), itree, i));
             }
             else{
-               nNodesBeforePruning = fForest.back()->BuildTree(fEventSample);  
+               nNodesBeforePruning = GrowTree(fForest.back(), kFALSE);
                fBoostWeights.push_back(this->Boost(fEventSample, fForest.back(), itree, i));
             }
          }
@@ -1125,13 +1172,13 @@ void TMVA::MethodBDT::Train()
                                               fRandomisedTrees, fUseNvars, fUsePoissonNvars, fNNodesMax, fMaxDepth,
                                               itree, fNodePurityLimit, itree));
          if (fPairNegWeightsInNode) fForest.back()->SetPairNegWeightsInNode();
+         fForest.back()->SetNThreads(fNThreads);
          if (fUseFisherCuts) {
             fForest.back()->SetUseFisherCuts();
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
             fForest.back()->SetUseExclusiveVars(fUseExclusiveVars); 
          }
-         if (fBaggedGradBoost) nNodesBeforePruning = fForest.back()->BuildTree(fSubSample);
-         else                  nNodesBeforePruning = fForest.back()->BuildTree(fEventSample);
+         nNodesBeforePruning = GrowTree(fForest.back(), fBaggedGradBoost);
          
          if (fBoostType!="Grad")
             if (fUseYesNoLeaf && !DoRegression() ){ // remove leaf nodes where both daughter nodes are of same type
@@ -1216,7 +1263,9 @@ void TMVA::MethodBDT::Train()
    Log() << kDEBUG << "Now I delete the privat data sample"<< Endl;
    for (UInt_t i=0; i<fEventSample.size();      i++) delete fEventSample[i];
    for (UInt_t i=0; i<fValidationSample.size(); i++) delete fValidationSample[i];
+   delete fBinnedSample; fBinnedSample=NULL;
 
+   BuildFlatForest();
 }
 
 //_______________________________________________________________________
@@ -1226,23 +1275,39 @@ void TMVA::MethodBDT::GetRandomSubSample()
    UInt_t nevents = fEventSample.size();
    
    if (!fSubSample.empty()) fSubSample.clear();
+   fSubSampleRows.clear();
    TRandom3 *trandom   = new TRandom3(fForest.size()+1);
 
    for (UInt_t ievt=0; ievt<nevents; ievt++) { // recreate new random subsample
-      if(trandom->Rndm()<fSampleFraction)
+      if(trandom->Rndm()<fSampleFraction) {
          fSubSample.push_back(fEventSample[ievt]);
+         fSubSampleRows.push_back(ievt);
+      }
    }
 }
 
+//_______________________________________________________________________
+UInt_t TMVA::MethodBDT::GrowTree( DecisionTree *dt, Bool_t useSubSample )
+{
+   // build the tree dt on the training events or on the bagged subsample; with
+   // UseHistogramSplits the cuts are searched on the pre-binned variables
+   if (fBinnedSample != NULL) return dt->BuildTree( *fBinnedSample, useSubSample ? fSubSampleRows : fEventSampleRows );
+   return dt->BuildTree( useSubSample ? fSubSample : fEventSample );
+}
+
 //_______________________________________________________________________
 Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
 {
    //returns MVA value: -1 for background, 1 for signal
    Double_t sum=0;
-   for (UInt_t itree=0; itree<nTrees; itree++) {
-      //loop over all trees in forest
-      sum += fForest[itree]->CheckEvent(e,kFALSE);
- 
+   if (fFlatForest != NULL && nTrees <= fFlatForest->GetNTrees()) {
+      sum = fFlatForest->GetSum( e, 0, nTrees );
+   }
+   else {
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         //loop over all trees in forest
+         sum += fForest[itree]->CheckEvent(e,kFALSE);
+      }
    }
    return 2.0/(1.0+exp(-2.0*sum))-1; //MVA output between -1 and 1
 }
@@ -2128,6 +2193,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   BuildFlatForest();
 }
 
 //_______________________________________________________________________
@@ -2163,6 +2230,26 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   BuildFlatForest();
+}
+
+//_______________________________________________________________________
+void TMVA::MethodBDT::BuildFlatForest()
+{
+   // flatten the trees for the evaluation; a forest with Fisher cuts is evaluated
+   // node by node
+   delete fFlatForest; fFlatForest = NULL;
+   if (fForest.empty()) return;
+   fFlatForest = new FlatForest();
+   if (!fFlatForest->Build( fForest, fUseYesNoLeaf )) {
+      Log() << kVERBOSE << "the forest has Fisher cuts and is evaluated node by node" << Endl;
+      delete fFlatForest; fFlatForest = NULL;
+   }
+   else {
+      Log() << kDEBUG << "flattened " << fFlatForest->GetNTrees() << " trees with "
+            << fFlatForest->GetNNodes() << " nodes for the evaluation" << Endl;
+   }
 }
 
 //_______________________________________________________________________
@@ -2204,6 +2291,11 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
    
    Double_t myMVA = 0;
    Double_t norm  = 0;
+   if (fFlatForest != NULL && nTrees <= fFlatForest->GetNTrees()) {
+      myMVA = fFlatForest->GetSum( ev, 0, nTrees, 1, fUseWeightedTrees ? &fBoostWeights[0] : 0 );
+      for (UInt_t itree=0; itree<nTrees; itree++) norm += fUseWeightedTrees ? fBoostWeights[itree] : 1;
+      return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //
       if (fUseWeightedTrees) {
@@ -2219,6 +2311,81 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 }
 
 
+//_______________________________________________________________________
+Double_t TMVA::MethodBDT::GetMvaValueConcurrent( const TMVA::Event* const ev, EvaluationContext& context ) const
+{
+   // as GetMvaValue, with the event transformed in the context going through the
+   // flattened trees (which are not modified by the evaluation)
+   if (fFlatForest == NULL) return MethodBase::GetMvaValueConcurrent( ev, context );
+
+   const Event* tev = GetEvent( ev, context );
+   if (fDoPreselection) {
+     Double_t val = ApplyPreselectionCuts(tev);
+     if (TMath::Abs(val)>0.05) return val; 
+   }
+
+   const UInt_t nTrees = fFlatForest->GetNTrees();
+   if (fBoostType=="Grad") {
+      Double_t sum = fFlatForest->GetSum( tev, 0, nTrees );
+      return 2.0/(1.0+exp(-2.0*sum))-1;
+   }
+   Double_t myMVA = fFlatForest->GetSum( tev, 0, nTrees, 1, fUseWeightedTrees ? &fBoostWeights[0] : 0 );
+   Double_t norm  = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) norm += fUseWeightedTrees ? fBoostWeights[itree] : 1;
+   return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA/norm : 0 ;
+}
+
+//_______________________________________________________________________
+void TMVA::MethodBDT::GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues )
+{
+   // MVA values of the events stored one after the other in inputs: the events go
+   // together through the flattened trees, by chunks of transformed events if the
+   // method transforms the variables or applies preselection cuts
+   if (fFlatForest == NULL) {
+      MethodBase::GetMvaValues( inputs, mvaValues );
+      return;
+   }
+
+   const UInt_t nvar    = GetNvar();
+   const UInt_t nEvents = nvar > 0 ? inputs.size()/nvar : 0;
+   const UInt_t nTrees  = fFlatForest->GetNTrees();
+   mvaValues.assign( nEvents, 0 );
+   if (nEvents == 0 || nTrees == 0) return;
+
+   const Bool_t    isGrad  = (fBoostType=="Grad");
+   const Double_t* weights = (!isGrad && fUseWeightedTrees) ? &fBoostWeights[0] : 0;
+
+   std::vector<Double_t> presel;
+   if (GetTransformationHandler().GetNumOfTransformations() == 0 && !fDoPreselection) {
+      fFlatForest->AddSums( &inputs[0], nEvents, nvar, 0, nTrees, 1, weights, &mvaValues[0] );
+   }
+   else {
+      const UInt_t nChunk = 256;
+      std::vector<Float_t> values( nChunk*nvar );
+      if (fDoPreselection) presel.resize( nEvents );
+      Event ev( std::vector<Float_t>( nvar ), 0 );
+      for (UInt_t begin=0; begin<nEvents; begin+=nChunk) {
+         const UInt_t n = (nEvents-begin < nChunk) ? nEvents-begin : nChunk;
+         for (UInt_t k=0; k<n; k++) {
+            for (UInt_t ivar=0; ivar<nvar; ivar++) ev.SetVal( ivar, inputs[(begin+k)*nvar+ivar] );
+            const Event* tev = GetEvent( &ev );
+            for (UInt_t ivar=0; ivar<nvar; ivar++) values[k*nvar+ivar] = tev->GetValue( ivar );
+            if (fDoPreselection) presel[begin+k] = ApplyPreselectionCuts( tev );
+         }
+         fFlatForest->AddSums( &values[0], n, nvar, 0, nTrees, 1, weights, &mvaValues[begin] );
+      }
+   }
+
+   // same normalisation as PrivateGetMvaValue and GetGradBoostMVA
+   Double_t norm = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) norm += weights ? fBoostWeights[itree] : 1;
+   for (UInt_t iev=0; iev<nEvents; iev++) {
+      if (!presel.empty() && TMath::Abs(presel[iev])>0.05) mvaValues[iev] = presel[iev];
+      else if (isGrad) mvaValues[iev] = 2.0/(1.0+exp(-2.0*mvaValues[iev]))-1;
+      else mvaValues[iev] = ( norm > std::numeric_limits<double>::epsilon() ) ? mvaValues[iev]/norm : 0;
+   }
+}
+
 //_______________________________________________________________________
 const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
 {
@@ -2233,6 +2400,10 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    UInt_t nClasses = DataInfo().GetNClasses();
    for(UInt_t iClass=0; iClass<nClasses; iClass++){
       temp.push_back(0.0);
+      if (fFlatForest != NULL) {
+         temp[iClass] = fFlatForest->GetSum( e, iClass, fForest.size(), nClasses );
+         continue;
+      }
       for(UInt_t itree = iClass; itree<fForest.size(); itree+=nClasses){
          temp[iClass] += fForest[itree]->CheckEvent(e,kFALSE);
       }
@@ -2474,6 +2645,11 @@ void TMVA::MethodBDT::GetHelpMessage() const
    Log() << "the comparison between efficiencies obtained on the training and" << Endl;
    Log() << "the independent test sample. They should be equal within statistical" << Endl;
    Log() << "errors, in order to minimize statistical fluctuations in different samples." << Endl;
+   Log() << Endl;
+   Log() << "For large training samples, the option \"UseHistogramSplits\" replaces" << Endl;
+   Log() << "the variables by \"nCuts\"+1 quantile bins once before the training" << Endl;
+   Log() << "and finds the cuts of the nodes on histograms of these bins, filled" << Endl;
+   Log() << "with \"NThreads\" threads." << Endl;
 }
 
 //_______________________________________________________________________
@@ -2812,7 +2988,7 @@ void TMVA::MethodBDT::DeterminePreselectionCuts(const std::vector<const TMVA::Ev
 }
 
 //_______________________________________________________________________
-Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev)
+Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev) const
 {
    // aply the  preselection cuts before even bothing about any 
    // Decision Trees  in the GetMVA .. --> -1 for background +1 for Signal 
@@ -808,6 +808,29 @@ Double_t TMVA::MethodBase::GetMvaValue( const Event* const ev, Double_t* err, Do
    return val;
 }
 
+//_______________________________________________________________________
+void TMVA::MethodBase::GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues )
+{
+   // evaluate the events stored one after the other in inputs, one by one
+   const UInt_t nvar    = GetNvar();
+   const UInt_t nEvents = nvar > 0 ? inputs.size()/nvar : 0;
+   mvaValues.resize( nEvents );
+   Event ev( std::vector<Float_t>( nvar ), 0 );
+   for (UInt_t iev=0; iev<nEvents; iev++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) ev.SetVal( ivar, inputs[iev*nvar+ivar] );
+      mvaValues[iev] = GetMvaValue( &ev );
+   }
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodBase::GetMvaValueConcurrent( const Event* const /*ev*/, EvaluationContext& /*context*/ ) const
+{
+   // the methods supporting the concurrent evaluation override it
+   Log() << kFATAL << "<GetMvaValueConcurrent> the method " << GetMethodName()
+         << " does not support the concurrent evaluation" << Endl;
+   return 0;
+}
+
 Bool_t TMVA::MethodBase::IsSignalLike() { 
    return GetMvaValue()*GetSignalReferenceCutOrientation() > GetSignalReferenceCut()*GetSignalReferenceCutOrientation() ? kTRUE : kFALSE; 
 }
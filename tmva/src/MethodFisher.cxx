@@ -264,6 +264,18 @@ Double_t TMVA::MethodFisher::GetMvaValue( Double_t* err, Double_t* errUpper )
 
 }
 
+//_______________________________________________________________________
+Double_t TMVA::MethodFisher::GetMvaValueConcurrent( const Event* const ev, EvaluationContext& context ) const
+{
+   // returns the Fisher value, the event being transformed in the context
+   const Event * tev = GetEvent( ev, context );
+   Double_t result = fF0;
+   for (UInt_t ivar=0; ivar<GetNvar(); ivar++)
+      result += (*fFisherCoeff)[ivar]*tev->GetValue(ivar);
+
+   return result;
+}
+
 //_______________________________________________________________________
 void TMVA::MethodFisher::InitMatrices( void )
 {
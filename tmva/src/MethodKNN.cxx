@@ -69,6 +69,7 @@ TMVA::MethodKNN::MethodKNN( const TString& jobName,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fNThreads(1)
    , fTreeOptDepth(0)
 {
    // standard constructor
@@ -90,6 +91,7 @@ TMVA::MethodKNN::MethodKNN( DataSetInfo& theData,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fNThreads(1)
    , fTreeOptDepth(0)
 {
    // constructor from weight file
@@ -116,6 +118,7 @@ void TMVA::MethodKNN::DeclareOptions()
    // fUseKernel    = false;  // use polynomial kernel weight function
    // fUseWeight    = true;   // count events using weights
    // fUseLDA       = false
+   // fNThreads     = 1;      // number of threads searching the neighbours in GetMvaValues (0: one per core)
 
    DeclareOptionRef(fnkNN         = 20,     "nkNN",         "Number of k-nearest neighbors");
    DeclareOptionRef(fBalanceDepth = 6,      "BalanceDepth", "Binary tree balance depth");
@@ -126,6 +129,7 @@ void TMVA::MethodKNN::DeclareOptions()
    DeclareOptionRef(fUseKernel    = kFALSE, "UseKernel",    "Use polynomial kernel weight");
    DeclareOptionRef(fUseWeight    = kTRUE,  "UseWeight",    "Use weight to count kNN events");
    DeclareOptionRef(fUseLDA       = kFALSE, "UseLDA",       "Use local linear discriminant - experimental feature");
+   DeclareOptionRef(fNThreads     = 1,      "NThreads",     "Number of threads searching the neighbours of blocks of events (0: one per core)");
 }
 
 //_______________________________________________________________________
@@ -300,11 +304,61 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
 
    // search for fnkNN+2 nearest neighbors, pad with two 
    // events to avoid Monte-Carlo events with zero distance
-   // most of CPU time is spent in this recursive function
+   // most of CPU time is spent in this search
    const kNN::Event event_knn(vvec, weight, 3);
    fModule->Find(event_knn, knn + 2);
 
-   const kNN::List &rlist = fModule->GetkNNList();
+   return MethodKNN::getResponse(fModule->GetkNNList(), event_knn);
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues )
+{
+   // Compute classifier response of the events stored one after the other in inputs:
+   // the neighbors of a chunk of events are searched together, by fNThreads threads,
+   // then the response of each event is computed as in GetMvaValue
+
+   const UInt_t nvar    = GetNVariables();
+   const UInt_t nevent  = nvar > 0 ? inputs.size()/nvar : 0;
+   const UInt_t knn     = static_cast<UInt_t>(fnkNN);
+   const UInt_t nchunk  = 1024;
+
+   mvaValues.resize(nevent);
+
+   kNN::VarVec values;
+   std::vector<Double_t> weights;
+   std::vector<kNN::List> lists;
+   Event ev(std::vector<Float_t>(nvar), 0);
+
+   for (UInt_t begin = 0; begin < nevent; begin += nchunk) {
+      const UInt_t n = (nevent - begin < nchunk) ? nevent - begin : nchunk;
+
+      values.resize(n*nvar);
+      weights.resize(n);
+      for (UInt_t k = 0; k < n; ++k) {
+         for (UInt_t ivar = 0; ivar < nvar; ++ivar) ev.SetVal(ivar, inputs[(begin + k)*nvar + ivar]);
+         const Event *tev = GetEvent(&ev);
+         for (UInt_t ivar = 0; ivar < nvar; ++ivar) values[k*nvar + ivar] = tev->GetValue(ivar);
+         weights[k] = tev->GetWeight();
+      }
+
+      // search for fnkNN+2 nearest neighbors, as in GetMvaValue
+      fModule->Find(values, knn + 2, lists, fNThreads);
+
+      for (UInt_t k = 0; k < n; ++k) {
+         const kNN::Event event_knn(kNN::VarVec(values.begin() + k*nvar, values.begin() + (k + 1)*nvar), weights[k], 3);
+         mvaValues[begin + k] = MethodKNN::getResponse(lists[k], event_knn);
+      }
+   }
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodKNN::getResponse(const kNN::List &rlist, const kNN::Event &event_knn)
+{
+   // Compute classifier response from the fnkNN+2 nearest neighbors of the event
+
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+
    if (rlist.size() != knn + 2) {
       Log() << kFATAL << "kNN result list is empty" << Endl;
       return -100.0;  
@@ -442,7 +496,7 @@ const std::vector< Float_t >& TMVA::MethodKNN::GetRegressionValues()
 
    // search for fnkNN+2 nearest neighbors, pad with two 
    // events to avoid Monte-Carlo events with zero distance
-   // most of CPU time is spent in this recursive function
+   // most of CPU time is spent in this search
    const kNN::Event event_knn(vvec, evt->GetWeight(), 3);
    fModule->Find(event_knn, knn + 2);
 
@@ -788,6 +842,9 @@ void TMVA::MethodKNN::GetHelpMessage() const
    Log() << Endl;
    Log() << "The method inclues an option to use a Gaussian kernel to smooth out the k-NN" << Endl
          << "response. The kernel re-weights events using a distance to the test event." << Endl;
+   Log() << Endl;
+   Log() << "The neighbors of the events evaluated by blocks (Reader::EvaluateMVA with a" << Endl
+         << "vector of events) are searched by \"NThreads\" threads." << Endl;
 }
 
 //_______________________________________________________________________
@@ -55,6 +55,12 @@
 #include "TMVA/MethodMLP.h"
 #include "TMVA/TNeuron.h"
 #include "TMVA/TSynapse.h"
+#include "TMVA/TNeuronInputSum.h"
+#include "TMVA/TActivationIdentity.h"
+#include "TMVA/TActivationSigmoid.h"
+#include "TMVA/TActivationTanh.h"
+#include "TMVA/TActivationRadial.h"
+#include "TMVA/DenseNetwork.h"
 #include "TMVA/Timer.h"
 #include "TMVA/Types.h"
 #include "TMVA/Tools.h"
@@ -72,6 +78,45 @@ ClassImp(TMVA::MethodMLP)
 
 using std::vector;
 
+namespace {
+
+   // output errors of the events of a batch, as set by TrainOneEvent through UpdateNetwork
+   class BatchErrors : public TMVA::DenseNetwork::ErrorFunction {
+   public:
+      BatchErrors( const std::vector<Double_t>& targets, const std::vector<Double_t>& desired,
+                   const std::vector<Double_t>& weights, UInt_t nOut,
+                   Bool_t regression, Bool_t multiclass, Bool_t crossEntropy ) :
+         fTargets(targets), fDesired(desired), fWeights(weights), fNOut(nOut),
+         fRegression(regression), fMulticlass(multiclass), fCrossEntropy(crossEntropy) {}
+
+      void GetErrors( UInt_t iev, const Double_t* outputs, Double_t* errors ) const
+      {
+         const Double_t weight = fWeights[iev];
+         if (fRegression || fMulticlass) {
+            for (UInt_t i = 0; i < fNOut; i++) errors[i] = (outputs[i] - fTargets[iev*fNOut+i])*weight;
+            if (fRegression) {
+               // the second update with the desired classification output keeps the
+               // errors of the other outputs: the errors of both updates add up
+               for (UInt_t i = 1; i < fNOut; i++) errors[i] *= 2;
+               errors[0] += (outputs[0] - fDesired[iev])*weight;
+            }
+         }
+         else if (fCrossEntropy) errors[0] = -1./(outputs[0] - 1 + fDesired[iev])*weight;
+         else                    errors[0] = (outputs[0] - fDesired[iev])*weight;
+      }
+
+   private:
+      const std::vector<Double_t>& fTargets;       // targets of the regression or multiclass events
+      const std::vector<Double_t>& fDesired;       // desired output of the classification
+      const std::vector<Double_t>& fWeights;       // event weights
+      UInt_t                       fNOut;          // number of outputs
+      Bool_t                       fRegression;
+      Bool_t                       fMulticlass;
+      Bool_t                       fCrossEntropy;
+   };
+
+}
+
 //______________________________________________________________________________
 TMVA::MethodMLP::MethodMLP( const TString& jobName,
                             const TString& methodTitle,
@@ -88,6 +133,7 @@ TMVA::MethodMLP::MethodMLP( const TString& jobName,
      fResetStep(0), fLearnRate(0.0), fDecayRate(0.0),     
      fBPMode(kSequential), fBpModeS("None"),
      fBatchSize(0), fTestRate(0), fEpochMon(false),
+     fUseDenseLayers(kFALSE), fNThreads(1), fDenseNetwork(0), fEvaluationNetwork(0),
      fGA_nsteps(0), fGA_preCalc(0), fGA_SC_steps(0), 
      fGA_SC_rate(0), fGA_SC_factor(0.0),
      fDeviationsFromTargets(0),
@@ -110,6 +156,7 @@ TMVA::MethodMLP::MethodMLP( DataSetInfo& theData,
      fResetStep(0), fLearnRate(0.0), fDecayRate(0.0),     
      fBPMode(kSequential), fBpModeS("None"),
      fBatchSize(0), fTestRate(0), fEpochMon(false),
+     fUseDenseLayers(kFALSE), fNThreads(1), fDenseNetwork(0), fEvaluationNetwork(0),
      fGA_nsteps(0), fGA_preCalc(0), fGA_SC_steps(0), 
      fGA_SC_rate(0), fGA_SC_factor(0.0),
      fDeviationsFromTargets(0),
@@ -122,7 +169,8 @@ TMVA::MethodMLP::MethodMLP( DataSetInfo& theData,
 TMVA::MethodMLP::~MethodMLP()
 {
    // destructor
-   // nothing to be done
+   delete fDenseNetwork;
+   delete fEvaluationNetwork;
 }
 
 //_______________________________________________________________________
@@ -197,6 +245,11 @@ void TMVA::MethodMLP::DeclareOptions()
    DeclareOptionRef(fBatchSize=-1, "BatchSize",
                     "Batch size: number of events/batch, only set if in Batch Mode, -1 for BatchSize=number_of_events");
 
+   DeclareOptionRef(fUseDenseLayers=kFALSE, "UseDenseLayers",
+                    "Batch mode: back-propagate the events of a batch together through dense weight matrices");
+   DeclareOptionRef(fNThreads=1, "NThreads",
+                    "Number of threads sharing the events of a batch with UseDenseLayers (0: one per core)");
+
    DeclareOptionRef(fImprovement=1e-30, "ConvergenceImprove",
                     "Minimum improvement which counts as improvement (<0 means automatic convergence check is turned off)");
 
@@ -236,6 +289,12 @@ void TMVA::MethodMLP::ProcessOptions()
    if      (fBpModeS == "sequential") fBPMode = kSequential;
    else if (fBpModeS == "batch")      fBPMode = kBatch;
 
+   if (fUseDenseLayers && (fTrainingMethod != kBP || fBPMode != kBatch)) {
+      Log() << kWARNING << "the option UseDenseLayers only applies to the back-propagation in batch mode "
+            << "(TrainingMethod=BP:BPMode=batch) --> switched off" << Endl;
+      fUseDenseLayers = kFALSE;
+   }
+
    //   InitializeLearningRates();
 
    if (fBPMode == kBatch) {
@@ -444,6 +503,8 @@ void TMVA::MethodMLP::Train(Int_t nEpochs)
       fInvHessian.ResizeTo(numSynapses,numSynapses);
       GetApproxInvHessian( fInvHessian ,false);
    }
+
+   BuildEvaluationNetwork();
 }
 
 //______________________________________________________________________________
@@ -997,6 +1058,9 @@ void TMVA::MethodMLP::BackPropagationMinimize(Int_t nEpochs)
    if (fSteps > 0) Log() << kINFO << "Inaccurate progress timing for MLP... " << Endl;
    timer.DrawProgressBar(0);
 
+   delete fDenseNetwork;
+   fDenseNetwork = fUseDenseLayers ? CreateDenseNetwork() : 0;
+
    // estimators
    Double_t trainE = -1;
    Double_t testE  = -1;
@@ -1026,7 +1090,8 @@ void TMVA::MethodMLP::BackPropagationMinimize(Int_t nEpochs)
       }
       Data()->SetCurrentType( Types::kTraining );
 
-      TrainOneEpoch();
+      if (fDenseNetwork) TrainOneEpochDense();
+      else               TrainOneEpoch();
       DecaySynapseWeights(i >= lateEpoch);
 
       // monitor convergence of training and control sample
@@ -1071,6 +1136,9 @@ void TMVA::MethodMLP::BackPropagationMinimize(Int_t nEpochs)
         timer.DrawProgressBar( i, convText );
       }
    }
+
+   delete fDenseNetwork;
+   fDenseNetwork = 0;
 }
 
 //______________________________________________________________________________
@@ -1115,6 +1183,156 @@ void TMVA::MethodMLP::TrainOneEpoch()
    delete[] index;
 }
 
+//______________________________________________________________________________
+TMVA::DenseNetwork* TMVA::MethodMLP::CreateDenseNetwork( Bool_t quiet ) const
+{
+   // copy of the layout of the network for the dense batch mode (the weights and
+   // learning rates are copied at each epoch) or for the concurrent evaluation;
+   // returns 0 if the neurons are not supported
+   TActivation* activations[2] = { fActivation, fOutput };
+   DenseNetwork::EActivation types[2];
+   for (Int_t i=0; i<2; i++) {
+      if      (dynamic_cast<TActivationIdentity*>(activations[i])) types[i] = DenseNetwork::kLinear;
+      else if (dynamic_cast<TActivationSigmoid*>(activations[i]))  types[i] = DenseNetwork::kSigmoid;
+      else if (dynamic_cast<TActivationTanh*>(activations[i]))     types[i] = DenseNetwork::kTanh;
+      else if (dynamic_cast<TActivationRadial*>(activations[i]))   types[i] = DenseNetwork::kRadial;
+      else {
+         if (!quiet) Log() << kWARNING << "UseDenseLayers: unknown neuron activation, the events are trained one by one" << Endl;
+         return 0;
+      }
+   }
+   if (dynamic_cast<TNeuronInputSum*>(fInputCalculator) == 0) {
+      if (!quiet) Log() << kWARNING << "UseDenseLayers requires NeuronInputType=sum, the events are trained one by one" << Endl;
+      return 0;
+   }
+
+   // all the layers but the output one end with a bias neuron
+   std::vector<UInt_t> layout;
+   Int_t numLayers = fNetwork->GetEntriesFast();
+   for (Int_t i = 0; i < numLayers; i++) {
+      Int_t numNeurons = ((TObjArray*)fNetwork->At(i))->GetEntriesFast();
+      layout.push_back( i < numLayers-1 ? numNeurons-1 : numNeurons );
+   }
+   DenseNetwork* network = new DenseNetwork( layout, types[0], types[1] );
+   if (Int_t(network->GetNWeights()) != fSynapses->GetEntriesFast())
+      Log() << kFATAL << "UseDenseLayers: inconsistent number of synapses" << Endl;
+   return network;
+}
+
+//______________________________________________________________________________
+void TMVA::MethodMLP::BuildEvaluationNetwork()
+{
+   // copy the trained network for the concurrent evaluation (no copy if the neurons
+   // are not supported, the network is then evaluated by one thread at a time)
+   delete fEvaluationNetwork;
+   fEvaluationNetwork = CreateDenseNetwork( kTRUE );
+   if (fEvaluationNetwork == 0) return;
+
+   std::vector<Double_t>& weights = fEvaluationNetwork->GetWeights();
+   Int_t numSynapses = fSynapses->GetEntriesFast();
+   for (Int_t i = 0; i < numSynapses; i++) weights[i] = ((TSynapse*)fSynapses->At(i))->GetWeight();
+}
+
+//______________________________________________________________________________
+void TMVA::MethodMLP::ReadWeightsFromXML( void* wghtnode )
+{
+   // read the network and copy it for the concurrent evaluation
+   MethodANNBase::ReadWeightsFromXML( wghtnode );
+   BuildEvaluationNetwork();
+}
+
+//______________________________________________________________________________
+Double_t TMVA::MethodMLP::GetMvaValueConcurrent( const Event* const ev, EvaluationContext& context ) const
+{
+   // get the mva value generated by the copy of the network, the input values and the
+   // values of the neurons being kept in the context
+   if (fEvaluationNetwork == 0) return MethodBase::GetMvaValueConcurrent( ev, context );
+
+   const Event* tev = GetEvent( ev, context );
+   std::vector<Double_t>& values = context.GetBuffer( 0 );
+   const UInt_t nvar = GetNvar();
+   const UInt_t nOut = fEvaluationNetwork->GetNOutputs();
+   values.resize( nvar + nOut );
+   for (UInt_t i = 0; i < nvar; i++) values[i] = tev->GetValue(i);
+   fEvaluationNetwork->Evaluate( &values[0], &values[nvar], context.GetBuffer( 1 ) );
+   return values[nvar];
+}
+
+//______________________________________________________________________________
+void TMVA::MethodMLP::TrainOneEpochDense()
+{
+   // train network over a single epoch/cycle of events in batch mode: the events
+   // are taken in the order of TrainOneEpoch, the ones of a batch being back-propagated
+   // together through the dense weight matrices
+
+   Int_t nEvents = Data()->GetNEvents();
+
+   // randomize the order events will be presented
+   Int_t* index = new Int_t[nEvents];
+   for (Int_t i = 0; i < nEvents; i++) index[i] = i;
+   Shuffle(index, nEvents);
+
+   // the weights and (decayed) learning rates of the synapses
+   Int_t numSynapses = fSynapses->GetEntriesFast();
+   std::vector<Double_t>& weights    = fDenseNetwork->GetWeights();
+   std::vector<Double_t>& learnRates = fDenseNetwork->GetLearningRates();
+   for (Int_t i = 0; i < numSynapses; i++) {
+      TSynapse* synapse = (TSynapse*)fSynapses->At(i);
+      weights[i]    = synapse->GetWeight();
+      learnRates[i] = synapse->GetLearningRate();
+   }
+
+   const UInt_t nvar = GetNvar();
+   const UInt_t nOut = fDenseNetwork->GetNOutputs();
+   std::vector<Double_t> inputs, targets, desired, eventWeights;
+   for (Int_t i = 0; i < nEvents; i++) {
+
+      const Event * ev = GetEvent(index[i]);
+      if ((ev->GetWeight() < 0) && IgnoreEventsWithNegWeightsInTraining() 
+          &&  (Data()->GetCurrentType() == Types::kTraining)){
+         continue;
+      }
+
+      for (UInt_t j = 0; j < nvar; j++) inputs.push_back( ev->GetValue(j) );
+      eventWeights.push_back( ev->GetWeight() );
+      if (DoRegression()) {
+         for (UInt_t j = 0; j < nOut; j++) targets.push_back( ev->GetTarget(j) );
+      }
+      if (DoMulticlass()) {
+         const std::vector<Float_t>& classTargets = *DataInfo().GetTargetsForMulticlass( ev );
+         for (UInt_t j = 0; j < nOut; j++) targets.push_back( classTargets.at(j) );
+      }
+      else desired.push_back( GetDesiredOutput( ev ) );
+
+      if ((i+1)%fBatchSize == 0) {
+         AccumulateDenseGradient( inputs, targets, desired, eventWeights );
+         fDenseNetwork->AdjustWeights();
+      }
+   }
+   // the events after the last complete batch are adjusted with the next batch
+   AccumulateDenseGradient( inputs, targets, desired, eventWeights );
+
+   for (Int_t i = 0; i < numSynapses; i++) ((TSynapse*)fSynapses->At(i))->SetWeight( weights[i] );
+
+   delete[] index;
+}
+
+//______________________________________________________________________________
+void TMVA::MethodMLP::AccumulateDenseGradient( std::vector<Double_t>& inputs, std::vector<Double_t>& targets,
+                                               std::vector<Double_t>& desired, std::vector<Double_t>& weights )
+{
+   // back-propagate the collected events and clear them
+   BatchErrors errors( targets, desired, weights, fDenseNetwork->GetNOutputs(),
+                       DoRegression(), DoMulticlass(), fEstimator==kCE );
+   // like TrainOneEvent, the regression events are updated twice
+   fDenseNetwork->AccumulateGradient( inputs.empty() ? 0 : &inputs[0], weights.size(), errors,
+                                      DoRegression() ? 2 : 1, fNThreads );
+   inputs.clear();
+   targets.clear();
+   desired.clear();
+   weights.clear();
+}
+
 //______________________________________________________________________________
 void TMVA::MethodMLP::Shuffle(Int_t* index, Int_t n)
 {
@@ -1677,5 +1895,10 @@ void TMVA::MethodMLP::GetHelpMessage() const
    Log() << "The number of cycles should be above 500. As said, if the number of" << Endl;
    Log() << "adjustable weights is small compared to the training sample size," << Endl;
    Log() << "using a large number of training samples should not lead to overtraining." << Endl;
+   Log() << "" << Endl;
+   Log() << "In the batch mode of the back-propagation (\"BPMode=batch\"), the option" << Endl;
+   Log() << "\"UseDenseLayers\" back-propagates the events of a batch together through" << Endl;
+   Log() << "the weight matrices of the layers, shared by \"NThreads\" threads. The" << Endl;
+   Log() << "network and its weight file are the same as without the option." << Endl;
 }
 
@@ -74,11 +74,15 @@
 #include "TFile.h"
 #include "TObjString.h"
 #include "TMath.h"
+#include "TMutex.h"
+#include "TVirtualMutex.h"
 
 #include "TMVA/ClassifierFactory.h"
 #include "TMVA/MethodPDERS.h"
 #include "TMVA/Tools.h"
 #include "TMVA/RootFinder.h"
+#include "TMVA/KDTree.h"
+#include "TMVA/ThreadExecutor.h"
 
 #define TMVA_MethodPDERS__countByHand__Debug__
 #undef  TMVA_MethodPDERS__countByHand__Debug__
@@ -103,6 +107,9 @@ TMVA::MethodPDERS::MethodPDERS( const TString& jobName,
    fFcnCall(0),
    fVRangeMode(kAdaptive),
    fKernelEstimator(kBox),
+   fKDTree(0),
+   fNThreads(1),
+   fMutex(0),
    fDelta(0),
    fShift(0),
    fScaleS(0),
@@ -133,6 +140,9 @@ TMVA::MethodPDERS::MethodPDERS( DataSetInfo& theData,
    fFcnCall(0),
    fVRangeMode(kAdaptive),
    fKernelEstimator(kBox),
+   fKDTree(0),
+   fNThreads(1),
+   fMutex(0),
    fDelta(0),
    fShift(0),
    fScaleS(0),
@@ -170,6 +180,8 @@ void TMVA::MethodPDERS::Init( void )
    // default initialisation routine called by all constructors
 
    fBinaryTree = NULL;
+   fKDTree     = new KDTree();
+   fMutex      = new TMutex();
 
    UpdateThis();
 
@@ -185,6 +197,7 @@ void TMVA::MethodPDERS::Init( void )
    fInitialScale    = 0.99;
    fGaussSigma      = 0.1;
    fNormTree        = kFALSE;
+   fNThreads        = 1;
     
    fkNNMin      = Int_t(fNEventsMin);
    fkNNMax      = Int_t(fNEventsMax);
@@ -204,6 +217,8 @@ TMVA::MethodPDERS::~MethodPDERS( void )
    if (fShift) delete fShift;
 
    if (NULL != fBinaryTree) delete fBinaryTree;
+   delete fKDTree;
+   delete fMutex;
 }
 
 //_______________________________________________________________________
@@ -240,6 +255,7 @@ void TMVA::MethodPDERS::DeclareOptions()
    // MaxVIterations    <int>     Maximum number of iterations for adaptive volume range
    // InitialScale      <float>   Initial scale for adaptive volume range           
    // GaussSigma        <float>   Width with respect to the volume size of Gaussian kernel estimator
+   // NThreads          <int>     Number of threads evaluating the blocks of events (0: one per core)
    DeclareOptionRef(fVolumeRange="Adaptive", "VolumeRangeMode", "Method to determine volume size");
    AddPreDefVal(TString("Unscaled"));
    AddPreDefVal(TString("MinMax"));
@@ -270,6 +286,7 @@ void TMVA::MethodPDERS::DeclareOptions()
    DeclareOptionRef(fInitialScale  , "InitialScale",   "InitialScale for adaptive volume range");
    DeclareOptionRef(fGaussSigma    , "GaussSigma",     "Width (wrt volume size) of Gaussian kernel estimator");
    DeclareOptionRef(fNormTree      , "NormTree",       "Normalize binary search tree");
+   DeclareOptionRef(fNThreads      , "NThreads",       "Number of threads evaluating the blocks of events (0: one per core)");
 }
 
 //_______________________________________________________________________
@@ -372,6 +389,62 @@ Double_t TMVA::MethodPDERS::GetMvaValue( Double_t* err, Double_t* errUpper )
    return this->CRScalc( *GetEvent() );
 }
 
+//_______________________________________________________________________
+class TMVA::MethodPDERS::VolumeTask : public TMVA::ThreadExecutor::Task {
+   // computes CRScalc for the events [begin,end) of a block; the volumes
+   // are local to CRScalc and the trees are only read
+public:
+   VolumeTask( MethodPDERS& method, const std::vector<Event>& events, Double_t* mvaValues ) :
+      fMethod(method), fEvents(events), fMvaValues(mvaValues) {}
+   void Process( UInt_t /*iblock*/, UInt_t begin, UInt_t end ) {
+      for (UInt_t iev=begin; iev<end; iev++) fMvaValues[iev] = fMethod.CRScalc( fEvents[iev] );
+   }
+private:
+   MethodPDERS&              fMethod;
+   const std::vector<Event>& fEvents;
+   Double_t*                 fMvaValues;
+};
+
+//_______________________________________________________________________
+void TMVA::MethodPDERS::GetMvaValues( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues )
+{
+   // the events are transformed by chunks, then evaluated by fNThreads threads; the
+   // kNN volume range mode keeps the distance of the last event in the method
+   // (fMax_distance) and evaluates the events one by one
+   if (fVRangeMode == kkNN || MethodPDERS_UseFindRoot) {
+      MethodBase::GetMvaValues( inputs, mvaValues );
+      return;
+   }
+
+   if (fInitializedVolumeEle == kFALSE) {
+      fInitializedVolumeEle = kTRUE;
+
+      // binary trees must exist
+      assert( fBinaryTree );
+
+      CalcAverages();
+      SetVolumeElement();
+   }
+
+   const UInt_t nvar    = GetNvar();
+   const UInt_t nEvents = nvar > 0 ? inputs.size()/nvar : 0;
+   const UInt_t nChunk  = 1024;
+   mvaValues.resize( nEvents );
+
+   std::vector<Event> events;
+   Event ev( std::vector<Float_t>( nvar ), 0 );
+   for (UInt_t begin=0; begin<nEvents; begin+=nChunk) {
+      const UInt_t n = (nEvents-begin < nChunk) ? nEvents-begin : nChunk;
+      events.clear();
+      for (UInt_t k=0; k<n; k++) {
+         for (UInt_t ivar=0; ivar<nvar; ivar++) ev.SetVal( ivar, inputs[(begin+k)*nvar+ivar] );
+         events.push_back( *GetEvent( &ev ) );
+      }
+      VolumeTask task( *this, events, &mvaValues[begin] );
+      ThreadExecutor::Run( task, n, fNThreads );
+   }
+}
+
 //_______________________________________________________________________
 const std::vector< Float_t >& TMVA::MethodPDERS::GetRegressionValues()
 {
@@ -457,6 +530,59 @@ void TMVA::MethodPDERS::CreateBinarySearchTree( Types::ETreeType type )
 
       Log() << kVERBOSE << "Signal and background scales: " << fScaleS << " " << fScaleB << Endl;
    }
+
+   BuildKDTree();
+}
+
+//_______________________________________________________________________
+void TMVA::MethodPDERS::BuildKDTree()
+{
+   // the volume searches run on a copy of the events of the binary search tree
+   // laid out in arrays (KDTree), which returns the same events
+   fKDNode.clear();
+   std::vector<Float_t>  points;
+   std::vector<Double_t> weights;
+   std::vector<const BinarySearchTreeNode*> stack;
+   if (fBinaryTree->GetRoot() != NULL) stack.push_back( (const BinarySearchTreeNode*)fBinaryTree->GetRoot() );
+   while (!stack.empty()) {
+      const BinarySearchTreeNode* node = stack.back();
+      stack.pop_back();
+      fKDNode.push_back( node );
+      points.insert( points.end(), node->GetEventV().begin(), node->GetEventV().begin()+GetNvar() );
+      weights.push_back( node->GetWeight() );
+      if (node->GetLeft()  != NULL) stack.push_back( (const BinarySearchTreeNode*)node->GetLeft() );
+      if (node->GetRight() != NULL) stack.push_back( (const BinarySearchTreeNode*)node->GetRight() );
+   }
+   fKDTree->Build( points, GetNvar(), weights );
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodPDERS::SearchVolume( Volume* volume, std::vector<const BinarySearchTreeNode*>* events ) const
+{
+   // sum of the weights of the events in the volume, as BinarySearchTree::SearchVolume
+   std::vector<UInt_t> points;
+   const Double_t count = fKDTree->SearchVolume( &(*volume->fLower)[0], &(*volume->fUpper)[0],
+                                                 events ? &points : 0 );
+   if (events) {
+      for (UInt_t i=0; i<points.size(); i++) events->push_back( fKDNode[points[i]] );
+   }
+   return count;
+}
+
+//_______________________________________________________________________
+Int_t TMVA::MethodPDERS::SearchVolumeWithMaxLimit( Volume* volume, std::vector<const BinarySearchTreeNode*>* events,
+                                                   Int_t maxPoints ) const
+{
+   // number of events in the volume, at most maxPoints (no limit if negative), as
+   // BinarySearchTree::SearchVolumeWithMaxLimit
+   std::vector<UInt_t> points;
+   const UInt_t count = fKDTree->SearchVolumeWithMaxLimit( &(*volume->fLower)[0], &(*volume->fUpper)[0],
+                                                           events ? &points : 0,
+                                                           maxPoints < 0 ? fKDNode.size() : UInt_t(maxPoints) );
+   if (events) {
+      for (UInt_t i=0; i<points.size(); i++) events->push_back( fKDNode[points[i]] );
+   }
+   return Int_t(count);
 }
 
 //_______________________________________________________________________
@@ -522,7 +648,7 @@ Double_t TMVA::MethodPDERS::GetVolumeContentForRoot( Double_t scale )
    Volume v( *fHelpVolume );
    v.ScaleInterval( scale );
 
-   Double_t count = GetBinaryTree()->SearchVolume( &v );
+   Double_t count = SearchVolume( &v );
 
    v.Delete();
    return count;
@@ -543,7 +669,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
 #ifdef  TMVA_MethodPDERS__countByHand__Debug__
 
    // starting values
-   count = fBinaryTree->SearchVolume( volume );
+   count = SearchVolume( volume );
 
    Int_t iS = 0, iB = 0;
    UInt_t nvar = GetNvar();
@@ -578,7 +704,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
       Volume* svolume = new Volume( lb, ub );
       // starting values
 
-      fBinaryTree->SearchVolume( svolume, &events );
+      SearchVolume( svolume, &events );
    }
    else if (fVRangeMode == kAdaptive) {      // adaptive volume
 
@@ -598,7 +724,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
 
          volume->ScaleInterval( scale );
 
-         fBinaryTree->SearchVolume( volume, &events );
+         SearchVolume( volume, &events );
 
          fHelpVolume = NULL;
       }
@@ -606,20 +732,23 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
       else {
 
          // starting values
-         count = fBinaryTree->SearchVolume( volume );
+         count = SearchVolume( volume );
 
          Float_t nEventsO = count;
          Int_t i_=0;
 
          while (nEventsO < fNEventsMin) { // this isn't a sain start... try again
             volume->ScaleInterval( 1.15 );
-            count = fBinaryTree->SearchVolume( volume );
+            count = SearchVolume( volume );
             nEventsO = count;
             i_++;
          }
-         if (i_ > 50) Log() << kWARNING << "warning in event: " << e
-                            << ": adaptive volume pre-adjustment reached "
-                            << ">50 iterations in while loop (" << i_ << ")" << Endl;
+         if (i_ > 50) {
+            R__LOCKGUARD( fMutex ); // GetMvaValues threads
+            Log() << kWARNING << "warning in event: " << e
+                  << ": adaptive volume pre-adjustment reached "
+                  << ">50 iterations in while loop (" << i_ << ")" << Endl;
+         }
 
          Float_t nEventsN    = nEventsO;
          Float_t nEventsE    = 0.5*(fNEventsMin + fNEventsMax);
@@ -635,7 +764,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
                // search for events in rescaled volume
                Volume* v = new Volume( *volume );
                v->ScaleInterval( scale );
-               nEventsN  = fBinaryTree->SearchVolume( v );
+               nEventsN  = SearchVolume( v );
 
                // determine next iteration (linear approximation)
                if (nEventsN > 1 && nEventsN - nEventsO != 0)
@@ -665,15 +794,17 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
          // last sanity check
          nEventsN = nEventsBest;
          // include "1" to cover float precision
-         if (nEventsN < fNEventsMin-1 || nEventsN > fNEventsMax+1)
+         if (nEventsN < fNEventsMin-1 || nEventsN > fNEventsMax+1) {
+            R__LOCKGUARD( fMutex ); // GetMvaValues threads
             Log() << kWARNING << "warning in event " << e
                   << ": adaptive volume adjustment reached "
                   << "max. #iterations (" << fMaxVIterations << ")"
                   << "[ nEvents: " << nEventsN << "  " << fNEventsMin << "  " << fNEventsMax << "]"
                   << Endl;
+         }
 
          volume->ScaleInterval( scaleBest );
-         fBinaryTree->SearchVolume( volume, &events );
+         SearchVolume( volume, &events );
       }
 
       // end of adaptive method
@@ -683,7 +814,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
 
       events.clear();
       // check number of signals in begining volume
-      Int_t kNNcount = fBinaryTree->SearchVolumeWithMaxLimit( &v, &events, fkNNMax+1 );
+      Int_t kNNcount = SearchVolumeWithMaxLimit( &v, &events, fkNNMax+1 );
       //if this number is too large return fkNNMax+1
 
       Int_t t_times = 0;  // number of iterations
@@ -701,7 +832,7 @@ void TMVA::MethodPDERS::GetSample( const Event& e,
 
          v = *volume ;
 
-         kNNcount = fBinaryTree->SearchVolumeWithMaxLimit( &v, &events, fkNNMax+1 );  //new search
+         kNNcount = SearchVolumeWithMaxLimit( &v, &events, fkNNMax+1 );  //new search
 
          t_times++;
 
@@ -1093,6 +1224,7 @@ void TMVA::MethodPDERS::ReadWeightsFromXML( void* wghtnode)
    fBinaryTree->SetPeriode( GetNvar() );
    fBinaryTree->CalcStatistics();
    fBinaryTree->CountNodes();
+   BuildKDTree();
    fScaleS = 1.0/fBinaryTree->GetSumOfWeights( Types::kSignal );
    fScaleB = 1.0/fBinaryTree->GetSumOfWeights( Types::kBackground );
    Log() << kINFO << "signal and background scales: " << fScaleS << " " << fScaleB << Endl;
@@ -1117,6 +1249,8 @@ void TMVA::MethodPDERS::ReadWeightsFromStream( std::istream& istr)
 
    fBinaryTree->CountNodes();
 
+   BuildKDTree();
+
    // these are the signal and background scales for the weights
    fScaleS = 1.0/fBinaryTree->GetSumOfWeights( Types::kSignal );
    fScaleB = 1.0/fBinaryTree->GetSumOfWeights( Types::kBackground );
@@ -1207,4 +1341,7 @@ void TMVA::MethodPDERS::GetHelpMessage() const
    Log() << "to reduce the number of events required in the volume, and/or to enlarge" << Endl;
    Log() << "the allowed range (\"NeventsMin/Max\"). PDERS is relatively insensitive" << Endl;
    Log() << "to the width (\"GaussSigma\") of the Gaussian kernel (if used)." << Endl;
+   Log() << "The events evaluated by blocks (Reader::EvaluateMVA with a vector of" << Endl;
+   Log() << "events) are shared by \"NThreads\" threads, except with the kNN volume" << Endl;
+   Log() << "range mode." << Endl;
 }
@@ -185,6 +185,8 @@ void TMVA::kNN::ModulekNN::Clear()
       fTree = 0;
    }
 
+   fKDTree.Clear();
+   fKDNode.clear();
    fVarScale.clear();
    fCount.clear();
    fEvent.clear();
@@ -302,8 +304,20 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
       return kFALSE;      
    }      
    
+   // the events of positive weight, the only ones returned by the searches,
+   // are also stored in the kd-tree laid out in arrays
+   std::vector<Float_t> points;
+   std::vector<Double_t> weights;
+   fKDNode.clear();
+
    for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
-      fTree->Add(*event, 0);
+      const Node<Event> *node = fTree->Add(*event, 0);
+
+      if (event->GetWeight() > 0.0) {
+         points.insert(points.end(), event->GetVars().begin(), event->GetVars().end());
+         weights.push_back(event->GetWeight());
+         fKDNode.push_back(node);
+      }
       
       std::map<Short_t, UInt_t>::iterator cit = fCount.find(event->GetType());
       if (cit == fCount.end()) {
@@ -314,6 +328,8 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
       }
    }
    
+   fKDTree.Build(points, fDimn, weights);
+
    for (std::map<Short_t, UInt_t>::const_iterator it = fCount.begin(); it != fCount.end(); ++it) {
       Log() << kINFO << "<Fill> Class " << it->first << " has " << std::setw(8) 
               << it->second << " events" << Endl;
@@ -362,9 +378,68 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
    }
    else
    {
-      // recursive kd-tree search for nfind-nearest neighbors
-      // count nodes and do not use event weight
-      kNN::Find<kNN::Event>(fkNNList, fTree, event, nfind);      
+      // search for nfind-nearest neighbors in the kd-tree laid out in arrays,
+      // which holds the same events as the nodes of positive weight of fTree
+      std::vector<KDTree::Neighbour> neighbours;
+      fKDTree.FindNearest(&(event.GetVars()[0]), nfind, neighbours);
+      for (std::vector<KDTree::Neighbour>::const_iterator nit = neighbours.begin(); nit != neighbours.end(); ++nit) {
+         fkNNList.push_back(Elem(fKDNode[nit->second], nit->first));
+      }
+   }
+
+   return kTRUE;
+}
+
+//-------------------------------------------------------------------------------------------
+Bool_t TMVA::kNN::ModulekNN::Find(const VarVec &values, const UInt_t nfind,
+                                  std::vector<List> &lists, const UInt_t nThreads) const
+{
+   // find in tree the nfind closest events of several events at a time,
+   // with the same search as Find(event, nfind, "count")
+
+   if (!fTree) {
+      Log() << kFATAL << "ModulekNN::Find() - tree has not been filled" << Endl;
+      return kFALSE;
+   }
+   if (fDimn < 1 || values.size() % fDimn != 0) {
+      Log() << kFATAL << "ModulekNN::Find() - number of dimension does not match training events" << Endl;
+      return kFALSE;
+   }
+   if (nfind < 1) {
+      Log() << kFATAL << "ModulekNN::Find() - requested 0 nearest neighbors" << Endl;
+      return kFALSE;
+   }
+
+   const UInt_t nevent = values.size()/fDimn;
+
+   // rescale the variables as in Scale()
+   VarVec scaled(values);
+   if (!fVarScale.empty()) {
+      for (UInt_t ivar = 0; ivar < fDimn; ++ivar) {
+         std::map<Int_t, Double_t>::const_iterator fit = fVarScale.find(ivar);
+         if (fit == fVarScale.end() || !(fit->second > 0.0)) {
+            Log() << kFATAL << "ModulekNN::Find() - failed to find scale for " << ivar << Endl;
+            continue;
+         }
+         for (UInt_t ievent = 0; ievent < nevent; ++ievent) {
+            scaled[ievent*fDimn + ivar] /= fit->second;
+         }
+      }
+   }
+
+   std::vector<KDTree::Neighbour> neighbours;
+   fKDTree.FindNearest(nevent > 0 ? &scaled[0] : 0, nevent, nfind, neighbours, nThreads);
+
+   lists.resize(nevent);
+   for (UInt_t ievent = 0; ievent < nevent; ++ievent) {
+      List &nlist = lists[ievent];
+      nlist.clear();
+      for (UInt_t j = 0; j < nfind; ++j) {
+         const KDTree::Neighbour &neighbour = neighbours[ievent*nfind + j];
+         if (neighbour.second < fKDNode.size()) {
+            nlist.push_back(Elem(fKDNode[neighbour.second], neighbour.first));
+         }
+      }
    }
 
    return kTRUE;
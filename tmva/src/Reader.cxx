@@ -86,6 +86,16 @@
 //    delete reader;
 //  ---------------------------------------------------------------------
 //
+//  Several threads can share a Reader (and a single copy of each booked
+//  method) when they evaluate it through
+//
+//      double mva = reader->EvaluateMVA( values, "BDT method", context );
+//
+//  each thread keeping its own TMVA::EvaluationContext for the values
+//  computed during the evaluation. BDTs, MLPs and Fisher discriminants are
+//  then evaluated by all the threads at the same time, the other methods
+//  by one thread at a time. The methods are booked before the threads start.
+//
 //  An example application of the Reader can be found in TMVA/macros/TMVApplication.C.
 //_______________________________________________________________________
 
@@ -99,6 +109,8 @@
 #include "TKey.h"
 #include "TVector.h"
 #include "TXMLEngine.h"
+#include "TMutex.h"
+#include "TVirtualMutex.h"
 
 #include <cstdlib>
 
@@ -130,6 +142,7 @@ TMVA::Reader::Reader( const TString& theOption, Bool_t verbose )
      fCalculateError(kFALSE),
      fMvaEventError( 0 ),
      fMvaEventErrorUpper( 0 ),
+     fMutex ( 0 ),
      fLogger ( 0 )
 {
    // constructor
@@ -154,6 +167,7 @@ TMVA::Reader::Reader( std::vector<TString>& inputVars, const TString& theOption,
      fCalculateError(kFALSE),
      fMvaEventError( 0 ),
      fMvaEventErrorUpper( 0 ),   //zjh
+     fMutex ( 0 ),
      fLogger ( 0 )
 {
    // constructor
@@ -184,6 +198,7 @@ TMVA::Reader::Reader( std::vector<std::string>& inputVars, const TString& theOpt
      fCalculateError(kFALSE),
      fMvaEventError( 0 ),
      fMvaEventErrorUpper( 0 ),
+     fMutex ( 0 ),
      fLogger ( 0 )
 {
    // constructor
@@ -213,6 +228,7 @@ TMVA::Reader::Reader( const std::string& varNames, const TString& theOption, Boo
      fCalculateError(kFALSE),
      fMvaEventError( 0 ),
      fMvaEventErrorUpper( 0 ),
+     fMutex ( 0 ),
      fLogger ( 0 )
 {
    // constructor
@@ -240,6 +256,7 @@ TMVA::Reader::Reader( const TString& varNames, const TString& theOption, Bool_t
      fCalculateError(kFALSE),
      fMvaEventError( 0 ),
      fMvaEventErrorUpper( 0 ),
+     fMutex ( 0 ),
      fLogger ( 0 )
 {
    // constructor
@@ -275,6 +292,7 @@ TMVA::Reader::~Reader( void )
 
    delete fDataSetManager; // DSMTEST
 
+   delete fMutex;
    delete fLogger;
 }
 
@@ -287,6 +305,8 @@ void TMVA::Reader::Init( void )
 
    gConfig().SetUseColor( fColor );
    gConfig().SetSilent  ( fSilent );
+
+   fMutex = new TMutex;
 }
 
 //_______________________________________________________________________
@@ -500,6 +520,63 @@ Double_t TMVA::Reader::EvaluateMVA( const std::vector<Double_t>& inputVec, const
    return EvaluateMVA( fTmpEvalVec, methodTag, aux );
 }
 
+//_______________________________________________________________________
+Double_t TMVA::Reader::EvaluateMVA( const std::vector<Float_t>& inputVec, const TString& methodTag,
+                                    EvaluationContext& context, Double_t aux ) const
+{
+   // Evaluate a std::vector<float> of input data for a given method, the values computed
+   // for the event being kept in the context: several threads may evaluate the methods
+   // of the Reader at the same time, each with its own context. The methods supporting
+   // it (BDT, MLP, Fisher) are evaluated concurrently, the other ones by one thread at a
+   // time. No error is computed. The methods must be booked before the threads start.
+   // The parameter aux is obligatory for the cuts method where it represents the efficiency cutoff
+   std::map<TString, IMethod*>::const_iterator it = fMethodMap.find( methodTag );
+   MethodBase* meth = (it == fMethodMap.end()) ? 0 : dynamic_cast<TMVA::MethodBase*>(it->second);
+   if (meth == 0) {
+      Log() << kFATAL << "<EvaluateMVA> unknown method in map: \"" << methodTag << "\"" << Endl;
+      return 0;
+   }
+
+   const Event* ev = context.SetInputs( inputVec );
+   if (meth->GetMethodType() != TMVA::Types::kCuts && meth->SupportsConcurrentEvaluation())
+      return meth->GetMvaValueConcurrent( ev, context );
+
+   R__LOCKGUARD( fMutex );
+   if (meth->GetMethodType() == TMVA::Types::kCuts) {
+      TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(meth);
+      if(mc)
+         mc->SetTestSignalEfficiency( aux );
+   }
+   return meth->GetMvaValue( ev );
+}
+
+//_______________________________________________________________________
+void TMVA::Reader::EvaluateMVA( const std::vector<Float_t>& inputs, std::vector<Double_t>& mvaValues,
+                                const TString& methodTag, Double_t aux )
+{
+   // Evaluate a block of events for a given method: inputs holds the input variables of
+   // the first event, then the ones of the second event, etc., and mvaValues is filled
+   // with one response per event. BDTs evaluate the events of the block together.
+   // The parameter aux is obligatory for the cuts method where it represents the efficiency cutoff
+   IMethod* imeth = FindMVA( methodTag );
+   MethodBase* meth = dynamic_cast<TMVA::MethodBase*>(imeth);
+   mvaValues.clear();
+   if(meth==0) return;
+
+   const UInt_t nvar = DataInfo().GetNVariables();
+   if (nvar == 0 || inputs.size() % nvar != 0) {
+      Log() << kWARNING << "<EvaluateMVA> the size of the input vector (" << inputs.size()
+            << ") is not a multiple of the number of variables (" << nvar << ")" << Endl;
+   }
+
+   if (meth->GetMethodType() == TMVA::Types::kCuts) {
+      TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(meth);
+      if(mc)
+         mc->SetTestSignalEfficiency( aux );
+   }
+   meth->GetMvaValues( inputs, mvaValues );
+}
+
 //_______________________________________________________________________
 Double_t TMVA::Reader::EvaluateMVA( const TString& methodTag, Double_t aux )
 {
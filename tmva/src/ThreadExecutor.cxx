@@ -0,0 +1,66 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : ThreadExecutor                                                        *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include "TMVA/ThreadExecutor.h"
+#include "TThreadTeam.h"
+
+namespace {
+
+   // the blocks of a task as the parts of a TThreadTeam job
+   class BlockJob : public TThreadTeam::TJob {
+   public:
+      BlockJob( TMVA::ThreadExecutor::Task& task, UInt_t n, UInt_t nBlocks ) :
+         fTask( task ), fN( n ), fNBlocks( nBlocks ) {}
+      void Run( UInt_t iblock )
+      {
+         fTask.Process( iblock,
+                        TMVA::ThreadExecutor::BlockBegin( iblock, fN, fNBlocks ),
+                        TMVA::ThreadExecutor::BlockBegin( iblock+1, fN, fNBlocks ) );
+      }
+   private:
+      TMVA::ThreadExecutor::Task& fTask;    // the loop
+      UInt_t                      fN;       // number of items of the loop
+      UInt_t                      fNBlocks; // number of blocks of the loop
+   };
+
+}
+
+//_______________________________________________________________________
+void TMVA::ThreadExecutor::Run( Task& task, UInt_t n, UInt_t nThreads )
+{
+   // process the items [0,n) of the task by nThreads blocks of contiguous items
+   if (nThreads == 0) nThreads = GetNCores();
+   if (nThreads > n) nThreads = n;
+   if (nThreads <= 1) {
+      if (n > 0) task.Process( 0, 0, n );
+      return;
+   }
+   BlockJob job( task, n, nThreads );
+   TThreadTeam::Run( job, nThreads );
+}
+
+//_______________________________________________________________________
+UInt_t TMVA::ThreadExecutor::GetNCores()
+{
+   // number of cores of the machine
+   return TThreadTeam::GetNCores();
+}
@@ -153,6 +153,24 @@ const TMVA::Event* TMVA::TransformationHandler::Transform( const Event* ev ) con
    return trEv;
 }
 
+//_______________________________________________________________________
+const TMVA::Event* TMVA::TransformationHandler::Transform( const Event* ev, std::vector<Event>& output ) const 
+{
+   // the transformation, each transformation writing into its own event of output
+   if (output.size() < (UInt_t)fTransformations.GetSize()) output.resize( fTransformations.GetSize() );
+
+   TListIter trIt(&fTransformations);
+   std::vector<Int_t>::const_iterator rClsIt = fTransformationsReferenceClasses.begin();
+   const Event* trEv = ev;
+   UInt_t itrf = 0;
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (rClsIt == fTransformationsReferenceClasses.end()) Log() << kFATAL<< "invalid read in TransformationHandler::Transform " <<Endl;
+      trEv = trf->TransformInto(trEv, &output[itrf++], (*rClsIt) );
+      rClsIt++;
+   }
+   return trEv;
+}
+
 //_______________________________________________________________________
 const TMVA::Event* TMVA::TransformationHandler::InverseTransform( const Event* ev, Bool_t suppressIfNoTargets ) const 
 {
@@ -157,7 +157,7 @@ std::vector<TString>* TMVA::VariableDecorrTransform::GetTransformationStrings( I
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event* const ev, Int_t cls ) const
+const TMVA::Event* TMVA::VariableDecorrTransform::TransformInto( const TMVA::Event* const ev, TMVA::Event* output, Int_t cls ) const
 {
    // apply the decorrelation transformation
    if (!IsCreated())
@@ -184,11 +184,6 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
                << Endl;
    }
 
-   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
-      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
-      fTransformedEvent = new Event();
-   }
-
    // transformation to decorrelate the variables
    const Int_t nvar = fGet.size();
 
@@ -202,8 +197,8 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
       if( numMasked>0 && numOK>0 ){
 	 Log() << kFATAL << "You mixed variables and targets in the decorrelation transformation. This is not possible." << Endl;
       }
-      SetOutput( fTransformedEvent, input, mask, ev );
-      return fTransformedEvent;
+      SetOutput( output, input, mask, ev );
+      return output;
    }
 
    TVectorD vec( nvar );
@@ -215,9 +210,9 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
    input.clear();
    for (Int_t ivar=0; ivar<nvar; ivar++) input.push_back( vec(ivar) );
 
-   SetOutput( fTransformedEvent, input, mask, ev );
+   SetOutput( output, input, mask, ev );
 
-   return fTransformedEvent;
+   return output;
 }
 
 //_______________________________________________________________________
@@ -118,7 +118,7 @@ Bool_t TMVA::VariableGaussTransform::PrepareTransformation (const std::vector<Ev
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev, Int_t cls ) const
+const TMVA::Event* TMVA::VariableGaussTransform::TransformInto(const Event* const ev, Event* output, Int_t cls ) const
 {
    // apply the Gauss transformation
 
@@ -135,7 +135,7 @@ const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev
    UInt_t inputSize = fGet.size();
 
    std::vector<Float_t> input(0);
-   std::vector<Float_t> output(0);
+   std::vector<Float_t> gaussian(0);
 
    std::vector<Char_t> mask; // entries with kTRUE must not be transformed
    GetInput( ev, input, mask );
@@ -163,7 +163,7 @@ const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev
          cumulant = TMath::Max(cumulant,0.+10e-10);
 
          if (fFlatNotGauss)
-            output.push_back( cumulant ); 
+            gaussian.push_back( cumulant ); 
          else {
             // sanity correction for out-of-range values
             Double_t maxErfInvArgRange = 0.99999999;
@@ -171,19 +171,14 @@ const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev
             arg = TMath::Min(+maxErfInvArgRange,arg);
             arg = TMath::Max(-maxErfInvArgRange,arg);
             
-            output.push_back( 1.414213562*TMath::ErfInverse(arg) );
+            gaussian.push_back( 1.414213562*TMath::ErfInverse(arg) );
          }
       }
    }
    
-   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
-      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
-      fTransformedEvent = new Event();
-   }
-
-   SetOutput( fTransformedEvent, output, mask, ev );
+   SetOutput( output, gaussian, mask, ev );
 
-   return fTransformedEvent;
+   return output;
 }
 
 //_______________________________________________________________________
@@ -82,7 +82,7 @@ void TMVA::VariableIdentityTransform::ReadFromXML( void* )
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariableIdentityTransform::Transform (const TMVA::Event* const ev, Int_t ) const 
+const TMVA::Event* TMVA::VariableIdentityTransform::TransformInto( const TMVA::Event* const ev, TMVA::Event* /*output*/, Int_t ) const
 {
    // identity transform returns same event
    return ev;
@@ -98,7 +98,7 @@ Bool_t TMVA::VariableNormalizeTransform::PrepareTransformation (const std::vecto
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Event* const ev, Int_t cls ) const
+const TMVA::Event* TMVA::VariableNormalizeTransform::TransformInto( const TMVA::Event* const ev, TMVA::Event* output, Int_t cls ) const
 {
 
    // apply the normalization transformation
@@ -115,12 +115,10 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
    // EVT workaround end
 
    FloatVector input; // will be filled with the selected variables, targets, (spectators)
-   FloatVector output; // will be filled with the selected variables, targets, (spectators)
+   FloatVector normalized; // will be filled with the selected variables, targets, (spectators)
    std::vector<Char_t> mask; // entries with kTRUE must not be transformed
    GetInput( ev, input, mask );
 
-   if (fTransformedEvent==0) fTransformedEvent = new Event();
-
    Float_t min,max;
    const FloatVector& minVector = fMin.at(cls); 
    const FloatVector& maxVector = fMax.at(cls);
@@ -143,14 +141,14 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
       Float_t scale  = 1.0/(max-min);
 
       Float_t valnorm = (val-offset)*scale * 2 - 1;
-      output.push_back( valnorm );
+      normalized.push_back( valnorm );
 
       ++iidx;
       ++itMask;
    }
    
-   SetOutput( fTransformedEvent, output, mask, ev );
-   return fTransformedEvent;
+   SetOutput( output, normalized, mask, ev );
+   return output;
 }
 
 //_______________________________________________________________________
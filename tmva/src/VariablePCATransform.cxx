@@ -112,7 +112,7 @@ Bool_t TMVA::VariablePCATransform::PrepareTransformation (const std::vector<Even
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev, Int_t cls ) const
+const TMVA::Event* TMVA::VariablePCATransform::TransformInto( const Event* const ev, Event* output, Int_t cls ) const
 {
    // apply the principal component analysis
    if (!IsCreated()) return 0;
@@ -131,10 +131,6 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
 
    // Perform PCA and put it into PCAed events tree
 
-   if (fTransformedEvent==0 ) {
-      fTransformedEvent = new Event();
-   }
-
    std::vector<Float_t> input;
    std::vector<Char_t>  mask;
    std::vector<Float_t> principalComponents;
@@ -147,14 +143,14 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
       if( numMasked>0 && numOK>0 ){
 	 Log() << kFATAL << "You mixed variables and targets in the decorrelation transformation. This is not possible." << Endl;
       }
-      SetOutput( fTransformedEvent, input, mask, ev );
-      return fTransformedEvent;
+      SetOutput( output, input, mask, ev );
+      return output;
    }
 
    X2P( principalComponents, input, cls );
-   SetOutput( fTransformedEvent, principalComponents, mask, ev );
+   SetOutput( output, principalComponents, mask, ev );
 
-   return fTransformedEvent;
+   return output;
 }
 
 //_______________________________________________________________________
@@ -74,21 +74,19 @@ Bool_t TMVA::VariableRearrangeTransform::PrepareTransformation (const std::vecto
 }
 
 //_______________________________________________________________________
-const TMVA::Event* TMVA::VariableRearrangeTransform::Transform( const TMVA::Event* const ev, Int_t /*cls*/ ) const
+const TMVA::Event* TMVA::VariableRearrangeTransform::TransformInto( const TMVA::Event* const ev, TMVA::Event* output, Int_t /*cls*/ ) const
 {
    if (!IsEnabled()) return ev;
 
    // apply the normalization transformation
    if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
 
-   if (fTransformedEvent==0) fTransformedEvent = new Event();
-
    FloatVector input; // will be filled with the selected variables, (targets)
    std::vector<Char_t> mask; // masked variables
    GetInput( ev, input, mask );
-   SetOutput( fTransformedEvent, input, mask, ev );
+   SetOutput( output, input, mask, ev );
 
-   return fTransformedEvent;
+   return output;
 }
 
 //_______________________________________________________________________
@@ -37,6 +37,7 @@
 #include "TH1.h"
 #include "TH2.h"
 #include "TProfile.h"
+#include "TVirtualMutex.h"
 
 #include "TMVA/VariableTransformBase.h"
 #include "TMVA/Ranking.h"
@@ -300,6 +301,26 @@ void TMVA::VariableTransformBase::SelectInput( const TString& _inputVariables, B
 }
 
 
+//_______________________________________________________________________
+const TMVA::Event* TMVA::VariableTransformBase::Transform( const Event* const ev, Int_t cls ) const
+{
+   // apply the transformation, the result being kept in the event of the transformation
+   if (fTransformedEvent==0) fTransformedEvent = new Event();
+   return TransformInto( ev, fTransformedEvent, cls );
+}
+
+//_______________________________________________________________________
+const TMVA::Event* TMVA::VariableTransformBase::TransformInto( const Event* const ev, Event* output, Int_t cls ) const
+{
+   // apply the transformation of a derived class which only overrides Transform, and copy
+   // the result into output; the calls are serialized since Transform writes into the
+   // event of the transformation
+   static TVirtualMutex* transformMutex = 0;
+   R__LOCKGUARD2( transformMutex );
+   output->CopyVarValues( *Transform( ev, cls ) );
+   return output;
+}
+
 //_______________________________________________________________________
 Bool_t TMVA::VariableTransformBase::GetInput( const Event* event, std::vector<Float_t>& input, std::vector<Char_t>& mask, Bool_t backTransformation ) const
 {
@@ -47,6 +47,9 @@ private:
 
    // Helper for managing the compressed buffer.
    void InitializeCompressedBuffer(Int_t len, TFile* file);
+
+   // Give back the part of a memory mapped file used by fBufferRef.
+   void ReleaseMappedBuffer();
  
 protected:
    Int_t       fBufferSize;      //fBuffer length in bytes
@@ -60,6 +63,7 @@ protected:
    TBuffer    *fCompressedBufferRef; //! Compressed buffer.
    Bool_t      fOwnsCompressedBuffer; //! Whether or not we own the compressed buffer.
    Int_t       fLastWriteBufferSize; //! Size of the buffer last time we wrote it to disk
+   const char *fMappedBuffer;     //! Part of a memory mapped file borrowed by fBufferRef (see TFile::GetMappedBuffer)
 
 public:
    
@@ -69,6 +73,8 @@ public:
    virtual ~TBasket();
    
    virtual void    AdjustSize(Int_t newsize);
+           Int_t   CommitWriteBuffer(TFile *file, Int_t nout);
+           Int_t   CompressBuffer(Int_t cxlevel, Int_t cxAlgorithm);
    virtual void    DeleteEntryOffset();
    virtual Int_t   DropBuffers();
    TBranch        *GetBranch() const {return fBranch;}
@@ -81,6 +87,7 @@ public:
            Int_t   GetLast() const {return fLast;}
    virtual void    MoveEntries(Int_t dentries);
    virtual void    PrepareBasket(Long64_t /* entry */) {};
+           void    PrepareWriteBuffer(TFile *file, Bool_t ownCompressedBuffer = kFALSE);
            Int_t   ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file);
            Int_t   ReadBasketBytes(Long64_t pos, TFile *file);
    virtual void    Reset();
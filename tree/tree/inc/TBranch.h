@@ -48,6 +48,7 @@ class TDirectory;
 class TFile;
 class TClonesArray;
 class TTreeCloner;
+class TBasketWriteQueue;
 
    const Int_t kDoNotProcess = BIT(10); // Active bit for branches
    const Int_t kIsClone      = BIT(11); // to indicate a TBranchClones
@@ -59,6 +60,7 @@ class TBranch : public TNamed , public TAttFill {
 
 protected:
    friend class TTreeCloner;
+   friend class TBasketWriteQueue;
    // TBranch status bits
    enum EStatusBits {
       kAutoDelete = BIT(15),
@@ -117,6 +119,7 @@ protected:
 
    TBasket *GetFreshBasket();
    Int_t    WriteBasket(TBasket* basket, Int_t where);
+   Int_t    CommitBasket(TBasket* basket, Int_t where, TFile *file, Int_t nout);
    
    TString  GetRealFileName() const;
 
@@ -150,6 +153,7 @@ public:
    virtual Long64_t  GetBasketSeek(Int_t basket) const;
    virtual Int_t     GetBasketSize() const {return fBasketSize;}
    virtual TList    *GetBrowsables();
+           Int_t     GetBulkEntries(Long64_t entry, void *buffer, Int_t maxentries);
    virtual const char* GetClassName() const;
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
@@ -99,6 +99,10 @@ protected:
    TStreamerInfoActions::TActionSequence *fFillActionSequence; //! Set of actions to be executed to write the data to the basket.
    TVirtualCollectionIterators           *fIterators;     //! holds the iterators when the branch is of fType==4.
    TVirtualCollectionPtrIterators        *fPtrIterators;  //! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
+   std::vector<void*>       fElementPool;   //! Elements of a split vector of pointers kept to be reused by the next entries (fType==4).
+   TClassRef                fElementPoolClass; //! Class of the elements in fElementPool
+
+   static Bool_t            fgRecycleElements; //  True if the elements of the split vectors of pointers are reused from entry to entry
 
 // Not implemented
 private:
@@ -115,6 +119,8 @@ protected:
    Bool_t                   IsMissingCollection() const;
    TClass                  *GetParentClass(); // Class referenced by fParentName
    TStreamerInfo           *GetInfoImp() const;
+   void                     RecycleElements(TVirtualCollectionProxy *proxy);
+   void                     ReleaseElementPool();
    void                     ReleaseObject();
    void                     SetBranchCount(TBranchElement* bre);
    void                     SetBranchCount2(TBranchElement* bre) { fBranchCount2 = bre; }
@@ -220,6 +226,8 @@ public:
    virtual void             SetTargetClass(const char *name);
    virtual void             SetupAddresses();
    virtual void             SetType(Int_t btype) { fType = btype; }
+   static  Bool_t           GetRecycleElements();
+   static  void             SetRecycleElements(Bool_t recycle = kTRUE);
    virtual void             UpdateFile();
 
    enum EBranchElementType {
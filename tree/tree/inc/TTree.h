@@ -85,6 +85,7 @@ class TCut;
 class TVirtualIndex;
 class TBranchRef;
 class TBasket;
+class TBasketWriteQueue;
 class TStreamerInfo;
 class TTreeCloner;
 class TFileMergeInfo;
@@ -140,6 +141,7 @@ protected:
    TBranchRef    *fBranchRef;         //  Branch supporting the TRefTable (if any)
    UInt_t         fFriendLockStatus;  //! Record which method is locking the friend recursion
    TBuffer       *fTransientBuffer;   //! Pointer to the current transient buffer.
+   TBasketWriteQueue *fBasketWriteQueue; //! Baskets being compressed in parallel (see SetParallelCompression)
 
    static Int_t     fgBranchStyle;      //  Old/New branch style
    static Long64_t  fgMaxTreeSize;      //  Maximum size of a file containg a Tree
@@ -415,6 +417,7 @@ public:
    virtual Long64_t        GetSelectedRows() { return GetPlayer()->GetSelectedRows(); }
    virtual Int_t           GetTimerInterval() const { return fTimerInterval; }
            TBuffer*        GetTransientBuffer(Int_t size);
+           TBasketWriteQueue *GetBasketWriteQueue() const { return fBasketWriteQueue; }
    virtual Long64_t        GetTotBytes() const { return fTotBytes; }
    virtual TTree          *GetTree() const { return const_cast<TTree*>(this); }
    virtual TVirtualIndex  *GetTreeIndex() const { return fTreeIndex; }
@@ -529,6 +532,7 @@ public:
    virtual void            SetName(const char* name); // *MENU*
    virtual void            SetNotify(TObject* obj) { fNotify = obj; }
    virtual void            SetObject(const char* name, const char* title);
+   virtual void            SetParallelCompression(Bool_t opt=kTRUE);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
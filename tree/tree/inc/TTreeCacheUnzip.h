@@ -33,7 +33,6 @@
 
 class TTree;
 class TBranch;
-class TThread;
 class TCondition;
 class TBasket;
 class TMutex;
@@ -47,10 +46,7 @@ public:
 protected:
 
    // Members for paral. managing
-   TThread    *fUnzipThread[10];
-   Bool_t      fActiveThread;          // Used to terminate gracefully the unzippers
-   TCondition *fUnzipStartCondition;   // Used to signal the threads to start.
-   TCondition *fUnzipDoneCondition;    // Used to wait for an unzip tour to finish. Gives the Async feel.
+   TCondition *fUnzipDoneCondition;    // Signaled each time an unzip task completes.
    Bool_t      fParallel;              // Indicate if we want to activate the parallelism (for this instance)
    Bool_t      fAsyncReading;
    TMutex     *fMutexList;             // Mutex to protect the various lists. Used by the condvars.
@@ -60,13 +56,16 @@ protected:
    static TTreeCacheUnzip::EParUnzipMode fgParallel;  // Indicate if we want to activate the parallelism
 
    Int_t       fLastReadPos;
-   Int_t       fBlocksToGo;
+   Int_t       fBlocksToGo;       //! Number of blocks not yet handed to the unzip pool in this cycle
+   Int_t       fNTasks;           //! Number of unzip tasks queued or running for this cache
 
    // Unzipping related members
    Int_t      *fUnzipLen;         //! [fNseek] Length of the unzipped buffers
    char      **fUnzipChunks;      //! [fNseek] Individual unzipped chunks. Their summed size is kept under control.
    Byte_t     *fUnzipStatus;      //! [fNSeek] For each blk, tells us if it's unzipped or pending
    Long64_t    fTotalUnzipBytes;  //! The total sum of the currently unzipped blks
+   Long64_t    fReservedBytes;    //! The sum of the memory budgets reserved by the pending tasks
+   Double_t    fUnzipRatio;       //! Running estimate of the unzipped/zipped size ratio, used to size the task budgets
 
    Int_t       fNseekMax;         //!  fNseek can change so we need to know its max size
    Long64_t    fUnzipBufferSize;  //!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
@@ -90,8 +89,9 @@ private:
 
    // Private methods
    void  Init();
-   Int_t StartThreadUnzip(Int_t nthreads);
-   Int_t StopThreadUnzip();
+   void  ScheduleUnzip();
+   void  WaitUnzipTasks();
+   void  WaitUnzipTasksLocked();
 
 public:
    TTreeCacheUnzip();
@@ -105,17 +105,15 @@ public:
    virtual void        StopLearningPhase();
    void                UpdateBranches(TTree *tree);
 
-   // Methods related to the thread
+   // Methods related to the thread pool
    static EParUnzipMode GetParallelUnzip();
    static Bool_t        IsParallelUnzip();
    static Int_t         SetParallelUnzip(TTreeCacheUnzip::EParUnzipMode option = TTreeCacheUnzip::kEnable);
+   static Int_t         GetUnzipPoolSize();
 
    Bool_t               IsActiveThread();
    Bool_t               IsQueueEmpty();
 
-   void                 WaitUnzipStartSignal();
-   void                 SendUnzipStartSignal(Bool_t broadcast);
-
    // Unzipping related methods
    Int_t          GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes, Int_t &objlen, Int_t &keylen);
    virtual void   ResetCache();
@@ -123,7 +121,7 @@ public:
    void           SetUnzipBufferSize(Long64_t bufferSize);
    static void    SetUnzipRelBufferSize(Float_t relbufferSize);
    Int_t          UnzipBuffer(char **dest, char *src);
-   Int_t          UnzipCache(Int_t &startindex, Int_t &locbuffsz, char *&locbuff);
+   Int_t          UnzipCache(Int_t index, Int_t cycle, Long64_t budget);
 
    // Methods to get stats
    Int_t  GetNUnzip() { return fNUnzip; }
@@ -132,8 +130,6 @@ public:
 
    void Print(Option_t* option = "") const;
 
-   // static members
-   static void* UnzipLoop(void *arg);
    ClassDef(TTreeCacheUnzip,0)  //Specialization of TTreeCache for parallel unzipping
 };
 
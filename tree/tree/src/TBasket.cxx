@@ -49,7 +49,7 @@ ClassImp(TBasket)
 //
 
 //_______________________________________________________________________
-TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fMappedBuffer(0)
 {
    // Default contructor.
 
@@ -66,7 +66,7 @@ TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLa
 }
 
 //_______________________________________________________________________
-TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fMappedBuffer(0)
 {
    // Constructor used during reading.
    fDisplacement  = 0;
@@ -83,7 +83,7 @@ TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0
 
 //_______________________________________________________________________
 TBasket::TBasket(const char *name, const char *title, TBranch *branch) : 
-   TKey(branch->GetDirectory()),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+   TKey(branch->GetDirectory()),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fMappedBuffer(0)
 {
    // Basket normal constructor, used during writing.
 
@@ -131,6 +131,7 @@ TBasket::~TBasket()
 {
    // Basket destructor.
 
+   ReleaseMappedBuffer();
    if (fDisplacement) delete [] fDisplacement;
    if (fEntryOffset)  delete [] fEntryOffset;
    if (fBufferRef) delete fBufferRef;
@@ -195,6 +196,7 @@ Int_t TBasket::DropBuffers()
    // Drop buffers of this basket if it is not the current basket.
    if (!fBuffer && !fBufferRef) return 0;
 
+   ReleaseMappedBuffer();
    if (fDisplacement) delete [] fDisplacement;
    if (fEntryOffset)  delete [] fEntryOffset;
    if (fBufferRef)    delete fBufferRef;
@@ -229,7 +231,12 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
 
    if (fBufferRef) {
       // Reuse the buffer if it exist.
+      ReleaseMappedBuffer();
       fBufferRef->SetReadMode();
+      if (!fBufferRef->TestBit(TBuffer::kIsOwner)) {
+         // The buffer is borrowed and must not be written to.
+         fBufferRef->SetBuffer(new char[len], len, kTRUE);
+      }
       fBufferRef->Reset();
       // We use this buffer both for reading and writing, we need to
       // make sure it is properly sized for writing.
@@ -385,6 +392,11 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
    TBuffer* result;
    if (R__likely(bufferRef)) {
       bufferRef->SetReadMode();
+      if (R__unlikely(!bufferRef->TestBit(TBuffer::kIsOwner))) {
+         // The buffer is borrowed (from the TTreeCache or from the memory
+         // mapping of the file) and must not be written to.
+         bufferRef->SetBuffer(new char[len], len, kTRUE);
+      }
       Int_t curBufferSize = bufferRef->BufferSize();
       if (curBufferSize < len) {
          // Experience shows that giving 5% "wiggle-room" decreases churn.
@@ -411,6 +423,18 @@ void inline TBasket::InitializeCompressedBuffer(Int_t len, TFile* file)
    }
 }
 
+//_______________________________________________________________________
+void TBasket::ReleaseMappedBuffer()
+{
+   // Give back to the memory mapped file the buffer fBufferRef was pointing
+   // to. The file keeps its mapping alive until then, even once closed.
+
+   if (fMappedBuffer) {
+      TFile::ReleaseMappedBuffer(fMappedBuffer);
+      fMappedBuffer = 0;
+   }
+}
+
 //_______________________________________________________________________
 Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 {
@@ -432,6 +456,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       return -1;
    }  
 
+   // The file is open, its mapping remains valid until fBufferRef is
+   // replaced below.
+   ReleaseMappedBuffer();
+
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
@@ -452,6 +480,38 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
    }
 
+   // With a memory mapped file (TFile option MMAP) the basket is used in
+   // place: it is not copied at all if it is not compressed, otherwise
+   // it is unzipped directly from the mapping.
+   rawCompressedBuffer = (char*)file->GetMappedBuffer(pos, len);
+   if (rawCompressedBuffer) {
+      fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
+      {
+         TBufferFile header(TBuffer::kRead, len, rawCompressedBuffer, kFALSE);
+         header.SetParent(file);
+         Streamer(header);
+      }
+      if (IsZombie()) {
+         return 1;
+      }
+      if (fObjlen+fKeylen != fNbytes) {
+         goto Uncompress;
+      }
+      // Borrow the buffer, so that the mapping outlives the file if the
+      // tree is detached from it.
+      fMappedBuffer = file->GetMappedBuffer(pos, len, kTRUE);
+      if (fBufferRef) {
+         fBufferRef->SetBuffer(rawCompressedBuffer, len, kFALSE);
+         fBufferRef->SetReadMode();
+         fBufferRef->Reset();
+      } else {
+         fBufferRef = new TBufferFile(TBuffer::kRead, len, rawCompressedBuffer, kFALSE);
+      }
+      fBufferRef->SetParent(file);
+      fBuffer = rawCompressedBuffer;
+      goto AfterBuffer;
+   }
+
    // Determine which buffer to use, so that we can avoid a memcpy in case of 
    // the basket was not compressed.
    TBuffer* readBufferRef;
@@ -523,6 +583,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
    }
 
+Uncompress:
    // Initialize buffer to hold the uncompressed data
    // Note that in previous versions we didn't allocate buffers until we verified
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
@@ -934,6 +995,26 @@ Int_t TBasket::WriteBuffer()
       return nBytes>0 ? fKeylen+nout : -1;
    }
 
+   PrepareWriteBuffer(file);
+   Int_t nout = CompressBuffer(fBranch->GetCompressionLevel(), fBranch->GetCompressionAlgorithm());
+   if (nout < 0) {
+      return -1;
+   }
+   return CommitWriteBuffer(file, nout);
+}
+
+//_______________________________________________________________________
+void TBasket::PrepareWriteBuffer(TFile *file, Bool_t ownCompressedBuffer)
+{
+   // First step of WriteBuffer: close the basket content by transferring
+   // the fEntryOffset table at the end of fBuffer.
+   //
+   // If ownCompressedBuffer is true, the basket will not share the
+   // compressed buffer of its TTree, so that CompressBuffer can be
+   // executed by another thread (see TTree::SetParallelCompression).
+
+   fMotherDir = file;
+
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
    if (fEntryOffset) {
@@ -951,59 +1032,87 @@ Int_t TBasket::WriteBuffer()
       }
    }
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
-   lbuf       = fBufferRef->Length();
-   fObjlen    = lbuf - fKeylen;
+   fObjlen    = fBufferRef->Length() - fKeylen;
 
    fHeaderOnly = kTRUE;
    fCycle = fBranch->GetWriteBasket();
-   Int_t cxlevel = fBranch->GetCompressionLevel();
-   Int_t cxAlgorithm = fBranch->GetCompressionAlgorithm();
-   if (cxlevel > 0) {
-      Int_t nbuffers = 1 + (fObjlen - 1) / kMAXBUF;
-      Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
-      InitializeCompressedBuffer(buflen, file);
-      if (!fCompressedBufferRef) {
-         Warning("WriteBuffer", "Unable to allocate the compressed buffer");
-         return -1;
-      }
-      fCompressedBufferRef->SetWriteMode();
-      fBuffer = fCompressedBufferRef->Buffer();
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else bufmax = kMAXBUF;
-         //compress the buffer
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-
-         // test if buffer has really been compressed. In case of small buffers 
-         // when the buffer contains random data, it may happen that the compressed
-         // buffer is larger than the input. In this case, we write the original uncompressed buffer
-         if (nout == 0 || nout >= fObjlen) {
-            nout = fObjlen;
-            // We used to delete fBuffer here, we no longer want to since
-            // the buffer (held by fCompressedBufferRef) might be re-used later.
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
-            if ((nout+fKeylen)>buflen) {
-               Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
-                  (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
-            }
-            goto WriteFile;
+
+   if (ownCompressedBuffer && !fOwnsCompressedBuffer) {
+      // The buffer belongs to the TTree, a private one is allocated
+      // by InitializeCompressedBuffer.
+      fCompressedBufferRef = 0;
+   }
+}
+
+//_______________________________________________________________________
+Int_t TBasket::CompressBuffer(Int_t cxlevel, Int_t cxAlgorithm)
+{
+   // Second step of WriteBuffer: compress the content of the basket into
+   // the compressed buffer. This does not access the file nor the branch
+   // and may be executed by another thread when the basket owns its
+   // compressed buffer.
+   //
+   // Returns the size of the compressed data, 0 if the basket must be
+   // written uncompressed or -1 if the compressed buffer could not be
+   // allocated.
+
+   if (cxlevel <= 0) {
+      return 0;
+   }
+   TFile *file = fMotherDir ? fMotherDir->GetFile() : 0;
+   Int_t nout, noutot, bufmax, nzip;
+   Int_t nbuffers = 1 + (fObjlen - 1) / kMAXBUF;
+   Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
+   InitializeCompressedBuffer(buflen, file);
+   if (!fCompressedBufferRef) {
+      Warning("WriteBuffer", "Unable to allocate the compressed buffer");
+      return -1;
+   }
+   fCompressedBufferRef->SetWriteMode();
+   char *objbuf = fBufferRef->Buffer() + fKeylen;
+   char *bufcur = &fCompressedBufferRef->Buffer()[fKeylen];
+   noutot = 0;
+   nzip   = 0;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      if (i == nbuffers - 1) bufmax = fObjlen - nzip;
+      else bufmax = kMAXBUF;
+      //compress the buffer
+      R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+
+      // test if buffer has really been compressed. In case of small buffers 
+      // when the buffer contains random data, it may happen that the compressed
+      // buffer is larger than the input. In this case, we write the original uncompressed buffer
+      if (nout == 0 || nout >= fObjlen) {
+         // We used to delete fBuffer here, we no longer want to since
+         // the buffer (held by fCompressedBufferRef) might be re-used later.
+         if ((fObjlen+fKeylen)>buflen) {
+            Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
+               (fObjlen+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
          }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXBUF;
-         nzip   += kMAXBUF;
+         return 0;
       }
-      nout = noutot;
-      Create(noutot,file);
+      bufcur += nout;
+      noutot += nout;
+      objbuf += kMAXBUF;
+      nzip   += kMAXBUF;
+   }
+   return noutot;
+}
+
+//_______________________________________________________________________
+Int_t TBasket::CommitWriteBuffer(TFile *file, Int_t nout)
+{
+   // Last step of WriteBuffer: reserve the space in the file, stream the
+   // key and write the basket. nout is the value returned by CompressBuffer.
+   // Since the position of the basket in the file is decided here, the
+   // baskets of a TTree must be committed in the order they were filled.
+   //
+   // The function returns the number of bytes committed to the memory
+   // or -1 in case of write error.
+
+   if (nout > 0) {
+      fBuffer = fCompressedBufferRef->Buffer();
+      Create(nout,file);
       fBufferRef->SetBufferOffset(0);
 
       Streamer(*fBufferRef);         //write key itself again
@@ -1017,7 +1126,6 @@ Int_t TBasket::WriteBuffer()
       nout = fObjlen;
    }
 
-WriteFile:
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
    return nBytes>0 ? fKeylen+nout : -1;
@@ -0,0 +1,194 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TBasketWriteQueue                                                    //
+//                                                                      //
+// Queue of the full baskets of a TTree being compressed in parallel.   //
+// Each basket is compressed by a task of a thread pool shared by all   //
+// the TTrees of the process, while the baskets are committed to the    //
+// file (space allocation, key and data writing) by the filling thread  //
+// strictly in the order they were pushed. The file produced is thus    //
+// identical to the one obtained with the sequential compression.       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TBasketWriteQueue.h"
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TEnv.h"
+#include "TError.h"
+#include "TSystem.h"
+#include "TVirtualMutex.h"
+#include "TThread.h"
+#include "TCondition.h"
+#include "TThreadPool.h"
+
+extern "C" int R__ZipMode;
+
+namespace {
+
+   class TBasketCompressTask : public TThreadPoolTaskImp<TBasketCompressTask, TBasketWriteQueue::TItem*> {
+   public:
+      bool runTask(TBasketWriteQueue::TItem *&item) {
+         item->fNout = item->fBasket->CompressBuffer(item->fCxLevel, item->fCxAlgorithm);
+         item->fQueue->Compressed(item);
+         return item->fNout >= 0;
+      }
+   };
+
+   typedef TThreadPool<TBasketCompressTask, TBasketWriteQueue::TItem*> TCompressPool_t;
+
+   TBasketCompressTask gCompressTask;
+   TCompressPool_t    *gCompressPool = 0;
+   Int_t               gCompressPoolSize = 0;
+
+   //______________________________________________________________________________
+   TCompressPool_t *GetCompressPool()
+   {
+      // Return the thread pool shared by all the TBasketWriteQueue, creating
+      // it on first use. The pool lives until the end of the process.
+
+      R__LOCKGUARD2(gGlobalMutex);
+      if (!gCompressPool) {
+         SysInfo_t info;
+         Int_t ncpus = gSystem->GetSysInfo(&info) == 0 ? info.fCpus : 1;
+         gCompressPoolSize = gEnv->GetValue("TTree.CompressionThreads", ncpus);
+         if (gCompressPoolSize < 1) gCompressPoolSize = 1;
+         gCompressPool = new TCompressPool_t(gCompressPoolSize);
+      }
+      return gCompressPool;
+   }
+}
+
+//______________________________________________________________________________
+TBasketWriteQueue::TBasketWriteQueue() : fNErrors(0)
+{
+   // Default constructor.
+
+   fMutex     = new TMutex();
+   fCondition = new TCondition(fMutex);
+   // Enough baskets in flight to keep all the threads busy while the
+   // filling thread waits for the oldest one.
+   fMaxPending = 4 * GetPoolSize();
+}
+
+//______________________________________________________________________________
+TBasketWriteQueue::~TBasketWriteQueue()
+{
+   // Destructor, write the baskets still in the queue.
+
+   Drain();
+   delete fCondition;
+   delete fMutex;
+}
+
+//______________________________________________________________________________
+Int_t TBasketWriteQueue::GetPoolSize()
+{
+   // Static function returning the number of threads used to compress
+   // the baskets, set by the rootrc variable TTree.CompressionThreads
+   // (default is the number of cores).
+
+   GetCompressPool();
+   return gCompressPoolSize;
+}
+
+//______________________________________________________________________________
+Bool_t TBasketWriteQueue::IsThreadSafeAlgorithm(Int_t cxAlgorithm)
+{
+   // Return true if the compression algorithm can be run concurrently
+   // by several threads. The very old algorithm (also selected by the
+   // global R__ZipMode when the algorithm is 0) uses global state.
+
+   if (cxAlgorithm == 0) cxAlgorithm = R__ZipMode;
+   return cxAlgorithm != 0 && cxAlgorithm != 3;
+}
+
+//______________________________________________________________________________
+void TBasketWriteQueue::Compressed(TItem *item)
+{
+   // Called by the task once the basket of item has been compressed.
+
+   R__LOCKGUARD(fMutex);
+   item->fDone = kTRUE;
+   fCondition->Broadcast();
+}
+
+//______________________________________________________________________________
+Bool_t TBasketWriteQueue::CommitFront(Bool_t wait)
+{
+   // Write to the file the oldest basket of the queue if it has been
+   // compressed. If wait is true, wait for its compression to complete.
+   // Returns true if a basket was committed.
+
+   if (fItems.empty()) return kFALSE;
+   TItem *item = fItems.front();
+   {
+      R__LOCKGUARD(fMutex);
+      if (!item->fDone) {
+         if (!wait) return kFALSE;
+         while (!item->fDone) fCondition->Wait();
+      }
+   }
+   fItems.pop_front();
+   if (item->fNout < 0) {
+      ::Error("TBasketWriteQueue::CommitFront", "Unable to compress basket %d of branch %s",
+              item->fWhere, item->fBranch->GetName());
+      item->fBasket->DropBuffers();
+      delete item->fBasket;
+      ++fNErrors;
+   } else if (item->fBranch->CommitBasket(item->fBasket, item->fWhere, item->fFile, item->fNout) < 0) {
+      ++fNErrors;
+   }
+   delete item;
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t TBasketWriteQueue::Drain()
+{
+   // Wait for the compression of all the baskets of the queue and write
+   // them to the file. Returns the number of write errors since the
+   // previous call.
+
+   while (CommitFront(kTRUE)) {}
+   Int_t nerrors = fNErrors;
+   fNErrors = 0;
+   return nerrors;
+}
+
+//______________________________________________________________________________
+void TBasketWriteQueue::Push(TBranch *branch, TBasket *basket, TFile *file, Int_t where)
+{
+   // Hand over a full basket, already prepared by TBasket::PrepareWriteBuffer,
+   // to the thread pool for compression. The queue takes the ownership of
+   // the basket. The baskets already compressed at the head of the queue
+   // are written to the file.
+
+   while (CommitFront(kFALSE)) {}
+   if (fItems.size() >= fMaxPending) {
+      CommitFront(kTRUE);
+   }
+
+   TItem *item = new TItem;
+   item->fQueue       = this;
+   item->fBranch      = branch;
+   item->fBasket      = basket;
+   item->fFile        = file;
+   item->fWhere       = where;
+   item->fCxLevel     = branch->GetCompressionLevel();
+   item->fCxAlgorithm = branch->GetCompressionAlgorithm();
+   item->fNout        = 0;
+   item->fDone        = kFALSE;
+   fItems.push_back(item);
+   GetCompressPool()->PushTask(gCompressTask, item);
+}
@@ -0,0 +1,69 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// helper class used internally by TTree and TBranch for the parallel
+// compression of the baskets (see TTree::SetParallelCompression)
+
+#ifndef ROOT_TBasketWriteQueue
+#define ROOT_TBasketWriteQueue
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+#include <deque>
+
+class TBasket;
+class TBranch;
+class TFile;
+class TMutex;
+class TCondition;
+
+class TBasketWriteQueue {
+
+public:
+   struct TItem {
+      TBasketWriteQueue *fQueue;       // Queue owning the item
+      TBranch           *fBranch;      // Branch of the basket
+      TBasket           *fBasket;      // Basket to compress and write
+      TFile             *fFile;        // File the basket is written to
+      Int_t              fWhere;       // Index of the basket in the branch
+      Int_t              fCxLevel;     // Compression level
+      Int_t              fCxAlgorithm; // Compression algorithm
+      Int_t              fNout;        // Result of TBasket::CompressBuffer
+      Bool_t             fDone;        // True once the basket has been compressed
+   };
+
+private:
+   TBasketWriteQueue(const TBasketWriteQueue&);            // not implemented
+   TBasketWriteQueue& operator=(const TBasketWriteQueue&); // not implemented
+
+   std::deque<TItem*> fItems;      // Baskets pushed and not yet committed, in fill order
+   TMutex            *fMutex;      // Protect fDone of the items
+   TCondition        *fCondition;  // Signaled each time a basket is compressed
+   UInt_t             fMaxPending; // Maximum number of baskets in flight
+   Int_t              fNErrors;    // Number of write errors since the last Drain
+
+   Bool_t  CommitFront(Bool_t wait);
+
+public:
+   TBasketWriteQueue();
+   ~TBasketWriteQueue();
+
+   static Bool_t IsThreadSafeAlgorithm(Int_t cxAlgorithm);
+   static Int_t  GetPoolSize();
+
+   void          Compressed(TItem *item);
+   Int_t         Drain();
+   Bool_t        IsEmpty() const { return fItems.empty(); }
+   void          Push(TBranch *branch, TBasket *basket, TFile *file, Int_t where);
+};
+
+#endif
@@ -13,6 +13,7 @@
 
 #include "Compression.h"
 #include "TBasket.h"
+#include "TBasketWriteQueue.h"
 #include "TBranchBrowsable.h"
 #include "TBrowser.h"
 #include "TClass.h"
@@ -1088,6 +1089,11 @@ TBasket* TBranch::GetBasket(Int_t basketnumber)
    if (basket) return basket;
    if (basketnumber == fWriteBasket) return 0;
 
+   if (fBasketSeek[basketnumber] == 0 && fTree->GetBasketWriteQueue()) {
+      // The basket may still be in the compression queue.
+      fTree->GetBasketWriteQueue()->Drain();
+   }
+
    // create/decode basket parameters from buffer
    TFile *file = GetFile(0);
    if (file == 0) {
@@ -1277,6 +1283,98 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    return buf->Length() - bufbegin;
 }
 
+//______________________________________________________________________________
+Int_t TBranch::GetBulkEntries(Long64_t entry, void *buffer, Int_t maxentries)
+{
+   // Read, starting at entry, the values of consecutive entries of this
+   // branch into buffer, in one pass over the basket containing entry.
+   //
+   // The branch must have a single leaf of a fundamental type (float,
+   // double, integers, bool) with a fixed length, e.g. "x/F" or "p[3]/D".
+   // The values are stored contiguously in the native byte order: buffer
+   // must have room for maxentries*GetLeaf()->GetLenStatic() values of
+   // the type of the leaf.
+   //
+   // At most maxentries entries are read and the reading stops at the end
+   // of the basket, so that no data is copied twice: the caller loops,
+   // advancing entry by the return value, until it reaches the number of
+   // entries of the branch. For example:
+   //
+   //     std::vector<Float_t> x(tree->GetEntries());
+   //     TBranch *b = tree->GetBranch("x");
+   //     Long64_t entry = 0;
+   //     while (entry < b->GetEntries()) {
+   //        Int_t n = b->GetBulkEntries(entry, &x[entry], x.size() - entry);
+   //        if (n <= 0) break;
+   //        entry += n;
+   //     }
+   //
+   // The address of the leaf and fReadEntry are not modified.
+   //
+   // The function returns the number of entries read, 0 if entry does not
+   // exist and -1 in case of an I/O error or if the branch is not supported.
+
+   if (!buffer || maxentries <= 0) return 0;
+   if (fLeaves.GetEntriesFast() != 1) return -1;
+   TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(0);
+   if (leaf->GetLeafCount() || fEntryOffsetLen) return -1;
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
+      return 0;
+   }
+
+   TBasket *basket = fCurrentBasket;
+   Long64_t first = fFirstBasketEntry;
+   if (!basket || entry < fFirstBasketEntry || entry >= fNextBasketEntry) {
+      fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
+      if (fReadBasket < 0) {
+         fNextBasketEntry = -1;
+         Error("GetBulkEntries", "In the branch %s, no basket contains the entry %lld\n", GetName(), entry);
+         return -1;
+      }
+      if (fReadBasket == fWriteBasket) {
+         fNextBasketEntry = fEntryNumber;
+      } else {
+         fNextBasketEntry = fBasketEntry[fReadBasket+1];
+      }
+      first = fFirstBasketEntry = fBasketEntry[fReadBasket];
+      basket = (TBasket*) fBaskets.UncheckedAt(fReadBasket);
+      if (!basket) {
+         basket = GetBasket(fReadBasket);
+         if (!basket) {
+            fCurrentBasket = 0;
+            fFirstBasketEntry = -1;
+            fNextBasketEntry = -1;
+            return -1;
+         }
+      }
+      fCurrentBasket = basket;
+   }
+   TBuffer* buf = basket->GetBufferRef();
+   if (R__unlikely(!buf)) {
+      TFile* file = GetFile(0);
+      if (!file) return -1;
+      basket->ReadBasketBuffers(fBasketSeek[fReadBasket], fBasketBytes[fReadBasket], file);
+      buf = basket->GetBufferRef();
+      if (!buf) return -1;
+   }
+   if (basket->GetEntryOffset()) return -1;
+   if (R__unlikely(!buf->IsReading())) {
+      basket->SetReadMode();
+   }
+
+   Long64_t nentries = fNextBasketEntry - entry;
+   if (nentries > maxentries) nentries = maxentries;
+   Int_t nvalues = Int_t(nentries) * leaf->GetLenStatic();
+   Int_t bufbegin = basket->GetKeylen() + ((entry-first) * basket->GetNevBufSize());
+   if (bufbegin + nvalues * leaf->GetLenType() > buf->BufferSize()) {
+      Error("GetBulkEntries", "In the branch %s, the basket of entry %lld is too short", GetName(), entry);
+      return -1;
+   }
+   buf->SetBufferOffset(bufbegin);
+   if (!leaf->ReadBasketBulk(*buf, nvalues, buffer)) return -1;
+   return Int_t(nentries);
+}
+
 //______________________________________________________________________________
 Int_t TBranch::GetEntryExport(Long64_t entry, Int_t /*getall*/, TClonesArray* li, Int_t nentries)
 {
@@ -2539,6 +2637,14 @@ Int_t TBranch::WriteBasket(TBasket* basket, Int_t where)
 {
    // Write the current basket to disk and return the number of bytes
    // written to the file.
+   //
+   // If the parallel compression is enabled for the Tree (see
+   // TTree::SetParallelCompression), the full write basket is instead
+   // handed over to the compression queue of the Tree and a new basket
+   // will be created by the next Fill. In this case the function returns
+   // the number of bytes of the uncompressed basket; fZipBytes and the
+   // location of the basket on file are updated when it is written
+   // (see TBranch::CommitBasket).
 
    Int_t nevbuf = basket->GetNevBuf();
    if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
@@ -2549,6 +2655,40 @@ Int_t TBranch::WriteBasket(TBasket* basket, Int_t where)
       fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
    }
 
+   TBasketWriteQueue *queue = fTree->GetBasketWriteQueue();
+   if (queue) {
+      const Int_t kWrite = 1;
+      TFile *file = (where == fWriteBasket) ? GetFile(kWrite) : 0;
+      if (file && file->IsWritable()
+          && !basket->GetBufferRef()->TestBit(TBufferFile::kNotDecompressed)
+          && TBasketWriteQueue::IsThreadSafeAlgorithm(GetCompressionAlgorithm())) {
+         basket->PrepareWriteBuffer(file, kTRUE);
+         Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+         fTotBytes += addbytes;
+         fTree->AddTotBytes(addbytes);
+
+         // The basket now belongs to the queue.
+         fBaskets[where] = 0;
+         --fNBaskets;
+         if (basket == fCurrentBasket) {
+            fCurrentBasket    = 0;
+            fFirstBasketEntry = -1;
+            fNextBasketEntry  = -1;
+         }
+         ++fWriteBasket;
+         if (fWriteBasket >= fMaxBaskets) {
+            ExpandBasketArrays();
+         }
+         fBaskets.AddAtAndExpand(0,fWriteBasket);
+         fBasketEntry[fWriteBasket] = fEntryNumber;
+
+         queue->Push(this, basket, file, where);
+         return addbytes;
+      }
+      // Keep the baskets in the file in the order they were filled.
+      queue->Drain();
+   }
+
    Int_t nout  = basket->WriteBuffer();    //  Write buffer
    fBasketBytes[where]  = basket->GetNbytes();
    fBasketSeek[where]   = basket->GetSeekKey();
@@ -2588,6 +2728,26 @@ Int_t TBranch::WriteBasket(TBasket* basket, Int_t where)
    return nout;
 }
 
+//______________________________________________________________________________
+Int_t TBranch::CommitBasket(TBasket* basket, Int_t where, TFile *file, Int_t nout)
+{
+   // Write to the file a basket compressed by the compression queue of the
+   // Tree (see WriteBasket) and record its location. nout is the value
+   // returned by TBasket::CompressBuffer. The basket is deleted.
+   // Return the number of bytes written to the file or -1 in case of error.
+
+   nout = basket->CommitWriteBuffer(file, nout);
+   fBasketBytes[where]  = basket->GetNbytes();
+   fBasketSeek[where]   = basket->GetSeekKey();
+   fZipBytes += nout;
+   fTree->AddZipBytes(nout);
+
+   basket->DropBuffers();
+   delete basket;
+
+   return nout;
+}
+
 //------------------------------------------------------------------------------
 void TBranch::SetFirstEntry(Long64_t entry)
 {
@@ -51,6 +51,8 @@
 
 ClassImp(TBranchElement)
 
+Bool_t TBranchElement::fgRecycleElements = kFALSE;
+
 #if (__GNUC__ >= 3) || defined(__INTEL_COMPILER)
 #if !defined(R__unlikely)
 #define R__unlikely(expr) __builtin_expect(!!(expr), 0)
@@ -3699,6 +3701,13 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
    // TODO: Exception safety a la TPushPop
    TVirtualCollectionProxy* proxy = GetCollectionProxy();
    TVirtualCollectionProxy::TPushPop helper(proxy, fObject);
+   // The elements of a split vector of pointers are taken out of the vector and
+   // reused below instead of being deleted by Allocate and created again.
+   Bool_t recycle = fgRecycleElements && fSTLtype == TClassEdit::kVector && proxy->HasPointers()
+                    && fSplitLevel > TTree::kSplitCollectionOfPointers && proxy->GetValueClass();
+   if (recycle) {
+      RecycleElements(proxy);
+   }
    void* alternate = proxy->Allocate(fNdata, true);
    if(fSTLtype != TClassEdit::kVector && proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers ) {
       fPtrIterators->CreateIterators(alternate);
@@ -3744,6 +3753,13 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
       for( ; i < fNdata; ++i )
       {
          void **el = (void**)proxy->At( i );
+         if (recycle && !fElementPool.empty()) {
+            // Reuse an element of a previous entry: its data members are all read
+            // from the sub-branches, as for the objects kept by a TClonesArray.
+            *el = fElementPool.back();
+            fElementPool.pop_back();
+            continue;
+         }
          // coverity[dereference] since this is a member streaming action by definition the collection contains objects and elClass is not null.
          *el = elClass->New();
       }
@@ -4069,6 +4085,50 @@ void  TBranchElement::FillLeavesImpl(TBuffer&)
    Fatal("FillLeaves","The FillLeaves function has not been configured for %s",GetName());
 }
 
+//______________________________________________________________________________
+void TBranchElement::RecycleElements(TVirtualCollectionProxy *proxy)
+{
+   // -- Move the elements of the split vector of pointers, currently pushed in
+   // proxy, to the pool of elements of this branch and empty the vector.
+   //
+   // The elements whose actual class is not the value class of the vector are
+   // deleted as before, the next entries being read in objects of the value class.
+
+   TClass *elClass = proxy->GetValueClass();
+   if (fElementPoolClass.GetClass() != elClass) {
+      ReleaseElementPool();
+      fElementPoolClass = elClass;
+   }
+   UInt_t n = proxy->Size();
+   for (UInt_t i = 0; i < n; ++i) {
+      void *el = *(void**)proxy->At(i);
+      if (!el) {
+         continue;
+      }
+      if (elClass->GetActualClass(el) == elClass) {
+         fElementPool.push_back(el);
+      } else {
+         elClass->Destructor(el);
+      }
+   }
+   // Remove the pointers without deleting the elements.
+   proxy->Clear();
+}
+
+//______________________________________________________________________________
+void TBranchElement::ReleaseElementPool()
+{
+   // -- Delete the elements kept to be reused by the next entries.
+
+   TClass *elClass = fElementPoolClass.GetClass();
+   if (elClass) {
+      for (std::vector<void*>::iterator iter = fElementPool.begin(); iter != fElementPool.end(); ++iter) {
+         elClass->Destructor(*iter);
+      }
+   }
+   fElementPool.clear();
+}
+
 //______________________________________________________________________________
 void TBranchElement::ReleaseObject()
 {
@@ -4197,6 +4257,9 @@ void TBranchElement::ResetAddress()
       if (br) br->ResetAddress();
    }
 
+   // The elements kept for the next entries belong to the branch.
+   ReleaseElementPool();
+
    //
    // SetAddress may have allocated an object.
    //
@@ -4226,6 +4289,34 @@ void TBranchElement::ResetDeleteObject()
    }
 }
 
+//______________________________________________________________________________
+Bool_t TBranchElement::GetRecycleElements()
+{
+   // -- Return true if the elements of the split vectors of pointers are reused
+   // from one entry to the next one (see SetRecycleElements).
+
+   return fgRecycleElements;
+}
+
+//______________________________________________________________________________
+void TBranchElement::SetRecycleElements(Bool_t recycle)
+{
+   // -- Reuse or not (default) the elements of the split vectors of pointers.
+   //
+   // When reading a split std::vector<T*>, the objects pointed to by the vector
+   // for the previous entry are kept by the branch and reused for the next
+   // entries instead of being deleted and allocated again, so that reading
+   // allocates memory only when a vector gets more elements than in the
+   // previous entries. This is the behavior of the TClonesArray branches, whose
+   // array keeps its objects. As a consequence, the data members which are not
+   // read (disabled sub-branches or transient members) keep the values of
+   // the previous entries instead of being reset by the default constructor,
+   // which is why the recycling must be requested explicitly. The elements
+   // kept by a branch are deleted by ResetAddress and by the destructor.
+
+   fgRecycleElements = recycle;
+}
+
 //______________________________________________________________________________
 void TBranchElement::SetAddress(void* addr)
 {
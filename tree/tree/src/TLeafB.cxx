@@ -151,6 +151,16 @@ void TLeafB::ReadBasket(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+Bool_t TLeafB::ReadBasketBulk(TBuffer &b, Int_t nvalues, void *dest)
+{
+   // Read nvalues consecutive Char_t from the basket buffer into dest,
+   // converting them from the file byte order (see TBranch::GetBulkEntries).
+
+   b.ReadFastArray((Char_t*)dest, nvalues);
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 void TLeafB::ReadBasketExport(TBuffer& b, TClonesArray* list, Int_t n)
 {
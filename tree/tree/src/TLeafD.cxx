@@ -138,6 +138,16 @@ void TLeafD::ReadBasket(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+Bool_t TLeafD::ReadBasketBulk(TBuffer &b, Int_t nvalues, void *dest)
+{
+   // Read nvalues consecutive Double_t from the basket buffer into dest,
+   // converting them from the file byte order (see TBranch::GetBulkEntries).
+
+   b.ReadFastArray((Double_t*)dest, nvalues);
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 void TLeafD::ReadBasketExport(TBuffer &b, TClonesArray *list, Int_t n)
 {
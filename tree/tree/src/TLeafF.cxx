@@ -142,6 +142,16 @@ void TLeafF::ReadBasket(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+Bool_t TLeafF::ReadBasketBulk(TBuffer &b, Int_t nvalues, void *dest)
+{
+   // Read nvalues consecutive Float_t from the basket buffer into dest,
+   // converting them from the file byte order (see TBranch::GetBulkEntries).
+
+   b.ReadFastArray((Float_t*)dest, nvalues);
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 void TLeafF::ReadBasketExport(TBuffer &b, TClonesArray *list, Int_t n)
 {
@@ -177,6 +177,16 @@ void TLeafI::ReadBasket(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+Bool_t TLeafI::ReadBasketBulk(TBuffer &b, Int_t nvalues, void *dest)
+{
+   // Read nvalues consecutive Int_t from the basket buffer into dest,
+   // converting them from the file byte order (see TBranch::GetBulkEntries).
+
+   b.ReadFastArray((Int_t*)dest, nvalues);
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 void TLeafI::ReadBasketExport(TBuffer &b, TClonesArray *list, Int_t n)
 {
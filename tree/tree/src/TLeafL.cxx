@@ -177,6 +177,16 @@ void TLeafL::ReadBasket(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+Bool_t TLeafL::ReadBasketBulk(TBuffer &b, Int_t nvalues, void *dest)
+{
+   // Read nvalues consecutive Long64_t from the basket buffer into dest,
+   // converting them from the file byte order (see TBranch::GetBulkEntries).
+
+   b.ReadFastArray((Long64_t*)dest, nvalues);
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 void TLeafL::ReadBasketExport(TBuffer &b, TClonesArray *list, Int_t n)
 {
@@ -316,6 +316,7 @@
 #include "TBufferFile.h"
 #include "TBaseClass.h"
 #include "TBasket.h"
+#include "TBasketWriteQueue.h"
 #include "TBranchClones.h"
 #include "TBranchElement.h"
 #include "TBranchObject.h"
@@ -655,6 +656,7 @@ TTree::TTree()
 , fBranchRef(0)
 , fFriendLockStatus(0)
 , fTransientBuffer(0)
+, fBasketWriteQueue(0)
 {
    // Default constructor and I/O constructor.
    //
@@ -724,6 +726,7 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */)
 , fBranchRef(0)
 , fFriendLockStatus(0)
 , fTransientBuffer(0)
+, fBasketWriteQueue(0)
 {
    // Normal tree constructor.
    //
@@ -781,6 +784,12 @@ TTree::~TTree()
 {
    // Destructor.
 
+   if (fBasketWriteQueue) {
+      // Write the baskets still being compressed, as they would have
+      // been with the sequential compression.
+      delete fBasketWriteQueue;
+      fBasketWriteQueue = 0;
+   }
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -1197,6 +1206,9 @@ Long64_t TTree::AutoSave(Option_t* option)
    if (opt.Contains("flushbaskets")) {
       if (gDebug > 0) printf("AutoSave:  calling FlushBaskets \n");
       FlushBaskets();
+   } else if (fBasketWriteQueue) {
+      // The header must describe all the baskets committed so far.
+      fBasketWriteQueue->Drain();
    }
 
    fSavedBytes = fZipBytes;
@@ -3394,6 +3406,9 @@ void TTree::Delete(Option_t* option /* = "" */)
          Error("Delete","File : %s is not writable, cannot delete Tree:%s", file->GetName(),GetName());
          return;
       }
+      if (fBasketWriteQueue) {
+         fBasketWriteQueue->Drain();
+      }
 
       //find key and import Tree header in memory
       TKey *key = fDirectory->GetKey(GetName());
@@ -4178,6 +4193,12 @@ Int_t TTree::Fill()
    if (fAutoFlush != 0 || fAutoSave != 0) {
       // Is it time to flush or autosave baskets?
       if (fFlushedBytes == 0) {
+         if (fBasketWriteQueue && (fAutoFlush < 0 || fAutoSave < 0)) {
+            // The decision is based on the compressed size, so it must
+            // include all the baskets closed out so far, as with the
+            // sequential compression.
+            fBasketWriteQueue->Drain();
+         }
          // Decision can be based initially either on the number of bytes
          // or the number of entries written.
          if ((fAutoFlush<0 && fZipBytes > -fAutoFlush)  ||
@@ -4566,6 +4587,10 @@ Int_t TTree::FlushBaskets() const
          }
       }
    }
+   if (fBasketWriteQueue) {
+      // Wait for the compression of the baskets just closed out.
+      nerror += fBasketWriteQueue->Drain();
+   }
    if (nerror) {
       return -1;
    } else {
@@ -6836,6 +6861,10 @@ void TTree::Reset(Option_t* option)
 {
    // Reset baskets, buffers and entries count in all branches and leaves.
 
+   if (fBasketWriteQueue) {
+      fBasketWriteQueue->Drain();
+   }
+
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -6866,6 +6895,10 @@ void TTree::ResetAfterMerge(TFileMergeInfo *info)
    // Resets the state of this TTree after a merge (keep the customization but
    // forget the data).
 
+   if (fBasketWriteQueue) {
+      fBasketWriteQueue->Drain();
+   }
+
    fEntries       = 0;
    fNClusterRange = 0;
    fTotBytes      = 0;
@@ -7819,6 +7852,36 @@ void TTree::SetObject(const char* name, const char* title)
    }
 }
 
+//______________________________________________________________________________
+void TTree::SetParallelCompression(Bool_t opt)
+{
+   // Enable or disable the parallel compression of the baskets of this Tree.
+   //
+   // When enabled, TTree::Fill does not compress and write the full baskets
+   // itself: they are compressed by a thread pool shared by all the Trees
+   // (one task per basket) and written to the file, in the order they were
+   // filled, by the following calls to Fill and at the latest by
+   // FlushBaskets, AutoSave, Write or the destructor of the Tree.
+   // The content and the layout of the file are identical to the ones
+   // obtained with the sequential compression.
+   //
+   // The number of threads is the number of cores, it can be changed with
+   // the rootrc variable TTree.CompressionThreads.
+   // The very old compression algorithm is not thread safe: the branches
+   // using it are still compressed sequentially.
+   //
+   // Note that until the first AutoFlush, when fAutoFlush or fAutoSave
+   // are expressed in bytes, Fill has to wait for the compression of the
+   // baskets it closed out since the decision depends on their size.
+
+   if (opt) {
+      if (!fBasketWriteQueue) fBasketWriteQueue = new TBasketWriteQueue();
+   } else if (fBasketWriteQueue) {
+      delete fBasketWriteQueue;
+      fBasketWriteQueue = 0;
+   }
+}
+
 //______________________________________________________________________________
 void TTree::SetParallelUnzip(Bool_t opt, Float_t RelSize)
 {
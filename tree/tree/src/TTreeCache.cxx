@@ -568,6 +568,9 @@ Bool_t TTreeCache::FillBuffer()
    // Fill the cache buffer with the branches in the cache.
 
    if (fNbranches <= 0) return kFALSE;
+   // The baskets of a memory mapped file are read from the mapping
+   // (see TBasket::ReadBasketBuffers), prefetching them would only copy them.
+   if (fFile && fFile->IsMapped()) return kFALSE;
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
    Long64_t entry = tree->GetReadEntry();
    Long64_t fEntryCurrentMax = 0;
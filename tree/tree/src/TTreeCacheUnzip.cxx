@@ -24,9 +24,17 @@
 // Parallel Unzipping                                                   //
 //                                                                      //
 // TTreeCache has been specialised in order to let additional threads   //
-//  free to unzip in advance its content. In this implementation we     //
-//  support up to 10 threads, but right now it makes more sense to      //
-//  limit their number to 1-2                                           //
+//  free to unzip in advance its content. Once the baskets of a cluster //
+//  have been transferred by FillBuffer, each of them is handed as an   //
+//  independent task to a thread pool shared by all the caches of the   //
+//  process. The number of threads of the pool is the number of cores,  //
+//  it can be changed with the rootrc variable TTreeCache.UnzipThreads. //
+//                                                                      //
+// Each task reserves, before being queued, a part of the unzip buffer  //
+//  size corresponding to the expected size of its unzipped basket; new //
+//  tasks are queued only while the sum of the unzipped blocks and of   //
+//  these reservations fits in the unzip buffer size. As the blocks are //
+//  consumed by the reading thread, more tasks are queued.              //
 //                                                                      //
 // The application reading data is carefully synchronized, in order to: //
 //  - if the block it wants is not unzipped, it self-unzips it without  //
@@ -53,12 +61,12 @@
 #include "TVirtualMutex.h"
 #include "TThread.h"
 #include "TCondition.h"
+#include "TThreadPool.h"
 #include "TMath.h"
 #include "Bytes.h"
 
 #include "TEnv.h"
 
-#define THREADCNT 2
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
 
@@ -71,18 +79,60 @@ Double_t TTreeCacheUnzip::fgRelBuffSize = .5;
 
 ClassImp(TTreeCacheUnzip)
 
+namespace {
+
+   struct TUnzipTaskArg {
+      TTreeCacheUnzip *fCache;   // Cache owning the block
+      Int_t            fIndex;   // Index of the block in the cache request list
+      Int_t            fCycle;   // Cycle of the cache when the task was queued
+      Long64_t         fBudget;  // Part of the unzip buffer reserved for this task
+   };
+
+   class TUnzipTask : public TThreadPoolTaskImp<TUnzipTask, TUnzipTaskArg> {
+   public:
+      bool runTask(TUnzipTaskArg &arg) {
+         return arg.fCache->UnzipCache(arg.fIndex, arg.fCycle, arg.fBudget) == 0;
+      }
+   };
+
+   typedef TThreadPool<TUnzipTask, TUnzipTaskArg> TUnzipPool_t;
+
+   TUnzipTask    gUnzipTask;
+   TUnzipPool_t *gUnzipPool = 0;
+   Int_t         gUnzipPoolSize = 0;
+
+   //______________________________________________________________________________
+   TUnzipPool_t *GetUnzipPool()
+   {
+      // Return the thread pool shared by all the TTreeCacheUnzip, creating it
+      // on first use. The pool lives until the end of the process.
+
+      R__LOCKGUARD2(gGlobalMutex);
+      if (!gUnzipPool) {
+         SysInfo_t info;
+         Int_t ncpus = gSystem->GetSysInfo(&info) == 0 ? info.fCpus : 1;
+         gUnzipPoolSize = gEnv->GetValue("TTreeCache.UnzipThreads", ncpus);
+         if (gUnzipPoolSize < 1) gUnzipPoolSize = 1;
+         gUnzipPool = new TUnzipPool_t(gUnzipPoolSize);
+      }
+      return gUnzipPool;
+   }
+}
+
 //______________________________________________________________________________
 TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
 
-   fActiveThread(kFALSE),
    fAsyncReading(kFALSE),
    fCycle(0),
    fLastReadPos(0),
    fBlocksToGo(0),
+   fNTasks(0),
    fUnzipLen(0),
    fUnzipChunks(0),
    fUnzipStatus(0),
    fTotalUnzipBytes(0),
+   fReservedBytes(0),
+   fUnzipRatio(3.),
    fNseekMax(0),
    fUnzipBufferSize(0),
    fNUnzip(0),
@@ -98,15 +148,17 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
 
 //______________________________________________________________________________
 TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tree,buffersize),
-   fActiveThread(kFALSE),
    fAsyncReading(kFALSE),
    fCycle(0),
    fLastReadPos(0),
    fBlocksToGo(0),
+   fNTasks(0),
    fUnzipLen(0),
    fUnzipChunks(0),
    fUnzipStatus(0),
    fTotalUnzipBytes(0),
+   fReservedBytes(0),
+   fUnzipRatio(3.),
    fNseekMax(0),
    fUnzipBufferSize(0),
    fNUnzip(0),
@@ -127,7 +179,6 @@ void TTreeCacheUnzip::Init()
    fMutexList        = new TMutex(kTRUE);
    fIOMutex          = new TMutex(kTRUE);
 
-   fUnzipStartCondition   = new TCondition(fMutexList);
    fUnzipDoneCondition   = new TCondition(fMutexList);
 
    fTotalUnzipBytes = 0;
@@ -139,20 +190,14 @@ void TTreeCacheUnzip::Init()
       fParallel = kFALSE;
    }
    else if(fgParallel == kEnable || fgParallel == kForce) {
-      SysInfo_t info;
-      gSystem->GetSysInfo(&info);
-
       fUnzipBufferSize = Long64_t(fgRelBuffSize * GetBufferSize());
 
-      if(gDebug > 0)
-         Info("TTreeCacheUnzip", "Enabling Parallel Unzipping");
-
-      fParallel = kTRUE;
-
-      for (Int_t i = 0; i < 10; i++) fUnzipThread[i] = 0;
-
-      StartThreadUnzip(THREADCNT);
+      // With kEnable the pool is only worth using when there is more than
+      // one core, kForce uses it in any case.
+      fParallel = (fgParallel == kForce || GetUnzipPoolSize() > 1);
 
+      if(gDebug > 0 && fParallel)
+         Info("TTreeCacheUnzip", "Enabling Parallel Unzipping on %d threads", GetUnzipPoolSize());
    }
    else {
       Warning("TTreeCacheUnzip", "Parallel Option unknown");
@@ -173,14 +218,10 @@ TTreeCacheUnzip::~TTreeCacheUnzip()
    // destructor. (in general called by the TFile destructor)
 
    ResetCache();
-
-   if (IsActiveThread())
-      StopThreadUnzip();
-
+   WaitUnzipTasks();
 
    delete [] fUnzipLen;
 
-   delete fUnzipStartCondition;
    delete fUnzipDoneCondition;
 
 
@@ -254,6 +295,10 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          }
       }
 
+      // The tasks of the previous cycle may still be reading from the
+      // cache buffer, let them finish before it gets cleared.
+      WaitUnzipTasksLocked();
+
       //clear cache buffer
       TFileCacheRead::Prefetch(0,0);
 
@@ -362,48 +407,35 @@ Bool_t TTreeCacheUnzip::IsParallelUnzip()
 }
 
 //_____________________________________________________________________________
-Bool_t TTreeCacheUnzip::IsActiveThread()
+Int_t TTreeCacheUnzip::GetUnzipPoolSize()
 {
-   // This indicates if the thread is active in this moment...
-   // this variable is very important because if we change it from true to
-   // false the thread will stop... ( see StopThreadTreeCacheUnzip() )
-   R__LOCKGUARD(fMutexList);
+   // Static function returning the number of threads of the pool shared by
+   // all the caches for unzipping. The pool is created on first use.
 
-   return fActiveThread;
+   GetUnzipPool();
+   return gUnzipPoolSize;
 }
 
 //_____________________________________________________________________________
-Bool_t TTreeCacheUnzip::IsQueueEmpty()
+Bool_t TTreeCacheUnzip::IsActiveThread()
 {
-   // It says if the queue is empty... useful to see if we have to process
-   // it.
+   // Returns true if unzip tasks for this cache are queued or running
+   // in the thread pool.
    R__LOCKGUARD(fMutexList);
 
-   if ( fIsLearning )
-      return kTRUE;
-
-   return kFALSE;
+   return fNTasks > 0;
 }
 
-void TTreeCacheUnzip::WaitUnzipStartSignal()
-{
-   // Here the threads sleep waiting for some blocks to unzip
-
-   fUnzipStartCondition->TimedWaitRelative(2000);
-
-}
 //_____________________________________________________________________________
-void TTreeCacheUnzip::SendUnzipStartSignal(Bool_t broadcast)
+Bool_t TTreeCacheUnzip::IsQueueEmpty()
 {
-   // This will send the signal corresponfing to the queue... normally used
-   // when we want to start processing the list of buffers.
+   // Returns true if there is no block waiting to be handed to the pool.
+   R__LOCKGUARD(fMutexList);
 
-   if (gDebug > 0) Info("SendSignal", " fUnzipCondition->Signal()");
+   if ( fIsLearning )
+      return kTRUE;
 
-   if (broadcast)
-      fUnzipStartCondition->Broadcast();
-   else 
-      fUnzipStartCondition->Signal();
+   return fBlocksToGo <= 0;
 }
 
 //_____________________________________________________________________________
@@ -411,10 +443,10 @@ Int_t TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::EParUnzipMode option)
 {
    // Static function that(de)activates multithreading unzipping
    // The possible options are:
-   // kEnable _Enable_ it, which causes an automatic detection and launches the
-   // additional thread if the number of cores in the machine is greater than one
-   // kDisable _Disable_ will not activate the additional thread.
-   // kForce _Force_ will start the additional thread even if there is only one core.
+   // kEnable _Enable_ it, which causes an automatic detection and uses the
+   // thread pool if the number of cores in the machine is greater than one
+   // kDisable _Disable_ will not use the thread pool.
+   // kForce _Force_ will use the thread pool even if there is only one core.
    // the default will be taken as kEnable.
    // returns 0 if there was an error, 1 otherwise.
 
@@ -425,134 +457,66 @@ Int_t TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::EParUnzipMode option)
    return 0;
 }
 
-
-class TTreeCacheUnzipData {
-public:
-   TTreeCacheUnzip *fInstance;
-   Int_t            fCount;
-};
-
 //_____________________________________________________________________________
-Int_t TTreeCacheUnzip::StartThreadUnzip(Int_t nthreads)
+void TTreeCacheUnzip::ScheduleUnzip()
 {
-   // The Thread is only a part of the TTreeCache but it is the part that
-   // waits for info in the queue and process it... unfortunatly, a Thread is
-   // not an object an we have to deal with it in the old C-Style way
-   // Returns 0 if the thread was initialized or 1 if it was already running
-   Int_t nt = nthreads;
-   if (nt > 10) nt = 10;
-
-   if (gDebug > 0)
-      Info("StartThreadUnzip", "Going to start %d threads.", nt);
-
-   for (Int_t i = 0; i < nt; i++) {
-      if (!fUnzipThread[i]) {
-         TString nm("UnzipLoop");
-         nm += i;
-
-         if (gDebug > 0)
-            Info("StartThreadUnzip", "Going to start thread '%s'", nm.Data());
-
-         TTreeCacheUnzipData *d = new TTreeCacheUnzipData;
-         d->fInstance = this;
-         d->fCount = i;
-
-         fUnzipThread[i] = new TThread(nm.Data(), UnzipLoop, (void*)d);
-         if (!fUnzipThread[i])
-            Error("TTreeCacheUnzip::StartThreadUnzip", " Unable to create new thread.");
-
-         fUnzipThread[i]->Run();
-
-         // There is at least one active thread
-         fActiveThread=kTRUE;
-
+   // Hand to the thread pool the blocks of the current cycle which are
+   // not yet unzipped, starting from the last one read, as long as the
+   // unzipped blocks plus the budgets reserved by the queued tasks fit
+   // in fUnzipBufferSize.
+   // Must be called with fMutexList locked.
+
+   if (!fParallel || fIsLearning || !fIsTransferred || fBlocksToGo <= 0 || !fNseek)
+      return;
+
+   TUnzipPool_t *pool = GetUnzipPool();
+   for (Int_t ii = 0; ii < fNseek && fBlocksToGo > 0; ii++) {
+      if (fTotalUnzipBytes + fReservedBytes >= fUnzipBufferSize) break;
+
+      Int_t reqi = (fLastReadPos + ii) % fNseek;
+      if (fUnzipStatus[reqi]) continue;
+
+      fUnzipStatus[reqi] = 1; // Set it as pending
+      fBlocksToGo--;
+      // Small blocks are cheaper to unzip in the reading thread
+      if (fSeekLen[reqi] <= 256) {
+         fUnzipStatus[reqi] = 2;
+         continue;
       }
-   }
 
-   return (fActiveThread == kTRUE);
+      TUnzipTaskArg arg;
+      arg.fCache  = this;
+      arg.fIndex  = reqi;
+      arg.fCycle  = fCycle;
+      arg.fBudget = Long64_t(fUnzipRatio * fSeekLen[reqi]);
+      fReservedBytes += arg.fBudget;
+      fNTasks++;
+      pool->PushTask(gUnzipTask, arg);
+   }
 }
 
 //_____________________________________________________________________________
-Int_t TTreeCacheUnzip::StopThreadUnzip()
+void TTreeCacheUnzip::WaitUnzipTasks()
 {
-   // To stop the thread we only need to change the value of the variable
-   // fActiveThread to false and the loop will stop (of course, we will have)
-   // to do the cleaning after that.
-   // Note: The syncronization part is important here or we will try to delete
-   //       teh object while it's still processing the queue
-   fActiveThread = kFALSE;
-
-   for (Int_t i = 0; i < 1; i++) {
-      if(fUnzipThread[i]){
-
-         SendUnzipStartSignal(kTRUE);
-
-         if (fUnzipThread[i]->Exists()) {
-            fUnzipThread[i]->Join();
-            delete fUnzipThread[i];
-         }
-      }
-
-   }
+   // Invalidate the tasks queued by this cache and wait until all of them
+   // have completed. Tasks of an outdated cycle return as soon as they run.
+   // Must not be called with fMutexList already locked.
+   R__LOCKGUARD(fMutexList);
 
-   return 1;
+   WaitUnzipTasksLocked();
 }
 
-
-
 //_____________________________________________________________________________
-void* TTreeCacheUnzip::UnzipLoop(void *arg)
+void TTreeCacheUnzip::WaitUnzipTasksLocked()
 {
-   // This is a static function.
-   // This is the call that will be executed in the Thread generated by
-   // StartThreadTreeCacheUnzip... what we want to do is to inflate the next
-   // series of buffers leaving them in the second cache.
-   // Returns 0 when it finishes
-   TTreeCacheUnzipData *d = (TTreeCacheUnzipData *)arg;
-   TTreeCacheUnzip *unzipMng = d->fInstance;
-
-   TThread::SetCancelOn();
-   TThread::SetCancelDeferred();
-
-   Int_t thrnum = d->fCount;
-   Int_t startindex = thrnum;
-   Int_t locbuffsz = 16384;
-   char *locbuff = new char[16384];
-   Int_t res = 0;
-   Int_t myCycle = 0;
-
-   while( unzipMng->IsActiveThread() ) {
-      res = 1;
-
-      {
-         R__LOCKGUARD(unzipMng->fMutexList);
-         if (myCycle != unzipMng->fCycle) startindex = thrnum;
-         myCycle = unzipMng->fCycle;
-         if (unzipMng->fNseek) startindex = startindex % unzipMng->fNseek;
-         else startindex = -1;
-      }
+   // Same as WaitUnzipTasks, for a caller holding fMutexList. The lock must
+   // be held exactly once: the wait on the condition releases a single
+   // level of the recursive mutex, so the tasks could not otherwise report
+   // their completion.
 
-
-      if (startindex >= 0)
-         res = unzipMng->UnzipCache(startindex, locbuffsz, locbuff);
-
-      {
-         R__LOCKGUARD(unzipMng->fMutexList);
-
-         if(!unzipMng->IsActiveThread()) break;
-
-         if ((res == 1) || (!unzipMng->fIsTransferred)) {
-            unzipMng->WaitUnzipStartSignal();
-            startindex = unzipMng->fLastReadPos+3+thrnum;
-         }
-      }
-
-
-   }
-
-   delete d;
-   delete [] locbuff;
-   return (void *)0;
+   fCycle++;
+   while (fNTasks > 0)
+      fUnzipDoneCondition->Wait();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -658,13 +622,10 @@ void TTreeCacheUnzip::ResetCache()
 
    fLastReadPos = 0;
    fTotalUnzipBytes = 0;
+   fReservedBytes = 0;
    fBlocksToGo = fNseek;
    }
 
-
-   SendUnzipStartSignal(kTRUE);
-
-
 }
 
 //_____________________________________________________________________________
@@ -763,17 +724,16 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                      *buf = fUnzipChunks[seekidx];
                      fUnzipChunks[seekidx] = 0;
                      fTotalUnzipBytes -= fUnzipLen[seekidx];
-                     SendUnzipStartSignal(kFALSE);
                      *free = kTRUE;
                   }
                   else {
                      memcpy(*buf, fUnzipChunks[seekidx], fUnzipLen[seekidx]);
-	             delete fUnzipChunks[seekidx];
+                     delete [] fUnzipChunks[seekidx];
                      fTotalUnzipBytes -= fUnzipLen[seekidx];
                      fUnzipChunks[seekidx] = 0;
-                     SendUnzipStartSignal(kFALSE);
                      *free = kFALSE;
                   }
+                  ScheduleUnzip();
 
                   fNFound++;
 
@@ -783,9 +743,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                // If the status of the unzipped chunk is pending
                // we wait on the condvar, hoping that the next signal is the good one
                if ( fUnzipStatus[seekidx] == 1 ) {
-                  //fMutexList->UnLock();
                   fUnzipDoneCondition->TimedWaitRelative(200);
-                  //fMutexList->Lock();
 
                   if ( myCycle != fCycle ) {
                      if (gDebug > 0)
@@ -815,17 +773,16 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                   *buf = fUnzipChunks[seekidx];
                   fUnzipChunks[seekidx] = 0;
                   fTotalUnzipBytes -= fUnzipLen[seekidx];
-                  SendUnzipStartSignal(kFALSE);
                   *free = kTRUE;
                }
                else {
                   memcpy(*buf, fUnzipChunks[seekidx], fUnzipLen[seekidx]);
-                  delete fUnzipChunks[seekidx];
+                  delete [] fUnzipChunks[seekidx];
                   fTotalUnzipBytes -= fUnzipLen[seekidx];
                   fUnzipChunks[seekidx] = 0;
-                  SendUnzipStartSignal(kFALSE);
                   *free = kFALSE;
                }
+               ScheduleUnzip();
 
 
                fNStalls++;
@@ -833,13 +790,13 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                return fUnzipLen[seekidx];
             }
             else {
-               // This is a complete miss. We want to avoid the threads
+               // This is a complete miss. We want to avoid the pool
                // to try unzipping this block in the future.
-               fUnzipStatus[seekidx] = 2;
-               fUnzipChunks[seekidx] = 0;
-
-               if ((fTotalUnzipBytes < fUnzipBufferSize) && fBlocksToGo)
-                  SendUnzipStartSignal(kFALSE);
+               if (seekidx >= 0) {
+                  if (!fUnzipStatus[seekidx]) fBlocksToGo--;
+                  fUnzipStatus[seekidx] = 2;
+                  fUnzipChunks[seekidx] = 0;
+               }
 
                //if (gDebug > 0)
                //   Info("GetUnzipBuffer", "++++++++++++++++++++ CacheMISS Block wanted: %d  len:%d fNseek:%d", seekidx, len, fNseek);
@@ -891,6 +848,13 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 
    } // scope of the lock!
 
+   {
+      // The first read of a cycle transfers the cache content, from there on
+      // the remaining blocks can be unzipped by the pool.
+      R__LOCKGUARD(fMutexList);
+      ScheduleUnzip();
+   }
+
    if (!res) {
       res = UnzipBuffer(buf, fCompBuffer);
       *free = kTRUE;
@@ -1029,226 +993,111 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
 }
 
 //_____________________________________________________________________________
-Int_t TTreeCacheUnzip::UnzipCache(Int_t &startindex, Int_t &locbuffsz, char *&locbuff)
+Int_t TTreeCacheUnzip::UnzipCache(Int_t index, Int_t cycle, Long64_t budget)
 {
-   // This inflates all the buffers in the cache.. passing the data to a new
-   // buffer that will only wait there to be read...
-   // We can not inflate all the buffers in the cache so we will try to do
-   // it until the cache gets full... there is a member called fUnzipBufferSize which will
-   // tell us the max size we can allocate for this cache.
-   //
-   // note that we will  unzip in the order they were put into the cache not
-   // the order of the transference so it has to be read in that order or the
-   // pre-unzipping will be useless.
-   //
-   // startindex is used as start index to check for blks to be unzipped
+   // Unzip the block number index of the cache request list, keeping the
+   // result in fUnzipChunks until it is picked up by GetUnzipBuffer.
+   // This is executed by the tasks of the unzip thread pool, cycle is the
+   // value of fCycle when the task was queued and budget the part of
+   // fUnzipBufferSize reserved for it.
    //
-   // returns 0 in normal conditions or -1 if error, 1 if it would like to sleep
-   //
-   // This func is supposed to compete among an indefinite number of threads to get a chunk to inflate
-   // in order to accommodate multiple unzippers
    // Since everything is so async, we cannot use a fixed buffer, we are forced to keep
    // the individual chunks as separate blocks, whose summed size does not exceed the maximum
    // allowed. The pointers are kept globally in the array fUnzipChunks
-   Int_t myCycle;
+   //
+   // returns 0 in normal conditions, -1 if error and 1 if the task was outdated
+
    const Int_t hlen=128;
    Int_t objlen=0, keylen=0;
    Int_t nbytes=0;
-   Int_t readbuf = 0;
-
-   Int_t idxtounzip = -1;
    Long64_t rdoffs = 0;
    Int_t rdlen = 0;
    {
       R__LOCKGUARD(fMutexList);
 
-      if (!IsActiveThread() || !fNseek || fIsLearning || !fIsTransferred) {
+      if (cycle != fCycle || !fNseek || fIsLearning || !fIsTransferred) {
          if (gDebug > 0)
-            Info("UnzipCache", "Sudden Break!!! IsActiveThread(): %d, fNseek: %d, fIsLearning:%d",
-                 IsActiveThread(), fNseek, fIsLearning);
+            Info("UnzipCache", "Outdated task for block %d (cycle %d, current %d)", index, cycle, fCycle);
+         fNTasks--;
+         fUnzipDoneCondition->Broadcast();
          return 1;
       }
-
-      // To synchronize with the 'paging'
-      myCycle = fCycle;
-
-      // Try to look for a blk to unzip
-      idxtounzip = -1;
-      rdoffs = 0;
-      rdlen = 0;
-      if (fTotalUnzipBytes < fUnzipBufferSize) {
-
-
-         if (fBlocksToGo > 0) {
-            for (Int_t ii=0; ii < fNseek; ii++) {
-               Int_t reqi = (startindex+ii) % fNseek;
-               if (!fUnzipStatus[reqi] && (fSeekLen[reqi] > 256)   ) {
-                  // We found a chunk which is not unzipped nor pending
-                  fUnzipStatus[reqi] = 1; // Set it as pending
-                  idxtounzip = reqi;
-
-                  rdoffs = fSeek[idxtounzip];
-                  rdlen = fSeekLen[idxtounzip];
-                  break;
-               }
-            }
-	    if (idxtounzip < 0) fBlocksToGo = 0;
-         }
-
-
-      }
-
+      rdoffs = fSeek[index];
+      rdlen = fSeekLen[index];
    } // lock scope
 
-
-
-   if (idxtounzip < 0) {
-      if (gDebug > 0)
-         Info("UnzipCache", "Nothing to do... startindex:%d fTotalUnzipBytes:%lld fUnzipBufferSize:%lld fNseek:%d",
-              startindex, fTotalUnzipBytes, fUnzipBufferSize, fNseek );
-      return 1;
-   }
-
-
-   // And here we have a new blk to unzip
-   startindex = idxtounzip+THREADCNT;
-
-
-   if (!IsActiveThread() || !fNseek || fIsLearning ) {
-      if (gDebug > 0)
-         Info("UnzipCache", "Sudden Break!!! IsActiveThread(): %d, fNseek: %d, fIsLearning:%d",
-              IsActiveThread(), fNseek, fIsLearning);
-      return 1;
-   }
+   if (gDebug > 0)
+      Info("UnzipCache", "Going to unzip block %d", index);
 
    Int_t loc = -1;
+   char *locbuff = new char[rdlen];
+   Int_t readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
-   // Prepare a static tmp buf of adequate size
-   if(locbuffsz < rdlen) {
-      if (locbuff) delete [] locbuff;
-      locbuffsz = rdlen;
-      locbuff = new char[locbuffsz];
-      //memset(locbuff, 0, locbuffsz);
-   } else
-      if(locbuffsz > rdlen*3) {
-         if (locbuff) delete [] locbuff;
-         locbuffsz = rdlen*2;
-         locbuff = new char[locbuffsz];
-         //memset(locbuff, 0, locbuffsz);
-      }
-
-
-      if (gDebug > 0) 
-      Info("UnzipCache", "Going to unzip block %d", idxtounzip);
-
-      readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
-
-   {
-      R__LOCKGUARD(fMutexList);
-
-      if ( (myCycle != fCycle) || !fIsTransferred )  {
-         if (gDebug > 0)
-            Info("UnzipCache", "Sudden paging Break!!! IsActiveThread(): %d, fNseek: %d, fIsLearning:%d",
-                 IsActiveThread(), fNseek, fIsLearning);
-
-         fUnzipStatus[idxtounzip] = 2; // Set it as not done
-         fUnzipChunks[idxtounzip] = 0;
-         fUnzipLen[idxtounzip] = 0;
-         fUnzipDoneCondition->Signal();
-         
-         startindex = 0;
-         return 1;
-      }
-
-
-      if (readbuf <= 0) {
-         fUnzipStatus[idxtounzip] = 2; // Set it as not done
-         fUnzipChunks[idxtounzip] = 0;
-         fUnzipLen[idxtounzip] = 0;
-         if (gDebug > 0)
-            Info("UnzipCache", "Block %d not done. rdoffs=%lld rdlen=%d readbuf=%d", idxtounzip, rdoffs, rdlen, readbuf);
-         return -1;
-      }
-
-
+   char *ptr = 0;
+   Int_t loclen = 0;
+   if (readbuf > 0) {
       GetRecordHeader(locbuff, hlen, nbytes, objlen, keylen);
-
       Int_t len = (objlen > nbytes-keylen)? keylen+objlen : nbytes;
 
-      // If the single unzipped chunk is really too big, reset it to not processable
-      // I.e. mark it as done but set the pointer to 0
-      // This block will be unzipped synchronously in the main thread
+      // If the single unzipped chunk is really too big it is left to be
+      // unzipped synchronously in the main thread.
       if (len > 4*fUnzipBufferSize) {
-
-         //if (gDebug > 0)
-            Info("UnzipCache", "Block %d is too big, skipping.", idxtounzip);
-
-         fUnzipStatus[idxtounzip] = 2; // Set it as done
-         fUnzipChunks[idxtounzip] = 0;
-         fUnzipLen[idxtounzip] = 0;
-
-         fUnzipDoneCondition->Signal();
-         return 0;
+         if (gDebug > 0)
+            Info("UnzipCache", "Block %d is too big, skipping.", index);
+      } else {
+         loclen = UnzipBuffer(&ptr, locbuff);
       }
+   }
+   delete [] locbuff;
 
-   } // Scope of the lock
-
-   // Unzip it into a new blk
-   char *ptr = 0;
-   Int_t loclen = 0;
+   R__LOCKGUARD(fMutexList);
 
-   loclen = UnzipBuffer(&ptr, locbuff);
+   Int_t res = 0;
+   if (cycle != fCycle) {
+      // The cache moved to another cluster in the meantime
+      delete [] ptr;
+      res = 1;
+   } else {
+      fReservedBytes -= budget;
+      if ((loclen > 0) && (loclen == objlen+keylen)) {
+         fUnzipStatus[index] = 2; // Set it as done
+         fUnzipChunks[index] = ptr;
+         fUnzipLen[index] = loclen;
+         fTotalUnzipBytes += loclen;
+         fActiveBlks.push(index);
 
-   if ((loclen > 0) && (loclen == objlen+keylen)) {
-      R__LOCKGUARD(fMutexList);
+         // Keep the budget of the next tasks close to the actual sizes
+         fUnzipRatio = 0.8 * fUnzipRatio + 0.2 * Double_t(loclen) / rdlen;
 
-      if ( (myCycle != fCycle)  || !fIsTransferred) {
          if (gDebug > 0)
-            Info("UnzipCache", "Sudden paging Break!!! IsActiveThread(): %d, fNseek: %d, fIsLearning:%d",
-                 IsActiveThread(), fNseek, fIsLearning);
-         delete [] ptr;
-
-         fUnzipStatus[idxtounzip] = 2; // Set it as not done
-         fUnzipChunks[idxtounzip] = 0;
-         fUnzipLen[idxtounzip] = 0;
+            Info("UnzipCache", "reqi:%d, rdoffs:%lld, rdlen: %d, loclen:%d",
+                 index, rdoffs, rdlen, loclen);
 
-         startindex = 0;
-         fUnzipDoneCondition->Signal();
-         return 1;
+         fNUnzip++;
+      } else {
+         // Not done, the main thread will unzip it synchronously
+         if (gDebug > 0 && readbuf <= 0)
+            Info("UnzipCache", "Block %d not done. rdoffs=%lld rdlen=%d readbuf=%d", index, rdoffs, rdlen, readbuf);
+         delete [] ptr;
+         fUnzipStatus[index] = 2;
+         fUnzipChunks[index] = 0;
+         fUnzipLen[index] = 0;
+         if (readbuf <= 0) res = -1;
       }
-
-      fUnzipStatus[idxtounzip] = 2; // Set it as done
-      fUnzipChunks[idxtounzip] = ptr;
-      fUnzipLen[idxtounzip] = loclen;
-      fTotalUnzipBytes += loclen;
-
-      fActiveBlks.push(idxtounzip);
-
-      if (gDebug > 0)
-         Info("UnzipCache", "reqi:%d, rdoffs:%lld, rdlen: %d, loclen:%d",
-              idxtounzip, rdoffs, rdlen, loclen);
-
-      fNUnzip++;
-   }
-   else {
-      R__LOCKGUARD(fMutexList);
-      Info("argh", "loclen:%d objlen:%d loc:%d readbuf:%d", loclen, objlen, loc, readbuf);
-      fUnzipStatus[idxtounzip] = 2; // Set it as done
-      fUnzipChunks[idxtounzip] = 0;
-      fUnzipLen[idxtounzip] = 0;
+      // Some budget was given back, keep the pool busy
+      ScheduleUnzip();
    }
 
-
-   fUnzipDoneCondition->Signal();
-
-   delete [] ptr;
-   return 0;
+   fNTasks--;
+   fUnzipDoneCondition->Broadcast();
+   return res;
 }
 
 void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
+   printf("Number of threads in the unzip pool: %d\n", gUnzipPoolSize);
    printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
@@ -25,6 +25,9 @@
 #pragma link C++ class TTreeDrawArgsParser+;
 #pragma link C++ class TTreePerfStats+;
 #pragma link C++ class TTreeReader+;
+#pragma link C++ class TThreadedTreeProcessor;
+#pragma link C++ class TThreadedTreeProcessor::TWorker;
+#pragma link C++ class TThreadedTreeProcessor::TRange;
 #pragma link C++ class TTreeTableInterface;
 
 #pragma link C++ namespace ROOT;
@@ -0,0 +1,99 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TThreadedTreeProcessor
+#define ROOT_TThreadedTreeProcessor
+
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TThreadedTreeProcessor                                                 //
+//                                                                        //
+// Process the entries of a TTree or a TChain with several threads, each  //
+// reading its own copy of the files through a TTreeReader.               //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TObject
+#include "TObject.h"
+#endif
+#ifndef ROOT_TString
+#include "TString.h"
+#endif
+
+#include <vector>
+
+class TTree;
+class TMutex;
+class TTreeReader;
+
+class TThreadedTreeProcessor : public TObject {
+public:
+
+   // User code run by the threads. Each thread works on its own copy of
+   // the worker (see MakeCopy), the copies are merged at the end.
+   class TWorker {
+   public:
+      virtual ~TWorker() {}
+
+      // Return a new worker with the same configuration and empty results.
+      virtual TWorker *MakeCopy() const = 0;
+      // Create the TTreeReaderValues/TTreeReaderArrays on reader. Called each
+      // time the thread switches to a new file, with a new reader.
+      virtual void     Init(TTreeReader &reader) = 0;
+      // Process the entry just loaded in the reader given to Init.
+      // entry is the entry number in the TTree of the current file.
+      virtual void     Process(Long64_t entry) = 0;
+      // Add the results of other to the ones of this worker.
+      virtual void     Merge(TWorker &other) = 0;
+   };
+
+   struct TRange {
+      Int_t    fFile;   // Index of the file in the list of files
+      Long64_t fFirst;  // First entry of the range, in the TTree of the file
+      Long64_t fEnd;    // Entry following the last entry of the range
+   };
+
+private:
+   TThreadedTreeProcessor(const TThreadedTreeProcessor&);            // not implemented
+   TThreadedTreeProcessor& operator=(const TThreadedTreeProcessor&); // not implemented
+
+   std::vector<TString> fFileNames;    // Files to process
+   std::vector<TString> fTreeNames;    // Name of the TTree in each file
+   std::vector<TRange>  fRanges;       // Cluster aligned ranges of entries, in file order
+   Int_t                fNThreads;     // Number of threads, 0 for the number of cores
+   Long64_t             fMinRangeSize; // Minimum number of entries of a range
+   UInt_t               fNextRange;    // Next range to be handed to a thread
+   Long64_t             fNProcessed;   // Number of entries processed
+   Int_t                fNErrors;      // Number of errors during the processing
+   TMutex              *fMutex;        // Protect fNextRange, fNProcessed and fNErrors
+
+   Bool_t        BuildRanges();
+   Bool_t        NextRange(TRange &range);
+   void          ProcessRanges(TWorker &worker);
+   static void  *ThreadRun(void *arg);
+
+public:
+   TThreadedTreeProcessor(TTree *tree);
+   TThreadedTreeProcessor(const char *treename, const char *filename);
+   virtual ~TThreadedTreeProcessor();
+
+   void          AddFile(const char *filename, const char *treename = 0);
+   Long64_t      GetMinRangeSize() const { return fMinRangeSize; }
+   Int_t         GetNThreads() const;
+   const std::vector<TRange> &GetRanges();
+   Long64_t      Process(TWorker &worker);
+   void          SetMinRangeSize(Long64_t nentries) { fMinRangeSize = nentries; }
+   void          SetNThreads(Int_t nthreads) { fNThreads = nthreads; }
+
+   ClassDef(TThreadedTreeProcessor,0)  // Process a TTree or a TChain with several threads
+};
+
+#endif
@@ -65,6 +65,11 @@ class TTreeFormula : public TFormula {
 
 friend class TTreeFormulaManager;
 
+public:
+   // Signatures of the expressions compiled by the JIT (see SetJitCompilation)
+   typedef Double_t (*JitLoad_t)(void *formula, Int_t oper, Int_t instance, Int_t *outOfRange);
+   typedef Double_t (*JitKernel_t)(void *formula, Int_t instance, JitLoad_t load, Int_t *outOfRange);
+
 protected:
    enum {
       kIsCharacter = BIT(12),
@@ -124,6 +129,12 @@ protected:
    TList                    *fDimensionSetup; //! list of dimension setups, for delayed creation of the dimension information.
    std::vector<std::string>  fAliasesUsed;    //! List of aliases used during the parsing of the expression.
 
+   // Members used by the JIT compiled evaluation
+   Int_t                     fJitState;       //! 0: not compiled yet, 1: compiled, -1: evaluated by the interpreter
+   JitKernel_t               fJitKernel;      //! Compiled expression
+   Bool_t                    fJitWillLoad;    //! True if the branches must be loaded by the current evaluation
+   static Int_t              fgJitCompilation;//! 1 if the expressions are JIT compiled, -1 if not yet read from gEnv
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -142,6 +153,10 @@ protected:
    virtual void*     GetValuePointerFromMethod(Int_t i, TLeaf *leaf) const;
    Int_t             GetRealInstance(Int_t instance, Int_t codeindex);
 
+   Bool_t            CompileJit();
+   Double_t          EvalJitOperand(Int_t oper, Int_t instance, Bool_t &outOfRange);
+   static Double_t   JitLoad(void *formula, Int_t oper, Int_t instance, Int_t *outOfRange);
+
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
    void              ResetDimensions();
@@ -184,12 +199,15 @@ public:
    //the mutable keyword.
    //NOTE: Also modify the code in PrintValue which current goes around this limitation :(
    virtual Bool_t      IsInteger(Bool_t fast=kTRUE) const;
+           Bool_t      IsJitCompiled() const { return fJitState > 0; }
+   static  Bool_t      IsJitCompilation();
            Bool_t      IsQuickLoad() const { return fQuickLoad; }
    virtual Bool_t      IsString() const;
    virtual Bool_t      Notify() { UpdateFormulaLeaves(); return kTRUE; }
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
    virtual void        SetAxis(TAxis *axis=0);
+   static  void        SetJitCompilation(Bool_t jit = kTRUE);
            void        SetQuickLoad(Bool_t quick) { fQuickLoad = quick; }
    virtual void        SetTree(TTree *tree) {fTree = tree;}
    virtual void        ResetLoading();
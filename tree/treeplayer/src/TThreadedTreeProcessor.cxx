@@ -0,0 +1,348 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TThreadedTreeProcessor                                                 //
+//                                                                        //
+// Process the entries of a TTree or a TChain with several threads.       //
+//                                                                        //
+// The entries of each file are split in ranges aligned on the clusters   //
+// of the TTree (see TTree::GetClusterIterator), so that no basket is     //
+// read by two threads. The ranges are handed, in file order, to the      //
+// threads as they become idle. Each thread opens its own TFile, TTree    //
+// and TTreeReader and runs its own copy of the user's worker, derived    //
+// from TThreadedTreeProcessor::TWorker; once all the ranges have been    //
+// processed the copies are merged, in thread order, into the worker      //
+// passed to Process. Which ranges a copy processed depends on the        //
+// scheduling of the threads: the result of a worker whose Merge is not   //
+// commutative (e.g. one filling a TTree or a list of entries) may change //
+// from one run to the next.                                              //
+//                                                                        //
+// Example:                                                               //
+//                                                                        //
+//   class TPtWorker : public TThreadedTreeProcessor::TWorker {           //
+//      TTreeReaderValue<Float_t> *fPt;                                   //
+//      TH1F                      *fHist;                                 //
+//   public:                                                              //
+//      TPtWorker() : fPt(0) {                                            //
+//         fHist = new TH1F("pt", "pt", 100, 0, 100);                     //
+//         fHist->SetDirectory(0);                                        //
+//      }                                                                 //
+//      ~TPtWorker() { delete fPt; delete fHist; }                        //
+//      TWorker *MakeCopy() const { return new TPtWorker; }               //
+//      void Init(TTreeReader &r) {                                       //
+//         delete fPt;                                                    //
+//         fPt = new TTreeReaderValue<Float_t>(r, "pt");                  //
+//      }                                                                 //
+//      void Process(Long64_t) { fHist->Fill(**fPt); }                    //
+//      void Merge(TWorker &o) { fHist->Add(((TPtWorker&)o).fHist); }     //
+//   };                                                                   //
+//                                                                        //
+//   TChain chain("T");                                                   //
+//   chain.Add("data*.root");                                             //
+//   TThreadedTreeProcessor proc(&chain);                                 //
+//   TPtWorker worker;                                                    //
+//   proc.Process(worker);                                                //
+//   worker.fHist->Draw();                                                //
+//                                                                        //
+// The objects created by the workers must not be attached to a           //
+// directory (use TH1::SetDirectory(0) or TH1::AddDirectory(kFALSE)).     //
+// The friends and the entry lists of the TTree are not used.             //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include "TThreadedTreeProcessor.h"
+
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TDirectory.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TMath.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TThread.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TVirtualMutex.h"
+
+ClassImp(TThreadedTreeProcessor)
+
+namespace {
+   struct TThreadArgs {
+      TThreadedTreeProcessor           *fProcessor;
+      TThreadedTreeProcessor::TWorker  *fWorker;
+   };
+}
+
+//______________________________________________________________________________
+TThreadedTreeProcessor::TThreadedTreeProcessor(TTree *tree) :
+   fNThreads(0), fMinRangeSize(0), fNextRange(0), fNProcessed(0), fNErrors(0)
+{
+   // Process the entries of tree, which can be a TChain. The TTree must
+   // have been read from a file: the threads open the files again.
+
+   fMutex = new TMutex();
+   if (!tree) return;
+   if (tree->IsA()->InheritsFrom(TChain::Class())) {
+      TIter next(((TChain*)tree)->GetListOfFiles());
+      TChainElement *element;
+      while ((element = (TChainElement*)next())) {
+         AddFile(element->GetTitle(), element->GetName());
+      }
+   } else if (tree->GetCurrentFile()) {
+      // Name of the TTree relative to the top directory of its file.
+      TString name = tree->GetName();
+      TString path = tree->GetDirectory() ? tree->GetDirectory()->GetPath() : "";
+      Ssiz_t colon = path.Index(":/");
+      if (colon != kNPOS && colon + 2 < path.Length()) {
+         name = TString(path(colon + 2, path.Length())) + "/" + name;
+      }
+      AddFile(tree->GetCurrentFile()->GetName(), name);
+   } else {
+      Error("TThreadedTreeProcessor", "The TTree %s is not attached to a file", tree->GetName());
+   }
+}
+
+//______________________________________________________________________________
+TThreadedTreeProcessor::TThreadedTreeProcessor(const char *treename, const char *filename) :
+   fNThreads(0), fMinRangeSize(0), fNextRange(0), fNProcessed(0), fNErrors(0)
+{
+   // Process the entries of the TTree treename in the file filename.
+   // More files can be added with AddFile.
+
+   fMutex = new TMutex();
+   AddFile(filename, treename);
+}
+
+//______________________________________________________________________________
+TThreadedTreeProcessor::~TThreadedTreeProcessor()
+{
+   // Destructor.
+
+   delete fMutex;
+}
+
+//______________________________________________________________________________
+void TThreadedTreeProcessor::AddFile(const char *filename, const char *treename)
+{
+   // Add the TTree treename of the file filename. If treename is null,
+   // the name of the TTree of the first file is used.
+
+   TString name = treename;
+   if (name.IsNull() && !fTreeNames.empty()) {
+      name = fTreeNames[0];
+   }
+   fFileNames.push_back(filename);
+   fTreeNames.push_back(name);
+   fRanges.clear();
+}
+
+//______________________________________________________________________________
+Bool_t TThreadedTreeProcessor::BuildRanges()
+{
+   // Split the entries of each file in ranges aligned on the clusters.
+   // Consecutive clusters are grouped until the range has at least
+   // fMinRangeSize entries.
+   // Returns kFALSE if a file or a TTree cannot be opened.
+
+   fRanges.clear();
+   for (UInt_t i = 0; i < fFileNames.size(); ++i) {
+      TDirectory::TContext ctxt(0);
+      TFile *file = TFile::Open(fFileNames[i]);
+      TTree *tree = 0;
+      if (file && !file->IsZombie()) {
+         file->GetObject(fTreeNames[i], tree);
+      }
+      if (!tree) {
+         Error("BuildRanges", "Cannot read the TTree %s from %s",
+               fTreeNames[i].Data(), fFileNames[i].Data());
+         delete file;
+         fRanges.clear();
+         return kFALSE;
+      }
+      Long64_t nentries = tree->GetEntries();
+      TTree::TClusterIterator clusters = tree->GetClusterIterator(0);
+      TRange range;
+      range.fFile = i;
+      range.fFirst = 0;
+      range.fEnd = 0;
+      Long64_t start;
+      while ((start = clusters()) < nentries) {
+         range.fEnd = TMath::Min(clusters.GetNextEntry(), nentries);
+         if (range.fEnd - range.fFirst >= fMinRangeSize) {
+            fRanges.push_back(range);
+            range.fFirst = range.fEnd;
+         }
+      }
+      if (range.fFirst < nentries) {
+         range.fEnd = nentries;
+         fRanges.push_back(range);
+      }
+      delete file;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t TThreadedTreeProcessor::GetNThreads() const
+{
+   // Return the number of threads used by Process. If it was not set
+   // with SetNThreads, this is the number of cores.
+
+   if (fNThreads > 0) return fNThreads;
+   SysInfo_t info;
+   if (gSystem->GetSysInfo(&info) == 0 && info.fCpus > 0) return info.fCpus;
+   return 1;
+}
+
+//______________________________________________________________________________
+const std::vector<TThreadedTreeProcessor::TRange> &TThreadedTreeProcessor::GetRanges()
+{
+   // Return the ranges of entries handed to the threads.
+
+   if (fRanges.empty()) BuildRanges();
+   return fRanges;
+}
+
+//______________________________________________________________________________
+Bool_t TThreadedTreeProcessor::NextRange(TRange &range)
+{
+   // Get the next range of entries to process. Returns kFALSE when
+   // all the ranges have been handed out.
+
+   R__LOCKGUARD(fMutex);
+   if (fNextRange >= fRanges.size()) return kFALSE;
+   range = fRanges[fNextRange++];
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+void TThreadedTreeProcessor::ProcessRanges(TWorker &worker)
+{
+   // Process ranges until there is none left. This is run by each thread.
+
+   TDirectory::TContext ctxt(0);
+   TFile *file = 0;
+   TTreeReader *reader = 0;
+   Int_t current = -1;
+   Long64_t nprocessed = 0;
+   Int_t nerrors = 0;
+   TRange range;
+   while (NextRange(range)) {
+      if (range.fFile != current) {
+         // Opening and closing the files goes through the global lists of
+         // ROOT (files, streamer infos, classes): one thread at a time.
+         // The readers of the worker are told that the reader disappears.
+         TTree *tree = 0;
+         {
+            R__LOCKGUARD2(gROOTMutex);
+            delete reader;
+            reader = 0;
+            delete file;
+            current = range.fFile;
+            file = TFile::Open(fFileNames[current]);
+            if (file && !file->IsZombie()) {
+               file->GetObject(fTreeNames[current], tree);
+            }
+            if (tree) reader = new TTreeReader(tree);
+         }
+         if (!tree) {
+            Error("Process", "Cannot read the TTree %s from %s",
+                  fTreeNames[current].Data(), fFileNames[current].Data());
+            ++nerrors;
+            continue;
+         }
+         worker.Init(*reader);
+      }
+      if (!reader) {
+         ++nerrors;
+         continue;
+      }
+      reader->GetTree()->SetCacheEntryRange(range.fFirst, range.fEnd - 1);
+      for (Long64_t entry = range.fFirst; entry < range.fEnd; ++entry) {
+         if (reader->SetEntry(entry) != TTreeReader::kEntryValid) {
+            Error("Process", "Cannot read entry %lld of %s", entry, fFileNames[current].Data());
+            ++nerrors;
+            break;
+         }
+         worker.Process(entry);
+         ++nprocessed;
+      }
+   }
+   {
+      R__LOCKGUARD2(gROOTMutex);
+      delete reader;
+      delete file;
+   }
+
+   R__LOCKGUARD(fMutex);
+   fNProcessed += nprocessed;
+   fNErrors += nerrors;
+}
+
+//______________________________________________________________________________
+void *TThreadedTreeProcessor::ThreadRun(void *arg)
+{
+   // Entry point of the threads.
+
+   TThreadArgs *args = (TThreadArgs*)arg;
+   args->fProcessor->ProcessRanges(*args->fWorker);
+   return 0;
+}
+
+//______________________________________________________________________________
+Long64_t TThreadedTreeProcessor::Process(TWorker &worker)
+{
+   // Process all the entries with GetNThreads() threads, each running a
+   // copy of worker obtained with TWorker::MakeCopy. At the end the
+   // results of the copies are merged into worker with TWorker::Merge.
+   //
+   // Returns the number of entries processed or -1 in case of error.
+
+   if (fFileNames.empty()) return -1;
+   if (fRanges.empty() && !BuildRanges()) return -1;
+
+   fNextRange = 0;
+   fNProcessed = 0;
+   fNErrors = 0;
+
+   Int_t nthreads = TMath::Min(GetNThreads(), (Int_t)fRanges.size());
+   if (nthreads <= 1) {
+      ProcessRanges(worker);
+      return fNErrors ? -1 : fNProcessed;
+   }
+
+   TThread::Initialize();
+
+   std::vector<TThreadArgs> args(nthreads);
+   std::vector<TThread*> threads(nthreads);
+   for (Int_t i = 0; i < nthreads; ++i) {
+      args[i].fProcessor = this;
+      args[i].fWorker = worker.MakeCopy();
+      threads[i] = new TThread(TString::Format("TThreadedTreeProcessor_%d", i),
+                               (TThread::VoidRtnFunc_t)&TThreadedTreeProcessor::ThreadRun,
+                               &args[i]);
+      threads[i]->Run();
+   }
+   for (Int_t i = 0; i < nthreads; ++i) {
+      threads[i]->Join();
+      delete threads[i];
+   }
+   // Merge in thread order; the ranges of each copy were taken as the
+   // threads became idle, so the order of the merged entries may still
+   // differ from one run to the next.
+   for (Int_t i = 0; i < nthreads; ++i) {
+      worker.Merge(*args[i].fWorker);
+      delete args[i].fWorker;
+   }
+   return fNErrors ? -1 : fNProcessed;
+}
@@ -45,6 +45,8 @@
 #include "TFormLeafInfoReference.h"
 
 #include "TEntryList.h"
+#include "TEnv.h"
+#include "TVirtualMutex.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -52,6 +54,7 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <map>
 
 const Int_t kMaxLen     = 1024;
 R__EXTERN TTree *gTree;
@@ -60,6 +63,8 @@ R__EXTERN TTree *gTree;
 
 ClassImp(TTreeFormula)
 
+Int_t TTreeFormula::fgJitCompilation = -1;
+
 //______________________________________________________________________________
 //
 // TTreeFormula now relies on a variety of TFormLeafInfo classes to handle the
@@ -128,7 +133,8 @@ public:
 
 //______________________________________________________________________________
 TTreeFormula::TTreeFormula(): TFormula(), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-   fDidBooleanOptimization(kFALSE), fDimensionSetup(0)
+   fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fJitState(0), fJitKernel(0),
+   fJitWillLoad(kFALSE)
 
 {
    // Tree Formula default constructor
@@ -159,7 +165,8 @@ TTreeFormula::TTreeFormula(): TFormula(), fQuickLoad(kFALSE), fNeedLoading(kTRUE
 //______________________________________________________________________________
 TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree)
    :TFormula(), fTree(tree), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-    fDidBooleanOptimization(kFALSE), fDimensionSetup(0)
+    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fJitState(0), fJitKernel(0),
+    fJitWillLoad(kFALSE)
 {
    // Normal TTree Formula Constuctor
 
@@ -170,7 +177,8 @@ TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree)
 TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree,
                            const std::vector<std::string>& aliases)
    :TFormula(), fTree(tree), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fAliasesUsed(aliases)
+    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fAliasesUsed(aliases), fJitState(0),
+    fJitKernel(0), fJitWillLoad(kFALSE)
 {
    // Constructor used during the expansion of an alias
    Init(name,expression);
@@ -3861,6 +3869,193 @@ namespace {
    }
 }
 
+namespace {
+
+   // Conventions of TTreeFormula::EvalInstance for the operators and the
+   // functions which are not defined everywhere, declared to the interpreter
+   // before the first compiled expression.
+   const char *gJitFunctions =
+      "namespace R__TTreeFormulaJit {"
+      " inline double Div(double a, double b) { return b == 0 ? 0 : a / b; }"
+      " inline double Mod(double a, double b) { return double((Long64_t)a % (Long64_t)b); }"
+      " inline double Fmod(double a, double b) { return fmod(a, b); }"
+      " inline double Tan(double a) { return TMath::Cos(a) == 0 ? 0 : TMath::Tan(a); }"
+      " inline double ACos(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ACos(a); }"
+      " inline double ASin(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ASin(a); }"
+      " inline double TanH(double a) { return TMath::CosH(a) == 0 ? 0 : TMath::TanH(a); }"
+      " inline double ACosH(double a) { return a < 1 ? 0 : TMath::ACosH(a); }"
+      " inline double ATanH(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ATanH(a); }"
+      " inline double Log(double a) { return a > 0 ? TMath::Log(a) : 0; }"
+      " inline double Log10(double a) { return a > 0 ? TMath::Log10(a) : 0; }"
+      " inline double Exp(double a) { return a < -700 ? 0 : (a > 700 ? TMath::Exp(700) : TMath::Exp(a)); }"
+      " inline double Sq(double a) { return a * a; }"
+      " inline double Sign(double a) { return a < 0 ? -1 : 1; }"
+      " inline double And(double a, double b) { return (a != 0 && b != 0) ? 1 : 0; }"
+      " inline double Or(double a, double b) { return (a != 0 || b != 0) ? 1 : 0; }"
+      "}";
+
+   Bool_t gJitFunctionsDeclared = kFALSE;
+   Int_t  gJitNKernels = 0;
+
+   // The compiled expressions, by source code, shared by all the formulas.
+   typedef std::map<std::string, TTreeFormula::JitKernel_t> JitKernels_t;
+   JitKernels_t &JitKernels()
+   {
+      static JitKernels_t kernels;
+      return kernels;
+   }
+}
+
+//______________________________________________________________________________
+Bool_t TTreeFormula::CompileJit()
+{
+   // Translate the expression into a C++ function compiled by the interpreter
+   // (see SetJitCompilation). The operators, the constants and the mathematical
+   // functions are compiled; the operands read from the tree, the aliases and
+   // the special functions (Sum$, Length$, ...) are still evaluated by
+   // EvalJitOperand. Returns kFALSE, in which case the expression is evaluated
+   // by EvalInstance, if it uses strings, the operator ?:, external functions
+   // or random numbers, or if the compilation fails.
+
+   fJitState = -1;
+   fJitKernel = 0;
+   if (fNoper < 2 || fAxis || !gInterpreter) return kFALSE;
+
+   // Simulate the evaluation stack of EvalInstance with the source code of
+   // each intermediate result. andor is 1 (resp. 2) if the operand is the left
+   // side of a && (resp. ||) which EvalInstance may not evaluate entirely.
+   std::vector<TString> stack;
+   std::vector<Int_t> andor;
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      const char *unary = 0;
+      const char *binary = 0;
+      switch (action) {
+         case kEnd: i = fNoper; continue;
+         case kConstant: {
+            Double_t value = fConst[(oper & kTFOperMask)];
+            if (!TMath::Finite(value)) return kFALSE;
+            stack.push_back(TString::Format("(%.17g)", value));
+            andor.push_back(0);
+            continue;
+         }
+         case kpi:
+            stack.push_back("TMath::ACos(-1.)");
+            andor.push_back(0);
+            continue;
+         case kDefinedVariable:
+         case kAlias:
+         case kMinIf:
+         case kMaxIf:
+            stack.push_back(TString::Format("v(f,%d,instance,s)", i));
+            andor.push_back(0);
+            if (action == kMinIf || action == kMaxIf) ++i; // skip the place holder for the condition
+            continue;
+         case kBoolOptimize:
+            if (stack.empty()) return kFALSE;
+            andor.back() = (oper & kTFOperMask) % 10;
+            continue;
+
+         case kAdd:        binary = "(%s+%s)"; break;
+         case kSubstract:  binary = "(%s-%s)"; break;
+         case kMultiply:   binary = "(%s*%s)"; break;
+         case kDivide:     binary = "R__TTreeFormulaJit::Div(%s,%s)"; break;
+         case kModulo:     binary = "R__TTreeFormulaJit::Mod(%s,%s)"; break;
+         case katan2:      binary = "TMath::ATan2(%s,%s)"; break;
+         case kfmod:       binary = "R__TTreeFormulaJit::Fmod(%s,%s)"; break;
+         case kpow:        binary = "TMath::Power(%s,%s)"; break;
+         case kmin:        binary = "TMath::Min(%s,%s)"; break;
+         case kmax:        binary = "TMath::Max(%s,%s)"; break;
+         case kAnd:        binary = andor.size() > 1 && andor[andor.size()-2] == 1 ?
+                                    "((%s)!=0&&(%s)!=0?1.:0.)" : "R__TTreeFormulaJit::And(%s,%s)"; break;
+         case kOr:         binary = andor.size() > 1 && andor[andor.size()-2] == 2 ?
+                                    "((%s)!=0||(%s)!=0?1.:0.)" : "R__TTreeFormulaJit::Or(%s,%s)"; break;
+         case kEqual:      binary = "((%s)==(%s)?1.:0.)"; break;
+         case kNotEqual:   binary = "((%s)!=(%s)?1.:0.)"; break;
+         case kLess:       binary = "((%s)<(%s)?1.:0.)"; break;
+         case kGreater:    binary = "((%s)>(%s)?1.:0.)"; break;
+         case kLessThan:   binary = "((%s)<=(%s)?1.:0.)"; break;
+         case kGreaterThan:binary = "((%s)>=(%s)?1.:0.)"; break;
+         case kBitAnd:     binary = "double((Long64_t)(%s)&(Long64_t)(%s))"; break;
+         case kBitOr:      binary = "double((Long64_t)(%s)|(Long64_t)(%s))"; break;
+         case kLeftShift:  binary = "double((Long64_t)(%s)<<(Long64_t)(%s))"; break;
+         case kRightShift: binary = "double((Long64_t)(%s)>>(Long64_t)(%s))"; break;
+
+         case kcos:    unary = "TMath::Cos(%s)"; break;
+         case ksin:    unary = "TMath::Sin(%s)"; break;
+         case ktan:    unary = "R__TTreeFormulaJit::Tan(%s)"; break;
+         case kacos:   unary = "R__TTreeFormulaJit::ACos(%s)"; break;
+         case kasin:   unary = "R__TTreeFormulaJit::ASin(%s)"; break;
+         case katan:   unary = "TMath::ATan(%s)"; break;
+         case kcosh:   unary = "TMath::CosH(%s)"; break;
+         case ksinh:   unary = "TMath::SinH(%s)"; break;
+         case ktanh:   unary = "R__TTreeFormulaJit::TanH(%s)"; break;
+         case kacosh:  unary = "R__TTreeFormulaJit::ACosH(%s)"; break;
+         case kasinh:  unary = "TMath::ASinH(%s)"; break;
+         case katanh:  unary = "R__TTreeFormulaJit::ATanH(%s)"; break;
+         case ksq:     unary = "R__TTreeFormulaJit::Sq(%s)"; break;
+         case ksqrt:   unary = "TMath::Sqrt(TMath::Abs(%s))"; break;
+         case klog:    unary = "R__TTreeFormulaJit::Log(%s)"; break;
+         case kexp:    unary = "R__TTreeFormulaJit::Exp(%s)"; break;
+         case klog10:  unary = "R__TTreeFormulaJit::Log10(%s)"; break;
+         case kabs:    unary = "TMath::Abs(%s)"; break;
+         case ksign:   unary = "R__TTreeFormulaJit::Sign(%s)"; break;
+         case kint:    unary = "double(Int_t(%s))"; break;
+         case kSignInv:unary = "(-(%s))"; break;
+         case kNot:    unary = "((%s)!=0?0.:1.)"; break;
+
+         default:
+            // Strings, jumps, function calls, random numbers, ...
+            return kFALSE;
+      }
+      if (unary) {
+         if (stack.empty()) return kFALSE;
+         stack.back() = TString::Format(unary, stack.back().Data());
+         andor.back() = 0;
+      } else {
+         if (stack.size() < 2) return kFALSE;
+         TString right = stack.back();
+         stack.pop_back();
+         andor.pop_back();
+         stack.back() = TString::Format(binary, stack.back().Data(), right.Data());
+         andor.back() = 0;
+      }
+   }
+   if (stack.size() != 1) return kFALSE;
+
+   R__LOCKGUARD(gClingMutex);
+   std::string code(stack.back().Data());
+   JitKernels_t::iterator iter = JitKernels().find(code);
+   if (iter != JitKernels().end()) {
+      fJitKernel = iter->second;
+   } else {
+      Bool_t errmsg = gInterpreter->SetErrorMessages(kFALSE);
+      TInterpreter::EErrorCode err = TInterpreter::kNoError;
+      if (!gJitFunctionsDeclared) {
+         gInterpreter->ProcessLine("#include \"TMath.h\"", &err);
+         if (err == TInterpreter::kNoError) gInterpreter->ProcessLine(gJitFunctions, &err);
+         gJitFunctionsDeclared = (err == TInterpreter::kNoError);
+      }
+      if (gJitFunctionsDeclared) {
+         TString name = TString::Format("Kernel%d", gJitNKernels++);
+         gInterpreter->ProcessLine(TString::Format("namespace R__TTreeFormulaJit {"
+                                                   " double %s(void *f, int instance, double (*v)(void*,int,int,int*), int *s)"
+                                                   " { return %s; } }", name.Data(), code.c_str()), &err);
+         if (err == TInterpreter::kNoError) {
+            Long_t address = gInterpreter->Calc(TString::Format("(long)&R__TTreeFormulaJit::%s", name.Data()), &err);
+            if (err == TInterpreter::kNoError) fJitKernel = (JitKernel_t)address;
+         }
+      }
+      gInterpreter->SetErrorMessages(errmsg);
+      // Remember the failures too, to not compile the same code again.
+      JitKernels()[code] = fJitKernel;
+   }
+   if (!fJitKernel) return kFALSE;
+   fJitState = 1;
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 Double_t TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
 {
@@ -3927,6 +4122,19 @@ Double_t TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[]
       }
    }
 
+   if (fJitState == 0 && IsJitCompilation()) CompileJit();
+   if (fJitState > 0) {
+      const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+      // The compiled code may evaluate the operands in a different order than
+      // EvalInstance and skip the right side of && and ||, so the operands
+      // which share their branch with another one must check that it is loaded.
+      if (willLoad) fDidBooleanOptimization = kTRUE;
+      fJitWillLoad = willLoad;
+      Int_t outOfRange = 0;
+      Double_t result = fJitKernel(this, instance, &TTreeFormula::JitLoad, &outOfRange);
+      return outOfRange ? 0 : result;
+   }
+
    Double_t tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4311,6 +4519,94 @@ Double_t TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[]
    return result;
 }
 
+//______________________________________________________________________________
+Double_t TTreeFormula::EvalJitOperand(Int_t i, Int_t instance, Bool_t &outOfRange)
+{
+   // Evaluate the operand i of the expression (a tree variable, an alias, ...)
+   // as EvalInstance does, for the compiled expression. outOfRange is set if
+   // instance is beyond the size of an array, in which case EvalInstance
+   // returns 0 for the whole expression.
+
+   const Int_t oper = GetOper()[i];
+   const Int_t newaction = oper >> kTFOperShift;
+   const Bool_t willLoad = fJitWillLoad;
+   outOfRange = kFALSE;
+
+   switch (newaction) {
+      case kAlias: {
+         TTreeFormula *subform = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+         R__ASSERT(subform);
+         return subform->EvalInstance(instance);
+      }
+      case kMinIf: {
+         TTreeFormula *primary = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+         TTreeFormula *condition = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i+1));
+         return FindMin(primary,condition);
+      }
+      case kMaxIf: {
+         TTreeFormula *primary = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+         TTreeFormula *condition = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i+1));
+         return FindMax(primary,condition);
+      }
+   }
+
+   const Int_t code = (oper & kTFOperMask);
+   switch (fLookupType[code]) {
+      case kIndexOfEntry: return (Double_t)fTree->GetReadEntry();
+      case kIndexOfLocalEntry: return (Double_t)fTree->GetTree()->GetReadEntry();
+      case kEntries:      return (Double_t)fTree->GetEntries();
+      case kLength:       return fManager->fNdata;
+      case kLengthFunc:   return ((TTreeFormula*)fAliases.UncheckedAt(i))->GetNdata();
+      case kIteration:    return instance;
+      case kSum:          return Summing((TTreeFormula*)fAliases.UncheckedAt(i));
+      case kMin:          return FindMin((TTreeFormula*)fAliases.UncheckedAt(i));
+      case kMax:          return FindMax((TTreeFormula*)fAliases.UncheckedAt(i));
+
+      // The macros return 0 if instance is out of range.
+      case kDirect:     { outOfRange = kTRUE; TT_EVAL_INIT_LOOP; outOfRange = kFALSE;
+                          return leaf->GetValue(real_instance); }
+      case kMethod:     { outOfRange = kTRUE; TT_EVAL_INIT_LOOP; outOfRange = kFALSE;
+                          return GetValueFromMethod(code,leaf); }
+      case kDataMember: { outOfRange = kTRUE; TT_EVAL_INIT_LOOP; outOfRange = kFALSE;
+                          return ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->GetValue(leaf,real_instance); }
+      case kTreeMember: { outOfRange = kTRUE; TREE_EVAL_INIT_LOOP; outOfRange = kFALSE;
+                          return ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->GetValue((TLeaf*)0x0,real_instance); }
+      case kEntryList: {
+         TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
+         return elist->Contains(fTree->GetReadEntry());
+      }
+      case -1: break;
+      default: return 0;
+   }
+   switch (fCodes[code]) {
+      case -2: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         TTreeFormula *fy = (TTreeFormula *)gcut->GetObjectY();
+         Double_t xcut = fx->EvalInstance(instance);
+         Double_t ycut = fy->EvalInstance(instance);
+         return gcut->IsInside(xcut,ycut);
+      }
+      case -1: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         return fx->EvalInstance(instance);
+      }
+      default: return 0;
+   }
+}
+
+//______________________________________________________________________________
+Double_t TTreeFormula::JitLoad(void *formula, Int_t oper, Int_t instance, Int_t *outOfRange)
+{
+   // Function called by the compiled expressions to evaluate their operands.
+
+   Bool_t out;
+   Double_t value = static_cast<TTreeFormula*>(formula)->EvalJitOperand(oper, instance, out);
+   if (out) *outOfRange = 1;
+   return value;
+}
+
 //______________________________________________________________________________
 TFormLeafInfo *TTreeFormula::GetLeafInfo(Int_t code) const
 {
@@ -4539,6 +4835,17 @@ Bool_t TTreeFormula::IsInteger(Bool_t fast) const
    return kFALSE;
 }
 
+//______________________________________________________________________________
+Bool_t TTreeFormula::IsJitCompilation()
+{
+   // Return kTRUE if the expressions are compiled (see SetJitCompilation).
+
+   if (fgJitCompilation < 0) {
+      fgJitCompilation = gEnv->GetValue("TreeFormula.JitCompilation", 0) ? 1 : 0;
+   }
+   return fgJitCompilation > 0;
+}
+
 //______________________________________________________________________________
 Bool_t TTreeFormula::IsLeafInteger(Int_t code) const
 {
@@ -4895,6 +5202,25 @@ void TTreeFormula::SetAxis(TAxis *axis)
    }
 }
 
+//______________________________________________________________________________
+void TTreeFormula::SetJitCompilation(Bool_t jit)
+{
+   // If jit is kTRUE, the expressions of the formulas evaluated afterwards
+   // are translated to C++ and compiled by the interpreter at their first
+   // evaluation, which avoids the interpretation of the operators and of the
+   // functions at each entry. The compiled functions are shared by all the
+   // formulas with the same expression (up to the names of the branches).
+   // The expressions using strings, the operator ?:, external functions or
+   // random numbers are still evaluated by EvalInstance.
+   // The default is given by the rootrc variable TreeFormula.JitCompilation.
+   //
+   // Example:
+   //    TTreeFormula::SetJitCompilation();
+   //    tree->Draw("sqrt(px*px+py*py)", "abs(eta)<2.5 && pt>20");
+
+   fgJitCompilation = jit ? 1 : 0;
+}
+
 //______________________________________________________________________________
 void TTreeFormula::Streamer(TBuffer &R__b)
 {